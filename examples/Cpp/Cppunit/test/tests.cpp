@@ -5,12 +5,14 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <cppunit/TestCase.h>
 #include <cppunit/TestFixture.h>
 #include <cppunit/TestResult.h>
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/TestRunner.h>
+#include <cppunit/TestSuite.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/XmlOutputter.h>
@@ -22,6 +24,7 @@ using std::cout;
 using std::endl;
 using std::string;
 using std::ofstream;
+using std::vector;
 
 static const int RET_OK = 0;
 static const int RET_USAGE = -1;
@@ -147,13 +150,14 @@ void usage(const char *path)
   image = image.substr(image.find_last_of("/\\") + 1);
 
   cout << endl;
-  cout << "Usage: " << image << " [ -l | -h | -t test]" << endl << endl;
+  cout << "Usage: " << image << " [ -l | -h | -t test ...]" << endl << endl;
 
   cout << "A test example built against cppunit version: ";
   cout << CPPUNIT_VERSION << endl << endl;
 
   cout << "Options:" << endl;
-  cout << "    -t  Runs the given test only. Default: All Tests" << endl;
+  cout << "    -t  Runs the given test only, can be repeated. Default: All Tests"
+       << endl;
   cout << "    -l  List all available tests." << endl;
   cout << "    -h  Print this usage message." << endl << endl;
 
@@ -226,7 +230,7 @@ int main(int argc, char **argv)
 
   Test *test = 0;
   char flag = 0;
-  string filter = "";
+  vector<string> filters;
   string fileOut = "";
 
   while ((flag = getopt(argc, argv, "t:y:lh")) != -1) {
@@ -241,7 +245,7 @@ int main(int argc, char **argv)
 
     case 't':
       {
-        filter = optarg;
+        filters.push_back(optarg);
       }
       break;
 
@@ -258,8 +262,22 @@ int main(int argc, char **argv)
     }
   }
 
-  if (filter.length())
-    test = find(TestFactoryRegistry::getRegistry().makeTest(), filter);
+  if (filters.size() == 1)
+    test = find(TestFactoryRegistry::getRegistry().makeTest(), filters[0]);
+  else if (filters.size() > 1) {
+    // e.g. a sample of the tests selected by Testplan
+    Test *all = TestFactoryRegistry::getRegistry().makeTest();
+    TestSuite *selected = new TestSuite("All Tests");
+    for (size_t i = 0; i < filters.size(); ++i) {
+      Test *found = find(all, filters[i]);
+      if (found == 0) {
+        cerr << "No test case found: " << filters[i] << endl;
+        return RET_BAD_TEST;
+      }
+      selected->addTest(found);
+    }
+    test = selected;
+  }
   else
     test = TestFactoryRegistry::getRegistry().makeTest();
 
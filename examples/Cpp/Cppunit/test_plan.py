@@ -3,20 +3,25 @@
 """
 This example shows how to use Cppunit test runner.
 
-To be able to run the test, you need to compile the files
-under `test` directory first to a binary target named `runTests`
+The files under `test` directory are compiled to a binary target named
+`runTests`. If CMake is available Testplan builds it incrementally before
+running it, otherwise you need to compile the test binary first.
 """
 
 import os
 import sys
 
 from testplan.testing.cpp import Cppunit
+from testplan.testing.cpp.build import CMakeProject
 from testplan.report.testing.styles import Style
 
 from testplan import test_plan
 
-BINARY_PATH = os.path.join(
-    os.path.dirname(os.path.abspath(__file__)), "test", "runTests"
+SOURCE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "test")
+BINARY_PATH = os.path.join(SOURCE_DIR, "runTests")
+
+PROJECT = CMakeProject(
+    source_dir=SOURCE_DIR, build_dir=os.path.join(SOURCE_DIR, "build")
 )
 
 
@@ -26,23 +31,32 @@ BINARY_PATH = os.path.join(
 )
 def main(plan):
 
-    if not os.path.exists(BINARY_PATH):
+    if os.path.exists(BINARY_PATH):
+        binary, build = BINARY_PATH, None
+    elif PROJECT.available:
+        build = PROJECT.target("runTests")
+        binary = build.binary
+    else:
         raise RuntimeError("You need to compile test binary first.")
 
-    else:
-        plan.add(
-            Cppunit(
-                name="My Cppunit", binary=BINARY_PATH, file_output_flag="-y"
-            )
+    plan.add(
+        Cppunit(
+            name="My Cppunit",
+            binary=binary,
+            build=build,
+            file_output_flag="-y",
         )
-        # You can apply Cppunit specific filtering via `filtering_flag` arg
-        # and `cppunit_filter` arg, for example:
-        # Cppunit(... filtering_flag='-t', cppunit_filter='LogicalOp::TestOr')
-        # And you can also implement listing feature via `listing_flag` arg,
-        # for example:
-        # Cppunit(... listing_flag='-l')
-        # But please be sure that your Cppunit binary is able to recognize
-        # those '-y', '-t' and '-l' flags.
+    )
+    # You can apply Cppunit specific filtering via `filtering_flag` arg
+    # and `cppunit_filter` arg, for example:
+    # Cppunit(... filtering_flag='-t', cppunit_filter='LogicalOp::TestOr')
+    # And you can also implement listing feature via `listing_flag` arg,
+    # for example:
+    # Cppunit(... listing_flag='-l')
+    # With both, a sample of the testcases can be run (`--sample 0.5`), the
+    # binary being passed '-t' for every sampled testcase.
+    # But please be sure that your Cppunit binary is able to recognize
+    # those '-y', '-t' and '-l' flags.
 
 
 if __name__ == "__main__":
@@ -1,11 +1,98 @@
 // app.cpp
 #include <math.h>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define APP_X86 1
+#endif
 
 double squareRoot(const double a) {
     double b = sqrt(a);
     if(b != b) { // nan check
         return -1.0;
     }else{
-        return sqrt(a);
+        return b;
     }
 }
+
+// Batch variants of squareRoot, every output element is equal to
+// squareRoot() of the matching input, including -1.0 for negative and
+// NaN inputs. Each code path handles the tail of the array which does not
+// fill a whole vector with the scalar version.
+namespace kernel {
+
+void squareRootScalar(const double* in, double* out, size_t n) {
+    for(size_t i = 0; i < n; ++i) {
+        out[i] = squareRoot(in[i]);
+    }
+}
+
+#ifdef APP_X86
+
+__attribute__((target("sse2")))
+void squareRootSSE2(const double* in, double* out, size_t n) {
+    const __m128d invalid = _mm_set1_pd(-1.0);
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        __m128d b = _mm_sqrt_pd(_mm_loadu_pd(in + i));
+        __m128d nan = _mm_cmpunord_pd(b, b);
+        _mm_storeu_pd(out + i,
+            _mm_or_pd(_mm_and_pd(nan, invalid), _mm_andnot_pd(nan, b)));
+    }
+    squareRootScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void squareRootAVX2(const double* in, double* out, size_t n) {
+    const __m256d invalid = _mm256_set1_pd(-1.0);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256d b = _mm256_sqrt_pd(_mm256_loadu_pd(in + i));
+        __m256d nan = _mm256_cmp_pd(b, b, _CMP_UNORD_Q);
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(b, invalid, nan));
+    }
+    squareRootScalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void squareRootAVX512(const double* in, double* out, size_t n) {
+    const __m512d invalid = _mm512_set1_pd(-1.0);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        // Zero-masked form, the unmasked one merges into an undefined
+        // vector which GCC reports as maybe uninitialized.
+        __m512d b = _mm512_maskz_sqrt_pd(0xFF, _mm512_loadu_pd(in + i));
+        __mmask8 nan = _mm512_cmp_pd_mask(b, b, _CMP_UNORD_Q);
+        _mm512_storeu_pd(out + i, _mm512_mask_blend_pd(nan, b, invalid));
+    }
+    squareRootScalar(in + i, out + i, n - i);
+}
+
+#endif // APP_X86
+
+typedef void (*SquareRootBatch)(const double*, double*, size_t);
+
+// Picks the widest code path supported by the CPU we are running on.
+inline SquareRootBatch selectSquareRoot() {
+#ifdef APP_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) {
+        return squareRootAVX512;
+    }
+    if(__builtin_cpu_supports("avx2")) {
+        return squareRootAVX2;
+    }
+    if(__builtin_cpu_supports("sse2")) {
+        return squareRootSSE2;
+    }
+#endif
+    return squareRootScalar;
+}
+
+} // namespace kernel
+
+void squareRoot(const double* in, double* out, size_t n) {
+    static const kernel::SquareRootBatch batch = kernel::selectSquareRoot();
+    batch(in, out, n);
+}
@@ -0,0 +1,68 @@
+// Benchmark of the batch squareRoot kernels against the scalar version,
+// reported in nanoseconds per element (lower is better).
+#include "app.cpp"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+static const size_t ELEMENTS = 1 << 20;
+static const int REPETITIONS = 20;
+
+template <typename Kernel>
+static double nsPerElement(Kernel kernel, const std::vector<double>& in,
+                           std::vector<double>& out) {
+    kernel(in.data(), out.data(), in.size());  // warm up
+    double best = 1e30;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        kernel(in.data(), out.data(), in.size());
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / in.size());
+    }
+    return best;
+}
+
+static void report(const char* name, double ns, double baseline) {
+    printf("%-12s %10.3f ns/element %8.2fx\n", name, ns, baseline / ns);
+}
+
+int main() {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(-1e3, 1e6);
+    std::vector<double> in(ELEMENTS), out(ELEMENTS);
+    for (double& value : in) {
+        value = dist(rng);
+    }
+
+    // The element-wise loop our tests used to write against squareRoot()
+    const double scalar = nsPerElement(
+        [](const double* a, double* b, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                b[i] = squareRoot(a[i]);
+            }
+        },
+        in, out);
+    report("Scalar", scalar, scalar);
+
+#ifdef APP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        report("SSE2", nsPerElement(kernel::squareRootSSE2, in, out), scalar);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        report("AVX2", nsPerElement(kernel::squareRootAVX2, in, out), scalar);
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        report("AVX512", nsPerElement(kernel::squareRootAVX512, in, out),
+               scalar);
+    }
+#endif
+    kernel::SquareRootBatch dispatched = squareRoot;
+    report("Dispatched", nsPerElement(dispatched, in, out), scalar);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+Measure the launch-to-first-test time of GTest binaries.
+
+Every binary is started repeatedly and timed until GTest reports the first
+test as running, which is the fixed cost paid by every launch: dynamic
+loading, symbol resolution and static initialization. Usage:
+
+    bench_launch.py [--runs N] runTests_dynamic runTests_now runTests_static
+"""
+import argparse
+import os
+import statistics
+import subprocess
+import time
+
+FIRST_TEST_MARKER = b"[ RUN      ]"
+
+
+def launch_to_first_test(binary):
+    """Seconds from spawning the binary until its first test starts."""
+    start = time.perf_counter()
+    proc = subprocess.Popen(
+        [binary, "--gtest_color=no"],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+    )
+    elapsed = None
+    for line in proc.stdout:
+        if line.startswith(FIRST_TEST_MARKER):
+            elapsed = time.perf_counter() - start
+            break
+    proc.kill()
+    proc.communicate()
+    if elapsed is None:
+        raise RuntimeError("{} did not run any test".format(binary))
+    return elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("binaries", nargs="+")
+    parser.add_argument("--runs", type=int, default=50)
+    args = parser.parse_args()
+
+    results = []
+    for binary in args.binaries:
+        launch_to_first_test(binary)  # warm up the page cache
+        samples = [launch_to_first_test(binary) for _ in range(args.runs)]
+        results.append((os.path.basename(binary), samples))
+
+    baseline = statistics.median(results[0][1])
+    print(
+        "{:<24} {:>10} {:>10} {:>10} {:>14}".format(
+            "binary", "min ms", "median ms", "p90 ms", "saved/1k runs"
+        )
+    )
+    for name, samples in results:
+        samples.sort()
+        median = statistics.median(samples)
+        print(
+            "{:<24} {:>10.2f} {:>10.2f} {:>10.2f} {:>13.1f}s".format(
+                name,
+                samples[0] * 1000,
+                median * 1000,
+                samples[int(len(samples) * 0.9) - 1] * 1000,
+                (baseline - median) * 1000,
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
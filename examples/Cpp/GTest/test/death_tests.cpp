@@ -0,0 +1,86 @@
+// Death tests of a multithreaded binary with a slow startup. GTest must
+// re-execute such a binary for every EXPECT_DEATH (threadsafe style), while
+// EXPECT_FORKED_DEATH forks a child of the fork server started at the
+// beginning of main, which has already paid for the startup.
+#include "app.cpp"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <testplan/gtest.h>
+#include <testplan/gtest_listener.h>
+
+// Stands for the reference data a real binary loads before its tests run.
+struct ReferenceTable {
+    ReferenceTable() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        for(int i = 0; i < 1024; ++i) {
+            roots.push_back(sqrt(static_cast<double>(i)));
+        }
+    }
+
+    std::vector<double> roots;
+};
+
+static ReferenceTable table;
+
+// Aborts on inputs squareRoot() has no result for.
+double checkedSquareRoot(double a) {
+    if(isnan(a) || a < 0) {
+        fprintf(stderr, "invalid input: %g\n", a);
+        abort();
+    }
+    return squareRoot(a);
+}
+
+void negativeInput() { checkedSquareRoot(-1.0); }
+
+TEST(CheckedSquareRootTest, Reference) {
+    for(size_t i = 0; i < table.roots.size(); ++i) {
+        EXPECT_NEAR(table.roots[i], checkedSquareRoot(i), 1e-6);
+    }
+}
+
+TEST(CheckedSquareRootTest, NegativeInput) {
+    EXPECT_FORKED_DEATH(checkedSquareRoot(-1.0), "invalid input: -1");
+}
+
+TEST(CheckedSquareRootTest, NaNInput) {
+    EXPECT_FORKED_DEATH(checkedSquareRoot(NAN), "invalid input: nan");
+}
+
+TEST(CheckedSquareRootTest, Exit) {
+    ASSERT_FORKED_DEATH(exit(3), "");
+}
+
+// The same test with EXPECT_DEATH, for comparison
+TEST(CheckedSquareRootTest, NegativeInputReExecuted) {
+    EXPECT_DEATH(negativeInput(), "invalid input: -1");
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    testplan::gtest::installListener();
+    ::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+
+    // Before any thread is started
+    testplan::death::ForkServer::instance().start(argc, argv);
+
+    std::atomic<bool> done(false);
+    std::thread worker([&done]() {
+        while(!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+    int result = RUN_ALL_TESTS();
+    done = true;
+    worker.join();
+    return result;
+}
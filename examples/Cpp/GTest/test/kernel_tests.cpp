@@ -0,0 +1,112 @@
+// Equivalence tests of the batch squareRoot kernels against the scalar
+// version. Every code path the CPU supports is tested, whichever one the
+// runtime dispatch picks.
+#include "app.cpp"
+
+#include <float.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+struct CodePath {
+    const char* name;
+    kernel::SquareRootBatch batch;
+    bool supported;
+};
+
+static std::vector<CodePath> codePaths() {
+    std::vector<CodePath> paths;
+    paths.push_back(CodePath{"Scalar", kernel::squareRootScalar, true});
+#ifdef APP_X86
+    __builtin_cpu_init();
+    paths.push_back(CodePath{"SSE2", kernel::squareRootSSE2,
+                             (bool)__builtin_cpu_supports("sse2")});
+    paths.push_back(CodePath{"AVX2", kernel::squareRootAVX2,
+                             (bool)__builtin_cpu_supports("avx2")});
+    paths.push_back(CodePath{"AVX512", kernel::squareRootAVX512,
+                             (bool)__builtin_cpu_supports("avx512f")});
+#endif
+    paths.push_back(CodePath{"Dispatched", squareRoot, true});
+    return paths;
+}
+
+// Compares bit patterns, so that -0.0 and 0.0 are told apart.
+static void expectSameAsScalar(const std::vector<double>& in,
+                               const std::vector<double>& out) {
+    ASSERT_EQ(in.size(), out.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        const double expected = squareRoot(in[i]);
+        EXPECT_EQ(0, memcmp(&expected, &out[i], sizeof(double)))
+            << "index " << i << ": squareRoot(" << in[i] << ") is "
+            << expected << " but the batch kernel returned " << out[i];
+    }
+}
+
+class SquareRootBatchTest : public ::testing::TestWithParam<CodePath> {
+protected:
+    void SetUp() override {
+        if (!GetParam().supported) {
+            GTEST_SKIP() << GetParam().name << " is not supported by the CPU";
+        }
+    }
+
+    std::vector<double> run(const std::vector<double>& in) {
+        std::vector<double> out(in.size(), 0.0);
+        GetParam().batch(in.data(), out.data(), in.size());
+        return out;
+    }
+};
+
+TEST_P(SquareRootBatchTest, SpecialValues) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<double> in = {
+        0.0, -0.0, 1.0, 4.0, 36.0, 645.16, -15.0, -0.2, nan, -nan,
+        inf, -inf, DBL_MIN / 4, DBL_MAX, -DBL_MIN, DBL_EPSILON, 1e300,
+    };
+    expectSameAsScalar(in, run(in));
+}
+
+TEST_P(SquareRootBatchTest, AllTailLengths) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+
+    for (size_t n = 0; n <= 33; ++n) {
+        std::vector<double> in(n);
+        for (double& value : in) {
+            value = dist(rng);
+        }
+        expectSameAsScalar(in, run(in));
+    }
+}
+
+TEST_P(SquareRootBatchTest, UnalignedBuffers) {
+    std::vector<double> buffer(1027);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (i % 3 == 0) ? -double(i) : double(i) * 0.5;
+    }
+    std::vector<double> out(buffer.size(), 0.0);
+    // Start one element into the buffers, misaligned for any vector width
+    const double* in = buffer.data() + 1;
+    ASSERT_NE(0u, reinterpret_cast<uintptr_t>(in) % 16);
+    GetParam().batch(in, out.data() + 1, buffer.size() - 1);
+    expectSameAsScalar(std::vector<double>(buffer.begin() + 1, buffer.end()),
+                       std::vector<double>(out.begin() + 1, out.end()));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CodePaths, SquareRootBatchTest, ::testing::ValuesIn(codePaths()),
+    [](const ::testing::TestParamInfo<CodePath>& info) {
+        return std::string(info.param.name);
+    });
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
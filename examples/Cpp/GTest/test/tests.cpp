@@ -1,5 +1,6 @@
 #include "app.cpp"
 #include <gtest/gtest.h>
+#include <testplan/gtest_listener.h>
 
 TEST(SquareRootTest, PositiveNos) {
   ASSERT_EQ(6, squareRoot(36.0));
@@ -33,5 +34,7 @@ TEST(SquareRootTestNonFatal, NegativeNos) {
 
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
+  // Report assertions with their operand values to Testplan
+  testplan::gtest::installListener();
   return RUN_ALL_TESTS();
 }
@@ -3,19 +3,26 @@
 """
 This example shows how to use GTest test runner.
 
-To be able to run the test, you need to compile the files
-under `test` directory first to a binary target named `runTests`
+The files under `test` directory are compiled to the binary targets
+`runTests`, `runKernelTests` and `runDeathTests`. If CMake is available Testplan builds them
+incrementally before running them, otherwise you need to compile the test
+binaries first.
 """
 
 import os
 import sys
 
 from testplan.testing.cpp import GTest
+from testplan.testing.cpp.build import CMakeProject
 from testplan.report.testing.styles import Style
 
 from testplan import test_plan
 
-BINARY_PATH = os.path.join(os.path.dirname(__file__), "test", "runTests")
+SOURCE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "test")
+
+PROJECT = CMakeProject(
+    source_dir=SOURCE_DIR, build_dir=os.path.join(SOURCE_DIR, "build")
+)
 
 
 @test_plan(
@@ -24,20 +31,37 @@ BINARY_PATH = os.path.join(os.path.dirname(__file__), "test", "runTests")
 )
 def main(plan):
 
-    if not os.path.exists(BINARY_PATH):
+    def binary_and_build(target):
+        binary = os.path.join(SOURCE_DIR, target)
+        if os.path.exists(binary):
+            return binary, None
+        elif PROJECT.available:
+            # The target is built in the background as soon as the test is
+            # added, and the test starts as soon as it has been linked.
+            build = PROJECT.target(target)
+            return build.binary, build
         raise RuntimeError("You need to compile test binary first.")
 
-    else:
-        plan.add(
-            GTest(
-                name="My GTest",
-                binary=BINARY_PATH,
-                # You can apply GTest specific filtering via `gtest_filter` arg
-                # gtest_filter='SquareRootTest.*',
-                # You can also shuffle test order via `gtest_shuffle` arg
-                # gtest_shuffle=True
-            )
+    binary, build = binary_and_build("runTests")
+    plan.add(
+        GTest(
+            name="My GTest",
+            binary=binary,
+            build=build,
+            # You can apply GTest specific filtering via `gtest_filter` arg
+            # gtest_filter='SquareRootTest.*',
+            # You can also shuffle test order via `gtest_shuffle` arg
+            # gtest_shuffle=True
         )
+    )
+
+    # Equivalence tests of the vectorized squareRoot kernels
+    binary, build = binary_and_build("runKernelTests")
+    plan.add(GTest(name="My Kernel GTest", binary=binary, build=build))
+
+    # Death tests run by the fork server, see testplan/fork_server.h
+    binary, build = binary_and_build("runDeathTests")
+    plan.add(GTest(name="My Death GTest", binary=binary, build=build))
 
 
 if __name__ == "__main__":
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Benchmark the minimum cost assignment used by unordered comparisons.
+
+Random error matrices like those of ``unordered_compare`` (many equal
+costs) are solved by the C++ extension and by the Python fallback, and the
+total cost checked against scipy. Usage:
+
+    bench_assignment.py [--sizes 10 100 200 500] [--runs N]
+"""
+
+import argparse
+import random
+import time
+
+import numpy
+from scipy.optimize import linear_sum_assignment
+
+from testplan.common.utils import assignment
+
+SIZES = (10, 20, 50, 100, 200, 500)
+
+
+def error_matrix(size, rng):
+    """Per tag errors of 10 tags weighted 100, as unordered_compare does."""
+    return [
+        [100 * rng.randint(0, 10) for _ in range(size)] for _ in range(size)
+    ]
+
+
+def timed(func, grid, runs):
+    best, result = None, None
+    for _ in range(runs):
+        start = time.perf_counter()
+        result = func(grid)
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--sizes", type=int, nargs="+", default=SIZES)
+    parser.add_argument("--runs", type=int, default=3)
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    if assignment._assignment is None:
+        print("C++ extension not built, timing the Python fallback only")
+    print(
+        "{:>6} {:>12} {:>12} {:>12}".format(
+            "size", "native ms", "python ms", "scipy ms"
+        )
+    )
+    rng = random.Random(args.seed)
+    for size in args.sizes:
+        grid = error_matrix(size, rng)
+        array = numpy.array(grid)
+        scipy_time, (rows, cols) = timed(
+            linear_sum_assignment, array, args.runs
+        )
+        optimum = array[rows, cols].sum()
+
+        timings = []
+        for func in (
+            assignment.min_cost_assignment if assignment._assignment else None,
+            assignment.python_min_cost_assignment,
+        ):
+            if func is None:
+                timings.append(None)
+                continue
+            elapsed, result = timed(func, grid, args.runs)
+            assert sorted(result) == list(range(size))
+            assert array[numpy.arange(size), result].sum() == optimum
+            timings.append(elapsed)
+
+        print(
+            "{:>6} {:>12} {:>12} {:>12.3f}".format(
+                size,
+                *[
+                    "-" if elapsed is None else "{:.3f}".format(elapsed * 1000)
+                    for elapsed in timings
+                ],
+                scipy_time * 1000
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
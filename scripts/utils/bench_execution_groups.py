@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+Benchmark execution groups of assertion heavy testcases.
+
+A MultiTest runs testcases matching many dicts in a single execution group,
+in its thread pool and in forked processes. Usage:
+
+    bench_execution_groups.py [--testcases 8] [--matches 500]
+"""
+
+import argparse
+import tempfile
+import time
+
+from testplan.common.utils.testing import log_propagation_disabled
+from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.testing.multitest import MultiTest, testsuite, testcase
+from testplan.common.utils import comparison
+from testplan import TestplanMock
+from testplan.report.testing.styles import Style, StyleEnum
+
+
+def make_suite(testcases, matches):
+    expected = {
+        "id": comparison.Greater(-1),
+        "side": comparison.In(["BUY", "SELL"]),
+        "legs": [{"qty": comparison.Greater(0), "px": 10.5}] * 4,
+    }
+
+    @testsuite
+    class Orders(object):
+        @testcase(parameters=range(testcases), execution_group="orders")
+        def match(self, env, result, index):
+            for idx in range(matches):
+                value = {
+                    "id": idx,
+                    "side": "BUY" if idx % 2 else "SELL",
+                    "legs": [{"qty": idx + 1, "px": 10.5}] * 4,
+                }
+                result.dict.match(value, expected)
+
+    return Orders()
+
+
+def run(suite, **options):
+    with tempfile.TemporaryDirectory() as runpath:
+        plan = TestplanMock(
+            "bench",
+            runpath=runpath,
+            stdout_style=Style(StyleEnum.RESULT, StyleEnum.RESULT),
+        )
+        plan.add(MultiTest(name="Bench", suites=[suite], **options))
+        start = time.perf_counter()
+        with log_propagation_disabled(TESTPLAN_LOGGER):
+            plan.run()
+        elapsed = time.perf_counter() - start
+        assert plan.report.passed
+    return elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--testcases", type=int, default=8)
+    parser.add_argument("--matches", type=int, default=500)
+    parser.add_argument("--workers", type=int, default=4)
+    args = parser.parse_args()
+
+    suite = make_suite(args.testcases, args.matches)
+    for label, options in (
+        ("threads", {"thread_pool_size": args.workers}),
+        ("processes", {"process_pool_size": args.workers}),
+    ):
+        print("{:>10}: {:.0f} ms".format(label, run(suite, **options) * 1000))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Benchmark a FIX match template replayed against many messages.
+
+The same expected message, with regexes, comparators and a repeating group,
+is matched against random orders as an expected dict and as a comparison
+plan compiled once. Usage:
+
+    bench_fix_match.py [--messages 100000]
+"""
+
+import argparse
+import random
+import re
+import time
+
+from testplan.common.utils import comparison
+from testplan.common.utils.testing import FixMessage
+from testplan.testing.multitest.entries import assertions
+
+
+def make_template():
+    return FixMessage(
+        (
+            (8, "FIX.4.2"),
+            (35, "D"),
+            (49, re.compile(r"CLIENT\d+")),
+            (56, "BROKER"),
+            (11, re.compile(r"\w+")),
+            (55, comparison.In(["AAPL", "MSFT", "GOOG"])),
+            (54, comparison.In(["1", "2"])),
+            (38, comparison.Greater(0)),
+            (40, "2"),
+            (44, lambda price: 0 < float(price) < 1000),
+            (59, "0"),
+            (
+                453,
+                [
+                    {448: re.compile(r"[A-Z]+"), 447: "D", 452: "1"},
+                    {448: re.compile(r"[A-Z]+"), 447: "D", 452: "3"},
+                ],
+            ),
+        )
+    )
+
+
+def make_message(index, rng):
+    return FixMessage(
+        (
+            (8, "FIX.4.2"),
+            (35, "D"),
+            (49, "CLIENT{}".format(rng.randint(1, 9))),
+            (56, "BROKER"),
+            (11, "ORD{}".format(index)),
+            (55, rng.choice(["AAPL", "MSFT", "GOOG", "IBM"])),
+            (54, rng.choice(["1", "2"])),
+            (38, rng.randint(1, 1000)),
+            (40, "2"),
+            (44, "{:.2f}".format(rng.uniform(1, 999))),
+            (59, "0"),
+            (
+                453,
+                [
+                    {448: "DESK", 447: "D", 452: "1"},
+                    {448: "TRADER", 447: "D", 452: rng.choice(["3", "4"])},
+                ],
+            ),
+        )
+    )
+
+
+def timed(func, *args):
+    start = time.perf_counter()
+    result = func(*args)
+    return time.perf_counter() - start, result
+
+
+def match_all(messages, expected):
+    return [assertions.FixMatch(msg, expected).passed for msg in messages]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--messages", type=int, default=100000)
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    messages = [make_message(index, rng) for index in range(args.messages)]
+    template = make_template()
+
+    dict_time, dict_passed = timed(match_all, messages, template)
+    plan_time, plan_passed = timed(
+        match_all, messages, comparison.ComparisonPlan(template)
+    )
+    assert plan_passed == dict_passed
+
+    print(
+        "{} messages, {} passed: dict {:.0f} ms, plan {:.0f} ms".format(
+            len(messages),
+            sum(dict_passed),
+            dict_time * 1000,
+            plan_time * 1000,
+        )
+    )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Benchmark the line matching of the diff functions.
+
+Logs of random lines, blank ones included, are diffed against a copy with
+some lines changed, removed and added. The C++ extension and the Python
+fallback of linediff are timed, and the SequenceMatcher the diff functions
+used before for the smaller sizes. Usage:
+
+    bench_linediff.py [--sizes 1000 10000 200000] [--changes 0.01]
+"""
+
+import argparse
+import random
+import time
+
+from testplan.common.utils import difflib, linediff
+
+SIZES = (1000, 10000, 50000, 200000)
+
+# SequenceMatcher is quadratic in the worst case, not timed beyond this
+SEQUENCE_MATCHER_MAX = 10000
+
+
+def make_log(size, rng):
+    return [
+        (
+            "\n"
+            if rng.random() < 0.05
+            else "12:{:02d}:{:02d} INFO [svc-{}] order {} {}\n".format(
+                index // 60 % 60,
+                index % 60,
+                rng.randint(0, 7),
+                rng.randint(0, 10**6),
+                rng.choice(("NEW", "ACK", "FILLED")),
+            )
+        )
+        for index in range(size)
+    ]
+
+
+def changed(lines, fraction, rng):
+    result = list(lines)
+    for _ in range(int(len(lines) * fraction)):
+        index = rng.randrange(len(result))
+        kind = rng.random()
+        if kind < 0.4:
+            result[index] = result[index].replace("INFO", "WARN")
+        elif kind < 0.7:
+            del result[index]
+        else:
+            result.insert(index, "inserted {}\n".format(index))
+    return result
+
+
+def timed(func, *args):
+    start = time.perf_counter()
+    result = func(*args)
+    return time.perf_counter() - start, result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--sizes", type=int, nargs="+", default=SIZES)
+    parser.add_argument("--changes", type=float, default=0.01)
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    if linediff._linediff is None:
+        print("C++ extension not built, timing the Python fallback only")
+    print(
+        "{:>8} {:>10} {:>10} {:>10} {:>12} {:>10}".format(
+            "lines",
+            "hash ms",
+            "native ms",
+            "python ms",
+            "seqmatch ms",
+            "diff ms",
+        )
+    )
+    rng = random.Random(args.seed)
+    for size in args.sizes:
+        first = make_log(size, rng)
+        second = changed(first, args.changes, rng)
+        hash_time, (a, b) = timed(
+            linediff.line_ids,
+            first,
+            second,
+            False,
+            False,
+            difflib.IS_LINE_JUNK,
+        )
+        native_time, blocks = (
+            timed(linediff.matching_blocks, a, b)
+            if linediff._linediff is not None
+            else (None, None)
+        )
+        python_time, python_blocks = timed(
+            linediff.python_matching_blocks, a, b
+        )
+        assert blocks is None or blocks == python_blocks
+
+        seqmatch_time = None
+        if size <= SEQUENCE_MATCHER_MAX:
+            seqmatch_time, _ = timed(
+                lambda: difflib.SequenceMatcher(
+                    difflib.IS_LINE_JUNK, first, second
+                ).get_opcodes()
+            )
+        diff_time, _ = timed(lambda: list(difflib.diff(first, second)))
+
+        print(
+            "{:>8} {:>10} {:>10} {:>10} {:>12} {:>10}".format(
+                size,
+                *[
+                    "-" if value is None else "{:.1f}".format(value * 1000)
+                    for value in (
+                        hash_time,
+                        native_time,
+                        python_time,
+                        seqmatch_time,
+                        diff_time,
+                    )
+                ]
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Benchmark serializing the entries of assertion heavy testcase reports.
+
+Testcase reports of many assertions are built as the runners do, then their
+status is computed and they are exported to JSON. Entries are serialized
+with a new schema for each entry as before, with the registry reusing its
+schemas, and lazily at export time. Usage:
+
+    bench_report_entries.py [--testcases 100] [--assertions 100]
+"""
+
+import argparse
+import json
+import time
+
+from testplan.common.utils import comparison
+from testplan.report import TestCaseReport
+from testplan.report.testing.schemas import TestCaseReportSchema
+from testplan.testing.multitest.entries import assertions
+from testplan.testing.multitest.entries.schemas.base import registry
+
+EXPECTED = {
+    "id": comparison.Greater(-1),
+    "side": comparison.In(["BUY", "SELL"]),
+    "legs": [{"qty": comparison.Greater(0), "px": 10.5}] * 4,
+}
+
+
+def make_entries(count):
+    entries = []
+    for idx in range(count):
+        value = {
+            "id": idx,
+            "side": "BUY" if idx % 2 else "SELL",
+            "legs": [{"qty": idx + 1, "px": 10.5}] * 4,
+        }
+        entries.append(assertions.Equal(idx, idx))
+        entries.append(
+            assertions.RawAssertion(
+                description="check", content=str(idx), passed=True
+            )
+        )
+        entries.append(assertions.DictMatch(value, EXPECTED))
+    return entries
+
+
+def serialize_new_schema(entry):
+    return registry[entry](strict=True).dump(entry).data
+
+
+def build(testcases, serialize):
+    reports = []
+    for idx, entries in enumerate(testcases):
+        name = "testcase_{}".format(idx)
+        report = TestCaseReport(name=name, uid=name)
+        for entry in entries:
+            report.append(serialize(entry))
+        report.status  # pylint: disable=pointless-statement
+        reports.append(report)
+    return reports
+
+
+def export(reports):
+    schema = TestCaseReportSchema(strict=True)
+    return [json.dumps(schema.dump(report).data) for report in reports]
+
+
+def timed(func, *args):
+    start = time.perf_counter()
+    result = func(*args)
+    return time.perf_counter() - start, result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--testcases", type=int, default=100)
+    parser.add_argument("--assertions", type=int, default=100)
+    args = parser.parse_args()
+
+    testcases = [make_entries(args.assertions) for _ in range(args.testcases)]
+    print(
+        "{} entries: {:>10} {:>10} {:>10}".format(
+            sum(map(len, testcases)), "build ms", "export ms", "total ms"
+        )
+    )
+    exported = []
+    for name, serialize in (
+        ("new schema", serialize_new_schema),
+        ("reused", registry.serialize),
+        ("lazy", registry.serialize_lazily),
+    ):
+        build_time, reports = timed(build, testcases, serialize)
+        export_time, result = timed(export, reports)
+        exported.append(result)
+        print(
+            "{:>12}: {:>10.0f} {:>10.0f} {:>10.0f}".format(
+                name,
+                build_time * 1000,
+                export_time * 1000,
+                (build_time + export_time) * 1000,
+            )
+        )
+    for result in exported[1:]:
+        for first, second in zip(exported[0], result):
+            first, second = json.loads(first), json.loads(second)
+            first.pop("hash"), second.pop("hash")  # Hash of entry ids
+            assert first == second, "Exported reports differ"
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Benchmark the table match assertion on large tables.
+
+Tables of orders are matched against expected tables of plain values,
+regexes and tolerances with a few mismatching rows, only reporting a few
+passing rows. The cell by cell comparison the assertion used before is
+timed as well. Usage:
+
+    bench_table_match.py [--sizes 1000 100000 1000000]
+"""
+
+import argparse
+import random
+import re
+import time
+
+from testplan.common.utils import comparison
+from testplan.testing.multitest.entries import assertions
+
+SIZES = (1000, 100000, 1000000)
+
+COLUMNS = ["id", "symbol", "side", "qty", "price"]
+
+
+def make_tables(size, rng):
+    table = [COLUMNS] + [
+        [
+            index,
+            rng.choice(("AAPL", "MSFT", "GOOG")),
+            rng.choice(("BUY", "SELL")),
+            rng.randint(1, 1000),
+            round(rng.uniform(10, 500), 2),
+        ]
+        for index in range(size)
+    ]
+    side = re.compile(r"BUY|SELL")
+    expected = [COLUMNS] + [
+        [
+            index,
+            symbol,
+            side,
+            qty,
+            comparison.IsClose(price, abs_tol=0.005),
+        ]
+        for index, symbol, _, qty, price in table[1:]
+    ]
+    for row in rng.sample(expected[1:], max(size // 1000, 1)):
+        row[3] += 1
+    return table, expected
+
+
+def compare_cells(table, expected):
+    failures = 0
+    for row, expected_row in zip(table[1:], expected[1:]):
+        for first, second in zip(row, expected_row):
+            passed, error = comparison.basic_compare(first, second)
+            failures += bool(error or not passed)
+    return failures
+
+
+def timed(func, *args, **kwargs):
+    start = time.perf_counter()
+    result = func(*args, **kwargs)
+    return time.perf_counter() - start, result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--sizes", type=int, nargs="+", default=SIZES)
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    print(
+        "{:>9} {:>10} {:>10} {:>9}".format(
+            "rows", "match ms", "cells ms", "reported"
+        )
+    )
+    rng = random.Random(args.seed)
+    for size in args.sizes:
+        table, expected = make_tables(size, rng)
+        match_time, entry = timed(
+            assertions.TableMatch, table, expected, report_pass_limit=10
+        )
+        cells_time, failures = timed(compare_cells, table, expected)
+        assert failures == sum(not row.passed for row in entry.data)
+        print(
+            "{:>9} {:>10.1f} {:>10.1f} {:>9}".format(
+                size, match_time * 1000, cells_time * 1000, len(entry.data)
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -5,7 +5,7 @@ Setup testplan and dependencies.
 
 import sys
 
-from setuptools import setup, find_packages
+from setuptools import setup, find_packages, Extension
 
 
 REQUIRED = [
@@ -41,6 +41,24 @@ REQUIRED = [
     "Pillow",
 ]
 
+# Native solver of testplan.common.utils.assignment, which falls back to
+# Python when it cannot be built.
+ASSIGNMENT = Extension(
+    "testplan.common.utils._assignment",
+    sources=["testplan/common/utils/_assignment.cpp"],
+    language="c++",
+    optional=True,
+)
+
+# Native engine of testplan.common.utils.linediff, which falls back to
+# Python when it cannot be built.
+LINEDIFF = Extension(
+    "testplan.common.utils._linediff",
+    sources=["testplan/common/utils/_linediff.cpp"],
+    language="c++",
+    optional=True,
+)
+
 setup(
     name="Testplan",
     version="1.0",
@@ -51,5 +69,6 @@ setup(
     packages=["testplan"] + find_packages(),
     include_package_data=True,
     install_requires=REQUIRED,
+    ext_modules=[ASSIGNMENT, LINEDIFF],
     scripts=["install-testplan-ui"],
 )
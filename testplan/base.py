@@ -116,6 +116,15 @@ class Testplan(entity.RunnableManager):
     :type xml_dir: ``str``
     :param json_path: JSON output path <PATH>/\*.json.
     :type json_path: ``str``
+    :param openmetrics_path: OpenMetrics output path <PATH>/\*.prom.
+    :type openmetrics_path: ``str``
+    :param performance_baseline: JSON report of a previous run to compare
+        the durations, resource usage and benchmarks of this run with.
+    :type performance_baseline: ``str``
+    :param report_journal: Path of the journal the report is appended to
+        while the plan runs, to recover the report of a crashed run or read
+        it before the run completes.
+    :type report_journal: ``str``
     :param http_url: HTTP url to post JSON report.
     :type http_url: ``str``
     :param pdf_path: PDF output path <PATH>/\*.pdf.
@@ -134,6 +143,9 @@ class Testplan(entity.RunnableManager):
     :type browse: ``bool`` or ``NoneType``
     :param ui_port: Port of web server for displaying test report.
     :type ui_port: ``int`` or ``NoneType``
+    :param monitor_port: Port of web server for monitoring the run live,
+        0 for any free port, ``None`` not to start it.
+    :type monitor_port: ``int`` or ``NoneType``
     :param web_server_startup_timeout: Timeout for starting web server.
     :type web_server_startup_timeout: ``int``
     :param test_filter: Tests filtering class.
@@ -142,6 +154,10 @@ class Testplan(entity.RunnableManager):
     :param test_sorter: Tests sorting class.
     :type test_sorter: Subclass of
         :py:class:`BaseSorter <testplan.testing.ordering.BaseSorter>`
+    :param test_sample: Sample of the testcases of the test binaries to
+        run, e.g. for smoke runs of huge C++ suites.
+    :type test_sample: ``NoneType`` or
+        :py:class:`Sample <testplan.testing.sampling.Sample>`
     :param test_lister: Tests listing class.
     :type test_lister: Subclass of
         :py:class:`BaseLister <testplan.testing.listing.BaseLister>`
@@ -152,6 +168,10 @@ class Testplan(entity.RunnableManager):
     :param timeout: Timeout value in seconds to kill Testplan and all child
         processes, default to 14400s(4h), set to 0 to disable.
     :type timeout: ``int``
+    :param report_workers: Number of processes converting the output of
+        local test binaries into reports while the next tests run, 0 to
+        convert it after each test.
+    :type report_workers: ``int``
     :param interactive_handler: Handler for interactive mode execution.
     :type interactive_handler: Subclass of :py:class:
         `TestRunnerIHandler <testplan.runnable.interactive.TestRunnerIHandler>`
@@ -183,6 +203,9 @@ class Testplan(entity.RunnableManager):
         report_dir=defaults.REPORT_DIR,
         xml_dir=None,
         json_path=None,
+        openmetrics_path=None,
+        performance_baseline=None,
+        report_journal=None,
         http_url=None,
         pdf_path=None,
         pdf_style=defaults.PDF_STYLE,
@@ -191,13 +214,16 @@ class Testplan(entity.RunnableManager):
         merge_scheduled_parts=False,
         browse=False,
         ui_port=None,
+        monitor_port=None,
         web_server_startup_timeout=defaults.WEB_SERVER_TIMEOUT,
         test_filter=filtering.Filter(),
         test_sorter=ordering.NoopSorter(),
+        test_sample=None,
         test_lister=None,
         verbose=False,
         debug=False,
         timeout=defaults.TESTPLAN_TIMEOUT,
+        report_workers=0,
         interactive_handler=TestRunnerIHandler,
         extra_deps=None,
         **options
@@ -233,6 +259,9 @@ class Testplan(entity.RunnableManager):
             report_dir=report_dir,
             xml_dir=xml_dir,
             json_path=json_path,
+            openmetrics_path=openmetrics_path,
+            performance_baseline=performance_baseline,
+            report_journal=report_journal,
             http_url=http_url,
             pdf_path=pdf_path,
             pdf_style=pdf_style,
@@ -241,13 +270,16 @@ class Testplan(entity.RunnableManager):
             merge_scheduled_parts=merge_scheduled_parts,
             browse=browse,
             ui_port=ui_port,
+            monitor_port=monitor_port,
             web_server_startup_timeout=web_server_startup_timeout,
             test_filter=test_filter,
             test_sorter=test_sorter,
+            test_sample=test_sample,
             test_lister=test_lister,
             verbose=verbose,
             debug=debug,
             timeout=timeout,
+            report_workers=report_workers,
             interactive_handler=interactive_handler,
             extra_deps=extra_deps,
             **options
@@ -338,6 +370,9 @@ class Testplan(entity.RunnableManager):
         report_dir=defaults.REPORT_DIR,
         xml_dir=None,
         json_path=None,
+        openmetrics_path=None,
+        performance_baseline=None,
+        report_journal=None,
         http_url=None,
         pdf_path=None,
         pdf_style=defaults.PDF_STYLE,
@@ -346,13 +381,16 @@ class Testplan(entity.RunnableManager):
         merge_scheduled_parts=False,
         browse=False,
         ui_port=None,
+        monitor_port=None,
         web_server_startup_timeout=defaults.WEB_SERVER_TIMEOUT,
         test_filter=filtering.Filter(),
         test_sorter=ordering.NoopSorter(),
+        test_sample=None,
         test_lister=None,
         verbose=False,
         debug=False,
         timeout=defaults.TESTPLAN_TIMEOUT,
+        report_workers=0,
         interactive_handler=TestRunnerIHandler,
         extra_deps=None,
         **options
@@ -392,6 +430,9 @@ class Testplan(entity.RunnableManager):
                     report_dir=report_dir,
                     xml_dir=xml_dir,
                     json_path=json_path,
+                    openmetrics_path=openmetrics_path,
+                    performance_baseline=performance_baseline,
+                    report_journal=report_journal,
                     http_url=http_url,
                     pdf_path=pdf_path,
                     pdf_style=pdf_style,
@@ -400,13 +441,16 @@ class Testplan(entity.RunnableManager):
                     merge_scheduled_parts=merge_scheduled_parts,
                     browse=browse,
                     ui_port=ui_port,
+                    monitor_port=monitor_port,
                     web_server_startup_timeout=web_server_startup_timeout,
                     test_filter=test_filter,
                     test_sorter=test_sorter,
+                    test_sample=test_sample,
                     test_lister=test_lister,
                     verbose=verbose,
                     debug=debug,
                     timeout=timeout,
+                    report_workers=report_workers,
                     interactive_handler=interactive_handler,
                     extra_deps=extra_deps,
                     **options
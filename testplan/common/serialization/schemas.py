@@ -1,3 +1,6 @@
+import copy
+from collections.abc import Mapping
+
 from marshmallow import Schema
 
 from testplan.common.utils.registry import Registry
@@ -63,7 +66,95 @@ class SchemaRegistry(Registry):
     """
     Registry class to be used with Marshmallow schemas, provides
     `serialize` method that calls `dump` on the underlying schema mapping.
+
+    Schemas are instantiated once and reused, as instantiating a schema
+    costs more than dumping most objects. An instance is only used by one
+    thread and one (possibly nested) dump at a time.
     """
 
+    def __init__(self):
+        super(SchemaRegistry, self).__init__()
+        # Schema instances not in use, by schema class
+        self._free_schemas = {}
+
     def serialize(self, obj):
-        return self[obj](strict=True).dump(obj).data
+        schema_cls = self[obj]
+        free = self._free_schemas.setdefault(schema_cls, [])
+        try:
+            schema = free.pop()
+        except IndexError:
+            schema = schema_cls(strict=True)
+        try:
+            return schema.dump(obj).data
+        finally:
+            free.append(schema)
+
+    def serialize_lazily(self, obj, **known):
+        """
+        Serialized form of an object, dumped when first accessed.
+
+        :param obj: Object to serialize, should not be modified afterwards.
+        :type obj: ``object``
+        :param known: Values of serialized keys known without dumping the
+            object.
+        :type known: ``dict``
+        :return: Read only mapping of the serialized object.
+        :rtype: :py:class:`LazySerialized`
+        """
+        return LazySerialized(self, obj, known)
+
+
+class LazySerialized(Mapping):
+    """
+    Serialized form of an object, the ``dict`` dumped by its schema when one
+    of its keys is first accessed, apart from the keys whose values are known
+    beforehand. Copies and pickles of it are plain ``dict`` objects.
+    """
+
+    __slots__ = ("_registry", "_obj", "_known", "_data")
+
+    def __init__(self, registry, obj, known=None):
+        self._registry = registry
+        self._obj = obj
+        self._known = known or {}
+        self._data = None
+
+    @property
+    def data(self):
+        """Serialized object, dumped on first access."""
+        if self._data is None:
+            self._data = self._registry.serialize(self._obj)
+            self._registry = self._obj = None
+        return self._data
+
+    def __getitem__(self, key):
+        if self._data is None and key in self._known:
+            return self._known[key]
+        return self.data[key]
+
+    def __iter__(self):
+        return iter(self.data)
+
+    def __len__(self):
+        return len(self.data)
+
+    def keys(self):
+        return self.data.keys()
+
+    def items(self):
+        return self.data.items()
+
+    def values(self):
+        return self.data.values()
+
+    def __repr__(self):
+        return "{}({!r})".format(self.__class__.__name__, self.data)
+
+    def __copy__(self):
+        return dict(self.data)
+
+    def __deepcopy__(self, memo):
+        return copy.deepcopy(self.data, memo)
+
+    def __reduce__(self):
+        return dict, (self.data,)
@@ -0,0 +1,274 @@
+// _assignment.cpp
+//
+// Minimum cost assignment of integer cost matrices, the native solver of
+// testplan/common/utils/assignment.py which documents the algorithm. The
+// numpy implementation there is the reference: both return the same
+// assignment.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+
+typedef long long Cost;
+
+const Cost INF = std::numeric_limits<Cost>::max() / 4;
+
+// Row major square matrix.
+struct Matrix {
+    explicit Matrix(size_t n) : size(n), values(n * n) {}
+
+    Cost& at(size_t row, size_t col) { return values[row * size + col]; }
+    Cost at(size_t row, size_t col) const { return values[row * size + col]; }
+
+    size_t size;
+    std::vector<Cost> values;
+};
+
+// Optimal assignment (match[row] = col) and dual potentials with
+// u[row] + v[col] <= cost(row, col), equal on the assignment.
+void hungarian(const Matrix& cost, std::vector<Cost>& u, std::vector<Cost>& v,
+               std::vector<size_t>& match) {
+    const size_t n = cost.size;
+    // Index 0 is a virtual column, rows and columns are numbered from 1
+    std::vector<Cost> rowPot(n + 1, 0), colPot(n + 1, 0), minReduced(n + 1);
+    std::vector<size_t> owner(n + 1, 0), way(n + 1, 0);
+    std::vector<char> used(n + 1);
+
+    for(size_t row = 1; row <= n; ++row) {
+        owner[0] = row;
+        size_t col = 0;
+        std::fill(minReduced.begin(), minReduced.end(), INF);
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[col] = 1;
+            const size_t current = owner[col];
+            Cost delta = INF;
+            size_t nextCol = 0;
+            for(size_t j = 1; j <= n; ++j) {
+                if(used[j]) {
+                    continue;
+                }
+                const Cost reduced =
+                    cost.at(current - 1, j - 1) - rowPot[current] - colPot[j];
+                if(reduced < minReduced[j]) {
+                    minReduced[j] = reduced;
+                    way[j] = col;
+                }
+                // Free columns first on equal costs, ending the search
+                if(minReduced[j] < delta ||
+                   (minReduced[j] == delta && owner[j] == 0 &&
+                    owner[nextCol] != 0)) {
+                    delta = minReduced[j];
+                    nextCol = j;
+                }
+            }
+            for(size_t j = 0; j <= n; ++j) {
+                if(used[j]) {
+                    rowPot[owner[j]] += delta;
+                    colPot[j] -= delta;
+                } else {
+                    minReduced[j] -= delta;
+                }
+            }
+            col = nextCol;
+        } while(owner[col] != 0);
+
+        // Augment along the path found
+        while(col) {
+            const size_t prevCol = way[col];
+            owner[col] = owner[prevCol];
+            col = prevCol;
+        }
+    }
+
+    u.assign(rowPot.begin() + 1, rowPot.end());
+    v.assign(colPot.begin() + 1, colPot.end());
+    match.assign(n, 0);
+    for(size_t col = 1; col <= n; ++col) {
+        match[owner[col] - 1] = col - 1;
+    }
+}
+
+// Set of rows, scanned 64 at a time.
+struct RowSet {
+    explicit RowSet(size_t n) : words((n + 63) / 64, 0) {}
+
+    void add(size_t row) { words[row / 64] |= 1ULL << (row % 64); }
+    bool has(size_t row) const { return words[row / 64] >> (row % 64) & 1; }
+
+    std::vector<unsigned long long> words;
+};
+
+// Gives each row in turn its preferred column among those it can get in an
+// optimal assignment, i.e. a perfect matching of the tight entries keeping
+// the columns of the previous rows.
+void prefer(const Matrix& cost, const std::vector<Cost>& u,
+            const std::vector<Cost>& v, std::vector<size_t>& match) {
+    const size_t n = cost.size;
+    const size_t none = n;
+
+    // Rows of the tight entries of each column
+    std::vector<RowSet> tightCols(n, RowSet(n));
+    for(size_t row = 0; row < n; ++row) {
+        for(size_t col = 0; col < n; ++col) {
+            if(cost.at(row, col) - u[row] - v[col] == 0) {
+                tightCols[col].add(row);
+            }
+        }
+    }
+
+    std::vector<size_t> owner(n), nextRow(n), pending;
+    RowSet fixed(n), reach(n);
+    for(size_t row = 0; row < n; ++row) {
+        owner[match[row]] = row;
+    }
+
+    for(size_t row = 0; row < n; ++row) {
+        // Rows that can hand their column over to this one, each taking the
+        // column of the next row on a path of tight entries ending here
+        reach = fixed;
+        reach.add(row);
+        pending.assign(1, row);
+        while(!pending.empty()) {
+            const size_t target = pending.back();
+            pending.pop_back();
+            const RowSet& tight = tightCols[match[target]];
+            for(size_t word = 0; word < reach.words.size(); ++word) {
+                unsigned long long found =
+                    tight.words[word] & ~reach.words[word];
+                reach.words[word] |= found;
+                while(found) {
+                    const size_t other = word * 64 + __builtin_ctzll(found);
+                    found &= found - 1;
+                    nextRow[other] = target;
+                    pending.push_back(other);
+                }
+            }
+        }
+
+        size_t best = none;
+        for(size_t col = 0; col < n; ++col) {
+            const size_t current = owner[col];
+            if(!tightCols[col].has(row) || fixed.has(current) ||
+               !reach.has(current)) {
+                continue;
+            }
+            if(best == none || cost.at(row, col) < cost.at(row, best)) {
+                best = col;
+            }
+        }
+
+        size_t current = owner[best];
+        while(current != row) {
+            const size_t target = nextRow[current];
+            match[current] = match[target];
+            owner[match[current]] = current;
+            current = target;
+        }
+        match[row] = best;
+        owner[best] = row;
+        fixed.add(row);
+    }
+}
+
+// Reads a square matrix of integers, raises TypeError for other values.
+bool readMatrix(PyObject* grid, Matrix& matrix) {
+    PyObject* rows = PySequence_Fast(grid, "Cost matrix must be a sequence");
+    if(!rows) {
+        return false;
+    }
+    const Py_ssize_t n = PySequence_Fast_GET_SIZE(rows);
+    matrix = Matrix(static_cast<size_t>(n));
+    for(Py_ssize_t row = 0; row < n; ++row) {
+        PyObject* values =
+            PySequence_Fast(PySequence_Fast_GET_ITEM(rows, row),
+                            "Cost matrix rows must be sequences");
+        if(!values) {
+            Py_DECREF(rows);
+            return false;
+        }
+        if(PySequence_Fast_GET_SIZE(values) != n) {
+            PyErr_SetString(PyExc_ValueError, "Cost matrix must be square");
+            Py_DECREF(values);
+            Py_DECREF(rows);
+            return false;
+        }
+        for(Py_ssize_t col = 0; col < n; ++col) {
+            PyObject* value = PySequence_Fast_GET_ITEM(values, col);
+            if(!PyLong_Check(value)) {
+                PyErr_SetString(PyExc_TypeError, "Costs must be integers");
+                Py_DECREF(values);
+                Py_DECREF(rows);
+                return false;
+            }
+            const Cost cost = PyLong_AsLongLong(value);
+            if(cost == -1 && PyErr_Occurred()) {
+                Py_DECREF(values);
+                Py_DECREF(rows);
+                return false;
+            }
+            if(cost > INF / (4 * (n + 1)) || cost < -INF / (4 * (n + 1))) {
+                PyErr_SetString(PyExc_TypeError, "Costs are too large");
+                Py_DECREF(values);
+                Py_DECREF(rows);
+                return false;
+            }
+            matrix.at(row, col) = cost;
+        }
+        Py_DECREF(values);
+    }
+    Py_DECREF(rows);
+    return true;
+}
+
+PyObject* solve(PyObject*, PyObject* grid) {
+    Matrix cost(0);
+    if(!readMatrix(grid, cost)) {
+        return NULL;
+    }
+
+    std::vector<Cost> u, v;
+    std::vector<size_t> match;
+    Py_BEGIN_ALLOW_THREADS;
+    hungarian(cost, u, v, match);
+    prefer(cost, u, v, match);
+    Py_END_ALLOW_THREADS;
+
+    PyObject* result = PyList_New(static_cast<Py_ssize_t>(match.size()));
+    if(!result) {
+        return NULL;
+    }
+    for(size_t row = 0; row < match.size(); ++row) {
+        PyObject* col = PyLong_FromSize_t(match[row]);
+        if(!col) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, static_cast<Py_ssize_t>(row), col);
+    }
+    return result;
+}
+
+PyMethodDef methods[] = {
+    {"solve", solve, METH_O,
+     "solve(grid)\n\nColumn assigned to each row of a square matrix of integer "
+     "costs,\nwith the least total cost."},
+    {NULL, NULL, 0, NULL}};
+
+struct PyModuleDef module = {PyModuleDef_HEAD_INIT,
+                             "_assignment",
+                             "Minimum cost assignment of integer matrices.",
+                             -1,
+                             methods,
+                             NULL,
+                             NULL,
+                             NULL,
+                             NULL};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__assignment(void) { return PyModule_Create(&module); }
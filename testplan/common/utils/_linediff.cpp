@@ -0,0 +1,356 @@
+// _linediff.cpp
+//
+// Matching of line ids, the native engine of
+// testplan/common/utils/linediff.py which documents the algorithm. The
+// Python implementation there is the reference: both return the same
+// matching blocks.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Lines occurring more often in a region are not used to split it.
+const size_t MAX_CHAIN = 64;
+
+// Block of equal lines, a[i:i + size] == b[j:j + size].
+struct Block {
+    Block(long i_, long j_, long size_) : i(i_), j(j_), size(size_) {}
+
+    bool operator<(const Block& other) const {
+        return i < other.i || (i == other.i && j < other.j);
+    }
+
+    long i, j, size;
+};
+
+// Region a[alo:ahi], b[blo:bhi] to match.
+struct Region {
+    long alo, ahi, blo, bhi;
+    bool myers;
+};
+
+class Matcher {
+  public:
+    // Ids are dense, junk[id] tells whether lines with the id are junk.
+    Matcher(const std::vector<int>& a, const std::vector<int>& b,
+            const std::vector<char>& junk)
+        : a_(a), b_(b), junk_(junk), positions_(junk.size()) {}
+
+    std::vector<Block> match() {
+        std::vector<Block> matches;
+        std::vector<Region> pending;
+        const Region all = {0, static_cast<long>(a_.size()), 0,
+                            static_cast<long>(b_.size()), false};
+        pending.push_back(all);
+        while(!pending.empty()) {
+            Region region = pending.back();
+            pending.pop_back();
+            long& alo = region.alo;
+            long& ahi = region.ahi;
+            long& blo = region.blo;
+            long& bhi = region.bhi;
+
+            // Common head and tail
+            long size = 0;
+            while(alo + size < ahi && blo + size < bhi &&
+                  a_[alo + size] == b_[blo + size]) {
+                ++size;
+            }
+            if(size) {
+                matches.push_back(Block(alo, blo, size));
+                alo += size;
+                blo += size;
+            }
+            size = 0;
+            while(ahi - size > alo && bhi - size > blo &&
+                  a_[ahi - size - 1] == b_[bhi - size - 1]) {
+                ++size;
+            }
+            if(size) {
+                matches.push_back(Block(ahi - size, bhi - size, size));
+                ahi -= size;
+                bhi -= size;
+            }
+            if(alo == ahi || blo == bhi) {
+                continue;
+            }
+
+            Block block(0, 0, 0);
+            if(!region.myers && histogram(region, block)) {
+                matches.push_back(block);
+                const Region before = {alo, block.i, blo, block.j, false};
+                const Region after = {block.i + block.size, ahi,
+                                      block.j + block.size, bhi, false};
+                pending.push_back(before);
+                pending.push_back(after);
+                continue;
+            }
+
+            long i = 0, j = 0;
+            if(bisect(region, i, j)) {
+                const Region before = {alo, i, blo, j, true};
+                const Region after = {i, ahi, j, bhi, true};
+                pending.push_back(before);
+                pending.push_back(after);
+            }
+        }
+        return merged(matches);
+    }
+
+  private:
+    // Block of equal lines containing the non junk line of b occurring the
+    // least in a, at most MAX_CHAIN times, the longest on equal occurrences.
+    bool histogram(const Region& region, Block& best) {
+        for(long i = region.alo; i < region.ahi; ++i) {
+            positions_[a_[i]].push_back(i);
+        }
+
+        bool found = false;
+        size_t bestCount = MAX_CHAIN + 1;
+        long j = region.blo;
+        while(j < region.bhi) {
+            long nextJ = j + 1;
+            const std::vector<long>& occurrences = positions_[b_[j]];
+            if(!junk_[b_[j]] && !occurrences.empty() &&
+               occurrences.size() <= std::min(bestCount, MAX_CHAIN)) {
+                for(size_t n = 0; n < occurrences.size(); ++n) {
+                    long i1 = occurrences[n], j1 = j;
+                    while(i1 > region.alo && j1 > region.blo &&
+                          a_[i1 - 1] == b_[j1 - 1]) {
+                        --i1;
+                        --j1;
+                    }
+                    long i2 = occurrences[n] + 1, j2 = j + 1;
+                    while(i2 < region.ahi && j2 < region.bhi &&
+                          a_[i2] == b_[j2]) {
+                        ++i2;
+                        ++j2;
+                    }
+                    nextJ = std::max(nextJ, j2);
+                    // Lines of the block occurring the least
+                    size_t count = MAX_CHAIN + 1;
+                    for(long k = i1; k < i2; ++k) {
+                        if(!junk_[a_[k]]) {
+                            count = std::min(count, positions_[a_[k]].size());
+                        }
+                    }
+                    if(count < bestCount ||
+                       (count == bestCount && i2 - i1 > best.size)) {
+                        best = Block(i1, j1, i2 - i1);
+                        bestCount = count;
+                        found = true;
+                    }
+                }
+            }
+            j = nextJ;
+        }
+
+        for(long i = region.alo; i < region.ahi; ++i) {
+            positions_[a_[i]].clear();
+        }
+        return found;
+    }
+
+    // Point where a shortest edit script of two regions without common head
+    // or tail goes through the middle snake, from the linear space variant
+    // of Myers' algorithm, junk lines being all different. False if the
+    // regions have no line in common.
+    bool bisect(const Region& region, long& splitI, long& splitJ) const {
+        const long lengthA = region.ahi - region.alo;
+        const long lengthB = region.bhi - region.blo;
+        const long maxD = (lengthA + lengthB + 1) / 2;
+        const long offset = maxD;
+        const long length = 2 * maxD + 2;
+        // Furthest reaching paths on each diagonal, from the start and end
+        std::vector<long> forward(length, -1), backward(length, -1);
+        forward[offset + 1] = backward[offset + 1] = 0;
+        const long delta = lengthA - lengthB;
+        // Paths from the start can meet those from the end after they moved
+        const bool front = delta % 2 != 0;
+        // Diagonals leaving the regions are not explored anymore
+        long startF = 0, endF = 0, startB = 0, endB = 0;
+
+        for(long d = 0; d < maxD; ++d) {
+            for(long k = -d + startF; k < d + 1 - endF; k += 2) {
+                const long index = offset + k;
+                long x;
+                if(k == -d ||
+                   (k != d && forward[index - 1] < forward[index + 1])) {
+                    x = forward[index + 1];
+                } else {
+                    x = forward[index - 1] + 1;
+                }
+                long y = x - k;
+                while(x < lengthA && y < lengthB &&
+                      equal(region.alo + x, region.blo + y)) {
+                    ++x;
+                    ++y;
+                }
+                forward[index] = x;
+                if(x > lengthA) {
+                    endF += 2;
+                } else if(y > lengthB) {
+                    startF += 2;
+                } else if(front) {
+                    const long other = offset + delta - k;
+                    if(other >= 0 && other < length && backward[other] != -1 &&
+                       x >= lengthA - backward[other]) {
+                        splitI = region.alo + x;
+                        splitJ = region.blo + y;
+                        return true;
+                    }
+                }
+            }
+
+            for(long k = -d + startB; k < d + 1 - endB; k += 2) {
+                const long index = offset + k;
+                long x;
+                if(k == -d ||
+                   (k != d && backward[index - 1] < backward[index + 1])) {
+                    x = backward[index + 1];
+                } else {
+                    x = backward[index - 1] + 1;
+                }
+                long y = x - k;
+                while(x < lengthA && y < lengthB &&
+                      equal(region.ahi - x - 1, region.bhi - y - 1)) {
+                    ++x;
+                    ++y;
+                }
+                backward[index] = x;
+                if(x > lengthA) {
+                    endB += 2;
+                } else if(y > lengthB) {
+                    startB += 2;
+                } else if(!front) {
+                    const long other = offset + delta - k;
+                    if(other >= 0 && other < length && forward[other] != -1) {
+                        const long forwardX = forward[other];
+                        const long forwardY = forwardX - (other - offset);
+                        if(forwardX >= lengthA - x) {
+                            splitI = region.alo + forwardX;
+                            splitJ = region.blo + forwardY;
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Whether a[i] and b[j] are equal non junk lines.
+    bool equal(long i, long j) const {
+        return a_[i] == b_[j] && !junk_[a_[i]];
+    }
+
+    // Sorts blocks, merges the adjacent ones and adds the dummy last one.
+    std::vector<Block> merged(std::vector<Block>& matches) const {
+        std::sort(matches.begin(), matches.end());
+        std::vector<Block> blocks;
+        for(size_t n = 0; n < matches.size(); ++n) {
+            const Block& block = matches[n];
+            if(!blocks.empty() &&
+               blocks.back().i + blocks.back().size == block.i &&
+               blocks.back().j + blocks.back().size == block.j) {
+                blocks.back().size += block.size;
+            } else {
+                blocks.push_back(block);
+            }
+        }
+        blocks.push_back(Block(static_cast<long>(a_.size()),
+                               static_cast<long>(b_.size()), 0));
+        return blocks;
+    }
+
+    const std::vector<int>& a_;
+    const std::vector<int>& b_;
+    const std::vector<char>& junk_;
+    // Positions in a of the lines of each id, for the current region
+    std::vector<std::vector<long>> positions_;
+};
+
+// Reads a sequence of line ids, renumbering them densely.
+bool readIds(PyObject* sequence, std::unordered_map<long long, int>& dense,
+             std::vector<char>& junk, std::vector<int>& ids) {
+    PyObject* items = PySequence_Fast(sequence, "Line ids must be a sequence");
+    if(!items) {
+        return false;
+    }
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(items);
+    ids.resize(static_cast<size_t>(size));
+    for(Py_ssize_t n = 0; n < size; ++n) {
+        const long long id =
+            PyLong_AsLongLong(PySequence_Fast_GET_ITEM(items, n));
+        if(id == -1 && PyErr_Occurred()) {
+            Py_DECREF(items);
+            return false;
+        }
+        std::unordered_map<long long, int>::iterator found = dense.find(id);
+        if(found == dense.end()) {
+            const int next = static_cast<int>(junk.size());
+            found = dense.insert(std::make_pair(id, next)).first;
+            junk.push_back(id < 0);
+        }
+        ids[n] = found->second;
+    }
+    Py_DECREF(items);
+    return true;
+}
+
+PyObject* match(PyObject*, PyObject* args) {
+    PyObject *first, *second;
+    if(!PyArg_ParseTuple(args, "OO", &first, &second)) {
+        return NULL;
+    }
+    std::unordered_map<long long, int> dense;
+    std::vector<char> junk;
+    std::vector<int> a, b;
+    if(!readIds(first, dense, junk, a) || !readIds(second, dense, junk, b)) {
+        return NULL;
+    }
+
+    std::vector<Block> blocks;
+    Py_BEGIN_ALLOW_THREADS;
+    blocks = Matcher(a, b, junk).match();
+    Py_END_ALLOW_THREADS;
+
+    PyObject* result = PyList_New(static_cast<Py_ssize_t>(blocks.size()));
+    if(!result) {
+        return NULL;
+    }
+    for(size_t n = 0; n < blocks.size(); ++n) {
+        PyObject* block =
+            Py_BuildValue("(lll)", blocks[n].i, blocks[n].j, blocks[n].size);
+        if(!block) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, static_cast<Py_ssize_t>(n), block);
+    }
+    return result;
+}
+
+PyMethodDef methods[] = {
+    {"match", match, METH_VARARGS,
+     "match(a, b)\n\nMatching blocks (i, j, n) of two sequences of line ids, "
+     "negative\nfor junk lines, ending with (len(a), len(b), 0)."},
+    {NULL, NULL, 0, NULL}};
+
+struct PyModuleDef module = {PyModuleDef_HEAD_INIT,
+                             "_linediff",
+                             "Histogram and Myers matching of line ids.",
+                             -1,
+                             methods,
+                             NULL,
+                             NULL,
+                             NULL,
+                             NULL};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__linediff(void) { return PyModule_Create(&module); }
@@ -0,0 +1,198 @@
+"""
+Minimum cost assignment of the rows of a square cost matrix to its columns,
+used to match actual values to expected ones in any order.
+
+The Hungarian algorithm (shortest augmenting paths, O(n^3)) finds an
+optimal assignment and dual potentials, whose tight entries (zero reduced
+cost) contain every optimal assignment. Among them, the one returned gives
+each row in turn its cheapest column (lowest index on equal costs) that
+still allows an optimal assignment, which is what the exhaustive search
+matching used to return.
+
+The ``_assignment`` C++ extension, built with the package when a compiler
+is available, solves integer matrices. Other matrices, or all of them
+without the extension, are solved in Python.
+"""
+
+try:
+    from testplan.common.utils import _assignment
+except ImportError:
+    _assignment = None
+
+
+def min_cost_assignment(grid):
+    """
+    Assignment of the rows of a square cost matrix to its columns with the
+    least total cost, e.g. for the grid::
+
+      >>> min_cost_assignment([[1000, 2000, 2000],
+      ...                      [1000, 2000, 2000],
+      ...                      [   0, 2000, 2000]])
+      [1, 2, 0]
+
+    Where [1, 2, 0] maps row 0 to column 1, row 1 to column 2 and row 2 to
+    column 0.
+
+    :param grid: Square matrix of costs.
+    :type grid: ``list`` of ``list`` of ``int`` or ``float``
+    :return: Column assigned to each row.
+    :rtype: ``list`` of ``int``
+    """
+    if _assignment is not None:
+        try:
+            return _assignment.solve(grid)
+        except (TypeError, OverflowError):
+            pass  # Not 64 bits integers
+    return python_min_cost_assignment(grid)
+
+
+def python_min_cost_assignment(grid):
+    """
+    :py:func:`min_cost_assignment` without the C++ extension.
+
+    :param grid: Square matrix of costs.
+    :type grid: ``list`` of ``list`` of ``int`` or ``float``
+    :return: Column assigned to each row.
+    :rtype: ``list`` of ``int``
+    """
+    size = len(grid)
+    if any(len(row) != size for row in grid):
+        raise ValueError("Cost matrix must be square")
+    if not size:
+        return []
+    cost = [list(row) for row in grid]
+
+    row_potentials, col_potentials, match = _hungarian(cost)
+    if any(isinstance(value, float) for row in cost for value in row):
+        scale = max(1.0, max(abs(value) for row in cost for value in row))
+        tolerance = scale * 1e-12 * size
+    else:
+        tolerance = 0
+    tight = [
+        [
+            value - row_potential - col_potential <= tolerance
+            for value, col_potential in zip(costs, col_potentials)
+        ]
+        for costs, row_potential in zip(cost, row_potentials)
+    ]
+    return _preferred(cost, tight, match)
+
+
+def _hungarian(cost):
+    """
+    Optimal assignment and dual potentials of a cost matrix, row ``i`` is
+    assigned to column ``match[i]`` and ``u[i] + v[j] <= cost[i][j]`` with
+    equality on the assignment.
+    """
+    size = len(cost)
+    inf = float("inf")
+    cols = range(1, size + 1)
+
+    # Index 0 is a virtual column, rows and columns are numbered from 1
+    u = [0] * (size + 1)
+    v = [0] * (size + 1)
+    owner = [0] * (size + 1)
+    way = [0] * (size + 1)
+
+    for row in range(1, size + 1):
+        owner[0] = row
+        col = 0
+        min_reduced = [inf] * (size + 1)
+        used = [False] * (size + 1)
+        while True:
+            used[col] = True
+            current = owner[col]
+            costs = cost[current - 1]
+            potential = u[current]
+            delta, next_col, next_free = inf, 0, False
+            for other in cols:
+                if used[other]:
+                    continue
+                reduced = costs[other - 1] - potential - v[other]
+                if reduced < min_reduced[other]:
+                    min_reduced[other] = reduced
+                    way[other] = col
+                reduced = min_reduced[other]
+                # Free columns first on equal costs, ending the search
+                if reduced < delta or (
+                    reduced == delta and not next_free and not owner[other]
+                ):
+                    delta, next_col = reduced, other
+                    next_free = not owner[other]
+
+            for other in range(size + 1):
+                if used[other]:
+                    u[owner[other]] += delta
+                    v[other] -= delta
+                else:
+                    min_reduced[other] -= delta
+
+            col = next_col
+            if not owner[col]:
+                break
+
+        # Augment along the path found
+        while col:
+            prev_col = way[col]
+            owner[col] = owner[prev_col]
+            col = prev_col
+
+    match = [0] * size
+    for col in cols:
+        match[owner[col] - 1] = col - 1
+    return u[1:], v[1:], match
+
+
+def _preferred(cost, tight, match):
+    """
+    Give each row in turn its preferred column among those it can get in an
+    optimal assignment, i.e. a perfect matching of the tight entries that
+    keeps the columns of the previous rows.
+    """
+    size = len(match)
+    owner = [0] * size
+    for row, col in enumerate(match):
+        owner[col] = row
+    # Rows of the tight entries of each column, columns are scanned
+    tight_rows = [
+        [row for row in range(size) if tight[row][col]] for col in range(size)
+    ]
+    fixed = [False] * size
+
+    for row in range(size):
+        # Rows that can hand their column over to this one, each taking the
+        # column of the next row on a path of tight entries ending here
+        reach = list(fixed)
+        reach[row] = True
+        next_row = [-1] * size
+        pending = [row]
+        while pending:
+            target = pending.pop()
+            for other in tight_rows[match[target]]:
+                if not reach[other]:
+                    reach[other] = True
+                    next_row[other] = target
+                    pending.append(other)
+
+        col = min(
+            (
+                col
+                for col in range(size)
+                if tight[row][col]
+                and not fixed[owner[col]]
+                and reach[owner[col]]
+            ),
+            key=lambda col: (cost[row][col], col),
+        )
+
+        current = owner[col]
+        while current != row:
+            target = next_row[current]
+            match[current] = match[target]
+            owner[match[current]] = current
+            current = target
+        match[row] = col
+        owner[col] = row
+        fixed[row] = True
+
+    return match
@@ -0,0 +1,257 @@
+"""
+Column by column comparison of tables, used by the table assertions.
+
+The cells of a column of the actual table are compared to those of the
+expected table, plain values or comparators, the whole column at once when
+numpy kernels can do it with the result of the cell by cell comparison:
+
+* plain values are compared with equality, as 64 bits integers or floats
+  for columns of such numbers, as objects otherwise,
+* numbers are compared to the same operator comparator in every cell (e.g.
+  ``comparison.Less``) or to ``comparison.IsClose`` tolerances,
+* regular expressions are matched once for each distinct value.
+
+Other columns, e.g. of arbitrary callables or objects, are compared cell by
+cell.
+
+numpy is an optional requirement of testplan: without it, this module can
+be imported but not used, and the table assertions compare tables row by
+row instead.
+"""
+
+import datetime
+import decimal
+import operator
+import re
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+from .comparison import IsClose, OperatorCallable, basic_compare
+
+_PATTERN = type(re.compile(""))
+
+_OPERATORS = (
+    operator.lt,
+    operator.le,
+    operator.gt,
+    operator.ge,
+    operator.eq,
+    operator.ne,
+)
+
+
+# Types of the plain values compared with equality, other values may be
+# comparators or compare to anything
+_PLAIN_TYPES = {
+    type(None),
+    bool,
+    int,
+    float,
+    complex,
+    str,
+    bytes,
+    decimal.Decimal,
+    datetime.date,
+    datetime.datetime,
+    datetime.time,
+    datetime.timedelta,
+}
+
+
+def numeric_array(values, types=None):
+    """
+    Column of numbers as an array of 64 bits integers or floats.
+
+    :param values: Cells of the column.
+    :type values: ``list``
+    :param types: Types of the cells, computed if not given.
+    :type types: ``set`` of ``type``
+    :return: Array of the cells, ``None`` if they are not all integers or
+        all floats, or if integers do not fit in 64 bits.
+    :rtype: ``numpy.ndarray`` or ``NoneType``
+    """
+    types = set(map(type, values)) if types is None else types
+    if types and types <= {int, bool}:
+        try:
+            return numpy.array(values, dtype=numpy.int64)
+        except OverflowError:
+            return None
+    if types == {float}:
+        return numpy.array(values, dtype=numpy.float64)
+    return None
+
+
+def object_array(values):
+    """
+    Column as a one dimensional array of objects, whatever the cells are.
+
+    :param values: Cells of the column.
+    :type values: ``list``
+    :return: Array of the cells.
+    :rtype: ``numpy.ndarray``
+    """
+    return numpy.fromiter(values, dtype=object, count=len(values))
+
+
+def compare_column(actual, expected, strict=False):
+    """
+    Compare the cells of a column of the actual table to those of the
+    expected table as ``comparison.basic_compare`` does.
+
+    :param actual: Cells of the actual table.
+    :type actual: ``list``
+    :param expected: Cells of the expected table, values or comparators.
+    :type expected: ``list``
+    :param strict: Do not convert values matched by regexes to ``str``.
+    :type strict: ``bool``
+    :return: Whether each cell matched, and the traceback of the cells
+        whose comparison raised by index.
+    :rtype: ``tuple`` of ``numpy.ndarray`` and ``dict``
+    """
+    passed = compare_whole_column(actual, expected, strict=strict)
+    if passed is not None:
+        return passed, {}
+    return compare_cells(actual, expected, strict=strict)
+
+
+def compare_whole_column(actual, expected, strict=False):
+    """
+    Compare a column at once with numpy kernels, which do not call any
+    comparator of the expected table.
+
+    :param actual: Cells of the actual table.
+    :type actual: ``list``
+    :param expected: Cells of the expected table, values or comparators.
+    :type expected: ``list``
+    :param strict: Do not convert values matched by regexes to ``str``.
+    :type strict: ``bool``
+    :return: Whether each cell matched, ``None`` if the cells must be
+        compared one by one with :py:func:`compare_cells`.
+    :rtype: ``numpy.ndarray`` or ``NoneType``
+    """
+    if len(actual) != len(expected):
+        raise ValueError("Columns must have the same length")
+    actual_types = set(map(type, actual))
+    expected_types = set(map(type, expected))
+
+    if expected_types <= _PLAIN_TYPES:
+        return _equal(actual, expected, actual_types, expected_types)
+    elif expected_types == {_PATTERN}:
+        return _regex(actual, expected, actual_types, strict)
+    elif len(expected_types) == 1:
+        kind = next(iter(expected_types))
+        if kind is IsClose:
+            return _isclose(actual, expected, actual_types)
+        elif (
+            issubclass(kind, OperatorCallable)
+            and kind.__call__ is OperatorCallable.__call__
+            and kind.func in _OPERATORS
+        ):
+            return _operator(actual, expected, actual_types, kind.func)
+    return None
+
+
+def compare_cells(actual, expected, strict=False):
+    """
+    Compare a column cell by cell with ``comparison.basic_compare``.
+
+    :param actual: Cells of the actual table.
+    :type actual: ``list``
+    :param expected: Cells of the expected table, values or comparators.
+    :type expected: ``list``
+    :param strict: Do not convert values matched by regexes to ``str``.
+    :type strict: ``bool``
+    :return: Whether each cell matched, and the traceback of the cells
+        whose comparison raised by index.
+    :rtype: ``tuple`` of ``numpy.ndarray`` and ``dict``
+    """
+    passed = numpy.zeros(len(actual), dtype=bool)
+    errors = {}
+    for idx, (first, second) in enumerate(zip(actual, expected)):
+        result, error = basic_compare(first, second, strict=strict)
+        if error:
+            errors[idx] = error
+        else:
+            passed[idx] = bool(result)
+    return passed, errors
+
+
+def _equal(actual, expected, actual_types, expected_types):
+    """Equality of plain values, ``None`` if a comparison raised."""
+    first = numeric_array(actual, actual_types)
+    second = numeric_array(expected, expected_types)
+    if first is None or second is None or first.dtype != second.dtype:
+        first, second = object_array(actual), object_array(expected)
+    try:
+        passed = numpy.equal(first, second)
+    except Exception:
+        return None
+    if passed.dtype != bool or passed.shape != (len(actual),):
+        return None
+    return passed
+
+
+def _regex(actual, expected, actual_types, strict):
+    """Regex matches, once per distinct pattern and value."""
+    if not actual_types <= {str}:
+        if strict:
+            return None  # Raises for other types
+        actual = [str(value) for value in actual]
+
+    # Patterns are slow to hash, they are identified by their id
+    patterns = {id(pattern): pattern for pattern in expected}
+    keys = list(zip(map(id, expected), actual))
+    try:
+        matches = {
+            key: patterns[key[0]].match(key[1]) is not None
+            for key in set(keys)
+        }
+    except Exception:
+        return None  # e.g. bytes patterns, for the traceback of each cell
+    return numpy.fromiter(
+        map(matches.__getitem__, keys), dtype=bool, count=len(keys)
+    )
+
+
+def _operator(actual, expected, actual_types, func):
+    """Operator comparators of numbers."""
+    first = numeric_array(actual, actual_types)
+    second = numeric_array(
+        list(map(operator.attrgetter("reference"), expected))
+    )
+    if first is None or second is None or first.dtype != second.dtype:
+        return None
+    return func(first, second)
+
+
+def _isclose(actual, expected, actual_types):
+    """``math.isclose`` of numbers and references."""
+    numbers = {int, bool, float}
+    columns = [actual] + [
+        list(map(operator.attrgetter(name), expected))
+        for name in ("reference", "rel_tol", "abs_tol")
+    ]
+    types = set(actual_types)
+    for column in columns[1:]:
+        types.update(map(type, column))
+    if not types <= numbers:
+        return None
+    try:
+        first, second, rel_tol, abs_tol = (
+            numpy.array(column, dtype=numpy.float64) for column in columns
+        )
+    except OverflowError:
+        return None
+
+    with numpy.errstate(invalid="ignore", over="ignore"):
+        diff = numpy.abs(second - first)
+        close = (
+            (diff <= numpy.abs(rel_tol * second))
+            | (diff <= numpy.abs(rel_tol * first))
+            | (diff <= abs_tol)
+        )
+        finite = numpy.isfinite(first) & numpy.isfinite(second)
+    return (first == second) | (finite & close)
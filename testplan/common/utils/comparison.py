@@ -1,3 +1,4 @@
+import math
 import operator
 import decimal
 import enum
@@ -5,6 +6,7 @@ import traceback
 from collections.abc import Mapping, Iterable
 from itertools import zip_longest
 
+from .assignment import min_cost_assignment
 from .reporting import Absent, fmt, NATIVE_TYPES, callable_name
 
 
@@ -136,6 +138,43 @@ class NotEqual(OperatorCallable):
     func_repr = "!="
 
 
+class IsClose(Callable):
+    """
+    Checks if a number is close to a reference, as :py:func:`math.isclose`
+    does, e.g. ``IsClose(1.5, abs_tol=0.01)``.
+    """
+
+    def __init__(self, reference, rel_tol=1e-09, abs_tol=0.0):
+        if rel_tol < 0 or abs_tol < 0:
+            raise ValueError("`rel_tol` and `abs_tol` must be non-negative.")
+        self.reference = reference
+        self.rel_tol = rel_tol
+        self.abs_tol = abs_tol
+
+    def __call__(self, value):
+        return math.isclose(
+            value, self.reference, rel_tol=self.rel_tol, abs_tol=self.abs_tol
+        )
+
+    def __eq__(self, other):
+        return (self.reference, self.rel_tol, self.abs_tol) == (
+            other.reference,
+            other.rel_tol,
+            other.abs_tol,
+        )
+
+    def __str__(self):
+        return "VAL ~= {}".format(self.reference)
+
+    def __repr__(self):
+        return "{}({}, rel_tol={}, abs_tol={})".format(
+            self.__class__.__name__,
+            repr(self.reference),
+            self.rel_tol,
+            self.abs_tol,
+        )
+
+
 class In(Callable):
     def __init__(self, container):
         self.container = container
@@ -300,9 +339,10 @@ class Custom(Callable):
 ########################################################################
 
 
-# Do not change unless you know what you are doing
-# Making this larger will considerably slow down the comparison
-MAX_UNORDERED_COMPARE = 16
+# Unordered comparisons compare every value to every expected one, the
+# number of comparisons grows with the square of this: 200 dicts of a few
+# keys take about a second, the assignment solved in a fraction of that
+MAX_UNORDERED_COMPARE = 200
 
 
 def compare_with_callable(callable_obj, value):
@@ -745,9 +785,11 @@ def compare(
     Ignore has precedence over only.
 
     :param lhs: object compared against rhs
-    :type lhs: ``dict`` interface (``__contains__`` and ``.items()``)
+    :type lhs: ``dict`` interface (``__contains__`` and ``.items()``) or
+               ``ComparisonPlan``
     :param rhs: object compared against lhs
-    :type rhs: ``dict`` interface (``__contains__`` and ``.items()``)
+    :type rhs: ``dict`` interface (``__contains__`` and ``.items()``) or
+               ``ComparisonPlan``
     :param ignore: list of keys to ignore in the comparison
     :type ignore: ``list``
     :param only: list of keys to exclusively consider in the comparison
@@ -766,6 +808,13 @@ def compare(
     :rtype: ``tuple`` of (``bool``, ``list`` of ``tuple``)
     """
 
+    # Compiled expected dicts are compared to the other side as such
+    plan, plan_lhs = None, False
+    if isinstance(rhs, ComparisonPlan):
+        plan, rhs = rhs, rhs.expected
+    if isinstance(lhs, ComparisonPlan):
+        plan, plan_lhs, lhs = lhs, True, lhs.expected
+
     if (lhs is None) and (rhs is None):
         return (True, [])
 
@@ -793,9 +842,19 @@ def compare(
 
     ignore = ignore or []
 
-    match, comparisons = _cmp_dicts(
-        lhs, rhs, ignore, only, report_mode, value_cmp_func
-    )
+    if plan is None:
+        match, comparisons = _cmp_dicts(
+            lhs, rhs, ignore, only, report_mode, value_cmp_func
+        )
+    else:
+        match, comparisons = plan.cmp_dicts(
+            rhs if plan_lhs else lhs,
+            plan_lhs,
+            ignore,
+            only,
+            report_mode,
+            value_cmp_func,
+        )
 
     # For the keys in only not matching anything,
     # we report them as absent in expected and value.
@@ -812,75 +871,322 @@ def compare(
     return Match.to_bool(match), comparisons
 
 
-def _best_permutation(grid):
+_NATIVE_TYPE_SET = frozenset(NATIVE_TYPES)
+
+
+def _fmt_value(obj):
+    """``fmt`` with a shortcut for the native types."""
+    obj_t = type(obj)
+    if obj_t is int or obj_t is bool:
+        return 0, obj_t.__name__, str(obj)
+    if obj_t in _NATIVE_TYPE_SET:
+        return 0, obj_t.__name__, obj
+    return fmt(obj)
+
+
+class _PlanNode(object):
+    """
+    Value of an expected structure with what its comparisons need:
+    its category, its report representation and its compiled children.
     """
-    Given a square matrix of errors comparing actual
-    value vs. expected value, finds the permutation which
-    associates actual vs expected with the least error.
 
-    Be careful running this on of large grids, as the
-    runtime is expotential O(a^n). Sample run times on desktop hardware::
+    __slots__ = ("value", "category", "descr", "children", "match")
 
-      size:  0, ms:    0.002  size:  1, ms:    0.010  size:  2, ms:    0.022
-      size:  3, ms:    0.046  size:  4, ms:    0.105  size:  5, ms:    0.207
-      size:  6, ms:    0.434  size:  7, ms:    0.540  size:  8, ms:    1.351
-      size:  9, ms:    2.338  size: 10, ms:    5.470  size: 11, ms:    9.398
-      size: 12, ms:   21.651  size: 13, ms:   36.114  size: 14, ms:   79.871
-      size: 15, ms:  166.488  size: 16, ms:  363.120  size: 17, ms:  943.494
-      size: 18, ms: 1818.761  size: 19, ms: 2370.988  size: 20, ms: 9989.508
+    def __init__(self, value):
+        category = _categorise(value)
+        if category == Category.ITERABLE and iter(value) is value:
+            value = list(value)  # Iterators can only be walked once
+
+        self.value = value
+        self.category = category
+        self.descr = None
+        self.children = None
+        self.match = None
+
+        if category == Category.CALLABLE:
+            self.descr = (0, "func", callable_name(value))
+        elif category == Category.REGEX:
+            self.descr = RegexAdapter.serialize(value)
+            self.match = value.match
+        elif category == Category.DICT:
+            self.children = {
+                key: _PlanNode(item) for key, item in value.items()
+            }
+        elif category == Category.ITERABLE:
+            self.children = [_PlanNode(item) for item in value]
+        else:
+            self.descr = fmt(value)
 
-    e.g. for the grid::
 
-      >>> grid = [[1000, 2000, 2000],
-      ...         [1000, 2000, 2000],
-      ...         [   0, 2000, 2000]]
-      [1, 2, 0]
+_ABSENT_NODE = _PlanNode(Absent)
+_NONE_NODE = _PlanNode(None)
+_ABSENT_DESCR = fmt(Absent)
 
-    Where [1, 2, 0] is a list of indices mapping::
 
-      - row 0 to col 1
-      - row 1 to col 2
-      - row 2 to col 0
+def _plan_res(key, match, descr, other_descr, plan_lhs):
+    """``_build_res`` with the plan on either side."""
+    if plan_lhs:
+        return key, match[0], descr, other_descr
+    return key, match[0], other_descr, descr
 
+
+def _plan_compare(
+    node, other, plan_lhs, ignore, only, key, report_mode, value_cmp_func
+):
     """
+    ``_rec_compare`` of a compiled value and another value, on the left
+    hand side if ``plan_lhs``. Combinations of categories that are not
+    common in comparisons are left to ``_rec_compare``.
+    """
+    category = node.category
+    other_t = type(other)
+    if other_t in _NATIVE_TYPE_SET:
+        other_category = Category.VALUE
+    else:
+        other_category = _categorise(other)
+
+    if category == Category.VALUE:
+        if other_category == Category.VALUE:
+            if plan_lhs:
+                passed = value_cmp_func(node.value, other)
+            else:
+                passed = value_cmp_func(other, node.value)
+            return _plan_res(
+                key,
+                Match.from_bool(passed),
+                node.descr,
+                _fmt_value(other),
+                plan_lhs,
+            )
+        if other_category == Category.ABSENT:
+            return _plan_res(
+                key, Match.FAIL, node.descr, _ABSENT_DESCR, plan_lhs
+            )
+
+    elif category == Category.ABSENT:
+        if other_category != Category.CALLABLE:
+            return _plan_res(
+                key,
+                Match.PASS
+                if other_category == Category.ABSENT
+                else Match.FAIL,
+                node.descr,
+                _fmt_value(other),
+                plan_lhs,
+            )
+
+    elif category == Category.CALLABLE:
+        if other_category != Category.CALLABLE:
+            result, error = compare_with_callable(
+                callable_obj=node.value, value=other
+            )
+            return _plan_res(
+                key,
+                Match.from_bool(result),
+                node.descr,
+                fmt("Value: {}, Error: {}".format(other, error))
+                if error
+                else _fmt_value(other),
+                plan_lhs,
+            )
 
-    def bp_loop(outstanding, level, grid, grid_len, cache):
+    elif category == Category.REGEX:
+        if other_category not in (
+            Category.ABSENT,
+            Category.CALLABLE,
+            Category.REGEX,
+        ):
+            return _plan_res(
+                key,
+                Match.from_bool(bool(node.match(other))),
+                node.descr,
+                _fmt_value(other),
+                plan_lhs,
+            )
+
+    elif category == Category.DICT:
+        if other_category == Category.DICT:
+            match, results = _plan_cmp_dicts(
+                node,
+                other,
+                plan_lhs,
+                ignore,
+                only,
+                report_mode,
+                value_cmp_func,
+            )
+            lhs_vals, rhs_vals = _partition(results)
+            return _build_res(
+                key=key, match=match, lhs=(2, lhs_vals), rhs=(2, rhs_vals)
+            )
+
+    elif category == Category.ITERABLE:
+        if other_category == Category.ITERABLE:
+            results = []
+            match = Match.IGNORED
+            for child, other_item in zip_longest(node.children, other):
+                result = _plan_compare(
+                    _NONE_NODE if child is None else child,
+                    other_item,
+                    plan_lhs,
+                    ignore,
+                    only,
+                    None,
+                    report_mode,
+                    value_cmp_func,
+                )
+                match = Match.combine(match, result[1])
+                results.append(result)
+
+            lhs_vals, rhs_vals = _partition(results)
+            return _build_res(
+                key=key, match=match, lhs=(1, lhs_vals), rhs=(1, rhs_vals)
+            )
+
+    if plan_lhs:
+        return _rec_compare(
+            node.value, other, ignore, only, key, report_mode, value_cmp_func
+        )
+    return _rec_compare(
+        other, node.value, ignore, only, key, report_mode, value_cmp_func
+    )
+
+
+def _plan_cmp_dicts(
+    node, other, plan_lhs, ignore, only, report_mode, value_cmp_func
+):
+    """``_cmp_dicts`` of a compiled dict and another dict."""
+    children = node.children
+
+    def pairs():
+        """Keys, compiled and other values in ``_idictzip_all`` order."""
+        if plan_lhs:
+            for key, child in children.items():
+                yield key, child, other.get(key, Absent)
+            for key, other_val in other.items():
+                if key not in children:
+                    yield key, _ABSENT_NODE, other_val
+        else:
+            for key, other_val in other.items():
+                yield key, children.get(key, _ABSENT_NODE), other_val
+            for key, child in children.items():
+                if key not in other:
+                    yield key, child, Absent
+
+    results = []
+    match = Match.IGNORED
+    for iter_key, child, other_val in pairs():
+        if iter_key in ignore or (only is not None and iter_key not in only):
+            if report_mode == ReportOptions.ALL:
+                results.append(
+                    _plan_res(
+                        iter_key,
+                        Match.IGNORED,
+                        fmt(child.value),
+                        fmt(other_val),
+                        plan_lhs,
+                    )
+                )
+        else:
+            result = _plan_compare(
+                child,
+                other_val,
+                plan_lhs,
+                ignore,
+                only,
+                iter_key,
+                report_mode,
+                value_cmp_func,
+            )
+
+            if report_mode in (ReportOptions.ALL, ReportOptions.NO_IGNORED):
+                keep_result = True
+            elif report_mode == ReportOptions.FAILS_ONLY:
+                keep_result = not Match.to_bool(result[1])
+            else:
+                raise ValueError("Invalid report mode {}".format(report_mode))
+
+            if keep_result:
+                results.append(result)
+            match = Match.combine(match, result[1])
+    return match, results
+
+
+class ComparisonPlan(object):
+    """
+    Expected dict compiled once for its comparisons to many values, e.g. a
+    FIX message template replayed against many messages. The expected side
+    of the comparisons is categorised, formatted and walked only once.
+
+    A plan can be used in place of the expected dict of :py:func:`compare`
+    and of the dict and FIX match assertions, with the same result:
+
+    .. code-block:: python
+
+        plan = ComparisonPlan({35: 'D', 55: re.compile(r'[A-Z]+')})
+        for msg in messages:
+            result.fix.match(msg, plan)
+    """
+
+    def __init__(self, expected):
         """
-        Recursively finds a solution by
-        progressively excluding poor permutations "paths"
+        :param expected: Dict to compare values against, can contain
+                         custom comparators.
+        :type expected: ``dict``-like interface (__contains__ and .items())
         """
-        if not outstanding:
-            return 0, []
+        if not isinstance(expected, Mapping):
+            raise TypeError(
+                "Expected a mapping, got: {}".format(type(expected))
+            )
+        self.expected = expected
+        self.typed_values = getattr(expected, "typed_values", False)
+        self._root = _PlanNode(expected)
 
-        # [(cost:int, indx:int)]
-        level_permutations = [
-            (grid[level][indx], indx) for indx in outstanding
-        ]
-        level_permutations.sort()
-        min_cost = None
-        min_path = None
-        for cost, indx in level_permutations:
-            remaining = outstanding - frozenset([indx])
-            # memoise calls, for large grids
-            # this cuts down the amount of calls significantly
-            pair = cache.get(remaining, None)
-            if pair is None:
-                pair = bp_loop(remaining, level + 1, grid, grid_len, cache)
-                cache[remaining] = pair
-            sub_cost, sub_path = pair
-            this_cost = cost + sub_cost
-            this_path = [indx] + sub_path
-            if (min_cost is None) or (this_cost < min_cost):
-                min_cost = this_cost
-                min_path = this_path
-        return min_cost, min_path
-
-    grid_len = len(grid)
-
-    cache = {}
-
-    # list of int indices
-    return bp_loop(frozenset(range(grid_len)), 0, grid, grid_len, cache)[1]
+    def __repr__(self):
+        return "{}({!r})".format(self.__class__.__name__, self.expected)
+
+    def compare(
+        self,
+        value,
+        ignore=None,
+        only=None,
+        report_mode=ReportOptions.ALL,
+        value_cmp_func=COMPARE_FUNCTIONS["native_equality"],
+    ):
+        """
+        Compare a value to the expected dict, as :py:func:`compare` does.
+
+        :param value: Object compared against the expected dict.
+        :type value: ``dict``-like interface (__contains__ and .items())
+        :return: Tuple of comparison bool ``(passed: True, failed: False)``
+                 and a description object for the testdb report
+        :rtype: ``tuple`` of (``bool``, ``list`` of ``tuple``)
+        """
+        return compare(
+            value,
+            self,
+            ignore=ignore,
+            only=only,
+            report_mode=report_mode,
+            value_cmp_func=value_cmp_func,
+        )
+
+    def cmp_dicts(
+        self, value, plan_lhs, ignore, only, report_mode, value_cmp_func
+    ):
+        """
+        ``_cmp_dicts`` of the expected dict and a value on the left hand
+        side if ``plan_lhs``.
+        """
+        return _plan_cmp_dicts(
+            self._root,
+            value,
+            plan_lhs,
+            ignore,
+            only,
+            report_mode,
+            value_cmp_func,
+        )
 
 
 # helper func, used to generate errors matrix
@@ -1027,14 +1333,15 @@ def unordered_compare(
     list_msgs = list(values)
     list_cmps = list(comparisons)
 
-    # if either the values or expected comparisons
-    # exceed 16, then raise an exception:
-    # it would take too long to process
-    #  (expotential complexity algorithm involved)
+    # if either the values or expected comparisons exceed
+    # MAX_UNORDERED_COMPARE, then raise an exception:
+    # it would take too long to compare all of them
     if max(len(list_msgs), len(list_cmps)) > MAX_UNORDERED_COMPARE:
         raise Exception(
             "Too many values being compared. "
-            + "Unordered matching supports up to 16 comparisons"
+            + "Unordered matching supports up to {} comparisons".format(
+                MAX_UNORDERED_COMPARE
+            )
         )
 
     # Generate fake comparisons or values in case that the number of values
@@ -1059,16 +1366,23 @@ def unordered_compare(
     #                   [tpl20, tpl21, tpl22, tpl23], # msg2
     #                   [tpl30, tpl31, tpl32, tpl33]] # msg3
     #
+    # every expected value is compared to every message
+    plans = [
+        ComparisonPlan(cmpr.value)
+        if isinstance(cmpr.value, Mapping)
+        else cmpr.value
+        for cmpr in proc_cmps
+    ]
     match_matrix = [
         [
             compare(
-                cmpr.value,
+                plan,
                 msg,
                 ignore=cmpr.ignore,
                 only=cmpr.only,
                 value_cmp_func=value_cmp_func,
             )
-            for cmpr in proc_cmps
+            for plan, cmpr in zip(plans, proc_cmps)
         ]
         for msg in proc_msgs
     ]
@@ -1090,7 +1404,7 @@ def unordered_compare(
 
     # compute the optimal matching based on the permutation between actual and
     # expected message that results in the least error
-    matched_indices = _best_permutation(errors_matrix)
+    matched_indices = min_cost_assignment(errors_matrix)
 
     # construct a list of report entries
     base_descr = description or "unordered {}".format(match_name)
@@ -91,11 +91,17 @@ def full_status(status):
 
 def expand_values(rows, level=0, ignore_key=False, key_path=None):
     """
-    Recursively yield all rows of VAL items (key, match, VAL).
+    Recursively collect all rows of VAL items (key, match, VAL).
     """
-    if key_path is None:
-        key_path = []
+    result = []
+    _expand_values(
+        rows, level, ignore_key, [] if key_path is None else key_path, result
+    )
+    return result
+
 
+def _expand_values(rows, level, ignore_key, key_path, result):
+    """Append the rows expanded by ``expand_values`` to ``result``."""
     for row in rows:
         # While comparing dict value (list type), dict key is ignored, thus
         # a special object `Absent` is used as key, which means no key here.
@@ -103,25 +109,24 @@ def expand_values(rows, level=0, ignore_key=False, key_path=None):
         if key is not Absent:  # `None` or empty string can also be used as key
             key_path.append(key)
 
-        match = row[1] if len(row) == 3 else ""
-        val = row[2] if len(row) == 3 else row[1]
+        if len(row) == 3:
+            match, val = row[1], row[2]
+        else:
+            match, val = "", row[1]
 
         if isinstance(val, tuple):
             if val[0] == 0:  # value
-                yield (tuple(key_path), level, key, match, (val[1], val[2]))
+                result.append(
+                    (tuple(key_path), level, key, match, (val[1], val[2]))
+                )
             elif val[0] in (1, 2, 3):
-                yield (tuple(key_path), level, key, match, "")
-                for new_row in expand_values(
-                    val[1],
-                    level=level + 1,
-                    ignore_key=True if val[0] == 1 else False,
-                    key_path=key_path,
-                ):
-                    yield new_row
+                result.append((tuple(key_path), level, key, match, ""))
+                _expand_values(
+                    val[1], level + 1, val[0] == 1, key_path, result
+                )
         elif isinstance(val, list):
-            yield (tuple(key_path), level, key, match, "")
-            for new_row in expand_values(val, level=level, key_path=key_path):
-                yield new_row
+            result.append((tuple(key_path), level, key, match, ""))
+            _expand_values(val, level, False, key_path, result)
 
         if key is not Absent:
             key_path.pop()
@@ -227,22 +232,26 @@ def flatten_dict_comparison(comparison):
     """
     result_table = []  # level, key, left, right, result
 
-    left = list(expand_values(extract_values(comparison, 2)))
-    right = list(expand_values(extract_values(comparison, 3)))
+    left = expand_values(extract_values(comparison, 2))
+    right = expand_values(extract_values(comparison, 3))
 
-    while left or right:
+    # Rows are consumed from the front, by index to keep this linear
+    lidx, ridx = 0, 0
+    while lidx < len(left) or ridx < len(right):
         lpart, rpart = None, None
-        if left and right:
-            if len(left[0][0]) > len(right[0][0]):
-                lpart = left.pop(0)
-            elif len(left[0][0]) < len(right[0][0]):
-                rpart = right.pop(0)
+        if lidx < len(left) and ridx < len(right):
+            if len(left[lidx][0]) > len(right[ridx][0]):
+                lpart = left[lidx]
+            elif len(left[lidx][0]) < len(right[ridx][0]):
+                rpart = right[ridx]
             else:
-                lpart, rpart = left.pop(0), right.pop(0)
-        elif left:
-            lpart = left.pop(0)
-        elif right:
-            rpart = right.pop(0)
+                lpart, rpart = left[lidx], right[ridx]
+        elif lidx < len(left):
+            lpart = left[lidx]
+        else:
+            rpart = right[ridx]
+        lidx += lpart is not None
+        ridx += rpart is not None
 
         level = lpart[1] if lpart else rpart[1]
         key = lpart[2] if lpart else rpart[2]
@@ -4,6 +4,8 @@ it provides diff (context/unified) functions with more options like GNU diff,
 including: --ignore-space-change, --ignore-whitespace, --ignore-blank-lines
 Due to the different algorithm, its output might be a slightly difference
 compared with that of gnu diff or windiff, but it won't lead to confusing.
+Lines are matched by the histogram and Myers algorithms of
+testplan.common.utils.linediff, natively when its extension is built.
 
 Module difflib -- helpers for computing deltas between objects.
 
@@ -33,6 +35,8 @@ from collections import namedtuple as _namedtuple
 from functools import reduce
 from datetime import datetime
 
+from . import linediff
+
 
 __all__ = [
     "Match",
@@ -892,8 +896,9 @@ class Differ(object):
     r"""
     Differ is a class for comparing sequences of lines of text, and
     producing human-readable differences or deltas.  Differ uses
-    SequenceMatcher both to compare sequences of lines, and to compare
-    sequences of characters within similar (near-matching) lines.
+    testplan.common.utils.linediff to compare sequences of lines, and
+    SequenceMatcher to compare sequences of characters within similar
+    (near-matching) lines.
 
     Use get_opcodes() and get_merged_opcodes() to get a list of 5-tuples
     describing how to turn a into b. The former can give detailed
@@ -1012,8 +1017,7 @@ class Differ(object):
                 )
             a, b = new_a, new_b
 
-        cruncher = SequenceMatcher(self.linejunk, a, b)
-        for tag, alo, ahi, blo, bhi in cruncher.get_opcodes():
+        for tag, alo, ahi, blo, bhi in self._line_opcodes(a, b):
             if tag == "replace":
                 # `_fancy_replace` can give us a more specific result, for
                 # example, it can recognize completely equal lines among
@@ -1050,7 +1054,7 @@ class Differ(object):
         ('replace', 11, 13, 10, 11)
         """
 
-        g = self._merge_opcodes(self.get_opcodes(a, b))
+        g = self._merge_opcodes(self._line_opcodes(a, b))
         if self.ignore_blank_lines:
             g = self._merge_opcodes(self._verify_blank_lines(a, b, g))
 
@@ -1114,7 +1118,7 @@ class Differ(object):
                     _check_adjacent_blank_block(codes, i - 2)
                     _check_adjacent_blank_block(codes, i + 2)
 
-        g = self._merge_opcodes(self.get_opcodes(a, b))
+        g = self._merge_opcodes(self._line_opcodes(a, b))
         if self.ignore_blank_lines:
             g = self._verify_blank_lines(a, b, g)
         codes = list(g)
@@ -1151,6 +1155,21 @@ class Differ(object):
         if group and not (len(group) == 1 and group[0][0] == "equal"):
             yield group
 
+    def _line_opcodes(self, a, b):
+        """
+        Opcodes of the matching lines of `a` and `b`. Lines of a 'replace'
+        block have nothing in common, so that refining it as get_opcodes()
+        does would not change the merged opcodes.
+        """
+        ids_a, ids_b = linediff.line_ids(
+            a,
+            b,
+            ignore_space_change=self.ignore_space_change,
+            ignore_whitespaces=self.ignore_whitespaces,
+            linejunk=self.linejunk,
+        )
+        return linediff.opcodes(linediff.matching_blocks(ids_a, ids_b))
+
     def _merge_opcodes(self, generator):
         "Algorithm for merging opcode"
         prev_tag = ""
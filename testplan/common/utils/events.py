@@ -0,0 +1,138 @@
+"""
+Event bus of a run, publishing compact events (e.g. a test started on a
+worker, a testcase finished) to the listeners of the run state and to the
+clients of live feeds.
+
+Events are numbered in the order they are published and the last ones are
+kept, so that a client reading them as a stream resumes from the last event
+it received. The cost of reading events only depends on their number, not on
+the size of the report.
+"""
+
+import collections
+import threading
+import time
+
+
+class Event(object):
+    """
+    Event published on an :py:class:`EventBus`.
+
+    :param seq: Number of the event, in the order events are published.
+    :type seq: ``int``
+    :param kind: Kind of event, e.g. ``"test_started"``.
+    :type kind: ``str``
+    :param data: Data of the event, JSON serializable.
+    :type data: ``dict``
+    """
+
+    __slots__ = ("seq", "kind", "time", "data")
+
+    def __init__(self, seq, kind, data):
+        self.seq = seq
+        self.kind = kind
+        self.time = time.time()
+        self.data = data
+
+    def to_dict(self):
+        """Event as a ``dict``, e.g. to send it as JSON."""
+        return dict(self.data, seq=self.seq, kind=self.kind, time=self.time)
+
+    def __repr__(self):
+        return "{}({}, {!r}, {!r})".format(
+            self.__class__.__name__, self.seq, self.kind, self.data
+        )
+
+
+class EventBus(object):
+    """
+    Publishes events to listeners, called synchronously by the publishing
+    thread, and keeps the last events for readers waiting for them.
+
+    :param history: Number of events kept for readers.
+    :type history: ``int``
+    """
+
+    def __init__(self, history=10000):
+        self._events = collections.deque(maxlen=history)
+        self._listeners = []
+        self._seq = 0
+        self._closed = False
+        self._cond = threading.Condition()
+
+    @property
+    def last_seq(self):
+        """Number of the last event published, 0 if none was."""
+        return self._seq
+
+    @property
+    def closed(self):
+        """No more events will be published."""
+        return self._closed
+
+    def subscribe(self, listener):
+        """
+        Call a listener with each event published from now on.
+
+        :param listener: Callable taking an :py:class:`Event`, it should not
+            block nor raise.
+        :type listener: ``callable``
+        """
+        with self._cond:
+            self._listeners.append(listener)
+
+    def publish(self, kind, **data):
+        """
+        Publish an event.
+
+        :param kind: Kind of event.
+        :type kind: ``str``
+        :param data: Data of the event, JSON serializable.
+        :type data: ``dict``
+        :return: Published event.
+        :rtype: :py:class:`Event`
+        """
+        with self._cond:
+            self._seq += 1
+            event = Event(self._seq, kind, data)
+            self._events.append(event)
+            # Listeners see the events in order
+            for listener in self._listeners:
+                listener(event)
+            self._cond.notify_all()
+        return event
+
+    def close(self):
+        """Stop the readers waiting for events."""
+        with self._cond:
+            self._closed = True
+            self._cond.notify_all()
+
+    def events_since(self, seq, timeout=None):
+        """
+        Events published after a given one, waiting for one to be published
+        if there is none yet.
+
+        :param seq: Number of the last event read, 0 for all events kept.
+        :type seq: ``int``
+        :param timeout: Maximum time to wait for an event in seconds,
+            ``None`` to wait until one is published or the bus is closed.
+        :type timeout: ``float`` or ``NoneType``
+        :return: Events published after the given one, empty if none was
+            before the timeout or the bus was closed, ``None`` if some of
+            them are no longer kept.
+        :rtype: ``list`` of :py:class:`Event` or ``NoneType``
+        """
+        with self._cond:
+            self._cond.wait_for(
+                lambda: self._seq > seq or self._closed, timeout=timeout
+            )
+            if self._seq <= seq:
+                return []
+            if not self._events or self._events[0].seq > seq + 1:
+                return None
+            # Newest events are the most likely to be read
+            start = len(self._events) - (self._seq - seq)
+            return [
+                self._events[idx] for idx in range(start, len(self._events))
+            ]
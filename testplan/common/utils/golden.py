@@ -0,0 +1,332 @@
+"""
+Comparison of (possibly multi-GB) output files against golden files.
+
+Both files are memory mapped and compared in fixed size chunks by a pool of
+threads (numpy releases the GIL while comparing). Pages are released once
+compared so that the resident memory stays flat, and no more chunks are
+compared once enough differing regions have been found. The same algorithm
+is available to C++ tests in ``testplan/golden.h``.
+"""
+
+import collections
+import mmap
+import os
+import shutil
+import string
+import tempfile
+from concurrent import futures
+
+import numpy
+
+# Bytes compared by a thread at a time, a multiple of the page size.
+CHUNK_SIZE = 8 << 20
+
+# Differences separated by at most this many equal bytes form one region.
+MERGE_GAP = 8
+
+MAX_REGIONS = 10
+
+UPDATE_GOLDEN_ENV = "TESTPLAN_UPDATE_GOLDEN"
+
+PREVIEW_SIZE = 16
+
+DiffRegion = collections.namedtuple("DiffRegion", ["offset", "length"])
+
+
+class GoldenResult(object):
+    """
+    Outcome of a golden file check.
+
+    :param actual_size: Size of the output file in bytes.
+    :type actual_size: ``int``
+    :param golden_size: Size of the golden file in bytes.
+    :type golden_size: ``int``
+    :param regions: First differing byte ranges, a size difference is
+        reported as a region covering the tail of the longer file.
+    :type regions: ``list`` of :py:class:`DiffRegion`
+    :param truncated: Whether there may be more regions than reported.
+    :type truncated: ``bool``
+    :param updated: Whether the golden file has been replaced.
+    :type updated: ``bool``
+    """
+
+    def __init__(
+        self,
+        actual_size=0,
+        golden_size=0,
+        regions=None,
+        truncated=False,
+        updated=False,
+    ):
+        self.actual_size = actual_size
+        self.golden_size = golden_size
+        self.regions = regions or []
+        self.truncated = truncated
+        self.updated = updated
+
+    @property
+    def passed(self):
+        return not self.regions
+
+    def __repr__(self):
+        return (
+            "{}(actual_size={}, golden_size={}, regions={}, truncated={},"
+            " updated={})".format(
+                self.__class__.__name__,
+                self.actual_size,
+                self.golden_size,
+                self.regions,
+                self.truncated,
+                self.updated,
+            )
+        )
+
+
+def _mapped(path):
+    """Read-only mapping of a file, ``None`` for an empty file."""
+    with open(path, "rb") as fobj:
+        if os.fstat(fobj.fileno()).st_size == 0:
+            return None
+        mapping = mmap.mmap(fobj.fileno(), 0, access=mmap.ACCESS_READ)
+    if hasattr(mapping, "madvise") and hasattr(mmap, "MADV_SEQUENTIAL"):
+        mapping.madvise(mmap.MADV_SEQUENTIAL)
+    return mapping
+
+
+def _release(mapping, begin, end):
+    """Drop the pages of an already compared range from the resident set."""
+    if hasattr(mapping, "madvise") and hasattr(mmap, "MADV_DONTNEED"):
+        mapping.madvise(mmap.MADV_DONTNEED, begin, end - begin)
+
+
+def _diff_chunk(actual, golden, begin, end, max_regions):
+    """Differing regions of ``[begin, end)``, at most ``max_regions``."""
+    first = numpy.frombuffer(
+        actual, dtype=numpy.uint8, count=end - begin, offset=begin
+    )
+    second = numpy.frombuffer(
+        golden, dtype=numpy.uint8, count=end - begin, offset=begin
+    )
+    try:
+        if numpy.array_equal(first, second):
+            return []
+        indices = numpy.flatnonzero(first != second)
+    finally:
+        # Views on the mappings must be gone before they can be closed.
+        del first, second
+
+    # Start a new region wherever the gap to the previous difference is
+    # larger than MERGE_GAP.
+    starts = numpy.flatnonzero(numpy.diff(indices) > MERGE_GAP + 1) + 1
+    starts = numpy.concatenate(([0], starts))[:max_regions]
+    ends = numpy.concatenate((starts[1:], [len(indices)]))
+    return [
+        DiffRegion(
+            offset=begin + int(indices[start]),
+            length=int(indices[stop - 1] - indices[start]) + 1,
+        )
+        for start, stop in zip(starts, ends)
+    ]
+
+
+def compare_files(
+    actual,
+    golden,
+    max_regions=MAX_REGIONS,
+    chunk_size=CHUNK_SIZE,
+    workers=None,
+):
+    """
+    Compare an output file against a golden file.
+
+    :param actual: Path of the output file.
+    :type actual: ``str``
+    :param golden: Path of the golden file.
+    :type golden: ``str``
+    :param max_regions: Number of differing regions to report.
+    :type max_regions: ``int``
+    :param chunk_size: Bytes compared by a thread at a time, must be a
+        multiple of :py:data:`mmap.PAGESIZE`.
+    :type chunk_size: ``int``
+    :param workers: Number of threads, defaults to the CPU count.
+    :type workers: ``int``
+    :return: Comparison result.
+    :rtype: :py:class:`GoldenResult`
+    """
+    actual_size = os.path.getsize(actual)
+    golden_size = os.path.getsize(golden)
+    common = min(actual_size, golden_size)
+    num_chunks = (common + chunk_size - 1) // chunk_size
+    workers = max(1, min(workers or os.cpu_count() or 1, num_chunks))
+
+    found = []
+    scanned = 0
+    if common:
+        actual_map, golden_map = _mapped(actual), _mapped(golden)
+        try:
+            # Chunks are submitted in order with a bounded number in flight,
+            # and collected in order, so that no chunk past the point where
+            # enough regions have been found is compared.
+            with futures.ThreadPoolExecutor(max_workers=workers) as pool:
+                pending = collections.deque()
+                next_chunk = 0
+                while scanned < num_chunks:
+                    while (
+                        next_chunk < num_chunks and len(pending) < 2 * workers
+                    ):
+                        begin = next_chunk * chunk_size
+                        end = min(common, begin + chunk_size)
+                        pending.append(
+                            (
+                                begin,
+                                end,
+                                pool.submit(
+                                    _diff_chunk,
+                                    actual_map,
+                                    golden_map,
+                                    begin,
+                                    end,
+                                    max_regions + 1,
+                                ),
+                            )
+                        )
+                        next_chunk += 1
+
+                    begin, end, future = pending.popleft()
+                    found.extend(future.result())
+                    _release(actual_map, begin, end)
+                    _release(golden_map, begin, end)
+                    scanned += 1
+                    if len(found) > max_regions:
+                        break
+
+                for _, _, future in pending:
+                    future.cancel()
+                futures.wait([future for _, _, future in pending])
+        finally:
+            actual_map.close()
+            golden_map.close()
+
+    # Join regions split by a chunk boundary.
+    regions = []
+    for region in found:
+        if regions:
+            prev = regions[-1]
+            if region.offset - (prev.offset + prev.length) <= MERGE_GAP:
+                regions[-1] = DiffRegion(
+                    prev.offset, region.offset + region.length - prev.offset
+                )
+                continue
+        regions.append(region)
+
+    if actual_size != golden_size:
+        regions.append(
+            DiffRegion(common, max(actual_size, golden_size) - common)
+        )
+
+    return GoldenResult(
+        actual_size=actual_size,
+        golden_size=golden_size,
+        regions=regions[:max_regions],
+        truncated=scanned < num_chunks or len(regions) > max_regions,
+    )
+
+
+def update_golden(actual, golden):
+    """
+    Replace the golden file with a copy of the output file. The copy is
+    written next to the golden file, synced and renamed over it, so readers
+    never see a partial file.
+
+    :param actual: Path of the output file.
+    :type actual: ``str``
+    :param golden: Path of the golden file.
+    :type golden: ``str``
+    """
+    directory = os.path.dirname(os.path.abspath(golden))
+    fd, tmp_path = tempfile.mkstemp(
+        dir=directory, prefix=os.path.basename(golden) + ".tmp."
+    )
+    try:
+        with os.fdopen(fd, "wb") as tmp_file, open(actual, "rb") as source:
+            shutil.copyfileobj(source, tmp_file, 1 << 20)
+            tmp_file.flush()
+            os.fsync(tmp_file.fileno())
+        if os.path.exists(golden):
+            shutil.copymode(golden, tmp_path)
+        os.replace(tmp_path, golden)
+    except BaseException:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+        raise
+
+
+def check_golden(actual, golden, update=False, **kwargs):
+    """
+    Compare an output file against a golden file, or replace the golden file
+    in update mode.
+
+    :param actual: Path of the output file.
+    :type actual: ``str``
+    :param golden: Path of the golden file.
+    :type golden: ``str``
+    :param update: Replace the golden file instead of comparing.
+    :type update: ``bool``
+    :return: Comparison result, a passing one in update mode.
+    :rtype: :py:class:`GoldenResult`
+    """
+    if update:
+        update_golden(actual, golden)
+        size = os.path.getsize(golden)
+        return GoldenResult(actual_size=size, golden_size=size, updated=True)
+    return compare_files(actual, golden, **kwargs)
+
+
+_PRINTABLE = set(string.printable.encode()) - set(b"\x0b\x0c\r")
+
+
+def preview(path, offset, length=PREVIEW_SIZE):
+    """
+    Short printable representation of the bytes of a file at an offset:
+    text if possible, hex otherwise.
+    """
+    with open(path, "rb") as fobj:
+        fobj.seek(offset)
+        data = fobj.read(min(length, PREVIEW_SIZE))
+    if all(byte in _PRINTABLE for byte in data):
+        return data.decode("ascii")
+    return data.hex()
+
+
+def regions_table(result, actual, golden):
+    """
+    Rows describing the differing regions of a result, header first.
+
+    :return: Table that can be passed to a ``TableLog`` entry.
+    :rtype: ``list`` of ``list``
+    """
+    table = [["Offset", "Length", "Actual", "Golden"]]
+    for region in result.regions:
+        table.append(
+            [
+                region.offset,
+                region.length,
+                preview(actual, region.offset, region.length),
+                preview(golden, region.offset, region.length),
+            ]
+        )
+    return table
+
+
+def summary(result):
+    """One line description of a result."""
+    if result.updated:
+        return "Golden file updated ({} bytes)".format(result.golden_size)
+    if result.passed:
+        return "Files are identical ({} bytes)".format(result.actual_size)
+    return "{}{} differing regions, size {} vs {} bytes".format(
+        len(result.regions),
+        "+" if result.truncated else "",
+        result.actual_size,
+        result.golden_size,
+    )
@@ -0,0 +1,348 @@
+"""
+Log-bucketed (HDR style) histograms of non negative integer values, e.g.
+latencies in nanoseconds.
+
+Values below ``2 ** sub_bucket_bits`` are counted exactly. Above, every power
+of two range is split into ``2 ** (sub_bucket_bits - 1)`` buckets of equal
+width, so a value is known within a relative error of
+``2 ** -(sub_bucket_bits - 1)`` (0.8% with the default of 8 bits) whatever its
+magnitude, with a few thousand buckets covering nanoseconds to hours.
+
+Histograms with the same ``sub_bucket_bits`` and unit are merged by adding
+their counts, e.g. to combine the results of several shards or repetitions.
+The encoded form (:py:meth:`HDRHistogram.encode`) only lists non empty
+buckets and is also produced by ``testplan/hdr.h`` for C++ tests.
+"""
+
+import math
+
+try:
+    import numpy
+except ImportError:
+    numpy = None  # Values are recorded one by one
+
+SUB_BUCKET_BITS = 8
+
+DEFAULT_UNIT = "ns"
+
+# Largest value with an exact float representation, values are converted
+# to floats to compute their buckets.
+MAX_VALUE = 2**53
+
+
+def bucket_index(value, sub_bucket_bits=SUB_BUCKET_BITS):
+    """
+    Index of the bucket of a value.
+
+    :param value: Non negative integer value.
+    :type value: ``int``
+    :param sub_bucket_bits: Precision of the histogram.
+    :type sub_bucket_bits: ``int``
+    :return: Bucket index.
+    :rtype: ``int``
+    """
+    shift = max(0, value.bit_length() - sub_bucket_bits)
+    return (shift << (sub_bucket_bits - 1)) + (value >> shift)
+
+
+def bucket_range(index, sub_bucket_bits=SUB_BUCKET_BITS):
+    """
+    Values of a bucket.
+
+    :param index: Bucket index.
+    :type index: ``int``
+    :param sub_bucket_bits: Precision of the histogram.
+    :type sub_bucket_bits: ``int``
+    :return: Lowest and highest value of the bucket.
+    :rtype: ``tuple`` of ``int``
+    """
+    half = 1 << (sub_bucket_bits - 1)
+    if index < 2 * half:
+        return index, index
+    shift = index // half - 1
+    low = (index - (shift << (sub_bucket_bits - 1))) << shift
+    return low, low + (1 << shift) - 1
+
+
+def _bucket_indices(values, sub_bucket_bits):
+    """Vectorized :py:func:`bucket_index` of an array of values."""
+    # frexp gives the bit length of integers exactly representable as floats
+    _, bit_length = numpy.frexp(values.astype(numpy.float64))
+    shift = numpy.maximum(0, bit_length - sub_bucket_bits).astype(numpy.int64)
+    return (shift << (sub_bucket_bits - 1)) + (values >> shift)
+
+
+def percentile_ticks(total):
+    """
+    Percentiles of a percentile distribution plot, closer as they get to
+    100: 0, 50, 75, 87.5, ... until the last sample.
+
+    :param total: Number of samples.
+    :type total: ``int``
+    :rtype: ``list`` of ``float``
+    """
+    ticks = []
+    step = 0
+    while total > 0 and 2**step <= total:
+        ticks.append(100.0 * (1 - 0.5**step))
+        step += 1
+    ticks.append(100.0)
+    return ticks
+
+
+class HDRHistogram(object):
+    """
+    Mergeable histogram of non negative values.
+
+    :param sub_bucket_bits: Precision, values are known within a relative
+        error of ``2 ** -(sub_bucket_bits - 1)``.
+    :type sub_bucket_bits: ``int``
+    :param unit: Unit of the values, only used for display.
+    :type unit: ``str``
+    """
+
+    def __init__(self, sub_bucket_bits=SUB_BUCKET_BITS, unit=DEFAULT_UNIT):
+        if not 2 <= sub_bucket_bits <= 20:
+            raise ValueError(
+                "sub_bucket_bits must be in [2, 20], got {}".format(
+                    sub_bucket_bits
+                )
+            )
+        self.sub_bucket_bits = sub_bucket_bits
+        self.unit = unit
+        self.counts = {}
+        self.total = 0
+        self.sum = 0
+        self.min = None
+        self.max = None
+
+    def __repr__(self):
+        return "{}(sub_bucket_bits={}, unit={!r}, total={})".format(
+            self.__class__.__name__,
+            self.sub_bucket_bits,
+            self.unit,
+            self.total,
+        )
+
+    def __eq__(self, other):
+        return isinstance(other, HDRHistogram) and self.encode() == (
+            other.encode()
+        )
+
+    def __ne__(self, other):
+        return not self == other
+
+    def __add__(self, other):
+        result = HDRHistogram(self.sub_bucket_bits, self.unit)
+        return result.merge(self).merge(other)
+
+    def _check_value(self, value):
+        if value < 0 or value >= MAX_VALUE:
+            raise ValueError("Value {} out of range [0, 2**53)".format(value))
+
+    def _update_bounds(self, low, high):
+        self.min = low if self.min is None else min(self.min, low)
+        self.max = high if self.max is None else max(self.max, high)
+
+    def record(self, value, count=1):
+        """
+        Record a value, rounded to the nearest integer.
+
+        :param value: Non negative value.
+        :type value: ``int`` or ``float``
+        :param count: Number of occurrences.
+        :type count: ``int``
+        :return: self
+        """
+        value = int(round(value))
+        self._check_value(value)
+        index = bucket_index(value, self.sub_bucket_bits)
+        self.counts[index] = self.counts.get(index, 0) + count
+        self.total += count
+        self.sum += value * count
+        self._update_bounds(value, value)
+        return self
+
+    def record_values(self, values):
+        """
+        Record many values at once, rounded to the nearest integers.
+
+        :param values: Non negative values.
+        :type values: iterable of ``int`` or ``float``
+        :return: self
+        """
+        if numpy is None:
+            values = [int(round(value)) for value in values]
+            if values:
+                self._check_value(min(values))
+                self._check_value(max(values))
+            for value in values:
+                self.record(value)
+            return self
+
+        values = numpy.rint(numpy.asarray(values, dtype=numpy.float64))
+        if values.size == 0:
+            return self
+        self._check_value(values.min())
+        self._check_value(values.max())
+
+        values = values.astype(numpy.int64)
+        indices, counts = numpy.unique(
+            _bucket_indices(values, self.sub_bucket_bits), return_counts=True
+        )
+        for index, count in zip(indices.tolist(), counts.tolist()):
+            self.counts[index] = self.counts.get(index, 0) + count
+        self.total += int(values.size)
+        self.sum += int(values.sum())
+        self._update_bounds(int(values.min()), int(values.max()))
+        return self
+
+    def merge(self, other):
+        """
+        Add the counts of another histogram to this one.
+
+        :param other: Histogram with the same precision and unit, or its
+            encoded form.
+        :type other: :py:class:`HDRHistogram` or ``dict``
+        :return: self
+        """
+        if isinstance(other, dict):
+            other = HDRHistogram.decode(other)
+        if (
+            other.sub_bucket_bits != self.sub_bucket_bits
+            or other.unit != self.unit
+        ):
+            raise ValueError(
+                "Cannot merge histograms of different precision or unit:"
+                " {!r} and {!r}".format(self, other)
+            )
+        for index, count in other.counts.items():
+            self.counts[index] = self.counts.get(index, 0) + count
+        self.total += other.total
+        self.sum += other.sum
+        if other.total:
+            self._update_bounds(other.min, other.max)
+        return self
+
+    @property
+    def mean(self):
+        return float(self.sum) / self.total if self.total else None
+
+    def value_at_percentile(self, percentile):
+        """
+        Value below or equal to which the given percentage of the values
+        are, as the highest value of its bucket (but at most the maximum).
+
+        :param percentile: Percentile in [0, 100].
+        :type percentile: ``float``
+        :return: Value, ``None`` if the histogram is empty.
+        :rtype: ``int``
+        """
+        if not self.total:
+            return None
+        rank = max(1, int(math.ceil(percentile / 100.0 * self.total)))
+        seen = 0
+        for index in sorted(self.counts):
+            seen += self.counts[index]
+            if seen >= rank:
+                _, high = bucket_range(index, self.sub_bucket_bits)
+                return max(self.min, min(high, self.max))
+        return self.max
+
+    def percentiles(self, percentiles=None):
+        """
+        Values at several percentiles.
+
+        :param percentiles: Percentiles, those of a percentile distribution
+            plot by default (see :py:func:`percentile_ticks`).
+        :type percentiles: ``list`` of ``float``
+        :return: Percentile and value pairs.
+        :rtype: ``list`` of ``tuple``
+        """
+        if percentiles is None:
+            percentiles = percentile_ticks(self.total)
+        if not self.total:
+            return []
+
+        # Single pass over the buckets for increasing percentiles.
+        ordered = sorted(percentiles)
+        buckets = sorted(self.counts.items())
+        result = []
+        position, seen = 0, 0
+        for percentile in ordered:
+            rank = max(1, int(math.ceil(percentile / 100.0 * self.total)))
+            while seen < rank and position < len(buckets):
+                seen += buckets[position][1]
+                position += 1
+            _, high = bucket_range(
+                buckets[position - 1][0], self.sub_bucket_bits
+            )
+            result.append((percentile, max(self.min, min(high, self.max))))
+        return result
+
+    def encode(self):
+        """
+        Compact JSON compatible form: the non empty buckets as a flat list of
+        (index delta, count) pairs.
+
+        :rtype: ``dict``
+        """
+        counts = []
+        previous = 0
+        for index in sorted(self.counts):
+            counts.extend((index - previous, self.counts[index]))
+            previous = index
+        return {
+            "sub_bucket_bits": self.sub_bucket_bits,
+            "unit": self.unit,
+            "total": self.total,
+            "sum": self.sum,
+            "min": self.min,
+            "max": self.max,
+            "counts": counts,
+        }
+
+    @classmethod
+    def decode(cls, data):
+        """
+        Histogram from its encoded form.
+
+        :param data: Result of :py:meth:`encode`.
+        :type data: ``dict``
+        :rtype: :py:class:`HDRHistogram`
+        """
+        histogram = cls(
+            sub_bucket_bits=data["sub_bucket_bits"],
+            unit=data.get("unit", DEFAULT_UNIT),
+        )
+        index = 0
+        counts = data["counts"]
+        for position in range(0, len(counts), 2):
+            index += counts[position]
+            histogram.counts[index] = (
+                histogram.counts.get(index, 0) + counts[position + 1]
+            )
+        histogram.total = data["total"]
+        histogram.sum = data.get("sum", 0)
+        histogram.min = data.get("min")
+        histogram.max = data.get("max")
+        return histogram
+
+
+def merge(histograms):
+    """
+    Merge histograms, e.g. of several shards or repetitions of a test.
+
+    :param histograms: Histograms or their encoded forms.
+    :type histograms: iterable of :py:class:`HDRHistogram` or ``dict``
+    :return: New histogram, ``None`` if there is none to merge.
+    :rtype: :py:class:`HDRHistogram`
+    """
+    result = None
+    for histogram in histograms:
+        if isinstance(histogram, dict):
+            histogram = HDRHistogram.decode(histogram)
+        if result is None:
+            result = HDRHistogram(histogram.sub_bucket_bits, histogram.unit)
+        result.merge(histogram)
+    return result
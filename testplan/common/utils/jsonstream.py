@@ -0,0 +1,260 @@
+"""
+Incremental reader of large JSON documents, e.g. test reports of hundreds of
+megabytes, which only keeps a chunk of the file in memory. Objects and arrays
+are iterated over one member at a time, the caller reading the values it
+needs and skipping the others:
+
+.. code-block:: python
+
+    with open("report.json") as report_file:
+        reader = JSONStreamReader(report_file)
+        for key in reader.iter_object():
+            if key == "name":
+                name = reader.read_value()
+            elif key == "entries":
+                for _ in reader.iter_array():
+                    ...  # read or skip each entry
+            else:
+                reader.skip_value()
+"""
+
+import json
+import json.decoder
+import json.scanner
+import re
+
+WHITESPACE = re.compile(r"[ \t\n\r]*")
+WORD = re.compile(r"[a-zA-Z]+")
+# Text of a container up to its next bracket, strings included.
+CONTAINER_TEXT = re.compile(
+    r'[^"\[\]{}]*(?:"[^"\\]*(?:\\.[^"\\]*)*"[^"\[\]{}]*)*', re.DOTALL
+)
+
+LITERALS = {"true": True, "false": False, "null": None}
+
+
+class JSONStreamReader(object):
+    """
+    Pull reader of a JSON document.
+
+    :param source: Text file like object to read from.
+    :type source: ``file``
+    :param chunk_size: Number of characters read at a time.
+    :type chunk_size: ``int``
+    """
+
+    def __init__(self, source, chunk_size=1 << 16):
+        self._source = source
+        self._chunk_size = chunk_size
+        self._buffer = ""
+        self._pos = 0
+        self._eof = False
+
+    def _fill(self, size=None):
+        """Read more characters, return False at the end of the document."""
+        if self._eof:
+            return False
+        chunk = self._source.read(size or self._chunk_size)
+        if not chunk:
+            self._eof = True
+            return False
+        self._buffer = self._buffer[self._pos :] + chunk
+        self._pos = 0
+        return True
+
+    def _error(self, message):
+        return ValueError(
+            "{} near: {!r}".format(
+                message, self._buffer[self._pos : self._pos + 40]
+            )
+        )
+
+    def peek(self):
+        """
+        Next non whitespace character, without consuming it.
+
+        :return: Character, empty at the end of the document.
+        :rtype: ``str``
+        """
+        while True:
+            self._pos = WHITESPACE.match(self._buffer, self._pos).end()
+            if self._pos < len(self._buffer):
+                return self._buffer[self._pos]
+            if not self._fill():
+                return ""
+
+    def _expect(self, char):
+        if self.peek() != char:
+            raise self._error("Expected {!r}".format(char))
+        self._pos += 1
+
+    def _read_string(self):
+        self._expect('"')
+        size = self._chunk_size
+        while True:
+            try:
+                value, end = json.decoder.scanstring(self._buffer, self._pos)
+            except ValueError:
+                # Unterminated in the buffer, read more of it at a time to
+                # scan long strings a bounded number of times.
+                self._pos -= 1
+                if not self._fill(size):
+                    raise self._error("Unterminated string")
+                self._pos = 1
+                size *= 2
+                continue
+            self._pos = end
+            return value
+
+    def _read_scalar(self):
+        """Read a number or a literal."""
+        # Tokens may stop at a partial fraction or exponent, e.g. "1." or
+        # "1e", have enough of the buffer to never split them.
+        while len(self._buffer) - self._pos < 64 and self._fill():
+            pass
+        while True:
+            number = json.scanner.NUMBER_RE.match(self._buffer, self._pos)
+            word = WORD.match(self._buffer, self._pos)
+            match = number or word
+            if not match or match.end() == self._pos:
+                raise self._error("Invalid value")
+            # Read on if the token may continue in the next chunk
+            if match.end() == len(self._buffer) and self._fill():
+                continue
+
+            self._pos = match.end()
+            if number:
+                integer, fraction, exponent = number.groups()
+                if fraction or exponent:
+                    return float(integer + (fraction or "") + (exponent or ""))
+                return int(integer)
+            if word.group() not in LITERALS:
+                self._pos = word.start()
+                raise self._error("Invalid literal")
+            return LITERALS[word.group()]
+
+    def iter_object(self):
+        """
+        Iterate over the keys of the next value, an object. The caller must
+        read or skip the value of each key before the next iteration.
+
+        :return: Keys.
+        :rtype: ``generator`` of ``str``
+        """
+        self._expect("{")
+        if self.peek() == "}":
+            self._pos += 1
+            return
+        while True:
+            key = self._read_string()
+            self._expect(":")
+            yield key
+            char = self.peek()
+            self._pos += 1
+            if char == "}":
+                return
+            if char != ",":
+                self._pos -= 1
+                raise self._error("Expected ',' or '}'")
+
+    def iter_array(self):
+        """
+        Iterate over the items of the next value, an array. The caller must
+        read or skip each item before the next iteration.
+
+        :return: Item indexes.
+        :rtype: ``generator`` of ``int``
+        """
+        self._expect("[")
+        if self.peek() == "]":
+            self._pos += 1
+            return
+        index = 0
+        while True:
+            yield index
+            index += 1
+            char = self.peek()
+            self._pos += 1
+            if char == "]":
+                return
+            if char != ",":
+                self._pos -= 1
+                raise self._error("Expected ',' or ']'")
+
+    def read_value(self):
+        """
+        Read the next value.
+
+        :return: Decoded value.
+        """
+        char = self.peek()
+        if char in ("{", "["):
+            return json.loads(self._scan_container(capture=True))
+        if char == '"':
+            return self._read_string()
+        if not char:
+            raise self._error("Unexpected end of document")
+        return self._read_scalar()
+
+    def _scan_container(self, capture):
+        """
+        Move past the next object or array, only looking for its closing
+        bracket, and return its text if captured.
+        """
+        pieces = []
+        start = self._pos
+        size = self._chunk_size
+        depth = 0
+        while True:
+            self._pos = CONTAINER_TEXT.match(self._buffer, self._pos).end()
+            if self._pos == len(self._buffer) or (
+                self._buffer[self._pos] == '"'
+            ):
+                # Out of the buffer, possibly in the middle of a string: read
+                # more at a time while in a string, to scan long strings a
+                # bounded number of times.
+                if capture:
+                    pieces.append(self._buffer[start : self._pos])
+                if self._pos == len(self._buffer):
+                    size = self._chunk_size
+                else:
+                    size *= 2
+                if not self._fill(size):
+                    raise self._error("Unexpected end of document")
+                start = 0
+                continue
+
+            char = self._buffer[self._pos]
+            self._pos += 1
+            depth += 1 if char in "[{" else -1
+            if not depth:
+                if capture:
+                    pieces.append(self._buffer[start : self._pos])
+                    return "".join(pieces)
+                return None
+
+    def read_raw(self):
+        """
+        Text of the next value, e.g. to only decode it if it contains some
+        string. Objects and arrays are not validated.
+
+        :rtype: ``str``
+        """
+        if self.peek() in ("{", "["):
+            return self._scan_container(capture=True)
+        return json.dumps(self.read_value())
+
+    def skip_value(self):
+        """
+        Skip the next value. Objects and arrays are not validated, only
+        scanned for their closing bracket.
+        """
+        char = self.peek()
+        if char in ("{", "["):
+            self._scan_container(capture=False)
+        elif char == '"':
+            self._read_string()
+        elif not char:
+            raise self._error("Unexpected end of document")
+        else:
+            self._read_scalar()
@@ -0,0 +1,312 @@
+"""
+Line matching of the diff functions of :py:mod:`testplan.common.utils.difflib`.
+
+Lines are first hashed into integer ids, equal ids meaning equal lines once
+whitespace is ignored as requested, so the matching itself only compares
+integers. It is the histogram diff of git: after trimming the common head
+and tail of a region, the common line occurring the least in it is extended
+into a block of equal lines, which splits the region in two regions matched
+the same way. Regions without such a line, only made of lines repeated many
+times, are matched by the O(ND) algorithm of Myers.
+
+As with :py:class:`difflib.SequenceMatcher`, junk lines (e.g. blank lines)
+never start a match: they are only matched next to other matching lines or
+in the common head and tail of a region.
+
+The ``_linediff`` C++ extension, built with the package when a compiler is
+available, matches the ids. Without it they are matched in Python, with the
+same result.
+"""
+
+try:
+    from testplan.common.utils import _linediff
+except ImportError:
+    _linediff = None
+
+# Lines occurring more often in a region are not used to split it.
+MAX_CHAIN = 64
+
+
+def line_ids(
+    a, b, ignore_space_change=False, ignore_whitespaces=False, linejunk=None
+):
+    """
+    Hash lines into integer ids, equal for lines that are equal once the
+    whitespace is ignored as requested. Junk lines have negative ids.
+
+    :param a: Lines of the first text.
+    :type a: ``list`` of ``str``
+    :param b: Lines of the second text.
+    :type b: ``list`` of ``str``
+    :param ignore_space_change: Ignore changes in the amount of whitespace.
+    :type ignore_space_change: ``bool``
+    :param ignore_whitespaces: Ignore all whitespace.
+    :type ignore_whitespaces: ``bool``
+    :param linejunk: Whether a line is junk, matched after the other lines.
+    :type linejunk: ``callable``
+    :return: Ids of the lines of both texts.
+    :rtype: ``tuple`` of ``list`` of ``int``
+    """
+    if ignore_whitespaces:
+        key = lambda line: "".join(line.split())
+    elif ignore_space_change:
+        key = _space_change_key
+    else:
+        key = str
+
+    ids = {}
+
+    def hashed(lines):
+        result = []
+        for line in lines:
+            content = key(line)
+            line_id = ids.get(content)
+            if line_id is None:
+                if linejunk and linejunk(line):
+                    line_id = -1 - len(ids)
+                else:
+                    line_id = len(ids)
+                ids[content] = line_id
+            result.append(line_id)
+        return result
+
+    return hashed(a), hashed(b)
+
+
+def _space_change_key(line):
+    """
+    Line with its whitespace runs replaced by a space, as gnu diff -b
+    compares lines, which also ignores trailing whitespace including line
+    breaks.
+    """
+    words = line.split()
+    if words and line[0].isspace():
+        return " " + " ".join(words)
+    return " ".join(words)
+
+
+def matching_blocks(a, b):
+    """
+    Blocks of equal ids of two sequences, as
+    :py:meth:`difflib.SequenceMatcher.get_matching_blocks` returns them:
+    triples ``(i, j, n)`` meaning ``a[i:i + n] == b[j:j + n]``, increasing
+    in ``i`` and ``j``, adjacent blocks merged, ending with the dummy block
+    ``(len(a), len(b), 0)``.
+
+    :param a: Line ids of the first text, negative for junk lines.
+    :type a: ``list`` of ``int``
+    :param b: Line ids of the second text, negative for junk lines.
+    :type b: ``list`` of ``int``
+    :return: Matching blocks.
+    :rtype: ``list`` of ``tuple``
+    """
+    if _linediff is not None:
+        try:
+            return _linediff.match(a, b)
+        except OverflowError:
+            pass  # Not 64 bits integers
+    return python_matching_blocks(a, b)
+
+
+def python_matching_blocks(a, b):
+    """
+    :py:func:`matching_blocks` without the C++ extension.
+
+    :param a: Line ids of the first text, negative for junk lines.
+    :type a: ``list`` of ``int``
+    :param b: Line ids of the second text, negative for junk lines.
+    :type b: ``list`` of ``int``
+    :return: Matching blocks.
+    :rtype: ``list`` of ``tuple``
+    """
+    matches = []
+    # Regions to match, with whether only Myers is used for them
+    pending = [(0, len(a), 0, len(b), False)]
+    while pending:
+        alo, ahi, blo, bhi, myers = pending.pop()
+        # Common head and tail
+        size = 0
+        while alo + size < ahi and blo + size < bhi:
+            if a[alo + size] != b[blo + size]:
+                break
+            size += 1
+        if size:
+            matches.append((alo, blo, size))
+            alo, blo = alo + size, blo + size
+        size = 0
+        while ahi - size > alo and bhi - size > blo:
+            if a[ahi - size - 1] != b[bhi - size - 1]:
+                break
+            size += 1
+        if size:
+            matches.append((ahi - size, bhi - size, size))
+            ahi, bhi = ahi - size, bhi - size
+        if alo == ahi or blo == bhi:
+            continue
+
+        block = None if myers else _histogram(a, alo, ahi, b, blo, bhi)
+        if block is not None:
+            i, j, size = block
+            matches.append(block)
+            pending.append((alo, i, blo, j, False))
+            pending.append((i + size, ahi, j + size, bhi, False))
+            continue
+
+        split = _bisect(a, alo, ahi, b, blo, bhi)
+        if split is not None:
+            i, j = split
+            pending.append((alo, i, blo, j, True))
+            pending.append((i, ahi, j, bhi, True))
+
+    return _merged(matches, len(a), len(b))
+
+
+def _histogram(a, alo, ahi, b, blo, bhi):
+    """
+    Block of equal lines containing the non junk line of ``b`` occurring the
+    least in ``a``, at most :py:data:`MAX_CHAIN` times, the longest on equal
+    occurrences. ``None`` if there is no such line.
+    """
+    positions = {}
+    for i in range(alo, ahi):
+        positions.setdefault(a[i], []).append(i)
+
+    best, best_count = None, MAX_CHAIN + 1
+    j = blo
+    while j < bhi:
+        next_j = j + 1
+        occurrences = positions.get(b[j], ())
+        if b[j] >= 0 and 0 < len(occurrences) <= min(best_count, MAX_CHAIN):
+            for i in occurrences:
+                i1, j1 = i, j
+                while i1 > alo and j1 > blo and a[i1 - 1] == b[j1 - 1]:
+                    i1, j1 = i1 - 1, j1 - 1
+                i2, j2 = i + 1, j + 1
+                while i2 < ahi and j2 < bhi and a[i2] == b[j2]:
+                    i2, j2 = i2 + 1, j2 + 1
+                next_j = max(next_j, j2)
+                # Lines of the block occurring the least
+                count = min(
+                    len(positions[a[k]]) for k in range(i1, i2) if a[k] >= 0
+                )
+                if count < best_count or (
+                    count == best_count and i2 - i1 > best[2]
+                ):
+                    best, best_count = (i1, j1, i2 - i1), count
+        j = next_j
+    return best
+
+
+def _bisect(a, alo, ahi, b, blo, bhi):
+    """
+    Point where a shortest edit script of two regions without common head
+    or tail goes through the middle snake, from the linear space variant of
+    Myers' algorithm, junk lines being all different. ``None`` if the
+    regions have no line in common.
+    """
+    length_a, length_b = ahi - alo, bhi - blo
+    max_d = (length_a + length_b + 1) // 2
+    offset = max_d
+    # Furthest reaching paths on each diagonal, from the start and the end
+    forward = [-1] * (2 * max_d + 2)
+    backward = [-1] * (2 * max_d + 2)
+    forward[offset + 1] = backward[offset + 1] = 0
+    delta = length_a - length_b
+    # Paths from the start can meet those from the end after they moved
+    front = delta % 2 != 0
+    # Diagonals leaving the regions are not explored anymore
+    start_f = end_f = start_b = end_b = 0
+
+    for d in range(max_d):
+        for k in range(-d + start_f, d + 1 - end_f, 2):
+            index = offset + k
+            if k == -d or (k != d and forward[index - 1] < forward[index + 1]):
+                x = forward[index + 1]
+            else:
+                x = forward[index - 1] + 1
+            y = x - k
+            while (
+                x < length_a and y < length_b and a[alo + x] == b[blo + y] >= 0
+            ):
+                x, y = x + 1, y + 1
+            forward[index] = x
+            if x > length_a:
+                end_f += 2
+            elif y > length_b:
+                start_f += 2
+            elif front:
+                other = offset + delta - k
+                if 0 <= other < len(backward) and backward[other] != -1:
+                    if x >= length_a - backward[other]:
+                        return alo + x, blo + y
+
+        for k in range(-d + start_b, d + 1 - end_b, 2):
+            index = offset + k
+            if k == -d or (
+                k != d and backward[index - 1] < backward[index + 1]
+            ):
+                x = backward[index + 1]
+            else:
+                x = backward[index - 1] + 1
+            y = x - k
+            while (
+                x < length_a
+                and y < length_b
+                and a[ahi - x - 1] == b[bhi - y - 1] >= 0
+            ):
+                x, y = x + 1, y + 1
+            backward[index] = x
+            if x > length_a:
+                end_b += 2
+            elif y > length_b:
+                start_b += 2
+            elif not front:
+                other = offset + delta - k
+                if 0 <= other < len(forward) and forward[other] != -1:
+                    forward_x = forward[other]
+                    forward_y = forward_x - (other - offset)
+                    if forward_x >= length_a - x:
+                        return alo + forward_x, blo + forward_y
+    return None
+
+
+def _merged(matches, length_a, length_b):
+    """Sort blocks, merge the adjacent ones and add the dummy last one."""
+    blocks = []
+    for i, j, size in sorted(matches):
+        if (
+            blocks
+            and blocks[-1][0] + blocks[-1][2] == i
+            and (blocks[-1][1] + blocks[-1][2] == j)
+        ):
+            blocks[-1] = (blocks[-1][0], blocks[-1][1], blocks[-1][2] + size)
+        else:
+            blocks.append((i, j, size))
+    blocks.append((length_a, length_b, 0))
+    return blocks
+
+
+def opcodes(blocks):
+    """
+    Operations turning a text into another one from their matching blocks,
+    as :py:meth:`difflib.SequenceMatcher.get_opcodes` returns them.
+
+    :param blocks: Matching blocks returned by :py:func:`matching_blocks`.
+    :type blocks: ``list`` of ``tuple``
+    :return: ``(tag, i1, i2, j1, j2)`` tuples, ``tag`` being ``'replace'``,
+        ``'delete'``, ``'insert'`` or ``'equal'``.
+    :rtype: ``list`` of ``tuple``
+    """
+    i = j = 0
+    result = []
+    for ai, bj, size in blocks:
+        if i < ai and j < bj:
+            result.append(("replace", i, ai, j, bj))
+        elif i < ai:
+            result.append(("delete", i, ai, j, bj))
+        elif j < bj:
+            result.append(("insert", i, ai, j, bj))
+        i, j = ai + size, bj + size
+        if size:
+            result.append(("equal", ai, i, bj, j))
+    return result
@@ -1,5 +1,7 @@
 """System process utilities module."""
 
+import os
+import sys
 import time
 import psutil
 import warnings
@@ -133,6 +135,82 @@ def kill_process_psutil(proc, timeout=5, signal_=None, output=None):
 DEFAULT_CLOSE_FDS = platform.system() != "Windows"
 
 
+def _peak_rss(status_path):
+    """Peak resident set size in bytes (``VmHWM``) from a proc status file."""
+    try:
+        with open(status_path) as status_file:
+            for line in status_file:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1]) * 1024
+    except (IOError, OSError, ValueError):
+        pass
+    return None
+
+
+def wait_with_usage(proc, interval=0.5):
+    """
+    Wait for a process to terminate and return its resource usage, as
+    reported by ``wait4`` on POSIX systems.
+
+    On Linux, the ``ru_maxrss`` of a child includes the memory of the parent
+    it was forked from, so the peak memory is sampled from
+    ``/proc/<pid>/status`` while waiting instead: growth in the last sampling
+    interval before the process exits is missed.
+
+    :param proc: process to wait for
+    :type proc: ``subprocess.Popen``
+    :param interval: maximum sampling interval of the peak memory, in seconds
+    :type interval: ``float``
+    :return: Exit code of process and its resource usage: peak resident set
+        size in bytes (``max_rss``), user and system CPU time in seconds
+        (``user_time``, ``system_time``). Usage is ``None`` where ``wait4``
+        is not available or when the process was reaped by another thread
+        (e.g. after a timeout).
+    :rtype: ``tuple`` of ``int`` and ``dict``
+    """
+    if not hasattr(os, "wait4"):
+        return proc.wait(), None
+
+    status_path = "/proc/{}/status".format(proc.pid)
+    sampled = os.path.exists(status_path)
+    max_rss = None
+
+    try:
+        if sampled:
+            delays = exponential_interval(initial=0.01, maximum=interval)
+            # WNOWAIT leaves the process to be reaped by wait4 below
+            while not os.waitid(
+                os.P_PID, proc.pid, os.WEXITED | os.WNOHANG | os.WNOWAIT
+            ):
+                peak = _peak_rss(status_path)
+                if peak is not None:
+                    max_rss = max(max_rss or 0, peak)
+                time.sleep(next(delays))
+        _, status, rusage = os.wait4(proc.pid, 0)
+    except ChildProcessError:
+        return proc.wait(), None
+
+    if os.WIFSIGNALED(status):
+        proc.returncode = -os.WTERMSIG(status)
+    else:
+        proc.returncode = os.WEXITSTATUS(status)
+
+    if not sampled:
+        # ru_maxrss is in kilobytes, except on macOS
+        max_rss = rusage.ru_maxrss
+        if sys.platform != "darwin":
+            max_rss *= 1024
+
+    return (
+        proc.returncode,
+        {
+            "max_rss": max_rss,
+            "user_time": rusage.ru_utime,
+            "system_time": rusage.ru_stime,
+        },
+    )
+
+
 def subprocess_popen(
     args,
     bufsize=0,  # unbuffered (`io.DEFAULT_BUFFER_SIZE` for Python 3 by default)
@@ -2,6 +2,9 @@
 
 import collections
 
+# Default of ``TableEntry.as_columns``: raise for missing cells
+NO_PLACEHOLDER = object()
+
 
 def all_are(objs, *are_what):
     # type: (Iterable[Any], Type) -> bool
@@ -99,6 +102,59 @@ class TableEntry(object):
 
         return formatted_table
 
+    def as_columns(self, column_names=None, placeholder=NO_PLACEHOLDER):
+        """
+        Returns the table as columns, without building its rows when it is
+        a ``list`` of ``list``.
+
+        :param column_names: Columns to return, all of them by default.
+        :type column_names: ``list`` of ``str``
+        :param placeholder: Value of the cells missing from a row or of the
+            columns missing from the table, ``KeyError`` or ``IndexError``
+            is raised for them by default.
+        :type placeholder: ``object``
+        :return: the cells of each column by column name
+        :rtype: ``OrderedDict`` of ``list``
+        """
+        table = self.table
+        if not table:
+            return collections.OrderedDict(
+                (column, []) for column in column_names or []
+            )
+        if column_names is None:
+            column_names = list(self.column_names)
+
+        columns = collections.OrderedDict()
+        if isinstance(table[0], dict):
+            for column in column_names:
+                if placeholder is NO_PLACEHOLDER:
+                    columns[column] = [row[column] for row in table]
+                else:
+                    columns[column] = [
+                        row.get(column, placeholder) for row in table
+                    ]
+        else:
+            # else it must be ``list`` of ``list``
+            assert isinstance(table[0], (list, tuple))
+            indices = {}
+            for col_idx, column in enumerate(table[0]):
+                indices[column] = col_idx  # last one wins, as for dicts
+            rows = table[1:]
+            for column in column_names:
+                col_idx = indices.get(column)
+                if col_idx is None and placeholder is NO_PLACEHOLDER:
+                    raise KeyError(column)
+                elif col_idx is None:
+                    columns[column] = [placeholder] * len(rows)
+                elif placeholder is NO_PLACEHOLDER:
+                    columns[column] = [row[col_idx] for row in rows]
+                else:
+                    columns[column] = [
+                        row[col_idx] if col_idx < len(row) else placeholder
+                        for row in rows
+                    ]
+        return columns
+
     def as_list_of_dict(self, keep_column_order=False):
         """
         Returns the table as ``list`` of ``dict``
@@ -2,5 +2,7 @@ from .base import Exporter, save_attachments
 from .pdf import PDFExporter, TagFilteredPDFExporter
 from .xml import XMLExporter
 from .json import JSONExporter
+from .openmetrics import OpenMetricsExporter
+from .performance import PerformanceComparisonExporter
 from .http import HTTPExporter
 from .webserver import WebServerExporter
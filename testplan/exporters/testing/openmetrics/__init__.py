@@ -0,0 +1,450 @@
+"""
+OpenMetrics exporter for test run performance metrics, e.g. for the textfile
+collector of the Prometheus node exporter: durations of the run, of each test
+instance (binary) and of the slowest testcases, queue wait and utilization of
+the pools, report processing time, peak memory of test processes and the
+latency distributions (histograms) logged by the tests.
+
+The file is replaced atomically on each run, so collectors never read a
+partially written file.
+"""
+
+import datetime
+import os
+import sys
+import tempfile
+
+import pytz
+from schema import And
+
+from testplan.common.config import ConfigOption
+from testplan.common.exporters import ExporterConfig
+from testplan.common.utils import hdr
+from testplan.report import ReportCategories, TestCaseReport
+
+from ..base import Exporter
+
+try:
+    import resource
+except ImportError:  # Windows
+    resource = None
+
+EPOCH = datetime.datetime(1970, 1, 1, tzinfo=pytz.utc)
+
+# Scale of the histogram units to seconds.
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+# Quantiles of the histograms exported as summaries.
+QUANTILES = (0.5, 0.9, 0.99, 0.999)
+
+
+class MetricFamily(object):
+    """
+    Samples of a metric, with its type, unit and help text.
+
+    :param name: Metric name, ending with the unit if any.
+    :type name: ``str``
+    :param metric_type: OpenMetrics type, e.g. ``gauge`` or ``summary``.
+    :type metric_type: ``str``
+    :param help: Description of the metric.
+    :type help: ``str``
+    :param unit: Unit, e.g. ``seconds`` or ``bytes``.
+    :type unit: ``str``
+    """
+
+    def __init__(self, name, metric_type, help, unit=None):
+        self.name = name
+        self.type = metric_type
+        self.help = help
+        self.unit = unit
+        self.samples = []
+
+    def add(self, labels, value, suffix=""):
+        """
+        Add a sample.
+
+        :param labels: Label names and values.
+        :type labels: ``list`` of ``tuple``
+        :param value: Sample value, ``None`` values are skipped.
+        :type value: ``int`` or ``float``
+        :param suffix: Sample name suffix, e.g. ``_count`` for summaries.
+        :type suffix: ``str``
+        """
+        if value is not None:
+            self.samples.append((suffix, labels, value))
+
+    def format(self):
+        """Text exposition of the family, empty if it has no samples."""
+        if not self.samples:
+            return ""
+        lines = ["# TYPE {} {}".format(self.name, self.type)]
+        if self.unit:
+            lines.append("# UNIT {} {}".format(self.name, self.unit))
+        lines.append("# HELP {} {}".format(self.name, _escape(self.help)))
+        for suffix, labels, value in self.samples:
+            lines.append(
+                "{}{}{} {}".format(
+                    self.name,
+                    suffix,
+                    _format_labels(labels),
+                    _format_value(value),
+                )
+            )
+        return "\n".join(lines) + "\n"
+
+
+def _escape(value):
+    return (
+        str(value)
+        .replace("\\", "\\\\")
+        .replace("\n", "\\n")
+        .replace('"', '\\"')
+    )
+
+
+def _format_labels(labels):
+    if not labels:
+        return ""
+    return "{{{}}}".format(
+        ",".join(
+            '{}="{}"'.format(name, _escape(value)) for name, value in labels
+        )
+    )
+
+
+def _format_value(value):
+    if isinstance(value, bool):
+        return "1" if value else "0"
+    if isinstance(value, int):
+        return str(value)
+    return repr(float(value))
+
+
+def _elapsed(report, key="run"):
+    interval = report.timer.get(key)
+    return interval.elapsed if interval else None
+
+
+def _testcases(report, path=()):
+    """Testcase reports of a test instance, with the names of their groups."""
+    for entry in report:
+        if isinstance(entry, TestCaseReport):
+            yield path, entry
+        else:
+            for item in _testcases(entry, path + (entry.name,)):
+                yield item
+
+
+def _histograms(entries):
+    """Histogram entries of a testcase, including those of groups."""
+    for entry in entries:
+        if entry.get("type") == "Histogram":
+            yield entry
+        elif entry.get("type") == "Group":
+            for item in _histograms(entry.get("entries", [])):
+                yield item
+
+
+def collect_metrics(report, top_testcases=10, runner_usage=True):
+    """
+    Performance metrics of a test run.
+
+    :param report: Test run report.
+    :type report: :py:class:`~testplan.report.testing.base.TestReport`
+    :param top_testcases: Number of slowest testcases to export.
+    :type top_testcases: ``int``
+    :param runner_usage: Whether to export the peak memory of the current
+        process.
+    :type runner_usage: ``bool``
+    :return: Metric families.
+    :rtype: ``list`` of :py:class:`MetricFamily`
+    """
+    plan = [("plan", report.name)]
+
+    run_duration = MetricFamily(
+        "testplan_run_duration_seconds",
+        "gauge",
+        "Duration of the test run.",
+        "seconds",
+    )
+    run_passed = MetricFamily(
+        "testplan_run_passed", "gauge", "Whether the test run passed."
+    )
+    run_end = MetricFamily(
+        "testplan_run_end_timestamp_seconds",
+        "gauge",
+        "End time of the test run.",
+        "seconds",
+    )
+    processing = MetricFamily(
+        "testplan_report_processing_seconds",
+        "gauge",
+        "Time spent collecting and merging the test reports.",
+        "seconds",
+    )
+    runner_rss = MetricFamily(
+        "testplan_runner_peak_rss_bytes",
+        "gauge",
+        "Peak resident memory of the Testplan process, including the tests"
+        " run in it.",
+        "bytes",
+    )
+    test_duration = MetricFamily(
+        "testplan_test_duration_seconds",
+        "gauge",
+        "Duration of a test instance, e.g. a MultiTest or a test binary.",
+        "seconds",
+    )
+    queue_wait = MetricFamily(
+        "testplan_test_queue_wait_seconds",
+        "gauge",
+        "Time a test instance waited for a pool worker.",
+        "seconds",
+    )
+    test_processing = MetricFamily(
+        "testplan_test_report_processing_seconds",
+        "gauge",
+        "Time spent converting the output of a test binary into its report.",
+        "seconds",
+    )
+    test_rss = MetricFamily(
+        "testplan_test_peak_rss_bytes",
+        "gauge",
+        "Peak resident memory of a test process.",
+        "bytes",
+    )
+    test_cpu = MetricFamily(
+        "testplan_test_cpu_seconds",
+        "gauge",
+        "CPU time of a test process.",
+        "seconds",
+    )
+    testcase_duration = MetricFamily(
+        "testplan_testcase_duration_seconds",
+        "gauge",
+        "Duration of the slowest testcases.",
+        "seconds",
+    )
+    pool_size = MetricFamily(
+        "testplan_pool_workers", "gauge", "Number of workers of a pool."
+    )
+    pool_tasks = MetricFamily(
+        "testplan_pool_tasks", "gauge", "Number of tasks executed by a pool."
+    )
+    pool_busy = MetricFamily(
+        "testplan_pool_busy_seconds",
+        "gauge",
+        "Time spent by the workers of a pool on tasks.",
+        "seconds",
+    )
+    pool_utilization = MetricFamily(
+        "testplan_pool_utilization_ratio",
+        "gauge",
+        "Fraction of the time of the workers of a pool spent on tasks.",
+        "ratio",
+    )
+    benchmark_seconds = MetricFamily(
+        "testplan_benchmark_seconds",
+        "summary",
+        "Latency distributions logged by the tests.",
+        "seconds",
+    )
+    benchmark = MetricFamily(
+        "testplan_benchmark",
+        "summary",
+        "Distributions of values other than durations logged by the tests.",
+    )
+
+    run_duration.add(plan, _elapsed(report))
+    run_passed.add(plan, report.passed)
+    run_interval = report.timer.get("run")
+    if run_interval and run_interval.end:
+        run_end.add(plan, (run_interval.end - EPOCH).total_seconds())
+    processing.add(plan, _elapsed(report, "process_results"))
+    if runner_usage and resource is not None:
+        max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        runner_rss.add(
+            plan, max_rss if sys.platform == "darwin" else max_rss * 1024
+        )
+
+    for name, stats in sorted(report.meta.get("executors", {}).items()):
+        labels = plan + [("pool", name)]
+        pool_size.add(labels, stats.get("size"))
+        pool_tasks.add(labels, stats.get("tasks"))
+        pool_busy.add(labels, stats.get("busy_time"))
+        pool_utilization.add(labels, stats.get("utilization"))
+
+    testcases = []
+    for test in report:
+        if test.category == ReportCategories.TASK_RERUN:
+            continue
+        labels = plan + [("test", test.name)]
+        test_duration.add(labels, _elapsed(test))
+        queue_wait.add(labels, _elapsed(test, "queue_wait"))
+        test_processing.add(labels, _elapsed(test, "process_results"))
+
+        usage = test.meta.get("resource_usage", {})
+        test_rss.add(labels, usage.get("max_rss"))
+        test_cpu.add(labels + [("mode", "user")], usage.get("user_time"))
+        test_cpu.add(labels + [("mode", "system")], usage.get("system_time"))
+
+        for path, testcase in _testcases(test):
+            case_labels = labels + [
+                ("suite", "/".join(path)),
+                ("testcase", testcase.name),
+            ]
+            duration = _elapsed(testcase)
+            if duration is not None:
+                testcases.append((duration, case_labels))
+
+            descriptions = {}
+            for entry in _histograms(testcase.entries):
+                description = entry.get("description") or "histogram"
+                descriptions[description] = (
+                    descriptions.get(description, 0) + 1
+                )
+                if descriptions[description] > 1:
+                    description = "{} #{}".format(
+                        description, descriptions[description]
+                    )
+                _add_histogram(
+                    benchmark_seconds,
+                    benchmark,
+                    case_labels + [("benchmark", description)],
+                    entry,
+                )
+
+    testcases.sort(key=lambda item: item[0], reverse=True)
+    for duration, labels in testcases[:top_testcases]:
+        testcase_duration.add(labels, duration)
+
+    return [
+        run_duration,
+        run_passed,
+        run_end,
+        processing,
+        runner_rss,
+        test_duration,
+        queue_wait,
+        test_processing,
+        test_rss,
+        test_cpu,
+        testcase_duration,
+        pool_size,
+        pool_tasks,
+        pool_busy,
+        pool_utilization,
+        benchmark_seconds,
+        benchmark,
+    ]
+
+
+def _add_histogram(seconds_family, family, labels, entry):
+    """Add a histogram entry as summary samples."""
+    histogram = hdr.HDRHistogram.decode(entry["histogram"])
+    if not histogram.total:
+        return
+
+    scale = TIME_UNITS.get(histogram.unit)
+    if scale is None:
+        scale = 1
+        labels = labels + [("unit", histogram.unit)]
+    else:
+        family = seconds_family
+
+    for quantile in QUANTILES:
+        family.add(
+            labels + [("quantile", repr(quantile))],
+            histogram.value_at_percentile(quantile * 100) * scale,
+        )
+    family.add(labels, histogram.total, suffix="_count")
+    family.add(labels, histogram.sum * scale, suffix="_sum")
+
+
+def format_metrics(families):
+    """
+    OpenMetrics text exposition of metric families.
+
+    :param families: Metric families.
+    :type families: ``list`` of :py:class:`MetricFamily`
+    :rtype: ``str``
+    """
+    return "".join(family.format() for family in families) + "# EOF\n"
+
+
+def write_atomically(path, content):
+    """
+    Write a file next to the target, sync it and rename it over the target.
+    The temporary name does not keep the extension, so that it is ignored by
+    collectors reading ``*.prom`` files.
+
+    :param path: Target file path.
+    :type path: ``str``
+    :param content: File content.
+    :type content: ``str``
+    """
+    directory = os.path.dirname(os.path.abspath(path))
+    if not os.path.exists(directory):
+        os.makedirs(directory)
+    fd, tmp_path = tempfile.mkstemp(
+        dir=directory, prefix=os.path.basename(path) + ".tmp."
+    )
+    try:
+        with os.fdopen(fd, "w") as tmp_file:
+            tmp_file.write(content)
+            tmp_file.flush()
+            os.fsync(tmp_file.fileno())
+        # mkstemp creates files only readable by their owner
+        os.chmod(tmp_path, 0o644)
+        os.replace(tmp_path, path)
+    except BaseException:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+        raise
+
+
+class OpenMetricsExporterConfig(ExporterConfig):
+    """
+    Configuration object for
+    :py:class:`OpenMetricsExporter
+    <testplan.exporters.testing.openmetrics.OpenMetricsExporter>` object.
+    """
+
+    @classmethod
+    def get_options(cls):
+        return {
+            ConfigOption("openmetrics_path"): str,
+            ConfigOption("top_testcases", default=10): And(
+                int, lambda n: n >= 0
+            ),
+        }
+
+
+class OpenMetricsExporter(Exporter):
+    """
+    OpenMetrics Exporter.
+
+    :param openmetrics_path: File path for saving the metrics, with a
+        ``.prom`` extension for the node exporter textfile collector.
+    :type openmetrics_path: ``str``
+    :param top_testcases: Number of slowest testcases to export the
+        duration of.
+    :type top_testcases: ``int``
+
+    Also inherits all
+    :py:class:`~testplan.exporters.testing.base.Exporter` options.
+    """
+
+    CONFIG = OpenMetricsExporterConfig
+
+    def __init__(self, name="OpenMetrics exporter", **options):
+        super(OpenMetricsExporter, self).__init__(name=name, **options)
+
+    def export(self, source):
+        openmetrics_path = self.cfg.openmetrics_path
+        families = collect_metrics(source, self.cfg.top_testcases)
+        write_atomically(openmetrics_path, format_metrics(families))
+        self.logger.exporter_info(
+            "OpenMetrics generated at %s", openmetrics_path
+        )
+        return openmetrics_path
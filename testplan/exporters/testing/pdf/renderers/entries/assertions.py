@@ -548,6 +548,100 @@ class DictMatchAllRenderer(AssertionRenderer):
         return first
 
 
+@registry.bind(assertions.DictMatchBulk, assertions.FixMatchBulk)
+class DictMatchBulkRenderer(AssertionRenderer):
+    """FixMatchBulk renderer for serialized assertion entries."""
+
+    def get_detail(self, source, depth, row_idx):
+        label = source["key_label"]
+        data = []
+
+        def add_text(text, passed=True, bold=False, offset=0):
+            styles = [
+                RowStyle(
+                    font=(
+                        const.FONT_BOLD if bold else const.FONT,
+                        const.FONT_SIZE_SMALL,
+                    ),
+                    text_color=colors.black if passed else colors.red,
+                    left_padding=const.INDENT * (depth + offset + 1),
+                    span=tuple(),
+                )
+            ]
+            data.append(
+                RowData(
+                    content=[text, "", "", ""],
+                    style=styles,
+                    start=row_idx + len(data),
+                )
+            )
+
+        for template in source["templates"]:
+            failed = template["total"] - template["passed"]
+            add_text(
+                "Template {}: {} of {} passed".format(
+                    template["name"], template["passed"], template["total"]
+                ),
+                passed=not failed,
+                bold=True,
+            )
+            if template["mismatches"]:
+                add_text(
+                    "Mismatched {}s: {}".format(
+                        label,
+                        ", ".join(
+                            "{} ({})".format(key, count)
+                            for key, count in template["mismatches"]
+                        ),
+                    )
+                )
+            for group in template["failures"]:
+                add_text(
+                    "{}s: {} - (Displaying {} of {} failures)".format(
+                        label.title(),
+                        ", ".join(map(str, group["keys"])),
+                        len(group["samples"]),
+                        group["total"],
+                    )
+                )
+                for sample in group["samples"]:
+                    add_text("Value #{}".format(sample["index"]), offset=1)
+                    for row in sample["comparison"]:
+                        append_comparison_data(
+                            data, row, depth + 1, row_idx + len(data)
+                        )
+            if template["other_failures"]:
+                add_text(
+                    "Other {} combinations: {} failures".format(
+                        label, template["other_failures"]
+                    )
+                )
+
+        unmatched = source["unmatched"]
+        if unmatched["total"]:
+            add_text(
+                "No template: {} values, e.g. {}".format(
+                    unmatched["total"],
+                    ", ".join(
+                        "#{} ({})".format(sample["index"], sample["name"])
+                        for sample in unmatched["samples"]
+                    ),
+                ),
+                passed=False,
+                bold=True,
+            )
+
+        if not data:
+            return None
+
+        first, rest = data[0], data[1:]
+
+        for d in rest:
+            first += d
+
+        return first
+
+
 @registry.bind(assertions.XMLCheck)
 class XMLCheckRenderer(AssertionRenderer):
     """XMLCheck renderer for serialized assertion entries."""
@@ -737,7 +831,8 @@ class TableMatchRenderer(AssertionRenderer):
                 table=raw_table,
                 columns=source["columns"],
                 row_indices=row_indices,
-                display_index=source["report_fails_only"],
+                display_index=source["report_fails_only"]
+                or bool(source.get("report_pass_limit")),
                 max_width=max_width,
                 style=table_style,
                 colour_matrix=colour_matrix,
@@ -15,7 +15,12 @@ from testplan.testing.multitest.entries import base
 
 from .. import constants
 from ..base import BaseRowRenderer, RowData
-from .baseUtils import get_matlib_plot, export_plot_to_image, format_image
+from .baseUtils import (
+    get_matlib_plot,
+    export_plot_to_image,
+    format_image,
+    plot_percentiles,
+)
 
 
 class SerializedEntryRegistry(Registry):
@@ -291,3 +296,51 @@ class GraphRenderer(SerializedEntryRenderer):
         return header + RowData(
             content=[image, "", "", ""], start=header.end, style=styles
         )
+
+
+@registry.bind(base.Histogram)
+class HistogramRenderer(SerializedEntryRenderer):
+    """Render a percentile distribution plot of a serialized histogram."""
+
+    def get_styles(self):
+        return [
+            RowStyle(
+                font=(constants.FONT, constants.FONT_SIZE_SMALL),
+                left_padding=20,
+                text_color=colors.black,
+            )
+        ]
+
+    def get_row_data(self, source, depth, row_idx):
+        header = self.get_header(source, depth, row_idx)
+
+        percentile_plot = plot_percentiles(source)
+        if percentile_plot is None:
+            return header + RowData(
+                content="(empty histogram)",
+                start=header.end,
+                style=self.get_styles(),
+            )
+
+        image = format_image(export_plot_to_image(percentile_plot))
+        percentile_plot.clf()
+        percentile_plot.cla()
+        percentile_plot.close()
+
+        summary = "count={}, min={}, mean={:.1f}, max={} ({})".format(
+            source["count"],
+            source["min"],
+            source["mean"],
+            source["max"],
+            source["unit"],
+        )
+        row_data = header + RowData(
+            content=[summary, "", "", ""],
+            start=header.end,
+            style=self.get_styles(),
+        )
+        return row_data + RowData(
+            content=[image, "", "", ""],
+            start=row_data.end,
+            style=self.get_styles(),
+        )
@@ -182,3 +182,39 @@ def plot_chart(source, graph_type):
             plot.pie(angles, labels=names)
 
     return plot
+
+
+def percentile_position(percentile):
+    """
+    X coordinate of a percentile on a percentile distribution plot, the
+    number of nines: 0 for p0, 1 for p90, 2 for p99...
+    """
+    return -np.log10(max(1.0 - percentile / 100.0, 1e-9))
+
+
+def plot_percentiles(source):
+    """
+    Create a MatPlot percentile distribution plot of a serialized histogram,
+    with a logarithmic percentile axis so that the tail is readable.
+    """
+    percentiles = [item["percentile"] for item in source["percentiles"]]
+    values = [item["value"] for item in source["percentiles"]]
+    if not values:
+        return None
+
+    positions = [percentile_position(percentile) for percentile in percentiles]
+    plot.step(positions, values, where="post")
+
+    ticks = [
+        tick
+        for tick in (0, 90, 99, 99.9, 99.99, 99.999, 99.9999)
+        if percentile_position(tick) <= positions[-1]
+    ]
+    plot.xticks(
+        [percentile_position(tick) for tick in ticks],
+        ["{:g}%".format(tick) for tick in ticks],
+    )
+    plot.xlabel("Percentile")
+    plot.ylabel(source["unit"])
+    plot.grid(True, alpha=0.3)
+    return plot
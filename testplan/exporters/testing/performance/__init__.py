@@ -0,0 +1,93 @@
+"""
+Performance comparison exporter: compares the durations, resource usage and
+benchmarks of the run with those of the JSON report of a previous run (see
+:py:mod:`testplan.report.testing.performance`), logs the largest changes and
+optionally saves the comparison as JSON.
+"""
+
+import json
+import os
+
+from schema import And, Or
+
+from testplan.common.config import ConfigOption
+from testplan.common.exporters import ExporterConfig
+from testplan.common.utils.path import makedirs
+from testplan.report.testing.performance import compare
+
+from ..base import Exporter
+
+
+class PerformanceComparisonExporterConfig(ExporterConfig):
+    """
+    Configuration object for
+    :py:class:`PerformanceComparisonExporter
+    <testplan.exporters.testing.performance.PerformanceComparisonExporter>`
+    object.
+    """
+
+    @classmethod
+    def get_options(cls):
+        return {
+            ConfigOption("performance_baseline"): str,
+            ConfigOption("comparison_path", default=None): Or(str, None),
+            ConfigOption("threshold", default=0.1): And(
+                Or(int, float), lambda n: n >= 0
+            ),
+            ConfigOption("top", default=20): And(int, lambda n: n >= 0),
+        }
+
+
+class PerformanceComparisonExporter(Exporter):
+    """
+    Performance Comparison Exporter.
+
+    :param performance_baseline: JSON report of a previous run, streamed so
+        that large reports are not loaded in memory.
+    :type performance_baseline: ``str``
+    :param comparison_path: File path for saving the comparison as JSON.
+    :type comparison_path: ``str``
+    :param threshold: Relative increase of a duration, resource usage or
+        benchmark percentile reported as a regression.
+    :type threshold: ``float``
+    :param top: Number of slowest testcases, and of logged changes of each
+        kind.
+    :type top: ``int``
+
+    Also inherits all
+    :py:class:`~testplan.exporters.testing.base.Exporter` options.
+    """
+
+    CONFIG = PerformanceComparisonExporterConfig
+
+    def __init__(self, name="Performance comparison exporter", **options):
+        super(PerformanceComparisonExporter, self).__init__(
+            name=name, **options
+        )
+
+    def export(self, source):
+        baseline = self.cfg.performance_baseline
+        if not os.path.exists(baseline):
+            self.logger.exporter_info(
+                "Skipping performance comparison, no baseline report at %s",
+                baseline,
+            )
+            return None
+
+        comparison = compare(
+            baseline, source, threshold=self.cfg.threshold, top=self.cfg.top
+        )
+        self.logger.exporter_info("%s", comparison.format())
+
+        if self.cfg.comparison_path:
+            makedirs(
+                os.path.dirname(os.path.abspath(self.cfg.comparison_path))
+            )
+            with open(self.cfg.comparison_path, "w") as json_file:
+                json.dump(comparison.to_dict(), json_file, indent=2)
+            self.logger.exporter_info(
+                "Performance comparison generated at %s",
+                self.cfg.comparison_path,
+            )
+            return self.cfg.comparison_path
+        return None
@@ -9,7 +9,7 @@ import sys
 from testplan.common.utils import logger
 from testplan import defaults
 from testplan.report.testing import styles, ReportTagsAction
-from testplan.testing import listing, filtering, ordering
+from testplan.testing import listing, filtering, ordering, sampling
 
 
 class HelpParser(argparse.ArgumentParser):
@@ -100,6 +100,16 @@ class TestplanParser(object):
             "processes, default to 14400s(4h), set to 0 to disable.",
         )
 
+        general_group.add_argument(
+            "--report-workers",
+            metavar="N",
+            default=self._default_options["report_workers"],
+            type=int,
+            help="Number of processes converting the output of local test "
+            "binaries into reports while the next tests run, default to 0 "
+            "(converted after each test).",
+        )
+
         general_group.add_argument(
             "-i",
             "--interactive",
@@ -179,6 +189,52 @@ Test filter, runs tests that match ALL of the given tags.
             "reproduce a particular order.",
         )
 
+        ordering_group.add_argument(
+            "--failure-history",
+            metavar="PATH",
+            nargs="+",
+            default=[],
+            help="JSON reports of earlier runs, the most recent first. Tests"
+            " that failed recently run first, then the fastest ones.",
+        )
+
+        sampling_group = parser.add_argument_group("Sampling")
+
+        sampling_group.add_argument(
+            "--sample",
+            metavar="FRACTION",
+            type=float,
+            default=None,
+            help="Only run a seeded stratified sample of this fraction of the"
+            " testcases of every suite of the test binaries (e.g. 0.05),"
+            " through their native filters.",
+        )
+
+        sampling_group.add_argument(
+            "--sample-seed",
+            metavar="SEED",
+            default="0",
+            help="Seed of the sample, the same seed selects the same"
+            " testcases.",
+        )
+
+        sampling_group.add_argument(
+            "--sample-failures",
+            metavar="PATH",
+            nargs="+",
+            default=[],
+            help="JSON reports of earlier runs, their failed testcases are"
+            " run in addition to the sample.",
+        )
+
+        sampling_group.add_argument(
+            "--verify-sample",
+            action="store_true",
+            default=False,
+            help="Run all testcases and report the failures the sample would"
+            " have missed.",
+        )
+
         report_group = parser.add_argument_group("Reporting")
 
         report_group.add_argument(
@@ -204,6 +260,34 @@ Test filter, runs tests that match ALL of the given tags.
             help="Path for JSON report.",
         )
 
+        report_group.add_argument(
+            "--openmetrics",
+            dest="openmetrics_path",
+            default=self._default_options["openmetrics_path"],
+            metavar="PATH",
+            help="Path for OpenMetrics text file of run performance metrics,"
+            " replaced atomically (e.g. for the node exporter textfile"
+            " collector).",
+        )
+
+        report_group.add_argument(
+            "--performance-baseline",
+            dest="performance_baseline",
+            default=self._default_options["performance_baseline"],
+            metavar="PATH",
+            help="JSON report of a previous run, to log the changes of the"
+            " test durations, resource usage and benchmarks of this run.",
+        )
+
+        report_group.add_argument(
+            "--report-journal",
+            dest="report_journal",
+            default=self._default_options["report_journal"],
+            metavar="PATH",
+            help="Path of the journal the report is appended to while the"
+            " plan runs, to recover the report of a crashed run.",
+        )
+
         report_group.add_argument(
             "--xml",
             dest="xml_dir",
@@ -275,6 +359,18 @@ Test filter, runs tests that match ALL of the given tags.
             "saved locally.".format(self._default_options["ui_port"]),
         )
 
+        report_group.add_argument(
+            "--monitor",
+            dest="monitor_port",
+            nargs="?",
+            default=self._default_options["monitor_port"],
+            const=defaults.WEB_SERVER_PORT,
+            type=int,
+            help="Start a web server to monitor the run live, streaming the "
+            "progress of the tests on each executor and worker. A port can "
+            "be specified, otherwise any free port is used.",
+        )
+
         report_group.add_argument(
             "--report-tags",
             nargs="+",
@@ -345,11 +441,22 @@ that match ALL of the given tags.
         if filter_args:
             args["test_filter"] = filter_args
 
-        # Cmdline supports shuffle ordering only for now
         if args.get("shuffle"):
             args["test_sorter"] = ordering.ShuffleSorter(
                 seed=args["shuffle_seed"], shuffle_type=args["shuffle"]
             )
+        elif args.get("failure_history"):
+            args["test_sorter"] = ordering.FailureHistorySorter(
+                history=args["failure_history"]
+            )
+
+        if args.get("sample"):
+            args["test_sample"] = sampling.Sample(
+                fraction=args["sample"],
+                seed=args["sample_seed"],
+                always_run=sampling.recent_failures(*args["sample_failures"]),
+                verify=args["verify_sample"],
+            )
 
         # Set stdout style and logging level options according to
         # verbose/debug parameters. Debug output should be a superset of
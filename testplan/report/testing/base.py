@@ -53,6 +53,7 @@ import itertools
 import traceback
 
 from collections import Counter
+from collections.abc import Mapping
 
 from testplan.common.report import (
     ExceptionLogger as ExceptionLoggerBase,
@@ -335,6 +336,7 @@ class BaseReportGroup(ReportGroup):
         super(BaseReportGroup, self).merge(report, strict=strict)
 
         self.timer.update(report.timer)
+        self.meta.update(report.meta)
         self.status_override = Status.precedent(
             [self.status_override, report.status_override],
             rule=Status.STATUS_PRECEDENCE,
@@ -379,7 +381,7 @@ class BaseReportGroup(ReportGroup):
 
         def _filter_func(obj):
             # Include all testcase entries, which are in dict form
-            if isinstance(obj, dict):
+            if isinstance(obj, Mapping):
                 return True
 
             tag_dict = tagging.validate_tag_value(tag_value)
@@ -0,0 +1,254 @@
+"""
+Append only journal of a test report, written while the plan runs so that
+the report of a long run survives a crash of the Testplan process and can be
+read before the run completes.
+
+The journal is a file of JSON records, one per line, flushed as they are
+written:
+
+* ``plan``: attributes of the test report, at the start and the end of the
+  run (``"complete": true``),
+* ``group``: a test instance, testsuite or parametrization group started,
+  without its children,
+* ``testcase``: a testcase completed, with its entries,
+* ``instance``: a test instance completed, with all of its children. It
+  replaces the records of the instance written before.
+
+Parents are given by their uids, testcases and groups of tests run in the
+process of the runner (e.g. MultiTest in the local runner) are journaled as
+they complete, other tests when their instance report is received.
+
+A JSON report can be created from a journal, e.g. of a crashed run:
+
+.. code-block:: bash
+
+    python -m testplan.report.testing.journal run.journal --json run.json
+"""
+
+import argparse
+import json
+import sys
+import threading
+
+from testplan.common.serialization.schemas import load_tree_data
+
+from .base import Status, TestGroupReport, TestReport
+from .schemas import (
+    ShallowTestGroupReportSchema,
+    TestCaseReportSchema,
+    TestGroupReportSchema,
+    TestReportSchema,
+)
+
+# Fields of the test report not written in plan records, as they are
+# computed from the entries.
+_PLAN_EXCLUDE = ("entries", "counter", "tags_index")
+
+
+class ReportJournal(object):
+    """
+    Journal of a test report, records are written by the threads of the
+    runner and the tests it runs.
+
+    :param path: Path of the journal, truncated when opened.
+    :type path: ``str``
+    """
+
+    def __init__(self, path):
+        self.path = path
+        self._file = None
+        self._lock = threading.Lock()
+
+    @property
+    def closed(self):
+        """The journal is not open."""
+        return self._file is None
+
+    def open(self, report):
+        """
+        Create the journal of a test report.
+
+        :param report: Test report of the run.
+        :type report: :py:class:`TestReport <testplan.report.TestReport>`
+        """
+        with self._lock:
+            self._file = open(self.path, "w")
+        self._write_plan(report, complete=False)
+
+    def close(self, report):
+        """
+        Record the final attributes of the test report and close the
+        journal.
+
+        :param report: Test report of the run.
+        :type report: :py:class:`TestReport <testplan.report.TestReport>`
+        """
+        self._write_plan(report, complete=True)
+        with self._lock:
+            if self._file is not None:
+                self._file.close()
+                self._file = None
+
+    def group(self, report, parent_uids):
+        """
+        Record a started test instance, testsuite or parametrization group.
+
+        :param report: Report of the group, its children are not recorded.
+        :type report: :py:class:`TestGroupReport
+            <testplan.report.TestGroupReport>`
+        :param parent_uids: Uids of the parents of the group below the test
+            report.
+        :type parent_uids: ``list`` of ``str``
+        """
+        data = ShallowTestGroupReportSchema(strict=True).dump(report).data
+        self._write(
+            {"record": "group", "parent_uids": parent_uids, "data": data}
+        )
+
+    def testcase(self, report, parent_uids):
+        """
+        Record a completed testcase.
+
+        :param report: Report of the testcase.
+        :type report: :py:class:`TestCaseReport
+            <testplan.report.TestCaseReport>`
+        :param parent_uids: Uids of the parents of the testcase below the test
+            report.
+        :type parent_uids: ``list`` of ``str``
+        """
+        data = TestCaseReportSchema(strict=True).dump(report).data
+        self._write(
+            {"record": "testcase", "parent_uids": parent_uids, "data": data}
+        )
+
+    def instance(self, report):
+        """
+        Record a completed test instance, e.g. a MultiTest or a GTest.
+
+        :param report: Report of the test instance.
+        :type report: :py:class:`TestGroupReport
+            <testplan.report.TestGroupReport>`
+        """
+        data = TestGroupReportSchema(strict=True).dump(report).data
+        self._write({"record": "instance", "data": data})
+
+    def _write_plan(self, report, complete):
+        schema = TestReportSchema(strict=True, exclude=_PLAN_EXCLUDE)
+        data = schema.dump(report).data
+        self._write({"record": "plan", "complete": complete, "data": data})
+
+    def _write(self, record):
+        line = json.dumps(record) + "\n"
+        with self._lock:
+            if self._file is None:
+                return
+            self._file.write(line)
+            self._file.flush()
+
+
+def load_journal(path):
+    """
+    Test report of a journal, as much of it as was written. Test instances
+    not completed when the journal was last written have their status
+    overridden as incomplete, as has the test report if the run did not
+    complete.
+
+    :param path: Path of the journal.
+    :type path: ``str``
+    :return: Test report.
+    :rtype: :py:class:`TestReport <testplan.report.TestReport>`
+    """
+    report = TestReport(name=path)
+    complete = False
+    completed = set()
+
+    with open(path) as journal:
+        for line in journal:
+            try:
+                record = json.loads(line)
+            except ValueError:
+                break  # Last record, cut short by a crash
+
+            kind = record["record"]
+            data = record["data"]
+            if kind == "plan":
+                data["entries"] = []
+                plan = TestReportSchema(strict=True).load(data).data
+                plan.entries, plan._index = report.entries, report._index
+                report, complete = plan, record["complete"]
+            elif kind == "instance":
+                instance = load_tree_data(
+                    data,
+                    node_schema=TestGroupReportSchema,
+                    leaf_schema=TestCaseReportSchema,
+                )
+                instance.build_index(recursive=True)
+                report.set_by_uid(instance.uid, instance)
+                completed.add(instance.uid)
+            else:
+                parent = _get_parent(report, record["parent_uids"])
+                if kind == "group":
+                    loaded = (
+                        ShallowTestGroupReportSchema(strict=True)
+                        .load(data)
+                        .data
+                    )
+                    if loaded.uid in parent.entry_uids:
+                        continue  # Already recorded, keep its children
+                else:
+                    loaded = TestCaseReportSchema(strict=True).load(data).data
+                parent.set_by_uid(loaded.uid, loaded)
+
+    for instance in report:
+        if instance.uid not in completed:
+            instance.status_override = Status.INCOMPLETE
+    if not complete:
+        report.status_override = Status.INCOMPLETE
+    report.propagate_tag_indices()
+    return report
+
+
+def _get_parent(report, parent_uids):
+    """Parent of a record, with a placeholder for those not recorded."""
+    parent = report
+    for uid in parent_uids:
+        try:
+            parent = parent.get_by_uid(uid)
+        except KeyError:
+            group = TestGroupReport(name=uid, uid=uid)
+            parent.append(group)
+            parent = group
+    return parent
+
+
+def main(argv=None):
+    """
+    Create a JSON report from a report journal.
+
+    :param argv: Command line arguments.
+    :type argv: ``list`` of ``str``
+    :rtype: ``int``
+    """
+    from testplan.exporters.testing import JSONExporter
+
+    parser = argparse.ArgumentParser(
+        description="Create a JSON report from a Testplan report journal."
+    )
+    parser.add_argument("journal", help="Report journal.")
+    parser.add_argument(
+        "--json", dest="json_path", required=True, help="JSON report path."
+    )
+    args = parser.parse_args(argv)
+
+    report = load_journal(args.journal)
+    JSONExporter(json_path=args.json_path).export(report)
+    print(
+        "{}: {} test instances, status {}".format(
+            args.json_path, len(report), report.status
+        )
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,732 @@
+"""
+Run over run performance comparison of test reports, e.g. of yesterday's and
+today's run of a C++ suite: changes of the durations of the test instances
+and testcases, testcases new among the slowest, resource usage deltas and
+benchmark (histogram) regressions.
+
+Testcase durations are their ``run`` timers, taken from the ``time``
+attributes of the GTest XML output, the ``testplan/cppunit_listener.h``
+timings of Cppunit tests and the durations reported by HobbesTest. Test
+instance durations, queue waits and resource usage are recorded by the
+runner.
+
+JSON reports are streamed (see :py:mod:`testplan.common.utils.jsonstream`),
+only the timers, resource usage and histograms are kept in memory:
+
+.. code-block:: bash
+
+    python -m testplan.report.testing.performance baseline.json current.json
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from testplan.common.utils import hdr
+from testplan.common.utils.jsonstream import JSONStreamReader
+from testplan.defaults import ATTACHMENTS
+
+from .base import ReportCategories, Status, TestCaseReport
+from .schemas import TimerField
+
+# Scale of the histogram units to seconds.
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+PERCENTILES = (("p50", 50), ("p90", 90), ("p99", 99), ("p99.9", 99.9))
+
+RESOURCES = ("max_rss", "user_time", "system_time")
+
+# Fields of the report nodes and assertions kept when streaming JSON reports.
+ENTRY_FIELDS = (
+    "name",
+    "uid",
+    "category",
+    "type",
+    "status",
+    "meta",
+    "description",
+    "histogram",
+)
+
+
+def _elapsed(timer, key="run"):
+    interval = timer.get(key) if timer else None
+    return interval.elapsed if interval else None
+
+
+def _benchmark(entry):
+    """Statistics of a histogram entry, in seconds for time units."""
+    histogram = hdr.HDRHistogram.decode(entry["histogram"])
+    if not histogram.total:
+        return None
+    scale = TIME_UNITS.get(histogram.unit)
+    unit = histogram.unit if scale is None else "s"
+    scale = scale or 1
+    result = {
+        "unit": unit,
+        "count": histogram.total,
+        "mean": histogram.mean * scale,
+    }
+    for name, percentile in PERCENTILES:
+        result[name] = histogram.value_at_percentile(percentile) * scale
+    return result
+
+
+def _histograms(entries):
+    """Histogram entries of a testcase, including those of groups."""
+    for entry in entries:
+        if entry.get("type") == "Histogram":
+            yield entry
+        elif entry.get("type") == "Group":
+            for item in _histograms(entry.get("entries", [])):
+                yield item
+
+
+class PerformanceSummary(object):
+    """
+    Durations, resource usage and benchmarks of a test run.
+
+    :param name: Name of the test plan.
+    :type name: ``str``
+    """
+
+    def __init__(self, name=None):
+        self.name = name
+        self.run = {}
+        self.executors = {}
+        # {instance: {"duration": ..., "queue_wait": ..., "max_rss": ...}}
+        self.instances = {}
+        # {(instance, suite path, testcase): duration}
+        self.testcases = {}
+        # {(instance, suite path, testcase)} failed or in error
+        self.failed = set()
+        # {(instance, suite path, testcase, benchmark): statistics}
+        self.benchmarks = {}
+
+    def __repr__(self):
+        return "{}(name={!r}, instances={}, testcases={})".format(
+            self.__class__.__name__,
+            self.name,
+            len(self.instances),
+            len(self.testcases),
+        )
+
+    @classmethod
+    def load(cls, source):
+        """
+        Summary of a report object or of a JSON report file.
+
+        :param source: Report or JSON report path.
+        :type source: :py:class:`~testplan.report.testing.base.TestReport`
+            or ``str``
+        :rtype: :py:class:`PerformanceSummary`
+        """
+        if isinstance(source, str):
+            return cls.from_json(source)
+        return cls.from_report(source)
+
+    @classmethod
+    def from_report(cls, report):
+        """
+        Summary of a report object.
+
+        :param report: Test run report.
+        :type report: :py:class:`~testplan.report.testing.base.TestReport`
+        :rtype: :py:class:`PerformanceSummary`
+        """
+        summary = cls(report.name)
+        summary._add_run(report.timer, report.meta)
+        for test in report:
+            summary._add_test(_ReportNode(test))
+        return summary
+
+    @classmethod
+    def from_json(cls, path):
+        """
+        Summary of a JSON report, streamed from the file. Reports split into
+        structure and assertions files (``split_json_report``) are read from
+        their attachments.
+
+        :param path: JSON report path.
+        :type path: ``str``
+        :rtype: :py:class:`PerformanceSummary`
+        """
+        summary = cls()
+        timer, meta, tests, attached = None, {}, [], {}
+        with open(path) as report_file:
+            reader = JSONStreamReader(report_file)
+            for key in reader.iter_object():
+                if key == "name":
+                    summary.name = reader.read_value()
+                elif key == "timer":
+                    timer = TimerField().deserialize(reader.read_value())
+                elif key == "meta":
+                    meta = reader.read_value()
+                elif key in (
+                    "attachments",
+                    "structure_file",
+                    "assertions_file",
+                ):
+                    attached[key] = reader.read_value()
+                elif key == "entries":
+                    tests = [_read_entry(reader) for _ in reader.iter_array()]
+                else:
+                    reader.skip_value()
+
+        if "structure_file" in attached:
+            tests = _read_split_report(path, attached)
+
+        summary._add_run(timer, meta)
+        for test in tests:
+            if isinstance(test, _JSONNode):
+                summary._add_test(test)
+        return summary
+
+    def _add_run(self, timer, meta):
+        self.run = {
+            "duration": _elapsed(timer),
+            "process_results": _elapsed(timer, "process_results"),
+        }
+        self.executors = dict(meta.get("executors", {}))
+
+    def _add_test(self, test):
+        if test.category == ReportCategories.TASK_RERUN:
+            return
+        usage = test.meta.get("resource_usage") or {}
+        instance = {
+            "duration": _elapsed(test.timer),
+            "queue_wait": _elapsed(test.timer, "queue_wait"),
+            "process_results": _elapsed(test.timer, "process_results"),
+        }
+        for name in RESOURCES:
+            instance[name] = usage.get(name)
+        self.instances[test.name] = instance
+
+        for path, testcase in test.testcases():
+            key = (test.name, "/".join(path), testcase.name)
+            if Status.STATUS_CATEGORY.get(testcase.status) in (
+                Status.ERROR,
+                Status.FAILED,
+            ):
+                self.failed.add(key)
+            duration = _elapsed(testcase.timer)
+            if duration is not None:
+                self.testcases[key] = duration
+
+            descriptions = {}
+            for entry in testcase.histograms():
+                description = entry.get("description") or "histogram"
+                descriptions[description] = (
+                    descriptions.get(description, 0) + 1
+                )
+                if descriptions[description] > 1:
+                    description = "{} #{}".format(
+                        description, descriptions[description]
+                    )
+                benchmark = _benchmark(entry)
+                if benchmark is not None:
+                    self.benchmarks[key + (description,)] = benchmark
+
+    def slowest(self, top):
+        """
+        Keys of the slowest testcases.
+
+        :param top: Number of testcases.
+        :type top: ``int``
+        :rtype: ``list`` of ``tuple``
+        """
+        return sorted(
+            self.testcases, key=lambda key: self.testcases[key], reverse=True
+        )[:top]
+
+
+class _ReportNode(object):
+    """Report object view used to summarize reports and JSON alike."""
+
+    def __init__(self, report):
+        self._report = report
+        self.name = report.name
+        self.category = report.category
+        self.status = report.status
+        self.timer = report.timer
+        self.meta = getattr(report, "meta", {})
+
+    def testcases(self, path=()):
+        for entry in self._report:
+            if isinstance(entry, TestCaseReport):
+                yield path, _ReportNode(entry)
+            else:
+                for item in _ReportNode(entry).testcases(path + (entry.name,)):
+                    yield item
+
+    def histograms(self):
+        return _histograms(self._report.entries)
+
+
+class _JSONNode(object):
+    """Fields of a report node read from JSON, without its assertions."""
+
+    def __init__(self, fields, timer, entries, histograms):
+        self.name = fields.get("name")
+        self.uid = fields.get("uid")
+        self.category = fields.get("category")
+        self.status = fields.get("status")
+        self.is_testcase = fields.get("type") == "TestCaseReport"
+        self.meta = fields.get("meta") or {}
+        self.timer = timer
+        self.entries = entries
+        self._histograms = histograms
+
+    def testcases(self, path=()):
+        for entry in self.entries:
+            if entry.is_testcase:
+                yield path, entry
+            else:
+                for item in entry.testcases(path + (entry.name,)):
+                    yield item
+
+    def histograms(self):
+        return self._histograms
+
+    def set_histograms(self, histograms):
+        self._histograms = list(histograms)
+
+
+def _is_testcase(fields):
+    return (
+        fields.get("type") == "TestCaseReport"
+        or fields.get("category") == ReportCategories.TESTCASE
+    )
+
+
+def _read_assertions(reader):
+    """
+    Histograms, and groups containing them, of the assertions of a testcase.
+    Assertions are only decoded if they contain a histogram.
+    """
+    assertions = []
+    for _ in reader.iter_array():
+        text = reader.read_raw()
+        if '"Histogram"' in text:
+            assertions.append(json.loads(text))
+    return assertions
+
+
+def _read_entry(reader):
+    """
+    Read a report node, keeping its timers and meta data, or an assertion,
+    keeping only histograms and the groups containing them.
+    """
+    if reader.peek() != "{":
+        reader.skip_value()
+        return None
+    fields, timer, children = {}, None, []
+    for key in reader.iter_object():
+        if key in ENTRY_FIELDS:
+            fields[key] = reader.read_value()
+        elif key == "timer":
+            timer = TimerField().deserialize(reader.read_value())
+        elif key == "entries":
+            if _is_testcase(fields):
+                children = _read_assertions(reader)
+            else:
+                # Report nodes, or assertions if the type is not known yet
+                children = [_read_entry(reader) for _ in reader.iter_array()]
+        else:
+            reader.skip_value()
+
+    entry_type = fields.get("type")
+    if entry_type in ("TestGroupReport", "TestCaseReport"):
+        if entry_type == "TestCaseReport":
+            histograms = list(_histograms(item for item in children if item))
+            return _JSONNode(fields, timer, [], histograms)
+        entries = [item for item in children if isinstance(item, _JSONNode)]
+        return _JSONNode(fields, timer, entries, [])
+    if entry_type == "Histogram":
+        return fields
+    if entry_type == "Group":
+        fields["entries"] = [item for item in children if item]
+        return fields
+    return None
+
+
+def _attachment_path(path, attached, key):
+    """Path of a split report file, moved along with the report or not."""
+    filename = attached[key]
+    local = os.path.join(os.path.dirname(path), ATTACHMENTS, filename)
+    if os.path.exists(local):
+        return local
+    return attached.get("attachments", {}).get(filename, local)
+
+
+def _read_split_report(path, attached):
+    """Test nodes of a split JSON report, with the testcase histograms."""
+    with open(_attachment_path(path, attached, "structure_file")) as fobj:
+        reader = JSONStreamReader(fobj)
+        tests = [_read_entry(reader) for _ in reader.iter_array()]
+
+    testcases = {}
+    for test in tests:
+        if isinstance(test, _JSONNode):
+            for _, testcase in test.testcases():
+                testcases[testcase.uid] = testcase
+
+    with open(_attachment_path(path, attached, "assertions_file")) as fobj:
+        reader = JSONStreamReader(fobj)
+        for uid in reader.iter_object():
+            if uid not in testcases:
+                reader.skip_value()
+                continue
+            testcases[uid].set_histograms(
+                _histograms(_read_assertions(reader))
+            )
+    return tests
+
+
+def _change(baseline, current):
+    """Absolute and relative change, ``None`` if a value is missing."""
+    if baseline is None or current is None:
+        return None, None
+    delta = current - baseline
+    if baseline:
+        return delta, float(delta) / baseline
+    return delta, None
+
+
+class Change(object):
+    """
+    Change of a value between two runs.
+
+    :param key: Name of the changed value, e.g. a testcase key.
+    :type key: ``tuple``
+    :param baseline: Baseline value.
+    :type baseline: ``float``
+    :param current: Current value.
+    :type current: ``float``
+    :param unit: Unit of the values.
+    :type unit: ``str``
+    """
+
+    def __init__(self, key, baseline, current, unit="s"):
+        self.key = key
+        self.baseline = baseline
+        self.current = current
+        self.unit = unit
+        self.delta, self.ratio = _change(baseline, current)
+
+    def __repr__(self):
+        return "{}({!r}, {!r}, {!r})".format(
+            self.__class__.__name__, self.key, self.baseline, self.current
+        )
+
+    def exceeds(self, threshold):
+        """Whether the value increased by more than a relative threshold."""
+        return self.ratio is not None and self.ratio > threshold
+
+    def to_dict(self):
+        return {
+            "key": list(self.key),
+            "baseline": self.baseline,
+            "current": self.current,
+            "unit": self.unit,
+            "delta": self.delta,
+            "ratio": self.ratio,
+        }
+
+
+def _ranked(changes):
+    """Changes by decreasing absolute delta, unchanged values dropped."""
+    return sorted(
+        (change for change in changes if change.delta),
+        key=lambda change: abs(change.delta),
+        reverse=True,
+    )
+
+
+class PerformanceComparison(object):
+    """
+    Ranked differences between the performance summaries of two runs.
+
+    :param baseline: Summary of the baseline run.
+    :type baseline: :py:class:`PerformanceSummary`
+    :param current: Summary of the current run.
+    :type current: :py:class:`PerformanceSummary`
+    :param threshold: Relative increase above which a duration, resource
+        usage or benchmark percentile is a regression, e.g. ``0.1`` for 10%.
+    :type threshold: ``float``
+    :param top: Number of slowest testcases, and of changes listed by
+        :py:meth:`format`.
+    :type top: ``int``
+    """
+
+    def __init__(self, baseline, current, threshold=0.1, top=20):
+        self.baseline = baseline
+        self.current = current
+        self.threshold = threshold
+        self.top = top
+
+        self.run = [
+            Change((name,), baseline.run.get(name), current.run.get(name))
+            for name in ("duration", "process_results")
+        ]
+        self.instances = _ranked(
+            Change(
+                (name, "duration"),
+                values.get("duration"),
+                current_values.get("duration"),
+            )
+            for name, values, current_values in self._common(
+                baseline.instances, current.instances
+            )
+        )
+        self.testcases = _ranked(
+            Change(key, duration, current.testcases[key])
+            for key, duration in baseline.testcases.items()
+            if key in current.testcases
+        )
+        self.resources = _ranked(
+            Change(
+                (name, resource),
+                values.get(resource),
+                current_values.get(resource),
+                "B" if resource == "max_rss" else "s",
+            )
+            for name, values, current_values in self._common(
+                baseline.instances, current.instances
+            )
+            for resource in ("queue_wait", "process_results") + RESOURCES
+        )
+        self.benchmarks = _ranked(
+            Change(
+                key + (percentile,),
+                stats[percentile],
+                current_stats[percentile],
+                stats["unit"],
+            )
+            for key, stats, current_stats in self._common(
+                baseline.benchmarks, current.benchmarks
+            )
+            if stats["unit"] == current_stats["unit"]
+            for percentile, _ in PERCENTILES
+        )
+
+        baseline_slowest = set(baseline.slowest(top))
+        self.new_slowest = [
+            (key, current.testcases[key], baseline.testcases.get(key))
+            for key in current.slowest(top)
+            if key not in baseline_slowest
+        ]
+        self.added = sorted(set(current.testcases) - set(baseline.testcases))
+        self.removed = sorted(set(baseline.testcases) - set(current.testcases))
+
+    @staticmethod
+    def _common(baseline, current):
+        for key, values in baseline.items():
+            if key in current:
+                yield key, values, current[key]
+
+    @property
+    def regressions(self):
+        """
+        Changes above the threshold, of the testcase and instance durations,
+        of the resource usage and of the benchmark percentiles.
+
+        :rtype: ``list`` of :py:class:`Change`
+        """
+        return [
+            change
+            for changes in (
+                self.instances,
+                self.testcases,
+                self.resources,
+                self.benchmarks,
+            )
+            for change in changes
+            if change.exceeds(self.threshold)
+        ]
+
+    def to_dict(self):
+        """
+        JSON compatible form of the comparison.
+
+        :rtype: ``dict``
+        """
+        return {
+            "baseline": self.baseline.name,
+            "current": self.current.name,
+            "threshold": self.threshold,
+            "run": [change.to_dict() for change in self.run],
+            "instances": [change.to_dict() for change in self.instances],
+            "testcases": [change.to_dict() for change in self.testcases],
+            "resources": [change.to_dict() for change in self.resources],
+            "benchmarks": [change.to_dict() for change in self.benchmarks],
+            "new_slowest": [
+                {"key": list(key), "current": duration, "baseline": previous}
+                for key, duration, previous in self.new_slowest
+            ],
+            "added": [list(key) for key in self.added],
+            "removed": [list(key) for key in self.removed],
+            "regressions": len(self.regressions),
+        }
+
+    def format(self):
+        """
+        Text report of the comparison, listing the largest changes first.
+
+        :rtype: ``str``
+        """
+        lines = [
+            "Performance comparison of {!r} against {!r}"
+            " (regression threshold {:.0%})".format(
+                self.current.name, self.baseline.name, self.threshold
+            )
+        ]
+        for change in self.run:
+            if change.delta is not None:
+                lines.append(
+                    "  Run {}: {}".format(
+                        change.key[0], _format_change(change)
+                    )
+                )
+
+        sections = (
+            ("Test instance durations", self.instances),
+            ("Testcase durations", self.testcases),
+            ("Resource usage", self.resources),
+            ("Benchmarks", self.benchmarks),
+        )
+        for title, changes in sections:
+            if not changes:
+                continue
+            lines.append("{} ({} changed):".format(title, len(changes)))
+            for change in changes[: self.top]:
+                lines.append(
+                    "  {}{}: {}".format(
+                        "! " if change.exceeds(self.threshold) else "",
+                        " / ".join(str(part) for part in change.key if part),
+                        _format_change(change),
+                    )
+                )
+
+        if self.new_slowest:
+            lines.append(
+                "New among the {} slowest testcases:".format(self.top)
+            )
+            for key, duration, previous in self.new_slowest:
+                lines.append(
+                    "  {}: {} (was {})".format(
+                        " / ".join(part for part in key if part),
+                        _format_value(duration, "s"),
+                        (
+                            "absent"
+                            if previous is None
+                            else _format_value(previous, "s")
+                        ),
+                    )
+                )
+        if self.added or self.removed:
+            lines.append(
+                "{} testcases added, {} removed".format(
+                    len(self.added), len(self.removed)
+                )
+            )
+        lines.append(
+            "{} regressions above {:.0%}".format(
+                len(self.regressions), self.threshold
+            )
+        )
+        return "\n".join(lines)
+
+
+def _format_value(value, unit):
+    if unit == "s":
+        return "{:.6g}s".format(value)
+    if unit == "B":
+        return "{:.4g}MiB".format(value / float(1 << 20))
+    return "{:.6g}{}".format(value, unit)
+
+
+def _format_change(change):
+    text = "{} -> {}".format(
+        _format_value(change.baseline, change.unit),
+        _format_value(change.current, change.unit),
+    )
+    if change.ratio is not None:
+        text += " ({:+.1%})".format(change.ratio)
+    return text
+
+
+def compare(baseline, current, threshold=0.1, top=20):
+    """
+    Compare the performance of two test runs.
+
+    :param baseline: Baseline report, JSON report path or summary.
+    :type baseline: :py:class:`~testplan.report.testing.base.TestReport`,
+        ``str`` or :py:class:`PerformanceSummary`
+    :param current: Current report, JSON report path or summary.
+    :type current: :py:class:`~testplan.report.testing.base.TestReport`,
+        ``str`` or :py:class:`PerformanceSummary`
+    :param threshold: Relative increase reported as a regression.
+    :type threshold: ``float``
+    :param top: Number of slowest testcases and of listed changes.
+    :type top: ``int``
+    :rtype: :py:class:`PerformanceComparison`
+    """
+    summaries = [
+        (
+            source
+            if isinstance(source, PerformanceSummary)
+            else PerformanceSummary.load(source)
+        )
+        for source in (baseline, current)
+    ]
+    return PerformanceComparison(
+        summaries[0], summaries[1], threshold=threshold, top=top
+    )
+
+
+def main(argv=None):
+    """
+    Compare two JSON reports, exit with 1 if there are regressions.
+
+    :param argv: Command line arguments.
+    :type argv: ``list`` of ``str``
+    :rtype: ``int``
+    """
+    parser = argparse.ArgumentParser(
+        description="Run over run performance comparison of Testplan JSON"
+        " reports."
+    )
+    parser.add_argument("baseline", help="Baseline JSON report.")
+    parser.add_argument("current", help="Current JSON report.")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="Relative increase reported as a regression (default: 0.1).",
+    )
+    parser.add_argument(
+        "--top",
+        type=int,
+        default=20,
+        help="Number of slowest testcases and of listed changes"
+        " (default: 20).",
+    )
+    parser.add_argument(
+        "--json", dest="json_path", help="Also write the comparison as JSON."
+    )
+    args = parser.parse_args(argv)
+
+    comparison = compare(
+        args.baseline, args.current, threshold=args.threshold, top=args.top
+    )
+    print(comparison.format())
+    if args.json_path:
+        with open(args.json_path, "w") as json_file:
+            json.dump(comparison.to_dict(), json_file, indent=2)
+    return 1 if comparison.regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -2,6 +2,7 @@
 
 import functools
 import json
+from collections.abc import Mapping
 
 from boltons.iterutils import remap, is_scalar
 
@@ -94,6 +95,10 @@ class EntriesField(fields.Field):
                 return key, str(_value)
             return True
 
+        if isinstance(value, Mapping) and not isinstance(value, dict):
+            value = dict(value.items())  # e.g. serialized lazily
+        if self._json_serializable(value):
+            return value  # Most entries, checked at once
         return remap(value, visit=visit)
 
 
@@ -148,6 +153,7 @@ class TestGroupReportSchema(TestCaseReportSchema):
     fix_spec_path = fields.String(allow_none=True)
     env_status = fields.String(allow_none=True)
     strict_order = fields.Bool()
+    meta = fields.Dict()
 
     entries = custom_fields.GenericNested(
         schema_context={
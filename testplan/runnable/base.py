@@ -21,7 +21,10 @@ from testplan.common.entity import (
 from testplan.common.exporters import BaseExporter, ExporterResult
 from testplan.common.report import MergeError
 from testplan.common.utils import logger
+from testplan.common.utils import networking
 from testplan.common.utils import strings
+from testplan.common.utils.events import EventBus
+from testplan.common.utils.timing import wait
 from testplan.common.utils.path import default_runpath
 from testplan.exporters import testing as test_exporters
 from testplan.report import (
@@ -30,12 +33,14 @@ from testplan.report import (
     Status,
     ReportCategories,
 )
+from testplan.report.testing.journal import ReportJournal
 from testplan.report.testing.styles import Style
 from testplan.runnable.interactive import TestRunnerIHandler
+from testplan.runnable.monitor import RunMonitor
 from testplan.runners.base import Executor
 from testplan.runners.pools.tasks import Task, TaskResult
-from testplan.testing import listing, filtering, ordering, tagging
-from testplan.testing.base import TestResult
+from testplan.testing import listing, filtering, ordering, sampling, tagging
+from testplan.testing.base import TestResult, ProcessRunnerTest
 
 
 def get_exporters(values):
@@ -118,6 +123,11 @@ class TestRunnerConfig(RunnableConfig):
             ConfigOption("xml_dir", default=None): Or(str, None),
             ConfigOption("pdf_path", default=None): Or(str, None),
             ConfigOption("json_path", default=None): Or(str, None),
+            ConfigOption("openmetrics_path", default=None): Or(str, None),
+            ConfigOption("performance_baseline", default=None): Or(
+                str, None
+            ),
+            ConfigOption("report_journal", default=None): Or(str, None),
             ConfigOption("http_url", default=None): Or(str, None),
             ConfigOption("pdf_style", default=defaults.PDF_STYLE): Style,
             ConfigOption("report_tags", default=[]): [
@@ -129,6 +139,7 @@ class TestRunnerConfig(RunnableConfig):
             ConfigOption("merge_scheduled_parts", default=False): bool,
             ConfigOption("browse", default=False): bool,
             ConfigOption("ui_port", default=None): Or(None, int),
+            ConfigOption("monitor_port", default=None): Or(None, int),
             ConfigOption(
                 "web_server_startup_timeout",
                 default=defaults.WEB_SERVER_TIMEOUT,
@@ -139,6 +150,9 @@ class TestRunnerConfig(RunnableConfig):
             ConfigOption(
                 "test_sorter", default=ordering.NoopSorter()
             ): ordering.BaseSorter,
+            ConfigOption("test_sample", default=None): Or(
+                None, sampling.Sample
+            ),
             # Test lister is None by default, otherwise Testplan would
             # list tests, not run them
             ConfigOption("test_lister", default=None): Or(
@@ -150,6 +164,9 @@ class TestRunnerConfig(RunnableConfig):
                 None, And(int, lambda t: t >= 0)
             ),
             ConfigOption("abort_wait_timeout", default=60): int,
+            ConfigOption("report_workers", default=0): And(
+                int, lambda n: n >= 0
+            ),
             ConfigOption(
                 "interactive_handler", default=TestRunnerIHandler
             ): object,
@@ -233,6 +250,15 @@ class TestRunner(Runnable):
     :type pdf_path: ``str``
     :param json_path: JSON output path <PATH>/\*.json.
     :type json_path: ``str``
+    :param openmetrics_path: OpenMetrics output path <PATH>/\*.prom.
+    :type openmetrics_path: ``str``
+    :param performance_baseline: JSON report of a previous run to compare
+        the durations, resource usage and benchmarks of this run with.
+    :type performance_baseline: ``str``
+    :param report_journal: Path of the journal the report is appended to
+        while the plan runs, to recover the report of a crashed run or read
+        it before the run completes.
+    :type report_journal: ``str``
     :param pdf_style: PDF creation styling options.
     :type pdf_style: :py:class:`Style <testplan.report.testing.styles.Style>`
     :param http_url: Web url for posting test report.
@@ -247,6 +273,9 @@ class TestRunner(Runnable):
     :type browse: ``bool`` or ``NoneType``
     :param ui_port: Port of web server for displaying test report.
     :type ui_port: ``int`` or ``NoneType``
+    :param monitor_port: Port of web server for monitoring the run live,
+        0 for any free port, ``None`` not to start it.
+    :type monitor_port: ``int`` or ``NoneType``
     :param web_server_startup_timeout: Timeout for starting web server.
     :type web_server_startup_timeout: ``int``
     :param test_filter: Tests filtering class.
@@ -255,6 +284,10 @@ class TestRunner(Runnable):
     :param test_sorter: Tests sorting class.
     :type test_sorter: Subclass of
         :py:class:`BaseSorter <testplan.testing.ordering.BaseSorter>`
+    :param test_sample: Sample of the testcases of the test binaries to
+        run, e.g. for smoke runs of huge C++ suites.
+    :type test_sample: ``NoneType`` or
+        :py:class:`Sample <testplan.testing.sampling.Sample>`
     :param test_lister: Tests listing class.
     :type test_lister: Subclass of
         :py:class:`BaseLister <testplan.testing.listing.BaseLister>`
@@ -266,6 +299,10 @@ class TestRunner(Runnable):
     :type timeout: ``NoneType`` or ``int`` (greater than 0).
     :param abort_wait_timeout: Timeout for test runner abort.
     :type abort_wait_timeout: ``int``
+    :param report_workers: Number of processes converting the output of
+        local test binaries into reports while the next tests run, 0 to
+        convert it after each test.
+    :type report_workers: ``int``
     :param interactive_handler: Handler for interactive mode execution.
     :type interactive_handler: Subclass of :py:class:
         `TestRunnerIHandler <testplan.runnable.interactive.TestRunnerIHandler>`
@@ -293,7 +330,11 @@ class TestRunner(Runnable):
             label=self.cfg.label,
         )
         self._exporters = None
+        self._report_journal = None
+        self._journaled = set()  # uids of the tests journaled
         self._web_server_thread = None
+        self._event_bus = None
+        self._monitor_server = None
         self._file_log_handler = None
         self._configure_stdout_logger()
         # Before saving test report, recursively generate unique strings in
@@ -306,6 +347,22 @@ class TestRunner(Runnable):
         """Tests report."""
         return self._result.test_report
 
+    @property
+    def report_journal(self):
+        """
+        Journal of the report, written while the plan runs, ``None`` if not
+        enabled.
+        """
+        return self._report_journal
+
+    @property
+    def event_bus(self):
+        """
+        Event bus of the run, followed by its live monitor, ``None`` if not
+        enabled.
+        """
+        return self._event_bus
+
     @property
     def exporters(self):
         """
@@ -335,6 +392,10 @@ class TestRunner(Runnable):
             exporters.append(test_exporters.TagFilteredPDFExporter())
         if self.cfg.json_path:
             exporters.append(test_exporters.JSONExporter())
+        if self.cfg.openmetrics_path:
+            exporters.append(test_exporters.OpenMetricsExporter())
+        if self.cfg.performance_baseline:
+            exporters.append(test_exporters.PerformanceComparisonExporter())
         if self.cfg.xml_dir:
             exporters.append(test_exporters.XMLExporter())
         if self.cfg.http_url:
@@ -515,6 +576,11 @@ class TestRunner(Runnable):
             self.cfg.test_lister.log_test_info(runnable)
             return None
 
+        # Start building the test binary right away, so that the build
+        # overlaps with the execution of the tests that were added before.
+        if isinstance(runnable, ProcessRunnerTest):
+            runnable.request_build()
+
         return runnable
 
     def _add_step(self, step, *args, **kwargs):
@@ -527,6 +593,12 @@ class TestRunner(Runnable):
     def _record_end(self):
         self.report.timer.end("run")
 
+    def _record_processing_start(self):
+        self.report.timer.start("process_results")
+
+    def _record_processing_end(self):
+        self.report.timer.end("process_results")
+
     def make_runpath_dirs(self):
         super(TestRunner, self).make_runpath_dirs()
         self.logger.test_info("Testplan runpath: {}".format(self.runpath))
@@ -537,6 +609,8 @@ class TestRunner(Runnable):
         self._add_step(self._record_start)
         self._add_step(self.make_runpath_dirs)
         self._add_step(self._configure_file_logger)
+        self._add_step(self._open_report_journal)
+        self._add_step(self._start_monitor)
 
     def main_batch_steps(self):
         """Steps to be executed while resources are running."""
@@ -544,9 +618,13 @@ class TestRunner(Runnable):
 
     def post_resource_steps(self):
         """Steps to be executed after resources stopped."""
+        self._add_step(self._record_processing_start)
         self._add_step(self._create_result)
+        self._add_step(self._record_processing_end)
         self._add_step(self._log_test_status)
         self._add_step(self._record_end)  # needs to happen before export
+        self._add_step(self._close_report_journal)
+        self._add_step(self._stop_monitor)
         self._add_step(self._invoke_exporters)
         self._add_step(self._post_exporters)
         self._add_step(self._close_file_logger)
@@ -579,6 +657,8 @@ class TestRunner(Runnable):
                 time.sleep(self.cfg.abort_wait_timeout)
                 break
 
+            self._journal_results()
+
             pending_work = False
             for resource in self.resources:
                 # Check if any resource has pending work.
@@ -600,8 +680,92 @@ class TestRunner(Runnable):
                 break
             time.sleep(self.cfg.active_loop_sleep)
 
+    def _open_report_journal(self):
+        if self.cfg.report_journal:
+            self._report_journal = ReportJournal(self.cfg.report_journal)
+            self._report_journal.open(self.report)
+            self.logger.test_info(
+                "Report journal: {}".format(self.cfg.report_journal)
+            )
+
+    def _close_report_journal(self):
+        if self._report_journal is not None:
+            self._report_journal.close(self.report)
+
+    def _start_monitor(self):
+        """Start the web server of the live monitor, if enabled."""
+        if self.cfg.monitor_port is None:
+            return
+        # Only runs with a monitor need the web server dependencies
+        from testplan.web_ui import web_app
+
+        event_bus = EventBus()
+        monitor = RunMonitor(event_bus, name=self.cfg.name)
+        server = web_app.MonitorServer(
+            event_bus, monitor, port=self.cfg.monitor_port
+        )
+        server.start()
+        wait(
+            server.ready,
+            self.cfg.web_server_startup_timeout,
+            raise_on_timeout=True,
+        )
+        # Events are only published once they can be followed
+        self._event_bus, self._monitor_server = event_bus, server
+        host, port = server.server.bind_addr
+        self.logger.test_info(
+            "Monitor the run in the browser:\n{}".format(
+                networking.format_access_urls(host, port, "/monitor/")
+            )
+        )
+        self._event_bus.publish(
+            "plan_started",
+            tests={
+                uid: self.resources[resource].uid()
+                for uid, resource in self._tests.items()
+            },
+        )
+
+    def _stop_monitor(self):
+        """Publish the end of the run and stop the live monitor."""
+        if self._event_bus is None:
+            return
+        if not self._event_bus.closed:
+            self._event_bus.publish(
+                "plan_finished",
+                status=self.report.status,
+                counter=dict(self.report.counter),
+            )
+            # Event streams end once they have sent the last events
+            self._event_bus.close()
+        if self._monitor_server is not None:
+            self._monitor_server.stop()
+            self._monitor_server = None
+
+    def _journal_results(self):
+        """Journal the reports of the tests completed since the last call."""
+        if self._report_journal is None:
+            return
+
+        for uid, resource in self._tests.items():
+            if uid in self._journaled or not isinstance(
+                self.resources[resource], Executor
+            ):
+                continue
+            result = self.resources[resource].results.get(uid)
+            if not result:
+                continue
+            if isinstance(result, TaskResult):
+                if result.status is False:
+                    result = result_for_failed_task(result)
+                else:
+                    result = result.result
+            self._report_journal.instance(result.report)
+            self._journaled.add(uid)
+
     def _create_result(self):
         """Fetch task result from executors and create a full test result."""
+        self._journal_results()
         step_result = True
         test_results = self._result.test_results
         test_report = self._result.test_report
@@ -665,6 +829,14 @@ class TestRunner(Runnable):
 
         step_result = self._merge_reports(test_rep_lookup) and step_result
 
+        for resource in self.resources:
+            if isinstance(resource, Executor):
+                statistics = resource.statistics()
+                if statistics:
+                    test_report.meta.setdefault("executors", {})[
+                        resource.uid()
+                    ] = statistics
+
         # Reset UIDs of the test report and all of its children in UUID4 format
         if self._reset_report_uid:
             test_report.reset_uid()
@@ -820,9 +992,10 @@ class TestRunner(Runnable):
                 )
 
     def aborting(self):
-        """Stop the web server if it is running."""
+        """Stop the web servers if they are running."""
         if self._web_server_thread is not None:
             self._web_server_thread.stop()
+        self._stop_monitor()
         self._close_file_logger()
 
     def _configure_stdout_logger(self):
@@ -14,6 +14,7 @@ from testplan.common.utils import networking
 from testplan.runnable.interactive import http
 from testplan.runnable.interactive import reloader
 from testplan.runnable.interactive import resource_loader
+from testplan.runnable.interactive.versions import ReportVersions
 
 from testplan.report import TestReport, TestGroupReport, RuntimeStatus
 
@@ -54,6 +55,7 @@ class TestRunnerIHandler(entity.Entity):
 
         self.report = self._initial_report()
         self.report_mutex = threading.Lock()
+        self.report_versions = ReportVersions()
         self._pool = None
         self._http_handler = None
 
@@ -184,6 +186,7 @@ class TestRunnerIHandler(entity.Entity):
             self.logger.exception("Failed to start environment for test.")
             with self.report_mutex:
                 self.report[test_uid].runtime_status = RuntimeStatus.FINISHED
+                self.report_changed([test_uid], recursive=True)
             return
 
         self._merge_testcase_reports(test.run_testcases_iter())
@@ -213,6 +216,7 @@ class TestRunnerIHandler(entity.Entity):
                 self.report[test_uid][
                     suite_uid
                 ].runtime_status = RuntimeStatus.FINISHED
+                self.report_changed([test_uid, suite_uid], recursive=True)
             return
 
         self._merge_testcase_reports(
@@ -250,6 +254,9 @@ class TestRunnerIHandler(entity.Entity):
                 self.report[test_uid][suite_uid][
                     case_uid
                 ].runtime_status = RuntimeStatus.FINISHED
+                self.report_changed(
+                    [test_uid, suite_uid, case_uid], recursive=True
+                )
             return
 
         self._merge_testcase_reports(
@@ -298,6 +305,7 @@ class TestRunnerIHandler(entity.Entity):
                 self.report[test_uid][suite_uid][case_uid][
                     param_uid
                 ].runtime_status = RuntimeStatus.FINISHED
+                self.report_changed([test_uid, suite_uid, case_uid, param_uid])
             return
 
         self._merge_testcase_reports(
@@ -334,14 +342,16 @@ class TestRunnerIHandler(entity.Entity):
 
         with self.report_mutex:
             self.report[test_uid].env_status = entity.ResourceStatus.STARTING
+            self.report_changed([test_uid])
 
         test = self.test(test_uid)
         test.start_test_resources()
-        # Re-initialize report of Multitest if environment restarted
-        self.report[test_uid] = test.dry_run().report
 
         with self.report_mutex:
+            # Re-initialize report of Multitest if environment restarted
+            self.report[test_uid] = test.dry_run().report
             self.report[test_uid].env_status = entity.ResourceStatus.STARTED
+            self.report_changed([test_uid], recursive=True)
 
     def stop_test_resources(self, test_uid, await_results=True):
         """
@@ -361,12 +371,14 @@ class TestRunnerIHandler(entity.Entity):
 
         with self.report_mutex:
             self.report[test_uid].env_status = entity.ResourceStatus.STOPPING
+            self.report_changed([test_uid])
 
         test = self.test(test_uid)
         test.stop_test_resources()
 
         with self.report_mutex:
             self.report[test_uid].env_status = entity.ResourceStatus.STOPPED
+            self.report_changed([test_uid])
 
     def get_environment(self, env_uid):
         """Get an environment."""
@@ -637,6 +649,24 @@ class TestRunnerIHandler(entity.Entity):
     def reload_report(self):
         """Update report with added/removed testcases"""
         new_report = self._initial_report()
+        with self.report_mutex:
+            self._reload_report(new_report)
+            self.report_versions.reset()
+
+    def report_changed(self, uids=(), recursive=False):
+        """
+        Record a change of the report, for clients to fetch the changed
+        nodes. Must be called with the report mutex held.
+
+        :param uids: Path of the changed node below the root of the report.
+        :type uids: ``list`` of ``str``
+        :param recursive: Whether the children of the node changed too.
+        :type recursive: ``bool``
+        """
+        self.report_versions.changed(self.report, uids, recursive=recursive)
+
+    def _reload_report(self, new_report):
+        """Update the testsuites of the report with those reloaded."""
         for mt in self.report.entries:  # multitest level
             for st_index in range(len(mt.entries)):  # testsuite level
                 st = mt.entries[st_index]
@@ -722,6 +752,7 @@ class TestRunnerIHandler(entity.Entity):
             self.logger.debug("Merge test result: %s", result)
             with self.report_mutex:
                 self.report[result.uid].merge(result)
+                self.report_changed([result.uid], recursive=True)
         elif result is not None:
             self.logger.debug(
                 "Discarding result from test operation: %s", result
@@ -748,6 +779,7 @@ class TestRunnerIHandler(entity.Entity):
                 "Setting env status of %s to %s", test_uid, new_status
             )
             self.report[test_uid].env_status = new_status
+            self.report_changed([test_uid])
 
     def _run_async(self, func, *args, **kwargs):
         """
@@ -786,3 +818,6 @@ class TestRunnerIHandler(entity.Entity):
                     ] = attachment.source_path
 
                 parent_entry[report.uid] = report
+                self.report_changed(
+                    list(parent_uids) + [report.uid], recursive=True
+                )
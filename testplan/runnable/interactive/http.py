@@ -29,6 +29,10 @@ from testplan.report import (
 )
 from .reloader import ModuleReloader
 
+# Maximum number of changed nodes returned by default by the changes
+# endpoint, clients read the report again if more nodes changed.
+CHANGES_LIMIT = 1000
+
 
 class OutOfOrderError(Exception):
     def __init__(self, msg):
@@ -116,7 +120,9 @@ def generate_interactive_api(ihandler):
         def get(self):
             """Get the state of the root interactive report."""
             with ihandler.report_mutex:
-                return ihandler.report.shallow_serialize()
+                return _conditional_get(
+                    ihandler, [], ihandler.report.shallow_serialize
+                )
 
         def put(self):
             """Update the state of the root interactive report."""
@@ -135,12 +141,14 @@ def generate_interactive_api(ihandler):
 
                 _check_uids_match(ihandler.report.uid, new_report.uid)
 
-                if _should_run(ihandler.report.runtime_status):
+                should_run = _should_run(ihandler.report.runtime_status)
+                if should_run:
                     _check_execution_order(ihandler.report)
                     new_report.runtime_status = RuntimeStatus.RUNNING
                     ihandler.run_all_tests(await_results=False)
 
                 ihandler.report = new_report
+                ihandler.report_changed([], recursive=should_run)
                 return ihandler.report.shallow_serialize()
 
     @api.route("/report/tests")
@@ -152,7 +160,13 @@ def generate_interactive_api(ihandler):
         def get(self):
             """Get the UIDs of all tests defined in the testplan."""
             with ihandler.report_mutex:
-                return [test.shallow_serialize() for test in ihandler.report]
+                return _conditional_get(
+                    ihandler,
+                    [],
+                    lambda: [
+                        test.shallow_serialize() for test in ihandler.report
+                    ],
+                )
 
     @api.route("/report/tests/<string:test_uid>")
     class SingleTest(flask_restplus.Resource):
@@ -177,10 +191,14 @@ def generate_interactive_api(ihandler):
             """Get the state of a specific test from the testplan."""
             with ihandler.report_mutex:
                 try:
-                    return ihandler.report[test_uid].shallow_serialize()
+                    test = ihandler.report[test_uid]
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
+                return _conditional_get(
+                    ihandler, [test_uid], test.shallow_serialize
+                )
+
         @decode_uri_component
         def put(self, test_uid):
             """Update the state of a specific test."""
@@ -206,7 +224,8 @@ def generate_interactive_api(ihandler):
 
                 # Trigger a side-effect if either the report or environment
                 # statuses have been updated.
-                if _should_run(current_test.runtime_status):
+                should_run = _should_run(current_test.runtime_status)
+                if should_run:
                     if current_test.env_status != new_test.env_status:
                         raise werkzeug.exceptions.BadRequest(
                             "env_status cannot change when test status is "
@@ -226,6 +245,7 @@ def generate_interactive_api(ihandler):
                         env_action(test_uid, await_results=False)
 
                 ihandler.report[test_uid] = new_test
+                ihandler.report_changed([test_uid], recursive=should_run)
                 return ihandler.report[test_uid].shallow_serialize()
 
         def _check_env_transition(self, current_state, new_state):
@@ -260,13 +280,17 @@ def generate_interactive_api(ihandler):
         @decode_uri_component
         def get(self, test_uid):
             """Get the UIDs of all test suites owned by a specific test."""
-            try:
-                return [
-                    entry.shallow_serialize()
-                    for entry in ihandler.report[test_uid]
-                ]
-            except KeyError:
-                raise werkzeug.exceptions.NotFound
+            with ihandler.report_mutex:
+                try:
+                    test = ihandler.report[test_uid]
+                except KeyError:
+                    raise werkzeug.exceptions.NotFound
+
+                return _conditional_get(
+                    ihandler,
+                    [test_uid],
+                    lambda: [entry.shallow_serialize() for entry in test],
+                )
 
     @api.route("/report/tests/<string:test_uid>/suites/<string:suite_uid>")
     class SingleSuite(flask_restplus.Resource):
@@ -280,12 +304,14 @@ def generate_interactive_api(ihandler):
             """Get the state of a specific test suite."""
             with ihandler.report_mutex:
                 try:
-                    return ihandler.report[test_uid][
-                        suite_uid
-                    ].shallow_serialize()
+                    suite = ihandler.report[test_uid][suite_uid]
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
+                return _conditional_get(
+                    ihandler, [test_uid, suite_uid], suite.shallow_serialize
+                )
+
         @decode_uri_component
         def put(self, test_uid, suite_uid):
             """Update the state of a specific test suite."""
@@ -309,7 +335,8 @@ def generate_interactive_api(ihandler):
 
                 _check_uids_match(current_suite.uid, new_suite.uid)
 
-                if _should_run(current_suite.runtime_status):
+                should_run = _should_run(current_suite.runtime_status)
+                if should_run:
                     _check_execution_order(
                         ihandler.report, test_uid=test_uid, suite_uid=suite_uid
                     )
@@ -319,6 +346,9 @@ def generate_interactive_api(ihandler):
                     )
 
                 ihandler.report[test_uid][suite_uid] = new_suite
+                ihandler.report_changed(
+                    [test_uid, suite_uid], recursive=should_run
+                )
                 return ihandler.report[test_uid][suite_uid].shallow_serialize()
 
     @api.route(
@@ -335,13 +365,16 @@ def generate_interactive_api(ihandler):
             """Get the UIDs of all testcases defined on a suite."""
             with ihandler.report_mutex:
                 try:
-                    return [
-                        _serialize_testcase(entry)
-                        for entry in ihandler.report[test_uid][suite_uid]
-                    ]
+                    suite = ihandler.report[test_uid][suite_uid]
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
+                return _conditional_get(
+                    ihandler,
+                    [test_uid, suite_uid],
+                    lambda: [_serialize_testcase(entry) for entry in suite],
+                )
+
     @api.route(
         "/report/tests/<string:test_uid>/suites/<string:suite_uid>/testcases"
         "/<string:testcase_uid>"
@@ -364,7 +397,11 @@ def generate_interactive_api(ihandler):
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
-                return _serialize_testcase(report_entry)
+                return _conditional_get(
+                    ihandler,
+                    [test_uid, suite_uid, testcase_uid],
+                    lambda: _serialize_testcase(report_entry),
+                )
 
         @decode_uri_component
         def put(self, test_uid, suite_uid, testcase_uid):
@@ -390,7 +427,8 @@ def generate_interactive_api(ihandler):
 
                 _check_uids_match(current_testcase.uid, new_testcase.uid)
 
-                if _should_run(current_testcase.runtime_status):
+                should_run = _should_run(current_testcase.runtime_status)
+                if should_run:
                     _check_execution_order(
                         ihandler.report,
                         test_uid=test_uid,
@@ -403,6 +441,9 @@ def generate_interactive_api(ihandler):
                     )
 
                 suite[testcase_uid] = new_testcase
+                ihandler.report_changed(
+                    [test_uid, suite_uid, testcase_uid], recursive=should_run
+                )
                 return _serialize_testcase(suite[testcase_uid])
 
     @api.route(
@@ -420,15 +461,18 @@ def generate_interactive_api(ihandler):
             """Get the state of all parametrizations of a testcase."""
             with ihandler.report_mutex:
                 try:
-                    return [
-                        entry.serialize()
-                        for entry in ihandler.report[test_uid][suite_uid][
-                            testcase_uid
-                        ]
+                    param_group = ihandler.report[test_uid][suite_uid][
+                        testcase_uid
                     ]
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
+                return _conditional_get(
+                    ihandler,
+                    [test_uid, suite_uid, testcase_uid],
+                    lambda: [entry.serialize() for entry in param_group],
+                )
+
     @api.route(
         "/report/tests/<string:test_uid>/suites/<string:suite_uid>/testcases"
         "/<string:testcase_uid>/parametrizations/<string:param_uid>"
@@ -450,7 +494,11 @@ def generate_interactive_api(ihandler):
                 except KeyError:
                     raise werkzeug.exceptions.NotFound
 
-                return report_entry.serialize()
+                return _conditional_get(
+                    ihandler,
+                    [test_uid, suite_uid, testcase_uid, param_uid],
+                    report_entry.serialize,
+                )
 
         @decode_uri_component
         def put(self, test_uid, suite_uid, testcase_uid, param_uid):
@@ -496,8 +544,34 @@ def generate_interactive_api(ihandler):
                     )
 
                 param_group[param_uid] = new_testcase
+                ihandler.report_changed(
+                    [test_uid, suite_uid, testcase_uid, param_uid]
+                )
                 return param_group[param_uid].serialize()
 
+    @api.route("/report/changes")
+    class ReportChanges(flask_restplus.Resource):
+        """
+        Changes endpoint. Represents the nodes of the report changed since a
+        version of the report, so that clients polling the report fetch only
+        what changed rather than the whole report. Read-only.
+        """
+
+        def get(self):
+            """
+            Get the nodes changed since the version given as ``since``, at
+            most ``limit`` of them.
+            """
+            since = request.args.get("since")
+            if since is None:
+                raise werkzeug.exceptions.BadRequest(
+                    "since parameter is required"
+                )
+            limit = request.args.get("limit", CHANGES_LIMIT, type=int)
+
+            with ihandler.report_mutex:
+                return report_changes(ihandler, since, limit=limit)
+
     @api.route("/report/export")
     class ExportReport(flask_restplus.Resource):
         """
@@ -594,6 +668,73 @@ def generate_interactive_api(ihandler):
     return app, api
 
 
+def report_changes(ihandler, since, limit=None):
+    """
+    Nodes of the interactive report changed since a version of the report.
+    Must be called with the report mutex held.
+
+    Clients start from the version of a ``reset`` response, read the nodes
+    they need, then apply the changes since that version: changes made while
+    they read the nodes are returned again.
+
+    :param ihandler: Interactive handler owning the report.
+    :type ihandler: ``TestRunnerIHandler``
+    :param since: Version of the report read by the client, as returned by
+        a previous call.
+    :type since: ``str``
+    :param limit: Maximum number of changed nodes, ``None`` for no limit.
+    :type limit: ``int`` or ``NoneType``
+    :return: Current version of the report and changed nodes, oldest change
+        first, with ``None`` data for the nodes removed. ``reset`` is set
+        instead of the changes if the client has to read the report again.
+    :rtype: ``dict``
+    """
+    versions = ihandler.report_versions
+    changes = versions.changes_since(since, limit=limit)
+    if changes is None:
+        return {"version": versions.tag(), "reset": True}
+
+    result = []
+    for uids, version in changes:
+        node = ihandler.report
+        try:
+            for uid in uids:
+                node = node[uid]
+        except KeyError:
+            node = None
+        result.append(
+            {
+                "uids": list(uids),
+                "version": versions.tag(version),
+                "data": None if node is None else _serialize_node(node),
+            }
+        )
+    return {"version": versions.tag(), "changes": result}
+
+
+def _conditional_get(ihandler, uids, serialize):
+    """
+    Response of a GET of a node of the report, with the entity tag of the
+    node. The node is not serialized again if the client already has this
+    version of it. Must be called with the report mutex held.
+    """
+    etag = ihandler.report_versions.etag(uids)
+    headers = {"ETag": '"{}"'.format(etag)}
+    if request.if_none_match.contains(etag):
+        return None, 304, headers
+    return serialize(), 200, headers
+
+
+def _serialize_node(node):
+    """
+    Serialize a node of the report, testcases with their entries and groups
+    without their children.
+    """
+    if isinstance(node, TestCaseReport):
+        return node.serialize()
+    return node.shallow_serialize()
+
+
 def _serialize_testcase(report_entry):
     """
     Serialize a report entry representing a testcase. Since the
@@ -0,0 +1,173 @@
+"""
+Change counters of the nodes of the interactive report, for clients to only
+fetch the nodes changed since they last read the report.
+
+Nodes are identified by their path of uids below the root of the report
+(e.g. ``("MTest1", "Suite1", "testcase")``, ``()`` for the root). Changes
+are recorded by the interactive handler as it updates the report, with the
+report mutex held. A change marks a node and its parents, whose statuses are
+computed from their children, and optionally its children, e.g. when a
+runtime status set on a test applies to its testcases.
+
+Versions given to clients are tagged with a token of the report, so that a
+version of the report of another handler, e.g. before a restart, is never
+taken for a version of this one.
+"""
+
+import collections
+import uuid
+
+
+class ReportVersions(object):
+    """
+    Version of the interactive report, incremented by each change, and
+    version of each node, the version of the last change of the node.
+
+    Changes are logged in the order they are made, so that the nodes changed
+    since a version are found without walking the report.
+    """
+
+    def __init__(self):
+        # Tells the versions of the report of another handler apart
+        self._token = uuid.uuid4().hex[:8]
+        self._version = 0
+        self._reset_version = 0
+        self._changes = collections.OrderedDict()  # path to version
+
+    @property
+    def version(self):
+        """Version of the report."""
+        return self._version
+
+    def tag(self, version=None):
+        """
+        Version tagged with the token of the report, as given to clients.
+
+        :param version: Version to tag, ``None`` for the version of the
+            report.
+        :type version: ``int`` or ``NoneType``
+        :rtype: ``str``
+        """
+        if version is None:
+            version = self._version
+        return "{}-{}".format(self._token, version)
+
+    def _untag(self, tag):
+        """Version of a tag of this report, ``None`` for any other tag."""
+        token, _, version = tag.rpartition("-")
+        if token != self._token or not version.isdigit():
+            return None
+        return int(version)
+
+    def changed(self, report, uids=(), recursive=False):
+        """
+        Record the change of a node of the report.
+
+        :param report: Root of the report.
+        :type report: :py:class:`TestReport <testplan.report.TestReport>`
+        :param uids: Path of the changed node below the root.
+        :type uids: ``list`` of ``str``
+        :param recursive: Whether the children of the node changed too.
+        :type recursive: ``bool``
+        :return: New version of the report.
+        :rtype: ``int``
+        """
+        self._version += 1
+        for depth in range(len(uids) + 1):
+            self._mark(tuple(uids[:depth]))
+
+        if recursive:
+            try:
+                node = _get_node(report, uids)
+            except KeyError:
+                return self._version  # Removed
+            self._mark_children(node, tuple(uids))
+        return self._version
+
+    def reset(self):
+        """
+        Record a change of the whole report, e.g. when it is reloaded.
+        Clients have to read the report again.
+
+        :return: New version of the report.
+        :rtype: ``int``
+        """
+        self._version += 1
+        self._reset_version = self._version
+        self._changes.clear()
+        return self._version
+
+    def node_version(self, uids=()):
+        """
+        Version of a node of the report.
+
+        :param uids: Path of the node below the root.
+        :type uids: ``list`` of ``str``
+        :rtype: ``int``
+        """
+        return self._changes.get(tuple(uids), self._reset_version)
+
+    def etag(self, uids=()):
+        """
+        Entity tag of a node of the report, changing with its version.
+
+        :param uids: Path of the node below the root.
+        :type uids: ``list`` of ``str``
+        :rtype: ``str``
+        """
+        return self.tag(self.node_version(uids))
+
+    def changes_since(self, version, limit=None):
+        """
+        Paths and versions of the nodes changed after a version of the
+        report, in the order of their last change.
+
+        :param version: Tagged version of the report read by the client.
+        :type version: ``str``
+        :param limit: Maximum number of changed nodes, ``None`` for no limit.
+        :type limit: ``int`` or ``NoneType``
+        :return: Changed nodes, ``None`` if the client has to read the
+            report again: it was reset after the version, the version is not
+            one of this report or more nodes than the limit changed.
+        :rtype: ``list`` of (``tuple`` of ``str``, ``int``) or ``NoneType``
+        """
+        version = self._untag(version)
+        if (
+            version is None
+            or version < self._reset_version
+            or version > self._version
+        ):
+            return None
+
+        changes = []
+        for path in reversed(self._changes):
+            node_version = self._changes[path]
+            if node_version <= version:
+                break
+            if limit is not None and len(changes) == limit:
+                return None
+            changes.append((path, node_version))
+        changes.reverse()
+        return changes
+
+    def _mark(self, path):
+        # Last changed nodes are at the end of the log
+        self._changes.pop(path, None)
+        self._changes[path] = self._version
+
+    def _mark_children(self, node, path):
+        for child in getattr(node, "entries", ()):
+            # Entries of testcases are assertions, not nodes
+            if not hasattr(child, "uid"):
+                return
+            child_path = path + (child.uid,)
+            self._mark(child_path)
+            self._mark_children(child, child_path)
+
+
+def _get_node(report, uids):
+    """Node of the report at a path of uids."""
+    node = report
+    for uid in uids:
+        node = node[uid]
+    return node
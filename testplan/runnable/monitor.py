@@ -0,0 +1,159 @@
+"""
+State of a run for its live monitor, built from the events of the run so
+that it is kept up to date without walking the test report.
+
+Events published by the test runner, its executors and the tests they run:
+
+* ``plan_started``: ``tests``, executor of each test, by uid,
+* ``test_started``: ``test`` started by ``executor``, on ``worker`` for
+  pools,
+* ``test_finished``: ``test`` completed by ``executor``, with its
+  ``status`` and ``counter``, ``utilization`` of the workers of pools,
+* ``testcase_finished``: ``testcase`` of ``suite`` of ``test`` completed,
+  with its ``status`` and number of ``entries``,
+* ``plan_finished``: run completed, with its ``status`` and ``counter``.
+"""
+
+import copy
+import threading
+
+# Status of the tests while they run, those of completed tests are the ones
+# of their report.
+WAITING = "waiting"
+RUNNING = "running"
+
+
+class RunMonitor(object):
+    """
+    State of a run, updated by the events of its event bus.
+
+    :param event_bus: Event bus of the run.
+    :type event_bus: :py:class:`EventBus
+        <testplan.common.utils.events.EventBus>`
+    :param name: Name of the plan.
+    :type name: ``str``
+    """
+
+    def __init__(self, event_bus, name=None):
+        self._lock = threading.Lock()
+        self._state = {
+            "seq": 0,
+            "plan": {
+                "name": name,
+                "status": WAITING,
+                "started": None,
+                "finished": None,
+                "tests": 0,
+                "done": 0,
+                "counter": {},
+            },
+            "tests": {},
+            "executors": {},
+        }
+        self._handlers = {
+            "plan_started": self._plan_started,
+            "plan_finished": self._plan_finished,
+            "test_started": self._test_started,
+            "test_finished": self._test_finished,
+            "testcase_finished": self._testcase_finished,
+        }
+        event_bus.subscribe(self.update)
+
+    def snapshot(self):
+        """
+        Copy of the state of the run, with the number of the last event it
+        was updated with, e.g. for clients to follow the events after it.
+
+        :rtype: ``dict``
+        """
+        with self._lock:
+            return copy.deepcopy(self._state)
+
+    def update(self, event):
+        """
+        Update the state of the run with an event.
+
+        :param event: Event of the run.
+        :type event: :py:class:`Event <testplan.common.utils.events.Event>`
+        """
+        handler = self._handlers.get(event.kind)
+        with self._lock:
+            self._state["seq"] = event.seq
+            if handler is not None:
+                handler(event)
+
+    def _executor(self, uid):
+        return self._state["executors"].setdefault(
+            uid, {"workers": {}, "utilization": None}
+        )
+
+    def _test(self, uid, executor=None):
+        tests = self._state["tests"]
+        if uid not in tests:
+            tests[uid] = {
+                "executor": executor,
+                "worker": None,
+                "status": WAITING,
+                "started": None,
+                "finished": None,
+                "counter": {},
+                "testcases": 0,
+            }
+            self._state["plan"]["tests"] = len(tests)
+        return tests[uid]
+
+    def _plan_started(self, event):
+        plan = self._state["plan"]
+        plan["status"] = RUNNING
+        plan["started"] = event.time
+        for uid, executor in event.data["tests"].items():
+            self._test(uid, executor)
+            self._executor(executor)
+
+    def _plan_finished(self, event):
+        plan = self._state["plan"]
+        plan["status"] = event.data["status"]
+        plan["counter"] = event.data["counter"]
+        plan["finished"] = event.time
+
+    def _test_started(self, event):
+        executor_uid = event.data["executor"]
+        # Local runners run one test at a time, as a single worker
+        worker_uid = event.data.get("worker") or executor_uid
+        test = self._test(event.data["test"], executor_uid)
+        test.update(
+            status=RUNNING,
+            worker=worker_uid,
+            started=event.time,
+            finished=None,
+            testcases=0,
+        )
+        worker = self._executor(executor_uid)["workers"].setdefault(
+            worker_uid, {"test": None, "since": None, "done": 0}
+        )
+        worker.update(test=event.data["test"], since=event.time)
+
+    def _test_finished(self, event):
+        executor_uid = event.data["executor"]
+        test = self._test(event.data["test"], executor_uid)
+        if test["status"] not in (WAITING, RUNNING):
+            return  # Result of an aborted test, already finished
+        test.update(
+            status=event.data["status"],
+            counter=event.data["counter"],
+            finished=event.time,
+        )
+        self._state["plan"]["done"] += 1
+
+        executor = self._executor(executor_uid)
+        if event.data.get("utilization") is not None:
+            executor["utilization"] = event.data["utilization"]
+        worker = executor["workers"].get(test["worker"])
+        if worker is not None and worker["test"] == event.data["test"]:
+            worker.update(test=None, since=event.time)
+            worker["done"] += 1
+
+    def _testcase_finished(self, event):
+        test = self._state["tests"].get(event.data["test"])
+        if test is not None:
+            test["testcases"] += 1
@@ -6,6 +6,7 @@ from collections import OrderedDict
 
 from testplan.common.entity import Resource, ResourceConfig
 from testplan.common.utils.thread import interruptible_join
+from testplan.report import Status
 
 
 class ExecutorConfig(ResourceConfig):
@@ -42,6 +43,11 @@ class Executor(Resource):
         """Items results."""
         return self._results
 
+    @property
+    def event_bus(self):
+        """Event bus of the run of the executor, ``None`` if it has none."""
+        return getattr(self.parent, "event_bus", None)
+
     @property
     def added_items(self):
         """Returns added items."""
@@ -74,6 +80,36 @@ class Executor(Resource):
     def _loop(self):
         raise NotImplementedError()
 
+    def _publish_test_started(self, uid, worker=None):
+        """Publish the start of a test on the event bus of the run, if any."""
+        bus = self.event_bus
+        if bus is not None:
+            bus.publish(
+                "test_started", test=uid, executor=self.uid(), worker=worker
+            )
+
+    def _publish_test_finished(self, uid, result):
+        """
+        Publish the completion of a test on the event bus of the run, if
+        any, with the status and counter of its report.
+        """
+        bus = self.event_bus
+        if bus is None:
+            return
+        # Test results have a report, task results the result of their test
+        report = getattr(result, "report", None)
+        if report is None:
+            report = getattr(getattr(result, "result", None), "report", None)
+        statistics = self.statistics() or {}
+        bus.publish(
+            "test_finished",
+            test=uid,
+            executor=self.uid(),
+            status=report.status if report is not None else Status.ERROR,
+            counter=dict(report.counter) if report is not None else {},
+            utilization=statistics.get("utilization"),
+        )
+
     def _execute(self, uid):
         raise NotImplementedError()
 
@@ -108,3 +144,10 @@ class Executor(Resource):
     def pending_work(self):
         """Resource has pending work."""
         return len(self.ongoing) > 0
+
+    def statistics(self):
+        """
+        Execution statistics to be recorded in the test report, ``None`` if
+        the executor does not keep any.
+        """
+        return None
@@ -2,13 +2,28 @@
 
 import time
 
-from .base import Executor
+from collections import OrderedDict
+
+from .base import Executor, ExecutorConfig
+from .processing import ReportProcessor
 from testplan.runners.pools import tasks
 from testplan.common import entity
+from testplan.common.config import ConfigOption
 from testplan.testing.base import TestResult
 from testplan.report import TestGroupReport, Status, ReportCategories
 
 
+class LocalRunnerConfig(ExecutorConfig):
+    """
+    Configuration object for
+    :py:class:`LocalRunner <testplan.runners.local.LocalRunner>` executor.
+    """
+
+    @classmethod
+    def get_options(cls):
+        return {ConfigOption("report_workers"): int}
+
+
 class LocalRunner(Executor):
     """
     Basic local execution that inherits
@@ -16,11 +31,22 @@ class LocalRunner(Executor):
     and accepts all
     :py:class:`ExecutorConfig <testplan.runners.base.ExecutorConfig>`
     options.
+
+    :param report_workers: Number of processes converting the output of
+        test binaries into reports while the next tests run, reports are
+        converted after each test when 0. Inherited from the test runner.
+    :type report_workers: ``int``
     """
 
+    CONFIG = LocalRunnerConfig
+
     def __init__(self, **options):
         super(LocalRunner, self).__init__(**options)
         self._uid = "local_runner"
+        self._processor = None
+        # Runnables and results of the tests whose reports are processed
+        self._processing = OrderedDict()
+        self._report_stats = None
 
     def _execute(self, uid):
         """Execute item implementation."""
@@ -46,8 +72,59 @@ class LocalRunner(Executor):
             if not runnable.cfg.parent:
                 runnable.cfg.parent = self.cfg
 
-        result = runnable.run()
-        self._results[uid] = result
+        future = None
+        if self._processor and hasattr(runnable, "defer_report_processing"):
+            runnable.defer_report_processing()
+            result = runnable.run()
+            if not isinstance(result.run, Exception):
+                future = runnable.submit_test_report(self._processor)
+        else:
+            result = runnable.run()
+
+        if future is None:
+            self._results[uid] = result
+        else:
+            self._processing[uid] = (runnable, result, future, time.time())
+
+    def _complete_reports(self):
+        """Complete the reports of the tests whose processing is done."""
+        if self._processor is None:
+            return
+        # Between tests, for them not to see processing processes forked
+        self._processor.poll()
+        for uid, processing in list(self._processing.items()):
+            runnable, result, future, submitted = processing
+            if not future.done():
+                continue
+            runnable.complete_test_report(future)
+            self._results[uid] = result
+            self._processing.pop(uid, None)
+            self._publish_test_finished(uid, result)
+
+            self._report_stats["reports"] += 1
+            self._report_stats["completion_time"] += time.time() - submitted
+            interval = result.report.timer.get("process_results")
+            if interval and interval.elapsed:
+                self._report_stats["processing_time"] += interval.elapsed
+
+    def statistics(self):
+        """
+        Report processing statistics, when reports are processed while the
+        next tests run: number of reports, time spent converting them and
+        time from the end of the tests to the completion of their reports,
+        in seconds.
+
+        :rtype: ``dict`` or ``NoneType``
+        """
+        if self._report_stats is None:
+            return None
+        return dict(self._report_stats, workers=self.cfg.report_workers)
+
+    def pending_work(self):
+        """Tests to run or reports being processed."""
+        return super(LocalRunner, self).pending_work() or bool(
+            self._processing
+        )
 
     def _loop(self):
         """Execution loop implementation for local runner."""
@@ -55,11 +132,13 @@ class LocalRunner(Executor):
             if self.status.tag == self.status.STARTING:
                 self.status.change(self.status.STARTED)
             elif self.status.tag == self.status.STARTED:
+                self._complete_reports()
                 try:
                     next_uid = self.ongoing[0]
                 except IndexError:
                     pass
                 else:
+                    self._publish_test_started(next_uid)
                     try:
                         self._execute(next_uid)
                     except Exception as exc:
@@ -76,21 +155,49 @@ class LocalRunner(Executor):
                         self._results[next_uid] = result
                     finally:
                         self.ongoing.pop(0)
+                    # Reports being processed are published once complete
+                    if next_uid in self._results:
+                        self._publish_test_finished(
+                            next_uid, self._results[next_uid]
+                        )
 
             elif self.status.tag == self.status.STOPPING:
                 self.status.change(self.status.STOPPED)
                 return
             time.sleep(self.cfg.active_loop_sleep)
 
+        # Aborted, the reports still processed are abandoned
+        if self._processor:
+            self._processor.shutdown(wait=False)
+
     def starting(self):
         """Starting the local runner."""
         if self.parent:
             self._runpath = self.parent.runpath
+        if self.cfg.report_workers:
+            self._processor = ReportProcessor(workers=self.cfg.report_workers)
+            self._report_stats = {
+                "reports": 0,
+                "processing_time": 0.0,
+                "completion_time": 0.0,
+            }
         super(LocalRunner, self).starting()  # start the loop
 
+    def stopping(self):
+        """Stopping the local runner."""
+        super(LocalRunner, self).stopping()
+        if self._processor:
+            self._processor.shutdown()
+            self._processor = None
+
     def aborting(self):
         """Aborting logic."""
         self.logger.critical("Discard pending tasks of {}.".format(self))
+        # Reports still processed are left as they are
+        for uid, processing in list(self._processing.items()):
+            self._results[uid] = processing[1]
+        self._processing.clear()
+
         # Will announce that all the ongoing tasks fail, but there is a buffer
         # period and some tasks might be finished, so, copy the uids of ongoing
         # tasks and set test result, although the report could be overwritten.
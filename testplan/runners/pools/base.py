@@ -13,7 +13,11 @@ from schema import Or, And, Use
 from testplan.common.config import ConfigOption, validate_func
 from testplan.common import entity
 from testplan.common.utils.thread import interruptible_join
-from testplan.common.utils.timing import wait_until_predicate
+from testplan.common.utils.timing import (
+    Interval,
+    utcnow,
+    wait_until_predicate,
+)
 from testplan.common.utils import strings
 from testplan.runners.base import Executor, ExecutorConfig
 from testplan.report import ReportCategories
@@ -267,6 +271,14 @@ class Pool(Executor):
         self._conn.parent = self
         self._pool_lock = threading.Lock()
         self._metadata = None
+        # Timestamps of tasks waiting for and assigned to a worker, and time
+        # spent by the workers on tasks, for utilization statistics.
+        self._queued_at = {}
+        self._assigned_at = {}
+        self._busy_time = 0.0
+        self._tasks_done = 0
+        self._started_at = None
+        self._stopped_at = None
         # Set when Pool is started.
         self._exit_loop = False
         self._start_monitor_thread = True
@@ -299,9 +311,14 @@ class Pool(Executor):
                 "Task was expected, got {} instead.".format(type(task))
             )
         super(Pool, self).add(task, uid)
-        self.unassigned.put((task.priority, uid))
+        self._enqueue(task, uid)
         self._task_retries_cnt[uid] = 0
 
+    def _enqueue(self, task, uid):
+        """Put a task in the queue of tasks waiting for a worker."""
+        self.unassigned.put((task.priority, uid))
+        self._queued_at[uid] = utcnow()
+
     def _can_assign_task(self, task):
         """
         Is this pool able to execute the task.
@@ -444,15 +461,17 @@ class Pool(Executor):
                                 )
                             )
                             worker.assigned.add(uid)
+                            self._assigned_at[uid] = utcnow()
                             tasks.append(task)
                             task.executors.setdefault(self.cfg.name, set())
                             task.executors[self.cfg.name].add(worker.uid())
                             self.record_execution(uid)
+                            self._publish_test_started(uid, worker.uid())
                         else:
                             self.logger.test_info(
                                 "Cannot schedule {} to {}".format(task, worker)
                             )
-                            self.unassigned.put((task.priority, uid))
+                            self._enqueue(task, uid)
                             self._task_retries_cnt[uid] += 1
                 else:
                     # Later may create a default local pool as failover option
@@ -509,6 +528,7 @@ class Pool(Executor):
             uid = task_result.task.uid()
             worker.assigned.remove(uid)
             self._workers_last_result.setdefault(worker, time.time())
+            self._record_task_time(uid, task_result)
             self.logger.test_info(
                 "De-assign {} from {}".format(task_result.task, worker)
             )
@@ -522,7 +542,7 @@ class Pool(Executor):
                         - task_result.task.reassign_cnt,
                     },
                 )
-                self.unassigned.put((task_result.task.priority, uid))
+                self._enqueue(task_result.task, uid)
                 self._task_retries_cnt[uid] = 0
                 self._input[uid].reassign_cnt += 1
                 # Will rerun task, but still need to retain the result
@@ -532,6 +552,46 @@ class Pool(Executor):
             self._print_test_result(task_result)
             self._results[uid] = task_result
             self.ongoing.remove(uid)
+            self._publish_test_finished(uid, task_result)
+
+    def _record_task_time(self, uid, task_result):
+        """
+        Add the execution time of a task to the busy time of the workers and
+        record how long it waited for a worker in its report timer.
+        """
+        queued_at = self._queued_at.pop(uid, None)
+        assigned_at = self._assigned_at.pop(uid, None)
+        if assigned_at is None:
+            return
+
+        self._busy_time += (utcnow() - assigned_at).total_seconds()
+        self._tasks_done += 1
+        report = getattr(task_result.result, "report", None)
+        if report is not None and queued_at is not None:
+            report.timer["queue_wait"] = Interval(queued_at, assigned_at)
+
+    def statistics(self):
+        """
+        Worker utilization: time spent by the workers on tasks, over the time
+        they were available since the pool started.
+
+        :return: Pool size, number of tasks executed, busy and elapsed time
+            in seconds and utilization ratio.
+        :rtype: ``dict``
+        """
+        if self._started_at is None:
+            return None
+        elapsed = (
+            (self._stopped_at or utcnow()) - self._started_at
+        ).total_seconds()
+        capacity = elapsed * self.cfg.size
+        return {
+            "size": self.cfg.size,
+            "tasks": self._tasks_done,
+            "busy_time": self._busy_time,
+            "elapsed": elapsed,
+            "utilization": self._busy_time / capacity if capacity else None,
+        }
 
     def _handle_heartbeat(self, worker, request, response):
         """Handle a Heartbeat message received from a worker."""
@@ -566,7 +626,7 @@ class Pool(Executor):
             self.logger.test_info(
                 "Re-collect {} from {} to {}.".format(task, worker, self)
             )
-            self.unassigned.put((task.priority, uid))
+            self._enqueue(task, uid)
             self._task_retries_cnt[uid] += 1
 
     def _workers_monitoring(self):
@@ -719,6 +779,7 @@ class Pool(Executor):
             reason="Task discarded by {} - {}.".format(self, reason),
         )
         self.ongoing.remove(uid)
+        self._publish_test_finished(uid, self._results[uid])
 
     def _discard_pending_tasks(self):
         self.logger.critical("Discard pending tasks of {}.".format(self))
@@ -790,6 +851,8 @@ class Pool(Executor):
         if self.runpath is None:
             raise RuntimeError("runpath was not set correctly")
         self._metadata = {"runpath": self.runpath}
+        self._started_at = utcnow()
+        self._stopped_at = None
 
         self._conn.start()
 
@@ -832,6 +895,7 @@ class Pool(Executor):
 
         self._exit_loop = True
         super(Pool, self).stopping()  # stop the loop and the monitor
+        self._stopped_at = utcnow()
 
         self._conn.stop()
 
@@ -0,0 +1,273 @@
+"""
+Post-processing of test reports off the execution loop of the local runner.
+
+Reading and converting the output of a test binary (XML or JSON reports,
+channel records) can take as long as running the binary for huge suites.
+:py:class:`ReportProcessor` runs it in forked processes, a bounded number at
+a time, while the runner goes on with the next tests.
+
+Other threads may be running when a process is forked (drivers, exporters,
+the interactive HTTP server), and only the forking thread exists in the
+forked process: a lock that another thread held at that time is held for
+good. Python re-creates the locks of the ``logging`` module and handlers in
+the forked process, and the standard streams and the streams of the
+logging handlers are re-opened over the same file descriptors, so that
+logging and printing cannot deadlock. Jobs must not wait for other threads
+nor take other locks that threads of the runner may hold.
+"""
+
+import errno
+import gc
+import io
+import logging
+import os
+import pickle
+import select
+import struct
+import sys
+import traceback
+
+from collections import deque
+from concurrent.futures import Future
+
+# Size of the payload sent back by a processing process, ahead of it.
+_HEADER = struct.Struct("!Q")
+
+
+class ReportProcessingError(Exception):
+    """Report processing failed or its process died."""
+
+
+# Streams replaced in a processing process, kept from being deallocated as
+# deallocating them flushes them, which takes their locks.
+_INHERITED_STREAMS = []
+
+
+def _reopen(stream, reopened):
+    """
+    New stream over the file descriptor of an inherited one, the inherited
+    stream itself if it has none.
+    """
+    if id(stream) not in reopened:
+        try:
+            fd = stream.fileno()
+        except (AttributeError, ValueError, io.UnsupportedOperation):
+            return stream
+        reopened[id(stream)] = io.open(
+            os.dup(fd),
+            "w",
+            buffering=1 if getattr(stream, "line_buffering", False) else -1,
+            encoding=getattr(stream, "encoding", None),
+            errors=getattr(stream, "errors", None),
+        )
+        _INHERITED_STREAMS.append(stream)
+    return reopened[id(stream)]
+
+
+def _reopen_streams():
+    """
+    Replace the standard streams inherited from the parent process, and
+    the streams of the logging handlers, by new ones over the same file
+    descriptors. Their locks may have been held by another thread of the
+    parent when it forked.
+    """
+    reopened = {}
+    sys.stdout = _reopen(sys.stdout, reopened)
+    sys.stderr = _reopen(sys.stderr, reopened)
+
+    loggers = [logging.getLogger()] + [
+        logger
+        for logger in logging.Logger.manager.loggerDict.values()
+        if isinstance(logger, logging.Logger)
+    ]
+    for logger in loggers:
+        for handler in logger.handlers:
+            stream = getattr(handler, "stream", None)
+            if stream is not None:
+                # Not setStream, which flushes the inherited stream
+                handler.stream = _reopen(stream, reopened)
+
+
+def _serve(fd, func, args, kwargs):
+    """Run a job in the processing process and send back its outcome."""
+    try:
+        _reopen_streams()
+        # Objects inherited from the parent are left out of garbage
+        # collections, which would otherwise copy the memory they are in
+        gc.freeze()
+        try:
+            outcome = (True, func(*args, **kwargs))
+            data = pickle.dumps(outcome, pickle.HIGHEST_PROTOCOL)
+        except Exception:
+            data = pickle.dumps((False, traceback.format_exc()))
+        view = memoryview(_HEADER.pack(len(data)) + data)
+        while view:
+            view = view[os.write(fd, view) :]
+        sys.stdout.flush()
+        sys.stderr.flush()
+    finally:
+        os._exit(0)
+
+
+class _Job(object):
+    """Job running in a processing process."""
+
+    def __init__(self, future, fd):
+        self.future = future
+        self.fd = fd
+        self.data = bytearray()
+
+    def read(self):
+        """Read the available output, return whether the job is over."""
+        while True:
+            try:
+                chunk = os.read(self.fd, 1 << 20)
+            except OSError as exc:
+                if exc.errno in (errno.EAGAIN, errno.EWOULDBLOCK):
+                    return False
+                raise
+            if not chunk:
+                return True
+            self.data += chunk
+
+    def complete(self):
+        """Set the result of the job from its output."""
+        os.close(self.fd)
+        size = len(self.data) - _HEADER.size
+        if size < 0 or _HEADER.unpack(self.data[: _HEADER.size])[0] != size:
+            self.future.set_exception(
+                ReportProcessingError(
+                    "Report processing process died before sending its result"
+                )
+            )
+            return
+        passed, result = pickle.loads(self.data[_HEADER.size :])
+        if passed:
+            self.future.set_result(result)
+        else:
+            self.future.set_exception(ReportProcessingError(result))
+
+
+class ReportProcessor(object):
+    """
+    Bounded pool of processes post-processing test reports.
+
+    Each job runs in a process forked from the current one, which inherits
+    the state of the test it processes instead of having it pickled, and
+    sends its result back pickled. At most ``workers`` jobs run at the same
+    time. See the module documentation for the state of the other threads
+    in the forked processes.
+
+    Processes are only forked and results only collected by :py:meth:`poll`,
+    so that the runner calling it controls when it happens: tests check for
+    child processes started or ended while they run. Jobs run inline on
+    platforms without ``fork``.
+
+    :param workers: Maximum number of jobs run at the same time, defaults to
+        the number of CPUs.
+    :type workers: ``int``
+    """
+
+    def __init__(self, workers=None):
+        self.workers = workers or os.cpu_count() or 1
+        self._queue = deque()
+        self._running = []
+
+    def __repr__(self):
+        return "{}(workers={})".format(self.__class__.__name__, self.workers)
+
+    @property
+    def pending(self):
+        """Number of jobs queued or running."""
+        return len(self._queue) + len(self._running)
+
+    def submit(self, func, *args, **kwargs):
+        """
+        Schedule a job, started by the next :py:meth:`poll`.
+
+        :param func: Job to run, its result must be picklable.
+        :type func: ``callable``
+        :return: Future of the result of the job, raising
+            :py:class:`ReportProcessingError` if it failed.
+        :rtype: :py:class:`concurrent.futures.Future`
+        """
+        future = Future()
+        if hasattr(os, "fork"):
+            self._queue.append((future, func, args, kwargs))
+            return future
+
+        future.set_running_or_notify_cancel()
+        try:
+            future.set_result(func(*args, **kwargs))
+        except Exception as exc:
+            future.set_exception(exc)
+        return future
+
+    def poll(self, timeout=0):
+        """
+        Collect the results of the finished jobs, then start queued jobs
+        while fewer than ``workers`` are running.
+
+        :param timeout: Time to wait for a job to send its result, in
+            seconds, ``None`` to wait for one.
+        :type timeout: ``float`` or ``NoneType``
+        """
+        if self._running:
+            readable, _, _ = select.select(
+                [job.fd for job in self._running], [], [], timeout
+            )
+            for job in list(self._running):
+                if job.fd in readable and job.read():
+                    self._running.remove(job)
+                    job.complete()
+
+        while self._queue and len(self._running) < self.workers:
+            self._running.append(self._start(*self._queue.popleft()))
+
+    @staticmethod
+    def _start(future, func, args, kwargs):
+        """
+        Fork the process running a job. It is forked twice and the
+        intermediate process exits right away, so that the processing
+        process is not a child of the current one.
+        """
+        future.set_running_or_notify_cancel()
+        read_fd, write_fd = os.pipe()
+        sys.stdout.flush()
+        sys.stderr.flush()
+        pid = os.fork()
+        if pid == 0:
+            try:
+                os.close(read_fd)
+                if os.fork() == 0:
+                    _serve(write_fd, func, args, kwargs)
+            finally:
+                os._exit(0)
+
+        os.close(write_fd)
+        os.waitpid(pid, 0)
+        os.set_blocking(read_fd, False)
+        return _Job(future, read_fd)
+
+    def shutdown(self, wait=True):
+        """
+        Stop processing reports.
+
+        :param wait: Wait for the scheduled jobs to complete, otherwise they
+            are cancelled and the running ones abandoned.
+        :type wait: ``bool``
+        """
+        if wait:
+            while self.pending:
+                self.poll(timeout=None)
+            return
+
+        for future, _, _, _ in self._queue:
+            future.cancel()
+        self._queue.clear()
+        for job in self._running:
+            os.close(job.fd)
+            job.future.set_exception(
+                ReportProcessingError("Report processing abandoned")
+            )
+        self._running = []
@@ -3,6 +3,7 @@ import os
 import sys
 import subprocess
 import warnings
+from collections.abc import Mapping
 
 from schema import Or, Use, And
 
@@ -20,8 +21,17 @@ from testplan.common.entity import (
 )
 from testplan.common.utils import strings
 from testplan.common.utils.process import subprocess_popen
-from testplan.common.utils.timing import parse_duration, format_duration
-from testplan.common.utils.process import enforce_timeout, kill_process
+from testplan.common.utils.timing import (
+    Interval,
+    parse_duration,
+    format_duration,
+    utcnow,
+)
+from testplan.common.utils.process import (
+    enforce_timeout,
+    kill_process,
+    wait_with_usage,
+)
 from testplan.common.utils.logger import TESTPLAN_LOGGER
 
 from testplan.report import (
@@ -32,7 +42,8 @@ from testplan.report import (
     RuntimeStatus,
 )
 from testplan.testing.multitest.entries.assertions import RawAssertion
-from testplan.testing.multitest.entries.base import Attachment
+from testplan.testing.multitest.entries.base import Attachment, TableLog
+from testplan.testing.multitest.entries.schemas.base import registry
 
 
 TEST_INST_INDENT = 2
@@ -193,6 +204,32 @@ class Test(Runnable):
         """Stdout style input."""
         return self.cfg.stdout_style
 
+    @property
+    def report_journal(self):
+        """
+        Journal of the report of the test runner, if it has one and the test
+        runs in its process, ``None`` otherwise.
+        """
+        return self._runner_attribute("report_journal")
+
+    @property
+    def event_bus(self):
+        """
+        Event bus of the run, if it has one and the test runs in the process
+        of the test runner, ``None`` otherwise.
+        """
+        return self._runner_attribute("event_bus")
+
+    def _runner_attribute(self, name):
+        """Attribute of the closest parent of the test having it set."""
+        parent = getattr(self, "parent", None)
+        while parent is not None:
+            value = getattr(parent, name, None)
+            if value is not None:
+                return value
+            parent = getattr(parent, "parent", None)
+        return None
+
     @property
     def test_context(self):
         if (
@@ -249,7 +286,7 @@ class Test(Runnable):
                 )
         elif isinstance(test_obj, TestCaseReport):
             return style.display_testcase, TESTCASE_INDENT
-        elif isinstance(test_obj, dict):
+        elif isinstance(test_obj, Mapping):
             return style.display_assertion, ASSERTION_INDENT
         raise TypeError("Unsupported test object: {}".format(test_obj))
 
@@ -266,9 +303,10 @@ class Test(Runnable):
         entries = []  # Composed of (depth, report obj)
 
         def log_entry(depth, obj):
-            name = obj["description"] if isinstance(obj, dict) else obj.name
+            is_entry = isinstance(obj, Mapping)
+            name = obj["description"] if is_entry else obj.name
             try:
-                passed = obj["passed"] if isinstance(obj, dict) else obj.passed
+                passed = obj["passed"] if is_entry else obj.passed
             except KeyError:
                 passed = True  # Some report entries (i.e. Log) always pass
 
@@ -276,7 +314,7 @@ class Test(Runnable):
             display, indent = self.should_log_test_result(depth, obj, style)
 
             if display:
-                if isinstance(obj, dict):
+                if is_entry:
                     if obj["type"] == "RawAssertion":
                         header = obj["description"]
                         details = obj["content"]
@@ -383,6 +421,17 @@ class Test(Runnable):
         return self.result
 
 
+def _add_usage(usage, other):
+    """Resource usage of test processes run one after the other."""
+    if not usage or not other:
+        return usage or other
+    return {
+        "max_rss": max(usage["max_rss"] or 0, other["max_rss"] or 0) or None,
+        "user_time": usage["user_time"] + other["user_time"],
+        "system_time": usage["system_time"] + other["system_time"],
+    }
+
+
 class ProcessRunnerTestConfig(TestConfig):
     """
     Configuration object for
@@ -399,6 +448,18 @@ class ProcessRunnerTestConfig(TestConfig):
                 None, float, int, Use(parse_duration)
             ),
             ConfigOption("ignore_exit_codes", default=[]): [int],
+            ConfigOption("build", default=None): Or(
+                None, lambda x: callable(getattr(x, "build", None))
+            ),
+            ConfigOption("golden_files", default={}): {str: str},
+            ConfigOption("update_golden", default=False): bool,
+            # Inherited from the test runner if not set
+            ConfigOption("test_sample"): Or(
+                None, lambda x: callable(getattr(x, "select", None))
+            ),
+            ConfigOption("memory_growth_threshold", default=None): Or(
+                None, And(int, lambda x: x >= 0)
+            ),
         }
 
 
@@ -434,6 +495,33 @@ class ProcessRunnerTest(Test):
                     This can be disabled by providing a list of
                     numbers to ignore.
     :type ignore_exit_codes: ``list`` of ``int``
+    :param build: Optional build target (e.g. a
+                    :py:class:`~testplan.testing.cpp.build.CMakeTarget`)
+                    that produces the binary. It is requested as soon as
+                    the test is added to a plan and waited for before the
+                    binary is listed or run.
+    :type build: :py:class:`~testplan.testing.cpp.build.CMakeTarget`
+    :param golden_files: Output files of the test process mapped to the
+                    golden files they are compared to once the process has
+                    finished. Relative output paths are resolved against
+                    ``proc_cwd``.
+    :type golden_files: ``dict`` of ``str`` to ``str``
+    :param update_golden: Replace the golden files with the outputs instead
+                    of comparing them. Also exported to the test process as
+                    ``TESTPLAN_UPDATE_GOLDEN=1`` for the checks made by the
+                    test binary itself.
+    :type update_golden: ``bool``
+    :param test_sample: Only run a sample of the listed testcases through
+                    the native filter of the test binary, see
+                    :py:class:`~testplan.testing.sampling.Sample`. Taken
+                    from the test runner by default, test binaries that
+                    cannot run a sample run all their testcases.
+    :type test_sample: :py:class:`~testplan.testing.sampling.Sample`
+    :param memory_growth_threshold: Growth of the resident set size in bytes
+                    above which a testcase fails, for test binaries that
+                    record the memory usage of each test (e.g. with the
+                    listeners of ``testplan/gtest_listener.h``).
+    :type memory_growth_threshold: ``int``
 
     Also inherits all
     :py:class:`~testplan.testing.base.Test` options.
@@ -448,6 +536,7 @@ class ProcessRunnerTest(Test):
     _DEFAULT_SUITE_NAME = "All Tests"
     _VERIFICATION_SUITE_NAME = "ProcessChecks"
     _VERIFICATION_TESTCASE_NAME = "ExitCodeCheck"
+    _GOLDEN_TESTCASE_NAME = "GoldenFileCheck"
     _MAX_RETAINED_LOG_SIZE = 4096
 
     def __init__(self, **options):
@@ -462,6 +551,9 @@ class ProcessRunnerTest(Test):
         self._test_process_retcode = None  # will be set by `self.run_tests`
         self._test_process_killed = False
         self._test_has_run = False
+        self._build_failed = False
+        self._sample = None  # will be set by `self.run_tests`
+        self._report_deferred = False
 
     @property
     def stderr(self):
@@ -479,6 +571,14 @@ class ProcessRunnerTest(Test):
     def report_path(self):
         return os.path.join(self._runpath, "report.xml")
 
+    @property
+    def entries_path(self):
+        """
+        File the test binary can append structured entry records to, its path
+        is exported in the ``TESTPLAN_ENTRIES_FILE`` environment variable.
+        """
+        return os.path.join(self._runpath, "entries.jsonl")
+
     def test_command(self):
         """
         Override this to add extra options to the test command.
@@ -510,6 +610,9 @@ class ProcessRunnerTest(Test):
         if cmd is None:
             return [(self._DEFAULT_SUITE_NAME, ())]
 
+        if self.cfg.build:
+            self.cfg.build.build()
+
         proc = subprocess_popen(
             cmd,
             cwd=self.cfg.proc_cwd,
@@ -569,7 +672,14 @@ class ProcessRunnerTest(Test):
     def get_proc_env(self):
         self._json_ouput = os.path.join(self.runpath, "output.json")
         self.logger.debug("Json output: {}".format(self._json_ouput))
-        env = {"JSON_REPORT": self._json_ouput}
+        env = {
+            "JSON_REPORT": self._json_ouput,
+            "TESTPLAN_ENTRIES_FILE": self.entries_path,
+        }
+        if self.cfg.update_golden:
+            from testplan.common.utils import golden
+
+            env[golden.UPDATE_GOLDEN_ENV] = "1"
         env.update(
             {key.upper(): val for key, val in self.cfg.proc_env.items()}
         )
@@ -589,12 +699,33 @@ class ProcessRunnerTest(Test):
 
         return env
 
+    def request_build(self):
+        """
+        Start building the binary in the background, the build step of this
+        test will only have to wait for whatever is left to do.
+        """
+        request = getattr(self.cfg.build, "request", None)
+        if callable(request):
+            request()
+
+    def build_binary(self):
+        """
+        Build the binary via the ``build`` option. Tests are not run if the
+        build fails, as the binary would be missing or stale.
+        """
+        self._build_failed = True
+        with self.result.report.logged_exceptions():
+            self.cfg.build.build()
+            self._build_failed = False
+
     def run_tests(self):
         """
         Run the tests in a subprocess, record stdout & stderr on runpath.
         Optionally enforce a timeout and log timeout related messages in
         the given timeout log path.
         """
+        if self._build_failed:
+            return
 
         with self.result.report.logged_exceptions(), open(
             self.stderr, "w"
@@ -613,38 +744,213 @@ class ProcessRunnerTest(Test):
                 self.cfg._options["binary"] = os.path.abspath(self.cfg.binary)
 
             test_cmd = self.test_command()
+            if self.cfg.test_sample:
+                test_cmd = self._sample_command(test_cmd)
+            test_cmds = self._ordered_commands(test_cmd)
+            self._remove_entries()
+            if self.cfg.timeout:
+                # Appended to by each pass of this run only
+                open(self.timeout_log, "w").close()
+
+            start = utcnow()
+            usage = None
+            self._test_process_retcode = None
+            for test_cmd in test_cmds:
+                self.result.report.logger.debug(
+                    "Running {} - Command: {}".format(self, test_cmd)
+                )
 
-            self.result.report.logger.debug(
-                "Running {} - Command: {}".format(self, test_cmd)
-            )
+                if not test_cmd:
+                    raise ValueError(
+                        "Invalid test command generated for: {}".format(self)
+                    )
 
-            if not test_cmd:
-                raise ValueError(
-                    "Invalid test command generated for: {}".format(self)
+                retcode, pass_usage = self._run_test_process(
+                    test_cmd,
+                    stdout=stdout,
+                    stderr=stderr,
+                    timeout=self.cfg.timeout
+                    and self.cfg.timeout - (utcnow() - start).total_seconds(),
                 )
+                # The exit code of the first failing pass is kept
+                if not self._test_process_retcode:
+                    self._test_process_retcode = retcode
+                usage = _add_usage(usage, pass_usage)
+                if self._test_process_killed or not self.run_next_pass(
+                    retcode
+                ):
+                    break
+
+            # Overwritten when running again in interactive mode
+            self.result.report.timer["run"] = Interval(start, utcnow())
+            if usage:
+                self.result.report.meta["resource_usage"] = usage
+            self._test_has_run = True
 
-            self._test_process = subprocess_popen(
-                test_cmd,
-                stderr=stderr,
-                stdout=stdout,
-                cwd=self.cfg.proc_cwd,
-                env=self.get_proc_env(),
+    def _run_test_process(self, test_cmd, stdout, stderr, timeout):
+        """Run a test command, return its exit code and resource usage."""
+        self._test_process = subprocess_popen(
+            test_cmd,
+            stderr=stderr,
+            stdout=stdout,
+            cwd=self.cfg.proc_cwd,
+            env=self.get_proc_env(),
+        )
+
+        if timeout is None:
+            return wait_with_usage(self._test_process)
+
+        with open(self.timeout_log, "a") as timeout_log:
+            timeout_checker = enforce_timeout(
+                process=self._test_process,
+                timeout=max(timeout, 0),
+                output=timeout_log,
+                callback=self.timeout_callback,
             )
+            result = wait_with_usage(self._test_process)
+            timeout_checker.join()
+        return result
 
-            if self.cfg.timeout:
-                with open(self.timeout_log, "w") as timeout_log:
-                    timeout_checker = enforce_timeout(
-                        process=self._test_process,
-                        timeout=self.cfg.timeout,
-                        output=timeout_log,
-                        callback=self.timeout_callback,
-                    )
-                    self._test_process_retcode = self._test_process.wait()
-                    timeout_checker.join()
-            else:
-                self._test_process_retcode = self._test_process.wait()
+    def _ordered_commands(self, test_cmd):
+        """
+        Commands running the testcases in the order of a sorter that can be
+        pushed down to the native test selection, e.g. the testcases that
+        failed recently first (see
+        :py:class:`~testplan.testing.ordering.FailureHistorySorter`).
+        """
+        sorter = self.cfg.test_sorter
+        order = getattr(sorter, "order_test_context", None)
+        if not callable(order) or not sorter.should_sort_testcases():
+            return [test_cmd]
+
+        test_context = self.runnable_test_context()
+        if self._sample and not self._sample.sample.verify:
+            test_context = self._sample.suites()
+        units, failing = order(self.name, test_context)
+        test_cmds = self.test_command_order(test_cmd, units, failing)
+        if not test_cmds:
+            self.logger.debug("%s: testcases cannot be reordered", self)
+            return [test_cmd]
+
+        self.result.report.meta["order"] = {
+            "testcases": len(units),
+            "failed_recently": failing,
+            "passes": len(test_cmds),
+        }
+        if failing:
+            self.logger.info(
+                "%s: running %d testcases that failed recently first",
+                self,
+                failing,
+            )
+        return test_cmds
 
-            self._test_has_run = True
+    def test_command_order(self, test_cmd, units, failing):
+        """
+        Return the test commands running testcases in the given order,
+        through the native test selection of the binary. Commands are run
+        one after the other, e.g. a binary that cannot reorder its testcases
+        can run the ones that failed recently in a first pass.
+
+        :param test_cmd: Test command of an unordered run.
+        :type test_cmd: ``list`` of ``str``
+        :param units: (suite, testcase) pairs in run order, the testcase is
+            ``None`` for suites listed without testcases.
+        :type units: ``list`` of ``tuple``
+        :param failing: Number of testcases at the start of ``units`` that
+            failed in earlier runs.
+        :type failing: ``int``
+        :return: Commands to run, ``None`` if the testcases cannot be
+            reordered.
+        :rtype: ``list`` of ``list`` of ``str`` or ``NoneType``
+        """
+        return None
+
+    def run_next_pass(self, retcode):
+        """
+        Whether to run the next command returned by
+        :py:meth:`test_command_order` after a pass exited with ``retcode``,
+        e.g. not after a failure in fail-fast mode.
+
+        :param retcode: Exit code of the previous pass.
+        :type retcode: ``int``
+        :rtype: ``bool``
+        """
+        return True
+
+    def _sample_command(self, test_cmd):
+        """
+        Select the sample of testcases to run from the test listing, and
+        return the command running it (or all of them in verification mode).
+        Test binaries that cannot run a sample run all their testcases.
+        """
+        if (
+            type(self).test_command_sample
+            is ProcessRunnerTest.test_command_sample
+        ):
+            self.logger.info(
+                "%s: sampling testcases is not supported, running all"
+                " of them",
+                self,
+            )
+            return test_cmd
+
+        sample = self.cfg.test_sample
+        selection = sample.select(self.name, self.runnable_test_context())
+        sample_cmd = self.test_command_sample(selection)
+        if not sample_cmd:
+            self.logger.info(
+                "%s: the sampled testcases cannot be selected, running all"
+                " of them",
+                self,
+            )
+            return test_cmd
+
+        self._sample = selection
+        self.result.report.meta["sample"] = selection.to_dict()
+        self.logger.info(
+            "%s: sampled %d of %d testcases (seed %s)%s",
+            self,
+            len(selection),
+            selection.listed,
+            sample.seed,
+            ", running all of them to verify the sample"
+            if sample.verify
+            else "",
+        )
+        if sample.verify:
+            return test_cmd
+        return sample_cmd
+
+    def test_command_sample(self, selection):
+        """
+        Return the test command running the sampled testcases only, through
+        the native filter of the test binary. To be implemented by concrete
+        subclasses that support sampling.
+
+        :param selection: Sampled testcases.
+        :type selection: :py:class:`~testplan.testing.sampling.Selection`
+        :return: Command to run the sampled testcases, ``None`` if the
+            binary cannot select them, in which case all testcases are run.
+        :rtype: ``list`` of ``str`` or ``NoneType``
+        """
+        return None
+
+    def runnable_test_context(self):
+        """
+        Listed testcases that the test command runs, which samples and
+        orderings are made of. Override this if the test command runs only
+        some of the listed testcases, e.g. those of a native filter.
+
+        :return: Test context as returned by ``get_test_context``.
+        :rtype: ``list`` of ``list``
+        """
+        return self.test_context
+
+    def _remove_entries(self):
+        """Records are appended, do not mix them with those of earlier runs."""
+        if os.path.exists(self.entries_path):
+            os.remove(self.entries_path)
 
     def read_test_data(self):
         """
@@ -723,8 +1029,72 @@ class ProcessRunnerTest(Test):
             entries=[testcase_report],
         )
 
+        if self.cfg.golden_files and retcode is not None:
+            suite_report.append(self.get_golden_file_report())
+
         return suite_report
 
+    def get_golden_file_report(self):
+        """
+        Compare the output files of the test process against their golden
+        files (or update the golden files), one assertion per file followed
+        by a table of the differing regions.
+        """
+        # Only tests with golden files need numpy
+        from testplan.common.utils import golden
+
+        testcase_report = TestCaseReport(
+            name=self._GOLDEN_TESTCASE_NAME,
+            uid=self._GOLDEN_TESTCASE_NAME,
+            suite_related=True,
+        )
+        cwd = self.cfg.proc_cwd or os.getcwd()
+
+        for output, golden_file in sorted(self.cfg.golden_files.items()):
+            output = os.path.join(cwd, output)
+            description = "Golden file check: {}".format(golden_file)
+            try:
+                result = golden.check_golden(
+                    output, golden_file, update=self.cfg.update_golden
+                )
+            except (IOError, OSError) as exc:
+                testcase_report.append(
+                    registry.serialize(
+                        RawAssertion(
+                            description=description,
+                            content="{}: {}".format(type(exc).__name__, exc),
+                            passed=False,
+                        )
+                    )
+                )
+                continue
+
+            testcase_report.append(
+                registry.serialize(
+                    RawAssertion(
+                        description=description,
+                        content="{} vs {}\n{}".format(
+                            output, golden_file, golden.summary(result)
+                        ),
+                        passed=result.passed,
+                    )
+                )
+            )
+            if result.regions:
+                testcase_report.append(
+                    registry.serialize(
+                        TableLog(
+                            table=golden.regions_table(
+                                result, output, golden_file
+                            ),
+                            description="Differing regions",
+                        )
+                    )
+                )
+
+        testcase_report.runtime_status = RuntimeStatus.FINISHED
+        return testcase_report
+
     def update_test_report(self):
         """
         Update current instance's test report with generated sub reports from
@@ -739,29 +1109,150 @@ class ProcessRunnerTest(Test):
             )
             return
 
-        if len(self.result.report):
+        self.merge_test_report(self.process_test_report())
+
+    def process_test_report(self):
+        """
+        Convert the raw test data into report entries. Only the runpath and
+        the report are read, so that the local runner can run it in another
+        process while the next tests run, see
+        :py:class:`~testplan.runners.processing.ReportProcessor`.
+
+        :return: Report entries, and meta data, logs, status override and
+            processing interval of the report.
+        :rtype: ``dict``
+        """
+        report = self.result.report
+        start = utcnow()
+        entries = []
+        with report.logged_exceptions():
+            entries = self.process_test_data(self.read_test_data())
+        return {
+            "entries": entries,
+            "meta": report.meta,
+            "logs": report.logs,
+            "status_override": report.status_override,
+            "interval": Interval(start, utcnow()),
+        }
+
+    def merge_test_report(self, processed):
+        """
+        Update the test report with the outcome of
+        :py:meth:`process_test_report`, then with the process checks.
+
+        :param processed: Outcome of the report processing.
+        :type processed: ``dict``
+        """
+        report = self.result.report
+        if len(report):
             raise ValueError(
                 "Cannot update test report,"
-                " it already has children: {}".format(self.result.report)
+                " it already has children: {}".format(report)
             )
 
-        with self.result.report.logged_exceptions():
-            self.result.report.extend(
-                self.process_test_data(self.read_test_data())
-            )
+        # Processed from a copy of the report in a processing process
+        report.meta = processed["meta"]
+        report.logs = processed["logs"]
+        report.status_override = processed["status_override"]
+        report.timer["process_results"] = processed["interval"]
+        report.extend(processed["entries"])
 
         # Check process exit code as last step, as we don't want to create
         # an error log if the report was populated
         # (with possible failures) already
-        self.result.report.append(
+        report.append(
             self.get_process_check_report(
                 self._test_process_retcode, self.stdout, self.stderr
             )
         )
 
+        if self._sample and self._sample.sample.verify:
+            coverage = self._sample.coverage(
+                report, ignored_suites=(self._VERIFICATION_SUITE_NAME,)
+            )
+            report.meta["sample"]["coverage"] = coverage
+            self.logger.info(
+                "%s: the sample would have caught %d of %d failed testcases",
+                self,
+                coverage["caught"],
+                coverage["failed"],
+            )
+
+    def defer_report_processing(self):
+        """
+        Leave the update of the test report to the runner, which calls
+        :py:meth:`submit_test_report` once the tests have run.
+        """
+        self._report_deferred = True
+
+    def submit_test_report(self, processor):
+        """
+        Schedule the processing of the test report with a report processor.
+        The report is updated at once if there is nothing to process.
+
+        :param processor: Report processor of the runner.
+        :type processor:
+            :py:class:`~testplan.runners.processing.ReportProcessor`
+        :return: Future of the processing outcome, to be passed to
+            :py:meth:`complete_test_report`, ``None`` if the report is
+            complete.
+        :rtype: :py:class:`concurrent.futures.Future` or ``NoneType``
+        """
+        if self._test_process_killed or not self._test_has_run:
+            self.complete_test_report(None)
+            return None
+        return processor.submit(self.process_test_report)
+
+    def complete_test_report(self, future):
+        """
+        Update the test report with the outcome of its processing and log
+        the test results, the steps skipped by deferring report processing.
+
+        :param future: Future returned by :py:meth:`submit_test_report`.
+        :type future: :py:class:`concurrent.futures.Future` or ``NoneType``
+        """
+        processed = None
+        if future is not None:
+            with self.result.report.logged_exceptions():
+                processed = future.result()
+        if processed is None:
+            # Nothing processed, only the process checks are reported
+            self.result.report.append(
+                self.get_process_check_report(
+                    self._test_process_retcode, self.stdout, self.stderr
+                )
+            )
+        else:
+            self.merge_test_report(processed)
+        self.propagate_tag_indices()
+        self.log_test_results(top_down=False)
+
+    def record_memory_growth(self, summary):
+        """
+        Record the memory growth of the testcases in the report meta data and
+        log the ones above ``memory_growth_threshold``.
+
+        :param summary: Memory growth summary, see
+            :py:func:`~testplan.testing.cpp.channel.memory_summary`.
+        :type summary: ``dict`` or ``NoneType``
+        """
+        if not summary:
+            return
+        self.result.report.meta["memory"] = summary
+        if summary["flagged"]:
+            self.logger.warning(
+                "%s: memory of %d testcases grew by more than %d bytes: %s",
+                self,
+                len(summary["flagged"]),
+                summary["threshold"],
+                ", ".join(summary["flagged"]),
+            )
+
     def pre_resource_steps(self):
         """Runnable steps to be executed before environment starts."""
         self._add_step(self.make_runpath_dirs)
+        if self.cfg.build:
+            self._add_step(self.build_binary)
         if self.cfg.before_start:
             self._add_step(self.cfg.before_start)
 
@@ -769,9 +1260,10 @@ class ProcessRunnerTest(Test):
         if self.cfg.after_start:
             self._add_step(self.cfg.after_start)
         self._add_step(self.run_tests)
-        self._add_step(self.update_test_report)
-        self._add_step(self.propagate_tag_indices)
-        self._add_step(self.log_test_results, top_down=False)
+        if not self._report_deferred:
+            self._add_step(self.update_test_report)
+            self._add_step(self.propagate_tag_indices)
+            self._add_step(self.log_test_results, top_down=False)
         if self.cfg.before_stop:
             self._add_step(self.cfg.before_stop)
 
@@ -831,10 +1323,13 @@ class ProcessRunnerTest(Test):
             with the UID of this test.
         """
         self.make_runpath_dirs()
+        if self.cfg.build:
+            self.cfg.build.build()
         test_cmd = self.test_command_filter(
             testsuite_pattern, testcase_pattern
         )
         self.logger.debug("test_cmd = %s", test_cmd)
+        self._remove_entries()
 
         with open(self.stdout, mode="w+") as stdout, open(
             self.stderr, mode="w+"
@@ -862,10 +1357,8 @@ class ProcessRunnerTest(Test):
                 for testcase_report in suite_report:
                     yield testcase_report, [self.uid(), suite_report.uid]
 
-        yield (
-            process_report[self._VERIFICATION_TESTCASE_NAME],
-            [self.uid(), process_report.uid],
-        )
+        for testcase_report in process_report:
+            yield testcase_report, [self.uid(), process_report.uid]
 
     def test_command_filter(self, testsuite_pattern, testcase_pattern):
         """
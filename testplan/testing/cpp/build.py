@@ -0,0 +1,431 @@
+"""
+CMake build integration for the C++ test runners.
+
+A :py:class:`CMakeProject` is configured once and then builds its targets on
+demand. Build requests from all test instances sharing a project are batched
+into a single incremental, parallel ``cmake --build`` invocation, and every
+target is reported as soon as it has been linked, so that tests can start
+running while the rest of the project is still being built.
+
+.. code-block:: python
+
+    project = CMakeProject(source_dir="test", build_dir="test/build")
+    target = project.target("runTests")
+
+    plan.add(GTest(name="My GTest", binary=target.binary, build=target))
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import threading
+import time
+
+try:
+    import fcntl
+except ImportError:  # Windows
+    fcntl = None
+
+from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.common.utils.path import makedirs
+from testplan.common.utils.process import subprocess_popen
+
+# Printed by the Makefile generators once a target has been linked, e.g.
+# "[100%] Built target runTests".
+BUILT_TARGET_PATTERN = re.compile(r"Built target (\S+)\s*$")
+
+# Printed by Ninja once an executable has been linked, e.g.
+# "[4/4] Linking CXX executable bin/runTests": when its output is not a
+# terminal, Ninja prints the build steps as they finish.
+NINJA_LINKED_PATTERN = re.compile(
+    r"^\[\d+/\d+\] Linking \S+ executable (\S+)\s*$"
+)
+
+
+def built_target(generator, line):
+    """
+    Target reported as built by a line of the output of a build.
+
+    :param generator: CMake generator of the build tree.
+    :type generator: ``str``
+    :param line: Line of the output of ``cmake --build``.
+    :type line: ``str``
+    :return: Name of the target, ``None`` if the line does not report one.
+    :rtype: ``str`` or ``NoneType``
+    """
+    if generator.startswith("Ninja"):
+        match = NINJA_LINKED_PATTERN.search(line)
+        if match:
+            # Executables are named after their target by default
+            return os.path.splitext(os.path.basename(match.group(1)))[0]
+    else:
+        match = BUILT_TARGET_PATTERN.search(line)
+        if match:
+            return match.group(1)
+    return None
+
+
+def reports_built_targets(generator):
+    """Whether builds of a generator report targets as they are built."""
+    return generator.startswith("Ninja") or generator.endswith("Makefiles")
+
+
+class _TargetState(object):
+    """Build progress of a single target within a test run."""
+
+    def __init__(self):
+        self.event = threading.Event()
+        self.error = None
+
+
+class CMakeProject(object):
+    """
+    A CMake source tree whose targets are built by the test runners before
+    they are executed.
+
+    :param source_dir: Directory containing the top level ``CMakeLists.txt``.
+    :type source_dir: ``str``
+    :param build_dir: Build directory, defaults to ``<source_dir>/build``.
+    :type build_dir: ``str``
+    :param generator: Optional CMake generator (e.g. ``Ninja``). Targets
+        are reported as soon as they are linked with the Makefile
+        generators, and with Ninja for executables named after their
+        target. With other generators, they are only reported once the
+        whole build has finished.
+    :type generator: ``str``
+    :param build_type: Optional ``CMAKE_BUILD_TYPE`` value.
+    :type build_type: ``str``
+    :param cmake_args: Extra arguments for the configure step.
+    :type cmake_args: ``list`` of ``str``
+    :param jobs: Number of parallel build jobs, defaults to the CPU count.
+    :type jobs: ``int``
+    :param batch_window: Seconds to wait for further build requests before
+        starting a build, so that targets requested by several test instances
+        are built by a single invocation.
+    :type batch_window: ``float``
+    :param cmake: CMake executable.
+    :type cmake: ``str``
+    """
+
+    def __init__(
+        self,
+        source_dir,
+        build_dir=None,
+        generator=None,
+        build_type=None,
+        cmake_args=None,
+        jobs=None,
+        batch_window=0.5,
+        cmake="cmake",
+    ):
+        self.source_dir = os.path.abspath(source_dir)
+        self.build_dir = os.path.abspath(
+            build_dir or os.path.join(self.source_dir, "build")
+        )
+        self.generator = generator
+        self.build_type = build_type
+        self.cmake_args = list(cmake_args or [])
+        self.jobs = jobs or os.cpu_count() or 1
+        self.batch_window = batch_window
+        self.cmake = cmake
+        self.logger = TESTPLAN_LOGGER
+
+        self._lock = threading.Lock()
+        self._configure_lock = threading.Lock()
+        self._configured = False
+        self._configure_error = None
+        self._build_generator = None
+        self._targets = {}
+        self._pending = []
+        self._builder = None
+
+    def __repr__(self):
+        return "{}[{}]".format(self.__class__.__name__, self.source_dir)
+
+    @property
+    def log_path(self):
+        """Path of the log file that collects all build output."""
+        return os.path.join(self.build_dir, "testplan_build.log")
+
+    @property
+    def available(self):
+        """Whether the CMake executable can be found."""
+        return shutil.which(self.cmake) is not None
+
+    def target(self, name, binary=None):
+        """
+        Return a buildable target of this project.
+
+        :param name: CMake target name.
+        :type name: ``str``
+        :param binary: Path of the linked binary, defaults to
+            ``<build_dir>/<name>``.
+        :type binary: ``str``
+        :return: Target that can be passed to a test runner as ``build``.
+        :rtype: :py:class:`CMakeTarget`
+        """
+        return CMakeTarget(self, name, binary=binary)
+
+    def configure(self):
+        """Run the CMake configure step, once per project."""
+        with self._configure_lock:
+            if self._configured:
+                if self._configure_error:
+                    raise RuntimeError(self._configure_error)
+                return
+            self._configured = True
+
+            # Configuring an existing build tree is incremental, it is still
+            # done once per run so that targets added since the last run are
+            # known before several of them are built by the same invocation.
+            makedirs(self.build_dir)
+            cmd = [self.cmake, self.source_dir]
+            if self.generator:
+                cmd.extend(["-G", self.generator])
+            if self.build_type:
+                cmd.append("-DCMAKE_BUILD_TYPE={}".format(self.build_type))
+            cmd.extend(self.cmake_args)
+
+            try:
+                with self._exclusive(), open(self.log_path, "a") as log:
+                    self.logger.debug("Configuring %s: %s", self, cmd)
+                    retcode = subprocess.call(
+                        cmd,
+                        cwd=self.build_dir,
+                        stdout=log,
+                        stderr=subprocess.STDOUT,
+                    )
+            except Exception as exc:
+                self._configure_error = "Configuring {} failed: {}".format(
+                    self, exc
+                )
+                raise RuntimeError(self._configure_error)
+            if retcode != 0:
+                self._configure_error = (
+                    "Configuring {} failed with exit code {}, see {}".format(
+                        self, retcode, self.log_path
+                    )
+                )
+                raise RuntimeError(self._configure_error)
+
+            self._build_generator = self._cached_generator()
+            if not reports_built_targets(self._build_generator):
+                self.logger.warning(
+                    "%s: the %s generator does not report targets as they"
+                    " are built, tests wait for the whole build to finish",
+                    self,
+                    self._build_generator,
+                )
+
+    def _cached_generator(self):
+        """
+        Generator of the build tree, which may have been configured before
+        or by the ``CMAKE_GENERATOR`` environment variable.
+        """
+        prefix = "CMAKE_GENERATOR:INTERNAL="
+        try:
+            with open(os.path.join(self.build_dir, "CMakeCache.txt")) as cache:
+                for line in cache:
+                    if line.startswith(prefix):
+                        return line[len(prefix) :].strip()
+        except (IOError, OSError):
+            pass
+        return self.generator or ""
+
+    def request(self, *targets):
+        """
+        Schedule targets to be built without waiting for them. Targets
+        requested within ``batch_window`` of each other are built together.
+        Targets that failed to build are built again.
+        """
+        with self._lock:
+            for target in targets:
+                state = self._targets.get(target)
+                if state is not None and not (
+                    state.event.is_set() and state.error
+                ):
+                    continue
+                self._targets[target] = _TargetState()
+                self._pending.append(target)
+
+            if self._pending and self._builder is None:
+                self._builder = threading.Thread(
+                    target=self._build_loop,
+                    name="CMakeBuilder[{}]".format(
+                        os.path.basename(self.source_dir)
+                    ),
+                )
+                self._builder.daemon = True
+                self._builder.start()
+
+    def wait(self, target, timeout=None):
+        """
+        Block until the target has been built.
+
+        :raises RuntimeError: if the target could not be built.
+        """
+        state = self._targets[target]
+        if not state.event.wait(timeout):
+            raise RuntimeError(
+                "Timeout after {}s while building {} of {}".format(
+                    timeout, target, self
+                )
+            )
+        if state.error:
+            raise RuntimeError(state.error)
+
+    def build(self, *targets, **kwargs):
+        """
+        Build the targets (batched with any other outstanding requests) and
+        wait for them to be linked.
+
+        :param timeout: Optional timeout in seconds.
+        :type timeout: ``float``
+        """
+        self.request(*targets)
+        for target in targets:
+            self.wait(target, timeout=kwargs.get("timeout"))
+
+    def _build_loop(self):
+        while True:
+            # Give other test instances the chance to request their targets
+            # so that they are all built by the same invocation.
+            time.sleep(self.batch_window)
+            with self._lock:
+                batch, self._pending = self._pending, []
+                if not batch:
+                    self._builder = None
+                    return
+            self._build_batch(batch)
+
+    def _build_batch(self, batch):
+        # Tests wait for their targets, so whatever goes wrong every target
+        # of the batch must be finished.
+        try:
+            self._run_build(batch)
+        except Exception as exc:
+            self.logger.debug("Building %s of %s failed: %s", batch, self, exc)
+            self._finish(batch, str(exc))
+
+    def _run_build(self, batch):
+        self.configure()
+
+        cmd = [
+            self.cmake,
+            "--build",
+            self.build_dir,
+            "--parallel",
+            str(self.jobs),
+            "--target",
+        ] + batch
+        start_time = time.time()
+
+        with self._exclusive(), open(self.log_path, "a") as log:
+            self.logger.debug("Building %s: %s", self, cmd)
+            proc = subprocess_popen(
+                cmd,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.STDOUT,
+                universal_newlines=True,
+            )
+            try:
+                for line in proc.stdout:
+                    log.write(line)
+                    target = built_target(self._build_generator, line)
+                    if target in batch:
+                        # Linked, its tests do not need to wait for the
+                        # others.
+                        log.flush()
+                        self._finish([target])
+                retcode = proc.wait()
+            finally:
+                if proc.poll() is None:
+                    proc.kill()
+                    proc.wait()
+
+        self.logger.debug(
+            "Built %s of %s in %.2fs, exit code %d",
+            batch,
+            self,
+            time.time() - start_time,
+            retcode,
+        )
+        if retcode == 0:
+            self._finish(batch)
+        else:
+            self._finish(
+                batch,
+                "Building {} failed with exit code {}, see {}".format(
+                    self, retcode, self.log_path
+                ),
+            )
+
+    def _finish(self, targets, error=None):
+        for target in targets:
+            state = self._targets[target]
+            if not state.event.is_set():
+                state.error = error
+                state.event.set()
+
+    def _exclusive(self):
+        """
+        Serialize builds of the same tree across processes (e.g. tests
+        materialized by several workers of a process pool).
+        """
+        return _FileLock(os.path.join(self.build_dir, ".testplan_build.lock"))
+
+
+class _FileLock(object):
+    """Advisory lock on a file, no-op where ``fcntl`` is not available."""
+
+    def __init__(self, path):
+        self.path = path
+        self._file = None
+
+    def __enter__(self):
+        if fcntl is not None:
+            self._file = open(self.path, "w")
+            fcntl.flock(self._file, fcntl.LOCK_EX)
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        if self._file is not None:
+            fcntl.flock(self._file, fcntl.LOCK_UN)
+            self._file.close()
+            self._file = None
+
+
+class CMakeTarget(object):
+    """
+    A single target of a :py:class:`CMakeProject`, to be passed as the
+    ``build`` option of a test runner.
+
+    :param project: Project the target belongs to.
+    :type project: :py:class:`CMakeProject`
+    :param name: CMake target name.
+    :type name: ``str``
+    :param binary: Path of the linked binary, defaults to
+        ``<build_dir>/<name>``.
+    :type binary: ``str``
+    """
+
+    def __init__(self, project, name, binary=None):
+        self.project = project
+        self.name = name
+        self.binary = os.path.abspath(
+            binary or os.path.join(project.build_dir, name)
+        )
+
+    def __repr__(self):
+        return "{}[{}:{}]".format(
+            self.__class__.__name__, self.project.source_dir, self.name
+        )
+
+    def request(self):
+        """Schedule the target to be built in the background."""
+        self.project.request(self.name)
+
+    def build(self, timeout=None):
+        """Build the target and block until it has been linked."""
+        self.project.build(self.name, timeout=timeout)
@@ -0,0 +1,655 @@
+"""
+Structured entries reported by C++ test binaries.
+
+The C++ runners export the path of a file in the runpath via the
+``TESTPLAN_ENTRIES_FILE`` environment variable. Test code built with the
+headers in :py:data:`INCLUDE_DIR` (e.g. ``testplan/gtest.h``) appends one JSON
+record per line to that file and refers to a record from the failure message
+with a ``[testplan:entry:<id>]`` marker. When the test results are parsed,
+referenced records are rendered as structured report entries instead of the
+raw failure text.
+"""
+
+import collections
+import datetime
+import json
+import os
+import re
+
+import pytz
+
+from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.common.utils.timing import Interval
+from testplan.testing.multitest.entries import assertions
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.base import Histogram, TableLog
+
+#: Directory to add to the include path of C++ tests, e.g.
+#: ``-I$(python -c "from testplan.testing.cpp.channel import INCLUDE_DIR;
+#: print(INCLUDE_DIR)")``
+INCLUDE_DIR = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "include"
+)
+
+ENTRIES_ENV = "TESTPLAN_ENTRIES_FILE"
+
+MARKER_PATTERN = re.compile(r"[ \t]*\[testplan:entry:(\w+)\]")
+
+EPOCH = datetime.datetime(1970, 1, 1, tzinfo=pytz.utc)
+
+_RENDERERS = {}
+
+
+def renderer(record_type):
+    """
+    Decorator that registers a function rendering records of the given type
+    into a list of entries. It receives the record, the failure text without
+    markers and whether the failure is a passing one.
+    """
+
+    def _register(func):
+        _RENDERERS[record_type] = func
+        return func
+
+    return _register
+
+
+def read_records(path):
+    """
+    Read the records written by a test binary.
+
+    :param path: Path of the channel file.
+    :type path: ``str``
+    :return: Records by id, empty if the file does not exist.
+    :rtype: ``dict``
+    """
+    records = {}
+    if not path or not os.path.isfile(path):
+        return records
+
+    with open(path) as channel_file:
+        for line in channel_file:
+            try:
+                record = json.loads(line)
+                records[record["id"]] = record
+            except (ValueError, KeyError, TypeError):
+                # A test binary killed while writing leaves a partial line.
+                TESTPLAN_LOGGER.debug("Invalid entry record: %r", line)
+    return records
+
+
+def render(records, description, content, passed):
+    """
+    Create the entries of a single result of a test binary (e.g. a failure
+    element of the XML report).
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :param description: Description of the raw entry (e.g. ``failure``).
+    :type description: ``str``
+    :param content: Raw result text, which may contain markers.
+    :type content: ``str``
+    :param passed: Whether the result is a passing one.
+    :type passed: ``bool``
+    :return: Structured entries for the referenced records, or a single
+        :py:class:`~testplan.testing.multitest.entries.assertions.RawAssertion`.
+    :rtype: ``list``
+    """
+    content = content or ""
+    referenced = [
+        records[uid]
+        for uid in MARKER_PATTERN.findall(content)
+        if uid in records and records[uid].get("type") in _RENDERERS
+    ]
+    if not referenced:
+        return [
+            RawAssertion(
+                description=description, content=content, passed=passed
+            )
+        ]
+
+    text = MARKER_PATTERN.sub("", content)
+    entries = []
+    for record in referenced:
+        entries.extend(_RENDERERS[record["type"]](record, text, passed))
+    return entries
+
+
+def _mismatch_row(mismatch, worst=False):
+    return [
+        "{}{}".format(mismatch["index"], " (worst)" if worst else ""),
+        repr(mismatch["actual"]),
+        repr(mismatch["expected"]),
+        "{:.6g}".format(mismatch["abs_err"]),
+        "{:.6g}".format(mismatch["rel_err"]),
+        mismatch["ulps"],
+    ]
+
+
+@renderer("array_compare")
+def render_array_compare(record, text, passed):
+    """
+    Summary assertion of a bulk numeric comparison, followed by a table of
+    the first mismatches (and the worst one, if not among them).
+    """
+    summary = RawAssertion(
+        description="{} vs {}: {} of {} elements differ".format(
+            record["actual_expr"],
+            record["expected_expr"],
+            record["mismatches"],
+            record["size"],
+        ),
+        content=text,
+        passed=passed,
+    )
+
+    worst = record.get("worst_entry")
+    reported = {mismatch["index"] for mismatch in record["first"]}
+    rows = [
+        _mismatch_row(
+            mismatch,
+            worst=worst is not None and mismatch["index"] == worst["index"],
+        )
+        for mismatch in record["first"]
+    ]
+    if worst is not None and worst["index"] not in reported:
+        rows.append(_mismatch_row(worst, worst=True))
+    if not rows:
+        return [summary]
+
+    columns = ["Index", "Actual", "Expected", "Abs Error", "Rel Error", "ULPs"]
+    table = TableLog(
+        table=[columns] + rows,
+        description="First {} of {} mismatches (abs_tol={}, rel_tol={}, "
+        "ulps={})".format(
+            len(record["first"]),
+            record["mismatches"],
+            record["abs_tol"],
+            record["rel_tol"],
+            record["ulps"],
+        ),
+    )
+    return [summary, table]
+
+
+@renderer("golden_diff")
+def render_golden_diff(record, text, passed):
+    """
+    Summary assertion of a golden file check made by the test binary,
+    followed by a table of the differing regions.
+    """
+    summary = RawAssertion(
+        description="Golden file check: {}".format(record["golden"]),
+        content=text,
+        passed=passed,
+    )
+    if not record["regions"]:
+        return [summary]
+
+    table = [["Offset", "Length", "Actual", "Golden"]] + [
+        [
+            region["offset"],
+            region["length"],
+            region["actual"],
+            region["golden"],
+        ]
+        for region in record["regions"]
+    ]
+    return [
+        summary,
+        TableLog(
+            table=table,
+            description="Differing regions{}".format(
+                " (truncated)" if record["truncated"] else ""
+            ),
+        ),
+    ]
+
+
+def attached_entries(records, test, suite=""):
+    """
+    Entries of the records attached to a testcase instead of being referenced
+    by a failure, e.g. passing latency measurements.
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :param test: Name of the testcase as reported by the test binary.
+    :type test: ``str``
+    :param suite: Name of the test suite, empty for Cppunit tests.
+    :type suite: ``str``
+    :return: Entries to append to the testcase report.
+    :rtype: ``list``
+    """
+    entries = []
+    for record in records.values():
+        if (
+            record.get("attached")
+            and record.get("test") == test
+            and record.get("suite", "") == suite
+            and record.get("type") in _RENDERERS
+        ):
+            entries.extend(
+                _RENDERERS[record["type"]](
+                    record, "", record.get("passed", True)
+                )
+            )
+    return entries
+
+
+def test_intervals(records):
+    """
+    Run intervals of the testcases timed by ``testplan/cppunit_listener.h``.
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :return: Intervals by (suite name, testcase name).
+    :rtype: ``dict``
+    """
+    intervals = {}
+    for record in records.values():
+        if record.get("type") == "test_time":
+            start = EPOCH + datetime.timedelta(
+                microseconds=record["start_us"]
+            )
+            intervals[(record.get("suite", ""), record["test"])] = Interval(
+                start, start + datetime.timedelta(seconds=record["elapsed"])
+            )
+    return intervals
+
+
+def forked_death_tests(records):
+    """
+    Summary of the death tests run by the fork server of
+    ``testplan/fork_server.h``.
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :return: Number of death tests run by the fork server, their total run
+        time and the time saved by not re-executing the binary for each of
+        them, in seconds. ``None`` if there was none.
+    :rtype: ``dict`` or ``NoneType``
+    """
+    forked = [
+        record
+        for record in records.values()
+        if record.get("type") == "forked_death_test"
+    ]
+    if not forked:
+        return None
+    return {
+        "forked": len(forked),
+        "elapsed": sum(record["elapsed"] for record in forked),
+        "time_saved": sum(record["saved"] for record in forked),
+    }
+
+
+def test_memory(records):
+    """
+    Memory usage of the process before and after each test, recorded by the
+    listeners of ``testplan/gtest_listener.h`` and
+    ``testplan/cppunit_listener.h``.
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :return: ``rss_start``, ``rss_end`` and ``rss_delta`` in bytes, and
+        ``heap_delta`` (``None`` if not sampled) by (suite name, testcase
+        name), in run order.
+    :rtype: ``collections.OrderedDict``
+    """
+    memory = collections.OrderedDict()
+    for record in records.values():
+        if record.get("type") == "test_memory":
+            heap_delta = None
+            if "heap_start" in record:
+                heap_delta = record["heap_end"] - record["heap_start"]
+            memory[(record.get("suite", ""), record["test"])] = {
+                "rss_start": record["rss_start"],
+                "rss_end": record["rss_end"],
+                "rss_delta": record["rss_end"] - record["rss_start"],
+                "heap_delta": heap_delta,
+            }
+    return memory
+
+
+def format_bytes(size):
+    """Human readable size, e.g. ``12.5MB``."""
+    for unit, scale in (("GB", 1 << 30), ("MB", 1 << 20), ("KB", 1 << 10)):
+        if abs(size) >= scale:
+            return "{:.1f}{}".format(size / scale, unit)
+    return "{}B".format(size)
+
+
+def memory_growth_entries(usage, threshold):
+    """
+    Entries of a testcase whose memory grew beyond a threshold.
+
+    :param usage: Memory usage of the testcase, see :py:func:`test_memory`.
+    :type usage: ``dict`` or ``NoneType``
+    :param threshold: Growth of the resident set size in bytes above which
+        the testcase fails, ``None`` to not check it.
+    :type threshold: ``int`` or ``NoneType``
+    :return: A failing assertion if the testcase grew beyond the threshold.
+    :rtype: ``list``
+    """
+    if not usage or threshold is None or usage["rss_delta"] <= threshold:
+        return []
+    content = "RSS grew by {} ({} to {}), above {}".format(
+        format_bytes(usage["rss_delta"]),
+        format_bytes(usage["rss_start"]),
+        format_bytes(usage["rss_end"]),
+        format_bytes(threshold),
+    )
+    if usage["heap_delta"] is not None:
+        content += ", heap grew by {}".format(
+            format_bytes(usage["heap_delta"])
+        )
+    return [
+        RawAssertion(
+            description="Memory growth", content=content, passed=False
+        )
+    ]
+
+
+def memory_summary(memory, threshold, name_format="{}.{}", top=5):
+    """
+    Memory growth of the tests of a binary, for the report meta data.
+
+    :param memory: Memory usage returned by :py:func:`test_memory`.
+    :type memory: ``dict``
+    :param threshold: Growth of the resident set size in bytes above which
+        a testcase is flagged, ``None`` to not flag any.
+    :type threshold: ``int`` or ``NoneType``
+    :param name_format: Format of testcase names from suite and test names.
+    :type name_format: ``str``
+    :param top: Number of testcases with the largest growth to list.
+    :type top: ``int``
+    :return: RSS at the start of the first test and at the end of the last
+        one, the testcases with the largest growth and the flagged ones.
+        ``None`` if no memory usage was recorded.
+    :rtype: ``dict`` or ``NoneType``
+    """
+    if not memory:
+        return None
+
+    def name(key):
+        suite, test = key
+        return name_format.format(suite, test) if suite else test
+
+    usages = list(memory.values())
+    largest = sorted(
+        memory.items(), key=lambda item: item[1]["rss_delta"], reverse=True
+    )
+    return {
+        "tests": len(memory),
+        "rss_start": usages[0]["rss_start"],
+        "rss_end": usages[-1]["rss_end"],
+        "largest_growth": [
+            {
+                "testcase": name(key),
+                "rss_delta": usage["rss_delta"],
+                "heap_delta": usage["heap_delta"],
+            }
+            for key, usage in largest[:top]
+            if usage["rss_delta"] > 0
+        ],
+        "threshold": threshold,
+        "flagged": [
+            name(key)
+            for key, usage in memory.items()
+            if memory_growth_entries(usage, threshold)
+        ],
+    }
+
+
+def format_duration(nanoseconds):
+    """Human readable duration, e.g. ``3.20us``."""
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return "{:.2f}{}".format(nanoseconds / scale, unit)
+    return "{:.0f}ns".format(nanoseconds)
+
+
+def _percentile_name(percentile):
+    return "p{:g}".format(percentile)
+
+
+@renderer("latency")
+def render_latency(record, text, passed):
+    """
+    Verdict of a latency budget, followed by a table of the percentiles and
+    the distribution of the samples.
+    """
+    verdict = RawAssertion(
+        description="Latency of {}: {} {} {} {}".format(
+            record["statement"],
+            _percentile_name(record["percentile"]),
+            format_duration(record["measured_ns"]),
+            "<=" if record["passed"] else ">",
+            format_duration(record["limit_ns"]),
+        ),
+        content=text
+        or "{} iterations after {} warmup iterations".format(
+            record["iterations"], record["warmup"]
+        ),
+        passed=passed,
+    )
+
+    percentiles = [["Percentile", "Latency"]]
+    percentiles.append(["min", format_duration(record["min_ns"])])
+    percentiles.append(["mean", format_duration(record["mean_ns"])])
+    for item in record["percentiles"]:
+        percentiles.append(
+            [_percentile_name(item["percentile"]), format_duration(item["ns"])]
+        )
+    percentiles.append(["max", format_duration(record["max_ns"])])
+
+    return [
+        verdict,
+        TableLog(table=percentiles, description="Latency percentiles"),
+        Histogram(record["histogram"], description="Latency distribution"),
+    ]
+
+
+@renderer("histogram")
+def render_histogram(record, text, passed):
+    """Histogram logged by the test binary, see ``testplan/hdr.h``."""
+    return [Histogram(record["histogram"], description=record["description"])]
+
+
+# Summaries of the GTest assertion macros, see gtest.h and gtest-printers.h
+
+GTEST_EQUALITY_HEADER = "Expected equality of these values:"
+
+GTEST_COMPARISON_PATTERN = re.compile(
+    r"^Expected: \((?P<first>.*)\) (?P<op>==|!=|<=|<|>=|>) \((?P<second>.*)\),"
+    r" actual: (?P<first_value>.*) vs (?P<second_value>.*)$"
+)
+
+GTEST_BOOLEAN_PATTERN = re.compile(
+    r"^Value of: (?P<expr>.*)\n  Actual: (?P<actual>true|false).*\n"
+    r"Expected: (?P<expected>true|false)$",
+    re.MULTILINE,
+)
+
+GTEST_NEAR_PATTERN = re.compile(
+    r"^The difference between (?P<first>.+) and (?P<second>.+) is .+,"
+    r" which exceeds (?P<tol>.+), where\n"
+    r".+ evaluates to (?P<first_value>.+),\n"
+    r".+ evaluates to (?P<second_value>.+), and\n"
+    r".+ evaluates to (?P<tol_value>.+)\.$",
+    re.MULTILINE,
+)
+
+GTEST_COMPARISONS = {
+    "==": assertions.Equal,
+    "!=": assertions.NotEqual,
+    "<": assertions.Less,
+    "<=": assertions.LessEqual,
+    ">": assertions.Greater,
+    ">=": assertions.GreaterEqual,
+}
+
+
+def gtest_parts(records):
+    """
+    Results reported by ``testplan/gtest_listener.h``, in reporting order.
+
+    :param records: Records returned by :py:func:`read_records`.
+    :type records: ``dict``
+    :return: Records of each testcase, by (suite name, testcase name).
+    :rtype: ``dict``
+    """
+    parts = collections.defaultdict(list)
+    for record in records.values():
+        if record.get("type") == "test_part":
+            parts[(record["suite"], record["test"])].append(record)
+    return parts
+
+
+def _parse_equality(lines):
+    """
+    Operands of an ``EXPECT_EQ`` family summary, an expression is its own
+    value if it is a literal:
+
+        Expected equality of these values:
+          squareRoot(36.0)
+            Which is: 6
+          4
+    """
+    operands = []
+    index = 1
+    while index < len(lines) and len(operands) < 2:
+        line = lines[index]
+        if not line.startswith("  ") or line.startswith("    "):
+            break
+        expr = value = line[2:]
+        index += 1
+        if index < len(lines) and lines[index].startswith("    Which is: "):
+            value = lines[index][len("    Which is: ") :]
+            index += 1
+        operands.append((expr, value))
+
+    if len(operands) != 2:
+        return None
+    # Skip details like "With diff:" blocks, the rest is the user message.
+    while index < len(lines) and lines[index].startswith("    "):
+        index += 1
+    return operands, "\n".join(lines[index:])
+
+
+def _typed_entry(summary, description):
+    """Typed assertion for a GTest summary, ``None`` if not recognized."""
+    lines = summary.splitlines()
+    if not lines:
+        return None
+
+    def _described(expr, message):
+        if message.strip():
+            return "{}: {} - {}".format(description, expr, message.strip())
+        return "{}: {}".format(description, expr)
+
+    if lines[0] == GTEST_EQUALITY_HEADER:
+        parsed = _parse_equality(lines)
+        if parsed:
+            ((first, first_value), (second, second_value)), message = parsed
+            return assertions.Equal(
+                first=first_value,
+                second=second_value,
+                description=_described(
+                    "{} == {}".format(first, second), message
+                ),
+            )
+
+    match = GTEST_COMPARISON_PATTERN.match(lines[0])
+    if match:
+        return GTEST_COMPARISONS[match.group("op")](
+            first=match.group("first_value"),
+            second=match.group("second_value"),
+            description=_described(
+                "{} {} {}".format(
+                    match.group("first"),
+                    match.group("op"),
+                    match.group("second"),
+                ),
+                "\n".join(lines[1:]),
+            ),
+        )
+
+    match = GTEST_BOOLEAN_PATTERN.match(summary)
+    if match:
+        entry_cls = (
+            assertions.IsTrue
+            if match.group("expected") == "true"
+            else assertions.IsFalse
+        )
+        return entry_cls(
+            expr=match.group("expr"),
+            description=_described(match.group("expr"), "\n".join(lines[3:])),
+        )
+
+    match = GTEST_NEAR_PATTERN.match(summary)
+    if match:
+        try:
+            return assertions.IsClose(
+                first=float(match.group("first_value")),
+                second=float(match.group("second_value")),
+                rel_tol=0.0,
+                abs_tol=float(match.group("tol_value")),
+                description=_described(
+                    "{} ~= {} +- {}".format(
+                        match.group("first"),
+                        match.group("second"),
+                        match.group("tol"),
+                    ),
+                    "\n".join(lines[4:]),
+                ),
+            )
+        except ValueError:
+            return None
+
+    return None
+
+
+def gtest_part_entries(record, records):
+    """
+    Entries of a single ``TestPartResult`` reported by the listener: a typed
+    assertion (e.g. ``Equal`` with both operand values) when the summary of
+    the GTest macro is recognized, a ``RawAssertion`` otherwise. The verdict
+    is always the one of GTest.
+
+    :param record: ``test_part`` record.
+    :type record: ``dict``
+    :param records: All records, referenced by markers in the message.
+    :type records: ``dict``
+    :return: Entries to append to the testcase report.
+    :rtype: ``list``
+    """
+    passed = record["result"] in ("success", "skip")
+    location = "{}:{}".format(os.path.basename(record["file"]), record["line"])
+    message = record["message"]
+
+    if record["result"] == "skip":
+        return [
+            RawAssertion(
+                description="{}: skipped".format(location),
+                content=message,
+                passed=True,
+            )
+        ]
+
+    if MARKER_PATTERN.search(message):
+        return render(records, location, message, passed)
+
+    entry = _typed_entry(record["summary"], location)
+    if entry is None:
+        entry = RawAssertion(
+            description=location,
+            content="{}:{}\n{}".format(
+                record["file"], record["line"], message
+            ),
+            passed=passed,
+        )
+    entry.passed = passed
+    entry.file_path = record["file"]
+    entry.line_no = record["line"]
+    return [entry]
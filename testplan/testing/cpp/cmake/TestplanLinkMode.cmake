@@ -0,0 +1,63 @@
+# Link modes of the GTest binaries run by Testplan, include() this file after
+# find_package(GTest). Dynamic symbol resolution is paid on every launch of a
+# binary (listing, every shard, rerun and interactive run):
+#   dynamic - default shared library linkage
+#   now     - bind all symbols at load time and call without the PLT
+#   static  - fully static binary, nothing to load at all
+
+set(TESTPLAN_LINK_MODE "dynamic" CACHE STRING "One of dynamic, now, static")
+set_property(CACHE TESTPLAN_LINK_MODE PROPERTY STRINGS dynamic now static)
+
+# find_package(GTest) may find the shared libraries only, the static mode
+# needs the archives of the same installation.
+set(_testplan_gtest_libs ${GTEST_LIBRARY} ${GTEST_LIBRARY_RELEASE})
+if(TARGET GTest::gtest)
+  get_target_property(_lib GTest::gtest LOCATION)
+  list(APPEND _testplan_gtest_libs ${_lib})
+endif()
+set(_testplan_gtest_dirs)
+foreach(_lib ${_testplan_gtest_libs})
+  if(EXISTS "${_lib}")
+    get_filename_component(_dir "${_lib}" DIRECTORY)
+    list(APPEND _testplan_gtest_dirs "${_dir}")
+  endif()
+endforeach()
+find_library(TESTPLAN_GTEST_STATIC_LIBRARY
+  NAMES ${CMAKE_STATIC_LIBRARY_PREFIX}gtest${CMAKE_STATIC_LIBRARY_SUFFIX}
+  HINTS ${_testplan_gtest_dirs} ${GTEST_ROOT} $ENV{GTEST_ROOT}
+  PATH_SUFFIXES lib lib64
+  NO_DEFAULT_PATH)
+
+if(TESTPLAN_GTEST_STATIC_LIBRARY)
+  set(TESTPLAN_STATIC_LINK_AVAILABLE TRUE)
+else()
+  set(TESTPLAN_STATIC_LINK_AVAILABLE FALSE)
+endif()
+
+# testplan_link_mode(<target> <mode>)
+#
+# Link <target> with GTest and pthread in one of the link modes above.
+function(testplan_link_mode target mode)
+  if(mode STREQUAL "static")
+    if(NOT TESTPLAN_STATIC_LINK_AVAILABLE)
+      message(FATAL_ERROR
+        "Static link mode of ${target} needs the static GTest library, "
+        "none found next to ${GTEST_LIBRARIES}")
+    endif()
+    target_link_libraries(${target} ${TESTPLAN_GTEST_STATIC_LIBRARY} pthread)
+    set_property(TARGET ${target} APPEND_STRING PROPERTY LINK_FLAGS " -static")
+    # Otherwise CMake switches back to -Bdynamic for the system libraries
+    set_target_properties(${target} PROPERTIES
+      LINK_SEARCH_START_STATIC ON
+      LINK_SEARCH_END_STATIC ON)
+    return()
+  endif()
+
+  target_link_libraries(${target} ${GTEST_LIBRARIES} pthread)
+  if(mode STREQUAL "now")
+    set_property(TARGET ${target} APPEND_STRING PROPERTY COMPILE_FLAGS " -fno-plt")
+    set_property(TARGET ${target} APPEND_STRING PROPERTY LINK_FLAGS " -Wl,-z,now")
+  elseif(NOT mode STREQUAL "dynamic")
+    message(FATAL_ERROR "Unknown link mode of ${target}: ${mode}")
+  endif()
+endfunction()
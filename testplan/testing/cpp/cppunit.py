@@ -18,6 +18,7 @@ from testplan.testing.multitest.entries.assertions import RawAssertion
 from testplan.testing.multitest.entries.schemas.base import registry
 
 from ..base import ProcessRunnerTest, ProcessRunnerTestConfig
+from . import channel
 
 CPPUNIT_TO_JUNIT_XSL = b"""<?xml version="1.0" encoding="UTF-8"?>
 <xsl:stylesheet version="1.0" xmlns:xsl="http://www.w3.org/1999/XSL/Transform">
@@ -168,6 +169,9 @@ class Cppunit(ProcessRunnerTest):
 
     CONFIG = CppunitConfig
 
+    # Longer selections of testcases are run as a whole
+    _MAX_UNITS_LENGTH = 32 * 1024
+
     def __init__(
         self,
         name,
@@ -199,6 +203,65 @@ class Cppunit(ProcessRunnerTest):
             cmd.extend([self.cfg.file_output_flag, self.report_path])
         return cmd
 
+    def test_command_sample(self, selection):
+        """
+        Return the test command running the sampled testcases, each passed
+        with the filtering flag (e.g. ``-t Suite::test1 -t Suite::test2``),
+        which the binary must accept multiple times. ``None`` if the
+        testcases cannot be selected, see :py:meth:`_units_command`.
+        """
+        return self._units_command(
+            "Sampling testcases",
+            [
+                (suite, testcase)
+                for suite, testcases in selection.suites()
+                for testcase in testcases or [None]
+            ],
+        )
+
+    def test_command_order(self, test_cmd, units, failing):
+        """
+        Return the test command running the testcases in the given order,
+        each passed with the filtering flag, which the binary must accept
+        multiple times and run in the order given. ``None`` if the testcases
+        cannot be selected, see :py:meth:`_units_command`.
+        """
+        cmd = self._units_command("Ordering testcases", units)
+        return [cmd] if cmd else None
+
+    def _units_command(self, action, units):
+        """
+        Command running the given (suite, testcase) units only. ``None`` if
+        the binary cannot select them: without ``filtering_flag``, without
+        ``listing_flag`` (the units are not real testcases then), with a
+        ``cppunit_filter`` (whose native semantics are unknown, passing it
+        along the units could run more testcases than it selects) or if the
+        command would be too long.
+        """
+        if not self.cfg.filtering_flag:
+            return self._skip_units(action, "no filtering_flag")
+        if not self.cfg.listing_flag:
+            return self._skip_units(action, "no listing_flag")
+        if self.cfg.cppunit_filter:
+            return self._skip_units(action, "a cppunit_filter")
+        if not units:
+            return self._skip_units(action, "no testcases")
+
+        cmd = [self.cfg.binary]
+        for suite, testcase in units:
+            if testcase is not None:
+                suite = "{}::{}".format(suite, testcase)
+            cmd.extend([self.cfg.filtering_flag, suite])
+        if sum(len(arg) + 1 for arg in cmd) > self._MAX_UNITS_LENGTH:
+            return self._skip_units(action, "too many testcases")
+        if self.cfg.file_output_flag:
+            cmd.extend([self.cfg.file_output_flag, self.report_path])
+        return cmd
+
+    def _skip_units(self, action, reason):
+        self.logger.debug("%s of %s: %s, skipped", action, self, reason)
+        return None
+
     def list_command(self):
         if self.cfg.listing_flag:
             return [self.cfg.binary, self.cfg.listing_flag]
@@ -226,8 +289,15 @@ class Cppunit(ProcessRunnerTest):
         """
         XML output contains entries for skipped testcases
         as well, which are not included in the report.
+
+        Testcase durations are those reported by
+        ``testplan/cppunit_listener.h``, the XML output has none, as well as
+        the memory growth of the testcases.
         """
         result = []
+        records = channel.read_records(self.entries_path)
+        intervals = channel.test_intervals(records)
+        memory = channel.test_memory(records)
 
         for suite in test_data.getchildren():
             suite_name = suite.attrib["name"]
@@ -257,17 +327,39 @@ class Cppunit(ProcessRunnerTest):
                         content="Testcase {} passed".format(testcase_name),
                         passed=True,
                     )
-                    testcase_report.append(registry.serialize(assertion_obj))
+                    testcase_report.append(
+                        registry.serialize_lazily(assertion_obj)
+                    )
                 else:
                     for entry in testcase.getchildren():
-                        assertion_obj = RawAssertion(
+                        for entry_obj in channel.render(
+                            records,
                             description=entry.tag,
                             content=entry.text,
                             passed=entry.tag not in ("failure", "error"),
-                        )
-                        testcase_report.append(
-                            registry.serialize(assertion_obj)
-                        )
+                        ):
+                            testcase_report.append(
+                                registry.serialize_lazily(entry_obj)
+                            )
+
+                for entry_obj in channel.attached_entries(
+                    records, testcase_report.name
+                ):
+                    testcase_report.append(
+                        registry.serialize_lazily(entry_obj)
+                    )
+
+                for entry_obj in channel.memory_growth_entries(
+                    memory.get(("", testcase_report.name)),
+                    self.cfg.memory_growth_threshold,
+                ):
+                    testcase_report.append(
+                        registry.serialize_lazily(entry_obj)
+                    )
+
+                interval = intervals.get(("", testcase_report.name))
+                if interval:
+                    testcase_report.timer["run"] = interval
 
                 testcase_report.runtime_status = RuntimeStatus.FINISHED
                 suite_report.append(testcase_report)
@@ -275,6 +367,9 @@ class Cppunit(ProcessRunnerTest):
             if len(suite_report) > 0:
                 result.append(suite_report)
 
+        self.record_memory_growth(
+            channel.memory_summary(memory, self.cfg.memory_growth_threshold)
+        )
         return result
 
     def parse_test_context(self, test_list_output):
@@ -1,7 +1,12 @@
+import datetime
+import os
+
+import pytz
 from schema import Or
 from lxml import objectify
 
 from testplan.common.config import ConfigOption
+from testplan.common.utils.timing import Interval
 
 from testplan.report import (
     TestGroupReport,
@@ -13,6 +18,23 @@ from testplan.testing.multitest.entries.assertions import RawAssertion
 from testplan.testing.multitest.entries.schemas.base import registry
 
 from ..base import ProcessRunnerTest, ProcessRunnerTestConfig
+from . import channel
+
+
+def _testcase_interval(attrib):
+    """
+    Run interval of a testcase from the ``timestamp`` (local time, GTest
+    1.10+) and ``time`` (seconds) attributes of its XML element.
+    """
+    try:
+        start = datetime.datetime.strptime(
+            attrib["timestamp"], "%Y-%m-%dT%H:%M:%S.%f"
+        )
+        elapsed = float(attrib["time"])
+    except (KeyError, ValueError):
+        return None
+    start = start.astimezone(pytz.utc)
+    return Interval(start, start + datetime.timedelta(seconds=elapsed))
 
 
 class GTestConfig(ProcessRunnerTestConfig):
@@ -47,6 +69,7 @@ class GTestConfig(ProcessRunnerTestConfig):
             ConfigOption("gtest_death_test_style", default="fast"): Or(
                 "fast", "threadsafe"
             ),
+            ConfigOption("gtest_fail_fast", default=False): bool,
         }
 
 
@@ -90,6 +113,10 @@ class GTest(ProcessRunnerTest):
     :param gtest_death_test_style: Test style flag, can either be
                         ``threadsafe`` or ``fast``. (Default value is ``fast``)
     :type gtest_death_test_style: ``str``
+    :param gtest_fail_fast: Stop running tests after the first failure, see
+                    :py:class:`~testplan.testing.ordering.FailureHistorySorter`
+                    to run the tests that failed recently first.
+    :type gtest_fail_fast: ``bool``
 
     Also inherits all
     :py:class:`~testplan.testing.base.ProcessRunnerTest` options.
@@ -97,6 +124,10 @@ class GTest(ProcessRunnerTest):
 
     CONFIG = GTestConfig
 
+    # Longer filters are passed in a flag file, well below the 128KB limit of
+    # a single argument on Linux.
+    _MAX_FILTER_LENGTH = 32 * 1024
+
     def __init__(
         self,
         name,
@@ -109,6 +140,7 @@ class GTest(ProcessRunnerTest):
         gtest_random_seed=0,
         gtest_stream_result_to="",
         gtest_death_test_style="fast",
+        gtest_fail_fast=False,
         **options
     ):
         options.update(self.filter_locals(locals()))
@@ -130,6 +162,8 @@ class GTest(ProcessRunnerTest):
 
         if self.cfg.gtest_also_run_disabled_tests:
             cmd.append("--gtest_also_run_disabled_tests")
+        if self.cfg.gtest_fail_fast:
+            cmd.append("--gtest_fail_fast")
         if self.cfg.gtest_repeat > 1:
             cmd.append("--gtest_repeat={}".format(self.cfg.gtest_repeat))
 
@@ -153,23 +187,73 @@ class GTest(ProcessRunnerTest):
     def list_command(self):
         return self.base_command() + ["--gtest_list_tests"]
 
+    @property
+    def sample_flags_path(self):
+        """Flag file of the filter of a sampled run."""
+        return os.path.join(self._runpath, "sample_flags")
+
+    @property
+    def failing_report_path(self):
+        """XML report of the pass running recently failed testcases first."""
+        return os.path.join(self._runpath, "report-failing.xml")
+
+    def _remove_entries(self):
+        """The report of a failing first pass is not kept either."""
+        super(GTest, self)._remove_entries()
+        if os.path.exists(self.failing_report_path):
+            os.remove(self.failing_report_path)
+
     def read_test_data(self):
         """
         Parse XML report generated by Google test and return the root node.
         XML report should be compatible with xUnit format.
 
+        The report of a pass running recently failed testcases first is
+        merged in front of the report of the other testcases.
+
         :return: Root node of parsed raw test data
         :rtype: ``xml.etree.Element``
         """
+        if not os.path.exists(self.failing_report_path):
+            with open(self.report_path) as report_file:
+                return objectify.parse(report_file).getroot()
+
+        with open(self.failing_report_path) as report_file:
+            merged = objectify.parse(report_file).getroot()
+        if not os.path.exists(self.report_path):
+            # Second pass skipped after a failure with gtest_fail_fast
+            return merged
         with open(self.report_path) as report_file:
-            return objectify.parse(report_file).getroot()
+            root = objectify.parse(report_file).getroot()
+
+        suites = {
+            suite.attrib["name"]: suite for suite in merged.getchildren()
+        }
+        for suite in root.getchildren():
+            name = suite.attrib["name"]
+            if name in suites:
+                for testcase in suite.getchildren():
+                    suites[name].append(testcase)
+            else:
+                merged.append(suite)
+        return merged
 
     def process_test_data(self, test_data):
         """
         XML output contains entries for skipped testcases
         as well, which are not included in the report.
+
+        Results reported by ``testplan/gtest_listener.h`` are used instead of
+        the XML failure elements when available, as typed assertions. Death
+        tests run by the fork server of ``testplan/fork_server.h`` are
+        summarized in the ``death_tests`` metadata of the report, the memory
+        growth of the tests recorded by the listener in the ``memory``
+        metadata.
         """
         result = []
+        records = channel.read_records(self.entries_path)
+        parts = channel.gtest_parts(records)
+        memory = channel.test_memory(records)
 
         for suite in test_data.getchildren():
             suite_name = suite.attrib["name"]
@@ -187,23 +271,55 @@ class GTest(ProcessRunnerTest):
                     name=testcase_name, uid=testcase_name
                 )
 
-                if not testcase.getchildren():
+                testcase_parts = parts.get((suite_name, testcase_name))
+
+                if testcase_parts:
+                    for part in testcase_parts:
+                        for entry_obj in channel.gtest_part_entries(
+                            part, records
+                        ):
+                            testcase_report.append(
+                                registry.serialize_lazily(entry_obj)
+                            )
+                elif not testcase.getchildren():
                     assertion_obj = RawAssertion(
                         description="Passed",
                         content="Testcase {} passed".format(testcase_name),
                         passed=True,
                     )
-                    testcase_report.append(registry.serialize(assertion_obj))
+                    testcase_report.append(
+                        registry.serialize_lazily(assertion_obj)
+                    )
                 else:
                     for entry in testcase.getchildren():
-                        assertion_obj = RawAssertion(
+                        for entry_obj in channel.render(
+                            records,
                             description=entry.tag,
                             content=entry.text,
                             passed=entry.tag != "failure",
-                        )
-                        testcase_report.append(
-                            registry.serialize(assertion_obj)
-                        )
+                        ):
+                            testcase_report.append(
+                                registry.serialize_lazily(entry_obj)
+                            )
+
+                for entry_obj in channel.attached_entries(
+                    records, testcase_name, suite_name
+                ):
+                    testcase_report.append(
+                        registry.serialize_lazily(entry_obj)
+                    )
+
+                for entry_obj in channel.memory_growth_entries(
+                    memory.get((suite_name, testcase_name)),
+                    self.cfg.memory_growth_threshold,
+                ):
+                    testcase_report.append(
+                        registry.serialize_lazily(entry_obj)
+                    )
+
+                interval = _testcase_interval(testcase.attrib)
+                if interval:
+                    testcase_report.timer["run"] = interval
 
                 testcase_report.runtime_status = RuntimeStatus.FINISHED
 
@@ -214,6 +330,20 @@ class GTest(ProcessRunnerTest):
             if suite_has_run:
                 result.append(suite_report)
 
+        self.record_memory_growth(
+            channel.memory_summary(memory, self.cfg.memory_growth_threshold)
+        )
+
+        death_tests = channel.forked_death_tests(records)
+        if death_tests:
+            self.result.report.meta["death_tests"] = death_tests
+            self.logger.info(
+                "%s: %d death tests run by the fork server, %.2fs saved",
+                self,
+                death_tests["forked"],
+                death_tests["time_saved"],
+            )
+
         return result
 
     def parse_test_context(self, test_list_output):
@@ -274,6 +404,86 @@ class GTest(ProcessRunnerTest):
         except Exception:
             self.result.report.xml_string = ""
 
+    def test_command_sample(self, selection):
+        """
+        Return the test command running the sampled testcases, listed in a
+        ``--gtest_filter``, see :py:meth:`_filter_args`.
+        """
+        units = [
+            (suite, testcase)
+            for suite, testcases in selection.suites()
+            for testcase in testcases or [None]
+        ]
+        return self.test_command() + self._filter_args(
+            ":".join(self._patterns(units)), self.sample_flags_path
+        )
+
+    @staticmethod
+    def _patterns(units):
+        for suite, testcase in units:
+            if testcase is None:
+                yield "{}.*".format(suite)
+            else:
+                # Parameterized tests are listed with a `# GetParam() = ...`
+                # comment
+                yield "{}.{}".format(suite, testcase.split()[0])
+
+    def _filter_args(self, gtest_filter, flags_path):
+        """
+        Arguments passing a ``--gtest_filter``, in a flag file if it is
+        longer than ``_MAX_FILTER_LENGTH``.
+        """
+        flag = "--gtest_filter={}".format(gtest_filter)
+        if len(flag) <= self._MAX_FILTER_LENGTH:
+            return [flag]
+        with open(flags_path, "w") as flags:
+            flags.write(flag + "\n")
+        return ["--gtest_flagfile={}".format(flags_path)]
+
+    def test_command_order(self, test_cmd, units, failing):
+        """
+        GTest runs testcases in the order they are defined, whatever the
+        filter. Testcases that failed recently are run in a first pass with
+        its own XML report, the other ones in a second pass. The second pass
+        is skipped after a failure with ``gtest_fail_fast``.
+        """
+        if not failing or failing == len(units):
+            return [test_cmd]
+
+        # Filters and output of the unordered command are replaced, the last
+        # flag wins but a flag file is read where it appears.
+        base = [
+            arg
+            for arg in test_cmd
+            if not arg.startswith(
+                ("--gtest_filter=", "--gtest_flagfile=", "--gtest_output=")
+            )
+        ]
+        first = ":".join(self._patterns(units[:failing]))
+        if self._sample and not self._sample.sample.verify:
+            rest = ":".join(self._patterns(units[failing:]))
+        else:
+            # Listed testcases are those matching the configured filter
+            rest = self.cfg.gtest_filter or "*"
+            rest += ":" if "-" in rest else "-"
+            rest += first
+
+        return [
+            base
+            + ["--gtest_output=xml:{}".format(self.failing_report_path)]
+            + self._filter_args(
+                first, os.path.join(self._runpath, "failing_flags")
+            ),
+            base
+            + ["--gtest_output=xml:{}".format(self.report_path)]
+            + self._filter_args(
+                rest, os.path.join(self._runpath, "order_flags")
+            ),
+        ]
+
+    def run_next_pass(self, retcode):
+        return not (self.cfg.gtest_fail_fast and retcode)
+
     def test_command_filter(self, testsuite_pattern, testcase_pattern):
         """
         Return the base test command with additional filtering to run a
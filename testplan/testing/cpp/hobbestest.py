@@ -1,6 +1,10 @@
+import datetime
+import re
+
 from schema import Or
 
 from testplan.common.config import ConfigOption
+from testplan.common.utils.timing import Interval, utcnow
 
 from testplan.report import (
     TestGroupReport,
@@ -17,6 +21,26 @@ import os
 import json
 
 
+DURATION_PATTERN = re.compile(r"^\s*([0-9.]+)\s*(ns|us|ms|s)\s*$")
+
+DURATION_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def parse_duration(duration):
+    """
+    Duration of a Hobbes testcase in seconds.
+
+    :param duration: Duration as reported by Hobbes, e.g. ``65.6057ms``.
+    :type duration: ``str``
+    :return: Duration in seconds, ``None`` if it cannot be parsed.
+    :rtype: ``float``
+    """
+    match = DURATION_PATTERN.match(duration or "")
+    if not match:
+        return None
+    return float(match.group(1)) * DURATION_UNITS[match.group(2)]
+
+
 class HobbesTestConfig(ProcessRunnerTestConfig):
     """
     Configuration object for :py:class:`~testplan.testing.cpp.HobbesTest`.
@@ -91,6 +115,41 @@ class HobbesTest(ProcessRunnerTest):
             cmd.extend(["--tests", testsuite_pattern])
         return cmd
 
+    def test_command_sample(self, selection):
+        """
+        Return the test command running the sampled tests. Hobbes only lists
+        tests, which are sampled as a whole, among those of ``tests``.
+        """
+        return self._tests_command(suite for suite, _ in selection.suites())
+
+    def test_command_order(self, test_cmd, units, failing):
+        """
+        Return the test command running the tests in the given order, Hobbes
+        runs the tests passed with ``--tests`` in that order. Only those of
+        ``tests`` are ordered if specified.
+        """
+        cmd = self._tests_command(suite for suite, _ in units)
+        return [cmd] if cmd else None
+
+    def runnable_test_context(self):
+        """
+        Listed tests that are run, those of ``tests`` if specified.
+        """
+        return [
+            [suite, testcases]
+            for suite, testcases in self.test_context
+            if suite and (not self.cfg.tests or suite in self.cfg.tests)
+        ]
+
+    def _tests_command(self, tests):
+        tests = list(tests)
+        if not tests:
+            return None
+        cmd = [self.cfg.binary, "--json", self.report_path, "--tests"]
+        cmd += tests
+        cmd += self.cfg.other_args
+        return cmd
+
     def list_command(self):
         cmd = [self.cfg.binary, "--list"]
         return cmd
@@ -112,6 +171,11 @@ class HobbesTest(ProcessRunnerTest):
         """
 
         result = []
+        # Hobbes only reports durations, testcases are run in sequence from
+        # the start of the process.
+        run = self.result.report.timer.get("run")
+        start = run.start if run else utcnow()
+
         for suite in test_data:
             suite_report = TestGroupReport(
                 name=suite["name"],
@@ -134,7 +198,16 @@ class HobbesTest(ProcessRunnerTest):
                         content=testcase["error"] or testcase["duration"],
                         description=testcase["name"],
                     )
-                    testcase_report.append(registry.serialize(assertion_obj))
+                    testcase_report.append(
+                        registry.serialize_lazily(assertion_obj)
+                    )
+
+                    duration = parse_duration(testcase["duration"])
+                    if duration is not None:
+                        end = start + datetime.timedelta(seconds=duration)
+                        testcase_report.timer["run"] = Interval(start, end)
+                        start = end
+
                     testcase_report.runtime_status = RuntimeStatus.FINISHED
                     suite_report.append(testcase_report)
 
@@ -0,0 +1,228 @@
+// channel.h
+//
+// Structured output channel between C++ test binaries and the Testplan
+// runners. The runner exports the path of a file in the test runpath via the
+// TESTPLAN_ENTRIES_FILE environment variable, test code appends one JSON
+// record per line to it and refers to a record from the assertion message
+// with marker(id). When the runner parses the test results, referenced
+// records are rendered as structured report entries instead of raw text.
+//
+// Records are appended with a single write(2) on a file opened with
+// O_APPEND, so forked children (e.g. death tests) can write to the same file.
+#ifndef TESTPLAN_CHANNEL_H
+#define TESTPLAN_CHANNEL_H
+
+#include <cmath>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#define TESTPLAN_GETPID _getpid
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define TESTPLAN_GETPID getpid
+#endif
+
+#define TESTPLAN_ENTRIES_ENV "TESTPLAN_ENTRIES_FILE"
+
+// Signature of the enclosing function, see testName().
+#ifdef _MSC_VER
+#define TESTPLAN_FUNCTION_ __FUNCTION__
+#else
+#define TESTPLAN_FUNCTION_ __PRETTY_FUNCTION__
+#endif
+
+namespace testplan {
+namespace channel {
+
+// Path of the channel file, NULL when not running under Testplan.
+inline const char* path() {
+    const char* value = getenv(TESTPLAN_ENTRIES_ENV);
+    return (value && *value) ? value : NULL;
+}
+
+inline bool enabled() {
+    return path() != NULL;
+}
+
+// Minimal JSON writer, just enough for flat records and arrays of them.
+class Json {
+public:
+    Json() : comma_(false) {}
+
+    Json& beginObject() { separate(); out_ += '{'; comma_ = false; return *this; }
+    Json& endObject() { out_ += '}'; comma_ = true; return *this; }
+    Json& beginArray() { separate(); out_ += '['; comma_ = false; return *this; }
+    Json& endArray() { out_ += ']'; comma_ = true; return *this; }
+
+    Json& key(const char* name) {
+        value(name);
+        out_ += ':';
+        comma_ = false;
+        return *this;
+    }
+
+    Json& value(const char* text) {
+        separate();
+        out_ += '"';
+        for(const char* c = text; *c; ++c) {
+            switch(*c) {
+                case '"': out_ += "\\\""; break;
+                case '\\': out_ += "\\\\"; break;
+                case '\n': out_ += "\\n"; break;
+                case '\r': out_ += "\\r"; break;
+                case '\t': out_ += "\\t"; break;
+                default:
+                    if(static_cast<unsigned char>(*c) < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", *c);
+                        out_ += buf;
+                    } else {
+                        out_ += *c;
+                    }
+            }
+        }
+        out_ += '"';
+        comma_ = true;
+        return *this;
+    }
+
+    Json& value(const std::string& text) { return value(text.c_str()); }
+
+    Json& value(bool flag) { return raw(flag ? "true" : "false"); }
+
+    // Non finite numbers use the NaN / Infinity tokens accepted by the
+    // Python json module.
+    Json& value(double number) {
+        if(number != number) {
+            return raw("NaN");
+        }
+        if(std::isinf(number)) {
+            return raw(number > 0 ? "Infinity" : "-Infinity");
+        }
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.17g", number);
+        return raw(buf);
+    }
+
+    Json& value(long long number) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%lld", number);
+        return raw(buf);
+    }
+
+    Json& value(unsigned long long number) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%llu", number);
+        return raw(buf);
+    }
+
+    Json& value(int number) { return value(static_cast<long long>(number)); }
+    Json& value(unsigned long number) {
+        return value(static_cast<unsigned long long>(number));
+    }
+    Json& value(long number) { return value(static_cast<long long>(number)); }
+    Json& value(unsigned int number) {
+        return value(static_cast<unsigned long long>(number));
+    }
+
+    template <typename T>
+    Json& field(const char* name, const T& val) {
+        return key(name).value(val);
+    }
+
+    const std::string& str() const { return out_; }
+
+private:
+    Json& raw(const char* text) {
+        separate();
+        out_ += text;
+        comma_ = true;
+        return *this;
+    }
+
+    void separate() {
+        if(comma_) {
+            out_ += ',';
+        }
+    }
+
+    std::string out_;
+    bool comma_;
+};
+
+// "Class::method" of a TESTPLAN_FUNCTION_ signature, without namespaces,
+// which is the name of a Cppunit test in the report. Records of a test are
+// attached to it by name.
+inline std::string testName(const char* signature) {
+    std::string name = signature;
+    size_t paren = name.find('(');
+    if(paren != std::string::npos) {
+        name.erase(paren);
+    }
+    size_t space = name.rfind(' ');
+    if(space != std::string::npos) {
+        name.erase(0, space + 1);
+    }
+    size_t method = name.rfind("::");
+    if(method != std::string::npos && method > 0) {
+        size_t fixture = name.rfind("::", method - 1);
+        if(fixture != std::string::npos) {
+            name.erase(0, fixture + 2);
+        }
+    }
+    return name;
+}
+
+// Unique id of a record, stable across forked children.
+inline std::string nextId() {
+    static std::atomic<unsigned long> counter(0);
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%ld_%lu",
+             static_cast<long>(TESTPLAN_GETPID()), ++counter);
+    return buf;
+}
+
+// Text to embed in an assertion message to refer to record `id`.
+inline std::string marker(const std::string& id) {
+    return "[testplan:entry:" + id + "]";
+}
+
+// Appends a complete JSON object as one line, returns false if the channel
+// is not available.
+inline bool write(const Json& record) {
+    const char* file = path();
+    if(!file) {
+        return false;
+    }
+    std::string line = record.str() + "\n";
+#ifdef _WIN32
+    FILE* out = fopen(file, "ab");
+    if(!out) {
+        return false;
+    }
+    bool ok = fwrite(line.data(), 1, line.size(), out) == line.size();
+    fclose(out);
+    return ok;
+#else
+    int fd = open(file, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if(fd < 0) {
+        return false;
+    }
+    bool ok = ::write(fd, line.data(), line.size()) ==
+              static_cast<ssize_t>(line.size());
+    close(fd);
+    return ok;
+#endif
+}
+
+} // namespace channel
+} // namespace testplan
+
+#endif // TESTPLAN_CHANNEL_H
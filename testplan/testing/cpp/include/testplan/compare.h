@@ -0,0 +1,361 @@
+// compare.h
+//
+// Bulk comparison of large floating point arrays against expected values
+// with absolute, relative and ULP tolerances. The comparison is vectorized
+// (AVX2 when the CPU supports it, scalar otherwise) and produces a single
+// summary: the number of mismatching elements, the worst mismatch and the
+// first TESTPLAN_COMPARE_MAX_REPORTED mismatches with their indices.
+//
+// An element matches its expected value if both are equal, both are NaN, or
+// their difference is finite and within any of the non zero tolerances:
+//
+//     |actual - expected| <= absTol
+//     |actual - expected| <= relTol * max(|actual|, |expected|)
+//     ulpDistance(actual, expected) <= ulps
+//
+// See gtest.h and cppunit.h for the assertion macros.
+#ifndef TESTPLAN_COMPARE_H
+#define TESTPLAN_COMPARE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "channel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TESTPLAN_COMPARE_X86 1
+#endif
+
+#ifndef TESTPLAN_COMPARE_MAX_REPORTED
+#define TESTPLAN_COMPARE_MAX_REPORTED 10
+#endif
+
+namespace testplan {
+namespace compare {
+
+struct Tolerance {
+    explicit Tolerance(double absTol = 0.0, double relTol = 0.0,
+                       uint64_t ulps = 0)
+        : absTol(absTol), relTol(relTol), ulps(ulps) {}
+
+    double absTol;
+    double relTol;
+    uint64_t ulps;
+};
+
+inline Tolerance absolute(double tol) { return Tolerance(tol, 0.0, 0); }
+inline Tolerance relative(double tol) { return Tolerance(0.0, tol, 0); }
+inline Tolerance ulps(uint64_t tol) { return Tolerance(0.0, 0.0, tol); }
+
+struct Mismatch {
+    size_t index;
+    double actual;
+    double expected;
+    double absError;
+    double relError;
+    uint64_t ulps;
+};
+
+struct Result {
+    Result() : size(0), mismatches(0) {}
+
+    bool passed() const { return mismatches == 0; }
+
+    size_t size;
+    size_t mismatches;
+    Tolerance tolerance;
+    Mismatch worst;
+    std::vector<Mismatch> first;
+};
+
+namespace detail {
+
+// Maps the bits of a double to a signed integer that is monotonic in the
+// value of the double, so that the ULP distance is a plain difference.
+inline int64_t orderedBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if(bits >> 63) {
+        bits = (uint64_t(1) << 63) - bits;
+    }
+    return static_cast<int64_t>(bits);
+}
+
+inline uint64_t ulpDistance(double actual, double expected) {
+    uint64_t diff = static_cast<uint64_t>(orderedBits(actual)) -
+                    static_cast<uint64_t>(orderedBits(expected));
+    return static_cast<int64_t>(diff) < 0 ? uint64_t(0) - diff : diff;
+}
+
+inline bool matches(double actual, double expected, const Tolerance& tol) {
+    if(actual == expected || (actual != actual && expected != expected)) {
+        return true;
+    }
+    double diff = std::fabs(actual - expected);
+    if(!(diff < HUGE_VAL)) { // infinite or NaN
+        return false;
+    }
+    double scale = std::fmax(std::fabs(actual), std::fabs(expected));
+    return diff <= tol.absTol || diff <= tol.relTol * scale ||
+           (tol.ulps && ulpDistance(actual, expected) <= tol.ulps);
+}
+
+// Error magnitude used to pick the worst mismatch, NaN counts as infinite.
+inline double severity(double error) {
+    return error != error ? HUGE_VAL : error;
+}
+
+inline void record(Result& result, const double* actual,
+                   const double* expected, size_t i) {
+    Mismatch m;
+    m.index = i;
+    m.actual = actual[i];
+    m.expected = expected[i];
+    m.absError = std::fabs(m.actual - m.expected);
+    double scale = std::fmax(std::fabs(m.actual), std::fabs(m.expected));
+    m.relError = scale > 0 ? m.absError / scale : m.absError;
+    m.ulps = ulpDistance(m.actual, m.expected);
+
+    if(result.mismatches == 0 ||
+       severity(m.absError) > severity(result.worst.absError)) {
+        result.worst = m;
+    }
+    if(result.first.size() < TESTPLAN_COMPARE_MAX_REPORTED) {
+        result.first.push_back(m);
+    }
+    ++result.mismatches;
+}
+
+inline void compareScalar(const double* actual, const double* expected,
+                          size_t begin, size_t end, Result& result) {
+    const Tolerance& tol = result.tolerance;
+    for(size_t i = begin; i < end; ++i) {
+        if(!matches(actual[i], expected[i], tol)) {
+            record(result, actual, expected, i);
+        }
+    }
+}
+
+#ifdef TESTPLAN_COMPARE_X86
+
+// Same predicate as matches() on 4 lanes, mismatching lanes are recorded
+// by the scalar code as they are expected to be rare.
+__attribute__((target("avx2")))
+inline void compareAVX2(const double* actual, const double* expected,
+                        size_t begin, size_t end, Result& result) {
+    const Tolerance& tol = result.tolerance;
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+    const __m256d absTol = _mm256_set1_pd(tol.absTol);
+    const __m256d relTol = _mm256_set1_pd(tol.relTol);
+    const __m256i ulpTol = _mm256_set1_epi64x(static_cast<int64_t>(tol.ulps));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i negZero = _mm256_set1_epi64x(INT64_MIN);
+
+    size_t i = begin;
+    for(; i + 4 <= end; i += 4) {
+        __m256d a = _mm256_loadu_pd(actual + i);
+        __m256d e = _mm256_loadu_pd(expected + i);
+        __m256d diff = _mm256_andnot_pd(signMask, _mm256_sub_pd(a, e));
+        __m256d scale = _mm256_max_pd(_mm256_andnot_pd(signMask, a),
+                                      _mm256_andnot_pd(signMask, e));
+
+        __m256d ok = _mm256_or_pd(
+            _mm256_cmp_pd(diff, absTol, _CMP_LE_OQ),
+            _mm256_cmp_pd(diff, _mm256_mul_pd(relTol, scale), _CMP_LE_OQ));
+
+        if(tol.ulps) {
+            __m256i ia = _mm256_castpd_si256(a);
+            __m256i ie = _mm256_castpd_si256(e);
+            // orderedBits(): negative values become INT64_MIN - bits
+            ia = _mm256_blendv_epi8(ia, _mm256_sub_epi64(negZero, ia),
+                                    _mm256_cmpgt_epi64(zero, ia));
+            ie = _mm256_blendv_epi8(ie, _mm256_sub_epi64(negZero, ie),
+                                    _mm256_cmpgt_epi64(zero, ie));
+            __m256i d = _mm256_sub_epi64(ia, ie);
+            d = _mm256_blendv_epi8(d, _mm256_sub_epi64(zero, d),
+                                   _mm256_cmpgt_epi64(zero, d));
+            __m256i within = _mm256_andnot_si256(
+                _mm256_cmpgt_epi64(d, ulpTol), _mm256_set1_epi64x(-1));
+            ok = _mm256_or_pd(ok, _mm256_castsi256_pd(within));
+        }
+
+        ok = _mm256_and_pd(ok, _mm256_cmp_pd(diff, inf, _CMP_LT_OQ));
+        ok = _mm256_or_pd(ok, _mm256_cmp_pd(a, e, _CMP_EQ_OQ));
+        ok = _mm256_or_pd(ok, _mm256_and_pd(_mm256_cmp_pd(a, a, _CMP_UNORD_Q),
+                                            _mm256_cmp_pd(e, e, _CMP_UNORD_Q)));
+
+        int bad = ~_mm256_movemask_pd(ok) & 0xf;
+        while(bad) {
+            int lane = __builtin_ctz(bad);
+            record(result, actual, expected, i + lane);
+            bad &= bad - 1;
+        }
+    }
+    compareScalar(actual, expected, i, end, result);
+}
+
+#endif // TESTPLAN_COMPARE_X86
+
+typedef void (*CompareKernel)(const double*, const double*, size_t, size_t,
+                              Result&);
+
+inline CompareKernel selectKernel() {
+#ifdef TESTPLAN_COMPARE_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        return compareAVX2;
+    }
+#endif
+    return compareScalar;
+}
+
+inline std::string format(const char* fmt, double value) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), fmt, value);
+    return buf;
+}
+
+} // namespace detail
+
+// Compares n elements of actual against expected.
+inline Result compareArrays(const double* actual, const double* expected,
+                            size_t n, const Tolerance& tol = Tolerance()) {
+    static const detail::CompareKernel kernel = detail::selectKernel();
+    Result result;
+    result.size = n;
+    result.tolerance = tol;
+    kernel(actual, expected, 0, n, result);
+    return result;
+}
+
+// Same as above, a size difference counts as one extra mismatch at the index
+// of the first missing element.
+inline Result compareArrays(const std::vector<double>& actual,
+                            const std::vector<double>& expected,
+                            const Tolerance& tol = Tolerance()) {
+    size_t n = actual.size() < expected.size() ? actual.size()
+                                                : expected.size();
+    Result result = compareArrays(actual.data(), expected.data(), n, tol);
+    if(actual.size() != expected.size()) {
+        Mismatch m;
+        m.index = n;
+        m.actual = actual.size() > n ? actual[n] : NAN;
+        m.expected = expected.size() > n ? expected[n] : NAN;
+        m.absError = m.relError = NAN;
+        m.ulps = 0;
+        if(result.mismatches == 0) {
+            result.worst = m;
+        }
+        if(result.first.size() < TESTPLAN_COMPARE_MAX_REPORTED) {
+            result.first.push_back(m);
+        }
+        result.size = actual.size() > expected.size() ? actual.size()
+                                                       : expected.size();
+        ++result.mismatches;
+    }
+    return result;
+}
+
+// One line description of the comparison, e.g.
+// "3 of 1000000 elements differ (abs_tol=1e-09, rel_tol=0, ulps=0), worst
+// at [42]: actual=1.5, expected=1.25, abs_err=0.25".
+inline std::string summary(const Result& result) {
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "%zu of %zu elements differ (abs_tol=%g, rel_tol=%g, ulps=%llu)",
+             result.mismatches, result.size, result.tolerance.absTol,
+             result.tolerance.relTol,
+             static_cast<unsigned long long>(result.tolerance.ulps));
+    std::string text = buf;
+    if(result.mismatches) {
+        const Mismatch& w = result.worst;
+        snprintf(buf, sizeof(buf),
+                 ", worst at [%zu]: actual=%.17g, expected=%.17g, "
+                 "abs_err=%.6g",
+                 w.index, w.actual, w.expected, w.absError);
+        text += buf;
+    }
+    return text;
+}
+
+// Failure message of an assertion. The details go to the Testplan channel
+// when it is available, so that the runner renders them as a table, and are
+// appended as text otherwise.
+inline std::string report(const Result& result, const char* actualExpr,
+                          const char* expectedExpr) {
+    std::string message = std::string("Arrays ") + actualExpr + " and " +
+                          expectedExpr + " are not close: " + summary(result);
+
+    if(channel::enabled()) {
+        std::string id = channel::nextId();
+        channel::Json json;
+        json.beginObject()
+            .field("id", id)
+            .field("type", "array_compare")
+            .field("actual_expr", actualExpr)
+            .field("expected_expr", expectedExpr)
+            .field("size", static_cast<unsigned long long>(result.size))
+            .field("mismatches",
+                   static_cast<unsigned long long>(result.mismatches))
+            .field("abs_tol", result.tolerance.absTol)
+            .field("rel_tol", result.tolerance.relTol)
+            .field("ulps",
+                   static_cast<unsigned long long>(result.tolerance.ulps))
+            .field("worst", static_cast<unsigned long long>(result.worst.index))
+            .key("first")
+            .beginArray();
+        for(size_t i = 0; i < result.first.size(); ++i) {
+            const Mismatch& m = result.first[i];
+            json.beginObject()
+                .field("index", static_cast<unsigned long long>(m.index))
+                .field("actual", m.actual)
+                .field("expected", m.expected)
+                .field("abs_err", m.absError)
+                .field("rel_err", m.relError)
+                .field("ulps", static_cast<unsigned long long>(m.ulps))
+                .endObject();
+        }
+        json.endArray();
+        const Mismatch& w = result.worst;
+        json.key("worst_entry")
+            .beginObject()
+            .field("index", static_cast<unsigned long long>(w.index))
+            .field("actual", w.actual)
+            .field("expected", w.expected)
+            .field("abs_err", w.absError)
+            .field("rel_err", w.relError)
+            .field("ulps", static_cast<unsigned long long>(w.ulps))
+            .endObject()
+            .endObject();
+        if(channel::write(json)) {
+            return message + " " + channel::marker(id);
+        }
+    }
+
+    for(size_t i = 0; i < result.first.size(); ++i) {
+        const Mismatch& m = result.first[i];
+        message += "\n  [" + std::to_string(m.index) + "] actual=" +
+                   detail::format("%.17g", m.actual) + ", expected=" +
+                   detail::format("%.17g", m.expected) + ", abs_err=" +
+                   detail::format("%.6g", m.absError);
+    }
+    if(result.mismatches > result.first.size()) {
+        message += "\n  ... " +
+                   std::to_string(result.mismatches - result.first.size()) +
+                   " more";
+    }
+    return message;
+}
+
+} // namespace compare
+} // namespace testplan
+
+#endif // TESTPLAN_COMPARE_H
@@ -0,0 +1,77 @@
+// cppunit.h
+//
+// CppUnit assertions built on compare.h. A failing comparison produces a
+// single failure, however large the arrays, which the Testplan Cppunit
+// runner renders as a summary plus a table of the first mismatches:
+//
+//     #include <testplan/cppunit.h>
+//
+//     TESTPLAN_CPPUNIT_ASSERT_ARRAY_NEAR(
+//         prices, golden, n, testplan::compare::relative(1e-9));
+//     TESTPLAN_CPPUNIT_ASSERT_GOLDEN_FILE("out/risk.csv", "golden/risk.csv");
+//     TESTPLAN_CPPUNIT_ASSERT_LATENCY(book.insert(order),
+//                                     testplan::latency::p99(5000));
+//     TESTPLAN_CPPUNIT_LOG_HISTOGRAM(latencies, "Order latency");
+#ifndef TESTPLAN_CPPUNIT_H
+#define TESTPLAN_CPPUNIT_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "compare.h"
+#include "golden.h"
+#include "hdr.h"
+#include "latency.h"
+
+#define TESTPLAN_CPPUNIT_ASSERT_COMPARE_(result, actual, expected) \
+    do { \
+        const ::testplan::compare::Result testplan_result_ = (result); \
+        if(!testplan_result_.passed()) { \
+            CPPUNIT_FAIL(::testplan::compare::report( \
+                testplan_result_, #actual, #expected)); \
+        } \
+    } while(0)
+
+#define TESTPLAN_CPPUNIT_ASSERT_ARRAY_NEAR(actual, expected, n, tolerance) \
+    TESTPLAN_CPPUNIT_ASSERT_COMPARE_( \
+        ::testplan::compare::compareArrays(actual, expected, n, tolerance), \
+        actual, expected)
+
+#define TESTPLAN_CPPUNIT_ASSERT_VECTOR_NEAR(actual, expected, tolerance) \
+    TESTPLAN_CPPUNIT_ASSERT_COMPARE_( \
+        ::testplan::compare::compareArrays(actual, expected, tolerance), \
+        actual, expected)
+
+#define TESTPLAN_CPPUNIT_ASSERT_GOLDEN_FILE(actual, golden) \
+    do { \
+        const std::string testplan_actual_ = (actual); \
+        const std::string testplan_golden_ = (golden); \
+        const ::testplan::golden::Result testplan_result_ = \
+            ::testplan::golden::checkGolden(testplan_actual_, \
+                                            testplan_golden_); \
+        if(!testplan_result_.passed()) { \
+            CPPUNIT_FAIL(::testplan::golden::report( \
+                testplan_result_, testplan_actual_, testplan_golden_)); \
+        } \
+    } while(0)
+
+// Must be used in a test method, the result is attached to the test named
+// after the enclosing function ("Fixture::method").
+#define TESTPLAN_CPPUNIT_ASSERT_LATENCY(statement, budget) \
+    do { \
+        const ::testplan::latency::Result testplan_result_ = \
+            ::testplan::latency::measure([&]() { statement; }, (budget)); \
+        const std::string testplan_message_ = ::testplan::latency::report( \
+            testplan_result_, #statement, "", \
+            ::testplan::channel::testName(TESTPLAN_FUNCTION_)); \
+        if(!testplan_result_.passed()) { \
+            CPPUNIT_FAIL(testplan_message_); \
+        } \
+    } while(0)
+
+// Logs a testplan::hdr::Histogram to the report of the enclosing test method.
+#define TESTPLAN_CPPUNIT_LOG_HISTOGRAM(histogram, description) \
+    ::testplan::hdr::log( \
+        histogram, description, "", \
+        ::testplan::channel::testName(TESTPLAN_FUNCTION_))
+
+#endif // TESTPLAN_CPPUNIT_H
@@ -0,0 +1,85 @@
+// cppunit_listener.h
+//
+// CppUnit test listener that sends the start time and duration of every test
+// through the Testplan channel, as the XML output of CppUnit has no timings.
+// The Cppunit runner records them as the run intervals of the testcases, e.g.
+// for run over run comparisons of test durations. The memory usage of the
+// process is also recorded at the start and at the end of every test (see
+// memory.h):
+//
+//     #include <testplan/cppunit_listener.h>
+//
+//     CppUnit::TestResult controller;
+//     CppUnit::TestResultCollector result;
+//     controller.addListener(&result);
+//     testplan::cppunit::installListener(controller);
+//     runner.run(controller);
+//
+// Nothing is installed when the binary is not run by Testplan.
+#ifndef TESTPLAN_CPPUNIT_LISTENER_H
+#define TESTPLAN_CPPUNIT_LISTENER_H
+
+#include <chrono>
+#include <string>
+
+#include <cppunit/Test.h>
+#include <cppunit/TestListener.h>
+#include <cppunit/TestResult.h>
+
+#include "channel.h"
+#include "memory.h"
+
+namespace testplan {
+namespace cppunit {
+
+class TimingListener : public CPPUNIT_NS::TestListener {
+public:
+    void startTest(CPPUNIT_NS::Test*) override {
+        memory_ = memory::current();
+        wallStart_ = std::chrono::system_clock::now();
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    void endTest(CPPUNIT_NS::Test* test) override {
+        double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start_)
+                             .count();
+        long long startUs =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                wallStart_.time_since_epoch())
+                .count();
+
+        channel::Json json;
+        json.beginObject()
+            .field("id", channel::nextId())
+            .field("type", "test_time")
+            .field("suite", "")
+            .field("test", test->getName())
+            .field("start_us", startUs)
+            .field("elapsed", elapsed)
+            .endObject();
+        channel::write(json);
+        memory::writeRecord("", test->getName(), memory_, memory::current());
+    }
+
+private:
+    std::chrono::system_clock::time_point wallStart_;
+    std::chrono::steady_clock::time_point start_;
+    memory::Usage memory_;
+};
+
+// Adds a TimingListener to the test result when the binary is run by
+// Testplan, returns whether it has been installed.
+inline bool installListener(CPPUNIT_NS::TestResult& controller) {
+    if(!channel::enabled()) {
+        return false;
+    }
+    static TimingListener listener;
+    controller.addListener(&listener);
+    return true;
+}
+
+} // namespace cppunit
+} // namespace testplan
+
+#endif // TESTPLAN_CPPUNIT_LISTENER_H
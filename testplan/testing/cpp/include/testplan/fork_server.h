@@ -0,0 +1,357 @@
+// fork_server.h
+//
+// Fork server for death tests. With gtest_death_test_style=threadsafe, which
+// multithreaded binaries need, every EXPECT_DEATH re-executes the whole
+// binary, paying its static initialization each time. The fork server is a
+// process forked once, before any thread exists, that forks a fresh child
+// for each death test statement and reports how it ended:
+//
+//     int main(int argc, char** argv) {
+//         testing::InitGoogleTest(&argc, argv);
+//         // Before starting any thread
+//         testplan::death::ForkServer::instance().start(argc, argv);
+//         startWorkers();
+//         return RUN_ALL_TESTS();
+//     }
+//
+// Statements run in the process as it was when the server started, so they
+// cannot refer to local variables or to state set up later (see
+// EXPECT_FORKED_DEATH in gtest.h). Death tests fall back to EXPECT_DEATH
+// when the server is not running, e.g. on Windows.
+#ifndef TESTPLAN_FORK_SERVER_H
+#define TESTPLAN_FORK_SERVER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#endif
+
+// Output of a statement kept for the report, the rest is drained.
+#ifndef TESTPLAN_FORK_SERVER_MAX_OUTPUT
+#define TESTPLAN_FORK_SERVER_MAX_OUTPUT (64 * 1024)
+#endif
+
+namespace testplan {
+namespace death {
+
+typedef void (*Statement)();
+
+// How a statement run by the fork server ended.
+struct Outcome {
+    Outcome() : ran(false), status(0), elapsed(0) {}
+
+    bool ran;            // false if the server was not available
+    int status;          // wait status of the child
+    std::string output;  // what the child wrote to stderr
+    double elapsed;      // seconds from fork to exit
+
+    // Same criterion as EXPECT_DEATH: killed by a signal or exited with a
+    // non zero code.
+    bool died() const {
+#ifdef _WIN32
+        return false;
+#else
+        return ran && (WIFSIGNALED(status) ||
+                       (WIFEXITED(status) && WEXITSTATUS(status) != 0));
+#endif
+    }
+
+    std::string describe() const {
+        char buf[64];
+#ifndef _WIN32
+        if(!ran) {
+            return "fork server not available";
+        }
+        if(WIFSIGNALED(status)) {
+            snprintf(buf, sizeof(buf), "killed by signal %d",
+                     WTERMSIG(status));
+            return buf;
+        }
+        if(WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+            snprintf(buf, sizeof(buf), "exited with code %d",
+                     WEXITSTATUS(status));
+            return buf;
+        }
+#endif
+        snprintf(buf, sizeof(buf), "did not die");
+        return buf;
+    }
+};
+
+#ifndef _WIN32
+namespace detail {
+
+inline bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while(size) {
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if(written < 0 && errno == EINTR) {
+            continue;
+        }
+        if(written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+inline bool readAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while(size) {
+        ssize_t got = read(fd, bytes, size);
+        if(got < 0 && errno == EINTR) {
+            continue;
+        }
+        if(got <= 0) {
+            return false;
+        }
+        bytes += got;
+        size -= got;
+    }
+    return true;
+}
+
+// Seconds since the process started: what re-executing the binary costs
+// before reaching the same point, 0 if unknown.
+inline double processAge() {
+#ifdef __linux__
+    FILE* stat = fopen("/proc/self/stat", "r");
+    if(!stat) {
+        return 0;
+    }
+    char line[1024];
+    size_t size = fread(line, 1, sizeof(line) - 1, stat);
+    fclose(stat);
+    line[size] = '\0';
+
+    // Fields after the command name, which may contain spaces; the start
+    // time is the 22nd field, in clock ticks since boot.
+    const char* field = strrchr(line, ')');
+    unsigned long long start = 0;
+    for(int index = 2; field && index < 22; ++index) {
+        field = strchr(field + 1, ' ');
+    }
+    if(!field || sscanf(field + 1, "%llu", &start) != 1) {
+        return 0;
+    }
+    struct timespec now;
+    if(clock_gettime(CLOCK_BOOTTIME, &now) != 0) {
+        return 0;
+    }
+    double age = now.tv_sec + now.tv_nsec * 1e-9 -
+                 static_cast<double>(start) / sysconf(_SC_CLK_TCK);
+    return age > 0 ? age : 0;
+#else
+    return 0;
+#endif
+}
+
+// Runs one statement in a child and sends back its wait status, run time
+// and error output.
+inline bool serveOne(int fd, Statement statement) {
+    int pipeFds[2];
+    if(pipe(pipeFds) != 0) {
+        return false;
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    pid_t child = fork();
+    if(child == 0) {
+        close(fd);
+        close(pipeFds[0]);
+        dup2(pipeFds[1], STDERR_FILENO);
+        close(pipeFds[1]);
+        statement();
+        _exit(0);
+    }
+    close(pipeFds[1]);
+
+    std::string output;
+    char buf[4096];
+    ssize_t got;
+    while((got = read(pipeFds[0], buf, sizeof(buf))) != 0) {
+        if(got < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if(output.size() < TESTPLAN_FORK_SERVER_MAX_OUTPUT) {
+            output.append(buf, got);
+        }
+    }
+    close(pipeFds[0]);
+
+    int status = 0;
+    if(child < 0) {
+        status = -1;
+    } else {
+        while(waitpid(child, &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+    double elapsed = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    int32_t wireStatus = status;
+    uint32_t length = static_cast<uint32_t>(output.size());
+    return writeAll(fd, &wireStatus, sizeof(wireStatus)) &&
+           writeAll(fd, &elapsed, sizeof(elapsed)) &&
+           writeAll(fd, &length, sizeof(length)) &&
+           writeAll(fd, output.data(), output.size());
+}
+
+// Server loop, until the test process closes its end of the socket.
+inline void serve(int fd) {
+    uintptr_t address;
+    while(readAll(fd, &address, sizeof(address))) {
+        if(!serveOne(fd, reinterpret_cast<Statement>(address))) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+} // namespace detail
+#endif // _WIN32
+
+class ForkServer {
+public:
+    static ForkServer& instance() {
+        static ForkServer server;
+        return server;
+    }
+
+    // Forks the server, to be called before any thread is started. Returns
+    // whether it is running. Child processes re-executed by GTest for
+    // threadsafe death tests do not start one.
+    bool start(int argc, char** argv) {
+#ifdef _WIN32
+        (void)argc;
+        (void)argv;
+        return false;
+#else
+        if(running()) {
+            return true;
+        }
+        for(int index = 1; index < argc; ++index) {
+            if(strstr(argv[index], "gtest_internal_run_death_test")) {
+                return false;
+            }
+        }
+
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            return false;
+        }
+        // Buffered output would be written again by every child
+        fflush(NULL);
+        pid_t pid = fork();
+        if(pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if(pid == 0) {
+            close(fds[0]);
+#ifdef __linux__
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+            detail::serve(fds[1]);
+        }
+        close(fds[1]);
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fd_ = fds[0];
+        pid_ = pid;
+        startup_ = detail::processAge();
+        return true;
+#endif
+    }
+
+    bool running() const { return pid_ > 0; }
+
+    // Time to reach the start of the server from the launch of the process,
+    // saved by every statement it runs compared to re-executing the binary.
+    double startup() const { return startup_; }
+
+    // Runs a statement in a fresh child of the server.
+    Outcome run(Statement statement) {
+        Outcome outcome;
+#ifndef _WIN32
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(!running()) {
+            return outcome;
+        }
+        uintptr_t address = reinterpret_cast<uintptr_t>(statement);
+        int32_t status;
+        uint32_t length;
+        if(detail::writeAll(fd_, &address, sizeof(address)) &&
+           detail::readAll(fd_, &status, sizeof(status)) &&
+           detail::readAll(fd_, &outcome.elapsed, sizeof(outcome.elapsed)) &&
+           detail::readAll(fd_, &length, sizeof(length))) {
+            outcome.output.resize(length);
+            if(!length || detail::readAll(fd_, &outcome.output[0], length)) {
+                outcome.ran = status != -1;
+                outcome.status = status;
+                return outcome;
+            }
+        }
+        // The server died, later death tests use EXPECT_DEATH
+        stop();
+        outcome.output.clear();
+#else
+        (void)statement;
+#endif
+        return outcome;
+    }
+
+    ~ForkServer() { stop(); }
+
+private:
+    ForkServer() : pid_(-1), fd_(-1), startup_(0) {}
+    ForkServer(const ForkServer&);
+    ForkServer& operator=(const ForkServer&);
+
+    void stop() {
+#ifndef _WIN32
+        if(fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        if(pid_ > 0) {
+            int status;
+            waitpid(pid_, &status, 0);
+            pid_ = -1;
+        }
+#endif
+    }
+
+    long pid_;
+    int fd_;
+    double startup_;
+    std::mutex mutex_;
+};
+
+} // namespace death
+} // namespace testplan
+
+#endif // TESTPLAN_FORK_SERVER_H
@@ -0,0 +1,425 @@
+// golden.h
+//
+// Comparison of (possibly multi-GB) output files against golden files. Both
+// files are memory mapped and compared in fixed size chunks by several
+// threads; pages are released once compared so that the resident memory
+// stays flat, and the comparison stops as soon as enough differing regions
+// have been found.
+//
+// When the TESTPLAN_UPDATE_GOLDEN environment variable is set (see the
+// update_golden option of the runners), checkGolden() replaces the golden
+// file with the output instead, atomically, and the check passes.
+//
+// See gtest.h and cppunit.h for the assertion macros.
+#ifndef TESTPLAN_GOLDEN_H
+#define TESTPLAN_GOLDEN_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "channel.h"
+
+#ifndef TESTPLAN_GOLDEN_MAX_REGIONS
+#define TESTPLAN_GOLDEN_MAX_REGIONS 10
+#endif
+
+#define TESTPLAN_UPDATE_GOLDEN_ENV "TESTPLAN_UPDATE_GOLDEN"
+
+namespace testplan {
+namespace golden {
+
+// Bytes compared by a thread at a time, a multiple of the page size.
+static const uint64_t CHUNK_SIZE = 8 << 20;
+
+// Differences separated by at most this many equal bytes form one region.
+static const uint64_t MERGE_GAP = 8;
+
+struct Region {
+    uint64_t offset;
+    uint64_t length;
+};
+
+struct Result {
+    Result() : actualSize(0), goldenSize(0), truncated(false), updated(false) {}
+
+    bool passed() const { return error.empty() && regions.empty(); }
+
+    uint64_t actualSize;
+    uint64_t goldenSize;
+    // First differing byte ranges, a size difference is reported as a
+    // region covering the tail of the longer file.
+    std::vector<Region> regions;
+    // Whether there may be more regions than reported.
+    bool truncated;
+    bool updated;
+    std::string error;
+};
+
+inline bool updateMode() {
+    const char* value = getenv(TESTPLAN_UPDATE_GOLDEN_ENV);
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+namespace detail {
+
+inline std::string systemError(const std::string& what,
+                               const std::string& path) {
+    return what + " " + path + ": " + strerror(errno);
+}
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+        : fd_(-1), data_(NULL), size_(0) {
+        fd_ = open(path.c_str(), O_RDONLY);
+        if(fd_ < 0) {
+            error_ = systemError("Cannot open", path);
+            return;
+        }
+        struct stat st;
+        if(fstat(fd_, &st) != 0) {
+            error_ = systemError("Cannot stat", path);
+            return;
+        }
+        size_ = static_cast<uint64_t>(st.st_size);
+        if(size_ == 0) {
+            return;
+        }
+        void* data = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if(data == MAP_FAILED) {
+            error_ = systemError("Cannot map", path);
+            return;
+        }
+        data_ = static_cast<const uint8_t*>(data);
+        madvise(const_cast<uint8_t*>(data_), size_, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile() {
+        if(data_) {
+            munmap(const_cast<uint8_t*>(data_), size_);
+        }
+        if(fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    // Drops the pages of an already compared range from the resident set.
+    void release(uint64_t offset, uint64_t length) const {
+        if(data_ && offset < size_) {
+            length = std::min(length, size_ - offset);
+            madvise(const_cast<uint8_t*>(data_ + offset), length,
+                    MADV_DONTNEED);
+        }
+    }
+
+    const uint8_t* data() const { return data_; }
+    uint64_t size() const { return size_; }
+    const std::string& error() const { return error_; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    int fd_;
+    const uint8_t* data_;
+    uint64_t size_;
+    std::string error_;
+};
+
+// Appends the differing regions of [begin, end), at most maxRegions.
+inline void diffRange(const uint8_t* a, const uint8_t* b, uint64_t begin,
+                      uint64_t end, size_t maxRegions,
+                      std::vector<Region>& out) {
+    static const uint64_t BLOCK = 64;
+    uint64_t i = begin;
+    while(i < end && out.size() < maxRegions) {
+        // Skip equal blocks with memcmp, then locate the first difference.
+        while(i + BLOCK <= end && memcmp(a + i, b + i, BLOCK) == 0) {
+            i += BLOCK;
+        }
+        while(i < end && a[i] == b[i]) {
+            ++i;
+        }
+        if(i == end) {
+            break;
+        }
+        Region region = {i, 1};
+        uint64_t last = i++;
+        while(i < end && i - last <= MERGE_GAP + 1) {
+            if(a[i] != b[i]) {
+                last = i;
+            }
+            ++i;
+        }
+        region.length = last + 1 - region.offset;
+        out.push_back(region);
+        i = last + 1;
+    }
+}
+
+} // namespace detail
+
+// Compares two files, threads defaults to the number of CPUs.
+inline Result compareFiles(const std::string& actual,
+                           const std::string& golden,
+                           size_t maxRegions = TESTPLAN_GOLDEN_MAX_REGIONS,
+                           unsigned threads = 0) {
+    Result result;
+    detail::MappedFile a(actual), b(golden);
+    if(!a.error().empty() || !b.error().empty()) {
+        result.error = a.error().empty() ? b.error() : a.error();
+        return result;
+    }
+    result.actualSize = a.size();
+    result.goldenSize = b.size();
+
+    const uint64_t common = std::min(a.size(), b.size());
+    const size_t chunks = static_cast<size_t>((common + CHUNK_SIZE - 1) /
+                                              CHUNK_SIZE);
+    if(threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(
+        std::min<size_t>(threads, std::max<size_t>(chunks, 1)));
+
+    // Chunks are taken in increasing order. Once the completed prefix of
+    // chunks holds enough regions, chunks past it are not compared at all.
+    std::vector<std::vector<Region> > found(chunks);
+    std::vector<char> done(chunks, 0);
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> limit(chunks);
+    std::mutex lock;
+    size_t prefix = 0, prefixRegions = 0;
+
+    auto worker = [&]() {
+        for(;;) {
+            size_t c = next++;
+            if(c >= limit.load()) {
+                return;
+            }
+            uint64_t begin = c * CHUNK_SIZE;
+            uint64_t end = std::min(common, begin + CHUNK_SIZE);
+            if(memcmp(a.data() + begin, b.data() + begin, end - begin) != 0) {
+                detail::diffRange(a.data(), b.data(), begin, end,
+                                  maxRegions + 1, found[c]);
+            }
+            a.release(begin, end - begin);
+            b.release(begin, end - begin);
+
+            std::lock_guard<std::mutex> guard(lock);
+            done[c] = 1;
+            while(prefix < chunks && done[prefix]) {
+                prefixRegions += found[prefix++].size();
+            }
+            if(prefixRegions > maxRegions) {
+                limit = std::min(limit.load(), prefix);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned t = 1; t < threads; ++t) {
+        pool.push_back(std::thread(worker));
+    }
+    worker();
+    for(size_t t = 0; t < pool.size(); ++t) {
+        pool[t].join();
+    }
+
+    // Merge in file order, joining regions split by a chunk boundary.
+    const size_t scanned = std::min(limit.load(), chunks);
+    for(size_t c = 0; c < scanned; ++c) {
+        for(size_t r = 0; r < found[c].size(); ++r) {
+            const Region& region = found[c][r];
+            if(!result.regions.empty()) {
+                Region& prev = result.regions.back();
+                if(region.offset - (prev.offset + prev.length) <= MERGE_GAP) {
+                    prev.length = region.offset + region.length - prev.offset;
+                    continue;
+                }
+            }
+            result.regions.push_back(region);
+        }
+    }
+    if(a.size() != b.size()) {
+        Region tail = {common, std::max(a.size(), b.size()) - common};
+        result.regions.push_back(tail);
+    }
+    if(scanned < chunks || result.regions.size() > maxRegions) {
+        result.truncated = true;
+    }
+    if(result.regions.size() > maxRegions) {
+        result.regions.resize(maxRegions);
+    }
+    return result;
+}
+
+// Replaces golden with a copy of actual: the copy is written next to the
+// golden file, synced and renamed over it, so readers never see a partial
+// file. Streams through a fixed size buffer.
+inline bool updateGolden(const std::string& actual, const std::string& golden,
+                         std::string* error = NULL) {
+    std::string tmp = golden + ".tmp." +
+                      std::to_string(static_cast<long>(TESTPLAN_GETPID()));
+    std::string message;
+    int in = open(actual.c_str(), O_RDONLY);
+    int out = -1;
+    if(in < 0) {
+        message = detail::systemError("Cannot open", actual);
+    } else if((out = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) <
+              0) {
+        message = detail::systemError("Cannot create", tmp);
+    } else {
+        std::vector<char> buffer(1 << 20);
+        ssize_t n;
+        while((n = read(in, buffer.data(), buffer.size())) > 0) {
+            if(::write(out, buffer.data(), static_cast<size_t>(n)) != n) {
+                message = detail::systemError("Cannot write", tmp);
+                break;
+            }
+        }
+        if(n < 0) {
+            message = detail::systemError("Cannot read", actual);
+        }
+        if(message.empty() && fsync(out) != 0) {
+            message = detail::systemError("Cannot sync", tmp);
+        }
+    }
+    if(in >= 0) {
+        close(in);
+    }
+    if(out >= 0) {
+        close(out);
+        if(message.empty() && rename(tmp.c_str(), golden.c_str()) != 0) {
+            message = detail::systemError("Cannot rename to", golden);
+        }
+        if(!message.empty()) {
+            unlink(tmp.c_str());
+        }
+    }
+    if(error) {
+        *error = message;
+    }
+    return message.empty();
+}
+
+// Compares actual against golden, or updates golden in update mode.
+inline Result checkGolden(const std::string& actual,
+                          const std::string& golden) {
+    if(!updateMode()) {
+        return compareFiles(actual, golden);
+    }
+    Result result;
+    result.updated = updateGolden(actual, golden, &result.error);
+    return result;
+}
+
+namespace detail {
+
+// Printable text when possible, hex otherwise.
+inline std::string preview(const std::string& path, uint64_t offset,
+                           uint64_t length) {
+    std::string bytes(static_cast<size_t>(std::min<uint64_t>(length, 16)),
+                      '\0');
+    int fd = open(path.c_str(), O_RDONLY);
+    ssize_t n = fd < 0 ? -1
+                       : pread(fd, &bytes[0], bytes.size(),
+                               static_cast<off_t>(offset));
+    if(fd >= 0) {
+        close(fd);
+    }
+    bytes.resize(n > 0 ? static_cast<size_t>(n) : 0);
+
+    bool printable = true;
+    for(size_t i = 0; i < bytes.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(bytes[i]);
+        printable = printable && (c >= 0x20 || c == '\n' || c == '\t') &&
+                    c < 0x7f;
+    }
+    if(printable) {
+        return bytes;
+    }
+    std::string hex;
+    char buf[4];
+    for(size_t i = 0; i < bytes.size(); ++i) {
+        snprintf(buf, sizeof(buf), "%02x",
+                 static_cast<unsigned char>(bytes[i]));
+        hex += buf;
+    }
+    return hex;
+}
+
+} // namespace detail
+
+// Failure message of an assertion. The regions go to the Testplan channel
+// when it is available, so that the runner renders them as a table, and are
+// appended as text otherwise.
+inline std::string report(const Result& result, const std::string& actual,
+                          const std::string& golden) {
+    std::string message = "Output " + actual + " differs from golden file " +
+                          golden + ": ";
+    if(!result.error.empty()) {
+        return message + result.error;
+    }
+    message += std::to_string(result.regions.size()) +
+               (result.truncated ? "+" : "") + " differing regions, size " +
+               std::to_string(result.actualSize) + " vs " +
+               std::to_string(result.goldenSize) + " bytes";
+
+    if(channel::enabled()) {
+        std::string id = channel::nextId();
+        channel::Json json;
+        json.beginObject()
+            .field("id", id)
+            .field("type", "golden_diff")
+            .field("actual", actual)
+            .field("golden", golden)
+            .field("actual_size",
+                   static_cast<unsigned long long>(result.actualSize))
+            .field("golden_size",
+                   static_cast<unsigned long long>(result.goldenSize))
+            .field("truncated", result.truncated)
+            .key("regions")
+            .beginArray();
+        for(size_t i = 0; i < result.regions.size(); ++i) {
+            const Region& r = result.regions[i];
+            json.beginObject()
+                .field("offset", static_cast<unsigned long long>(r.offset))
+                .field("length", static_cast<unsigned long long>(r.length))
+                .field("actual", detail::preview(actual, r.offset, r.length))
+                .field("golden", detail::preview(golden, r.offset, r.length))
+                .endObject();
+        }
+        json.endArray().endObject();
+        if(channel::write(json)) {
+            return message + " " + channel::marker(id);
+        }
+    }
+
+    for(size_t i = 0; i < result.regions.size(); ++i) {
+        const Region& r = result.regions[i];
+        message += "\n  @" + std::to_string(r.offset) + " +" +
+                   std::to_string(r.length);
+    }
+    return message;
+}
+
+} // namespace golden
+} // namespace testplan
+
+#endif // TESTPLAN_GOLDEN_H
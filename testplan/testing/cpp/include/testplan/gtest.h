@@ -0,0 +1,210 @@
+// gtest.h
+//
+// Google Test assertions built on compare.h. A failing comparison produces
+// a single failure, however large the arrays, which the Testplan GTest
+// runner renders as a summary plus a table of the first mismatches:
+//
+//     #include <testplan/gtest.h>
+//
+//     EXPECT_ARRAY_NEAR(prices, golden, n, testplan::compare::relative(1e-9));
+//     ASSERT_VECTOR_NEAR(risk, expected, testplan::compare::ulps(4));
+//
+// Output files are checked against golden files the same way, failures are
+// rendered as a table of differing regions:
+//
+//     EXPECT_GOLDEN_FILE("out/risk.csv", "golden/risk.csv");
+//
+// Hot path statements are timed against a latency budget (see latency.h),
+// the percentiles and histogram are reported whether the budget is met or
+// not:
+//
+//     EXPECT_LATENCY(book.insert(order), testplan::latency::p99(5000));
+//
+// Distributions recorded by the test are logged as histograms:
+//
+//     testplan::gtest::logHistogram(latencies, "Order latency");
+//
+// Death tests are run by the fork server of fork_server.h when it has been
+// started, instead of re-executing the binary:
+//
+//     EXPECT_FORKED_DEATH(abort(), "");
+#ifndef TESTPLAN_GTEST_H
+#define TESTPLAN_GTEST_H
+
+#include <regex>
+
+#include <gtest/gtest.h>
+
+#include "channel.h"
+#include "compare.h"
+#include "fork_server.h"
+#include "golden.h"
+#include "hdr.h"
+#include "latency.h"
+
+namespace testplan {
+namespace gtest {
+
+inline ::testing::AssertionResult toAssertionResult(
+    const compare::Result& result, const char* actualExpr,
+    const char* expectedExpr) {
+    if(result.passed()) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure()
+           << compare::report(result, actualExpr, expectedExpr);
+}
+
+inline ::testing::AssertionResult arrayNear(
+    const char* actualExpr, const char* expectedExpr, const char*,
+    const char*, const double* actual, const double* expected, size_t n,
+    const compare::Tolerance& tol) {
+    return toAssertionResult(compare::compareArrays(actual, expected, n, tol),
+                             actualExpr, expectedExpr);
+}
+
+inline ::testing::AssertionResult vectorNear(
+    const char* actualExpr, const char* expectedExpr, const char*,
+    const std::vector<double>& actual, const std::vector<double>& expected,
+    const compare::Tolerance& tol) {
+    return toAssertionResult(compare::compareArrays(actual, expected, tol),
+                             actualExpr, expectedExpr);
+}
+
+inline ::testing::AssertionResult goldenFile(const char*, const char*,
+                                             const std::string& actual,
+                                             const std::string& golden) {
+    golden::Result result = golden::checkGolden(actual, golden);
+    if(result.passed()) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure()
+           << golden::report(result, actual, golden);
+}
+
+// The statement is passed as a value, its text is reported instead of the
+// expression of the measurement.
+inline ::testing::AssertionResult latencyWithin(const char*, const char*,
+                                                const char* statement,
+                                                const latency::Result& result) {
+    const ::testing::TestInfo* info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string message =
+        latency::report(result, statement, info ? info->test_suite_name() : "",
+                        info ? info->name() : "");
+    if(result.passed()) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure() << message;
+}
+
+// Logs a histogram to the report of the running test.
+inline bool logHistogram(const hdr::Histogram& histogram,
+                         const std::string& description) {
+    const ::testing::TestInfo* info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    return hdr::log(histogram, description,
+                    info ? info->test_suite_name() : "",
+                    info ? info->name() : "");
+}
+
+// Checks a statement run by the fork server like EXPECT_DEATH: it must die
+// and its error output must contain a match of the (POSIX extended) regex.
+// Every run is recorded for the runner to report the time saved.
+inline ::testing::AssertionResult forkedDeath(const char*, const char*,
+                                              const char*,
+                                              const char* statement,
+                                              const std::string& regex,
+                                              const death::Outcome& outcome) {
+    const ::testing::TestInfo* info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    if(outcome.ran) {
+        channel::Json record;
+        record.beginObject()
+            .field("id", channel::nextId())
+            .field("type", "forked_death_test")
+            .field("suite", info ? info->test_suite_name() : "")
+            .field("test", info ? info->name() : "")
+            .field("statement", statement)
+            .field("elapsed", outcome.elapsed)
+            .field("saved", death::ForkServer::instance().startup())
+            .endObject();
+        channel::write(record);
+    }
+
+    bool matched = false;
+    std::string error;
+    try {
+        matched = std::regex_search(
+            outcome.output, std::regex(regex, std::regex::extended));
+    } catch(const std::regex_error& exc) {
+        error = exc.what();
+    }
+    if(outcome.died() && matched) {
+        return ::testing::AssertionSuccess();
+    }
+
+    ::testing::AssertionResult result = ::testing::AssertionFailure();
+    result << "Death test: " << statement << "\n    Result: ";
+    if(!outcome.died()) {
+        result << "failed to die";
+    } else if(!error.empty()) {
+        result << "invalid regex \"" << regex << "\": " << error;
+    } else {
+        result << outcome.describe() << " but its error output does not"
+               << " match \"" << regex << "\"";
+    }
+    return result << "\n Error msg:\n" << outcome.output;
+}
+
+} // namespace gtest
+} // namespace testplan
+
+#define EXPECT_ARRAY_NEAR(actual, expected, n, tolerance) \
+    EXPECT_PRED_FORMAT4(::testplan::gtest::arrayNear, actual, expected, n, \
+                        tolerance)
+#define ASSERT_ARRAY_NEAR(actual, expected, n, tolerance) \
+    ASSERT_PRED_FORMAT4(::testplan::gtest::arrayNear, actual, expected, n, \
+                        tolerance)
+#define EXPECT_VECTOR_NEAR(actual, expected, tolerance) \
+    EXPECT_PRED_FORMAT3(::testplan::gtest::vectorNear, actual, expected, \
+                        tolerance)
+#define ASSERT_VECTOR_NEAR(actual, expected, tolerance) \
+    ASSERT_PRED_FORMAT3(::testplan::gtest::vectorNear, actual, expected, \
+                        tolerance)
+
+#define EXPECT_GOLDEN_FILE(actual, golden) \
+    EXPECT_PRED_FORMAT2(::testplan::gtest::goldenFile, actual, golden)
+#define ASSERT_GOLDEN_FILE(actual, golden) \
+    ASSERT_PRED_FORMAT2(::testplan::gtest::goldenFile, actual, golden)
+
+// Commas in the statement must be within parentheses.
+#define EXPECT_LATENCY(statement, budget) \
+    EXPECT_PRED_FORMAT2(::testplan::gtest::latencyWithin, #statement, \
+                        ::testplan::latency::measure([&]() { statement; }, \
+                                                     budget))
+#define ASSERT_LATENCY(statement, budget) \
+    ASSERT_PRED_FORMAT2(::testplan::gtest::latencyWithin, #statement, \
+                        ::testplan::latency::measure([&]() { statement; }, \
+                                                     budget))
+
+// Death tests run by the fork server, or by EXPECT_DEATH / ASSERT_DEATH when
+// it is not running. The statement runs in a fork of the process as it was
+// when the server started, it cannot refer to local variables.
+#define EXPECT_FORKED_DEATH(statement, regex) \
+    TESTPLAN_FORKED_DEATH_(statement, regex, EXPECT_DEATH, \
+                           EXPECT_PRED_FORMAT3)
+#define ASSERT_FORKED_DEATH(statement, regex) \
+    TESTPLAN_FORKED_DEATH_(statement, regex, ASSERT_DEATH, \
+                           ASSERT_PRED_FORMAT3)
+
+#define TESTPLAN_FORKED_DEATH_(statement, regex, death_test, check) \
+    GTEST_AMBIGUOUS_ELSE_BLOCKER_ \
+    if(!::testplan::death::ForkServer::instance().running()) { \
+        death_test(statement, regex); \
+    } else \
+        check(::testplan::gtest::forkedDeath, #statement, regex, \
+              ::testplan::death::ForkServer::instance().run( \
+                  []() { statement; }))
+
+#endif // TESTPLAN_GTEST_H
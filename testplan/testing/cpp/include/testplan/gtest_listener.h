@@ -0,0 +1,105 @@
+// gtest_listener.h
+//
+// Google Test event listener that sends every TestPartResult (type, file,
+// line, summary and message) of the running test through the Testplan
+// channel, so that the GTest runner can build typed assertion entries
+// (Equal, Less, IsTrue, IsClose, ...) with the expressions and operand
+// values instead of parsing the text of the XML report. The memory usage of
+// the process is also recorded at the start and at the end of every test
+// (see memory.h):
+//
+//     #include <testplan/gtest_listener.h>
+//
+//     int main(int argc, char **argv) {
+//       testing::InitGoogleTest(&argc, argv);
+//       testplan::gtest::installListener();
+//       return RUN_ALL_TESTS();
+//     }
+//
+// Nothing is installed when the binary is not run by Testplan.
+#ifndef TESTPLAN_GTEST_LISTENER_H
+#define TESTPLAN_GTEST_LISTENER_H
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "channel.h"
+#include "memory.h"
+
+namespace testplan {
+namespace gtest {
+
+class ChannelListener : public ::testing::EmptyTestEventListener {
+public:
+    ChannelListener() : pid_(TESTPLAN_GETPID()) {}
+
+    // UnitTest::current_test_info() cannot be used from OnTestPartResult,
+    // GTest holds its lock while reporting the result.
+    void OnTestStart(const ::testing::TestInfo& info) override {
+        suite_ = info.test_suite_name();
+        test_ = info.name();
+        memory_ = memory::current();
+    }
+
+    void OnTestEnd(const ::testing::TestInfo&) override {
+        if(TESTPLAN_GETPID() == pid_) {
+            memory::writeRecord(suite_, test_, memory_, memory::current());
+        }
+        suite_.clear();
+        test_.clear();
+    }
+
+    void OnTestPartResult(const ::testing::TestPartResult& part) override {
+        // Death test children report their failures through the parent.
+        if(TESTPLAN_GETPID() != pid_) {
+            return;
+        }
+
+        channel::Json json;
+        json.beginObject()
+            .field("id", channel::nextId())
+            .field("type", "test_part")
+            .field("suite", suite_)
+            .field("test", test_)
+            .field("result", resultName(part.type()))
+            .field("file", part.file_name() ? part.file_name() : "")
+            .field("line", part.line_number())
+            .field("summary", part.summary())
+            .field("message", part.message())
+            .endObject();
+        channel::write(json);
+    }
+
+private:
+    static const char* resultName(::testing::TestPartResult::Type type) {
+        switch(type) {
+            case ::testing::TestPartResult::kSuccess: return "success";
+            case ::testing::TestPartResult::kNonFatalFailure: return "nonfatal";
+            case ::testing::TestPartResult::kFatalFailure: return "fatal";
+            case ::testing::TestPartResult::kSkip: return "skip";
+        }
+        return "unknown";
+    }
+
+    long pid_;
+    std::string suite_;
+    std::string test_;
+    memory::Usage memory_;
+};
+
+// Appends a ChannelListener to the GTest listeners when the binary is run
+// by Testplan, returns whether it has been installed.
+inline bool installListener() {
+    if(!channel::enabled()) {
+        return false;
+    }
+    ::testing::UnitTest::GetInstance()->listeners().Append(
+        new ChannelListener());
+    return true;
+}
+
+} // namespace gtest
+} // namespace testplan
+
+#endif // TESTPLAN_GTEST_LISTENER_H
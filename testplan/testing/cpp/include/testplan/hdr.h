@@ -0,0 +1,214 @@
+// hdr.h
+//
+// Log-bucketed (HDR style) histogram of non negative integer values, e.g.
+// latencies in nanoseconds, with the same buckets and encoding as
+// testplan.common.utils.hdr in Python. Values below 2^subBucketBits are
+// counted exactly, above every power of two range is split in
+// 2^(subBucketBits - 1) buckets, so values are known within a relative error
+// of 2^-(subBucketBits - 1) (0.8% with the default of 8 bits).
+//
+// Histograms are logged to the report as Histogram entries, rendered as
+// percentile distribution plots:
+//
+//     testplan::hdr::Histogram latencies;
+//     for(...) {
+//         latencies.record(elapsedNs);
+//     }
+//     testplan::gtest::logHistogram(latencies, "Order latency");  // gtest.h
+//     TESTPLAN_CPPUNIT_LOG_HISTOGRAM(latencies, "Order latency");  // cppunit.h
+//
+// Histograms of the same precision and unit can be merged, here or in Python
+// (e.g. across shards).
+#ifndef TESTPLAN_HDR_H
+#define TESTPLAN_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "channel.h"
+
+namespace testplan {
+namespace hdr {
+
+const int SUB_BUCKET_BITS = 8;
+
+namespace detail {
+
+inline int bitLength(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? 64 - __builtin_clzll(value) : 0;
+#else
+    int length = 0;
+    while(value) {
+        ++length;
+        value >>= 1;
+    }
+    return length;
+#endif
+}
+
+} // namespace detail
+
+// Index of the bucket of a value.
+inline size_t bucketIndex(uint64_t value, int subBucketBits) {
+    int shift = std::max(0, detail::bitLength(value) - subBucketBits);
+    return (static_cast<size_t>(shift) << (subBucketBits - 1)) +
+           static_cast<size_t>(value >> shift);
+}
+
+// Highest value of a bucket.
+inline uint64_t bucketHigh(size_t index, int subBucketBits) {
+    size_t half = static_cast<size_t>(1) << (subBucketBits - 1);
+    if(index < 2 * half) {
+        return index;
+    }
+    size_t shift = index / half - 1;
+    uint64_t low = static_cast<uint64_t>(index - (shift << (subBucketBits - 1)))
+                   << shift;
+    return low + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+class Histogram {
+public:
+    explicit Histogram(int subBucketBits = SUB_BUCKET_BITS,
+                       const std::string& unit = "ns")
+        : bits_(subBucketBits), unit_(unit), total_(0), sum_(0), min_(0),
+          max_(0) {
+        if(subBucketBits < 2 || subBucketBits > 20) {
+            throw std::invalid_argument("subBucketBits must be in [2, 20]");
+        }
+    }
+
+    void record(uint64_t value, uint64_t count = 1) {
+        size_t index = bucketIndex(value, bits_);
+        if(index >= counts_.size()) {
+            counts_.resize(index + 1, 0);
+        }
+        counts_[index] += count;
+        updateBounds(value, value);
+        total_ += count;
+        sum_ += static_cast<double>(value) * static_cast<double>(count);
+    }
+
+    // Adds the counts of a histogram of the same precision and unit.
+    void merge(const Histogram& other) {
+        if(other.bits_ != bits_ || other.unit_ != unit_) {
+            throw std::invalid_argument(
+                "Cannot merge histograms of different precision or unit");
+        }
+        if(other.counts_.size() > counts_.size()) {
+            counts_.resize(other.counts_.size(), 0);
+        }
+        for(size_t i = 0; i < other.counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        if(other.total_) {
+            updateBounds(other.min_, other.max_);
+        }
+        total_ += other.total_;
+        sum_ += other.sum_;
+    }
+
+    // Highest value of the bucket of the percentile, at most the maximum.
+    uint64_t valueAtPercentile(double percentile) const {
+        if(!total_) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(
+            std::ceil(percentile / 100.0 * static_cast<double>(total_)));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for(size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if(seen >= rank) {
+                return std::max(min_, std::min(bucketHigh(i, bits_), max_));
+            }
+        }
+        return max_;
+    }
+
+    int subBucketBits() const { return bits_; }
+    const std::string& unit() const { return unit_; }
+    uint64_t total() const { return total_; }
+    uint64_t min() const { return min_; }
+    uint64_t max() const { return max_; }
+    double mean() const {
+        return total_ ? sum_ / static_cast<double>(total_) : 0;
+    }
+
+    // Writes the encoded histogram as a JSON object value: the non empty
+    // buckets as a flat list of (index delta, count) pairs.
+    void encode(channel::Json& json) const {
+        json.beginObject()
+            .field("sub_bucket_bits", bits_)
+            .field("unit", unit_)
+            .field("total", static_cast<unsigned long long>(total_))
+            .field("sum", sum_);
+        if(total_) {
+            json.field("min", static_cast<unsigned long long>(min_))
+                .field("max", static_cast<unsigned long long>(max_));
+        }
+        json.key("counts").beginArray();
+        size_t previous = 0;
+        for(size_t i = 0; i < counts_.size(); ++i) {
+            if(counts_[i]) {
+                json.value(static_cast<unsigned long long>(i - previous))
+                    .value(static_cast<unsigned long long>(counts_[i]));
+                previous = i;
+            }
+        }
+        json.endArray().endObject();
+    }
+
+private:
+    void updateBounds(uint64_t low, uint64_t high) {
+        if(!total_) {
+            min_ = low;
+            max_ = high;
+        } else {
+            min_ = std::min(min_, low);
+            max_ = std::max(max_, high);
+        }
+    }
+
+    int bits_;
+    std::string unit_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_;
+    double sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+// Writes a Histogram entry attached to the given test, see gtest.h and
+// cppunit.h for the helpers filling in the test. Returns whether the
+// channel is available.
+inline bool log(const Histogram& histogram, const std::string& description,
+                const std::string& suite, const std::string& test) {
+    if(!channel::enabled()) {
+        return false;
+    }
+    channel::Json json;
+    json.beginObject()
+        .field("id", channel::nextId())
+        .field("type", "histogram")
+        .field("description", description)
+        .field("suite", suite)
+        .field("test", test)
+        .field("attached", true)
+        .key("histogram");
+    histogram.encode(json);
+    json.endObject();
+    return channel::write(json);
+}
+
+} // namespace hdr
+} // namespace testplan
+
+#endif // TESTPLAN_HDR_H
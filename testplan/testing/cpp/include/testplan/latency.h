@@ -0,0 +1,259 @@
+// latency.h
+//
+// Latency budgets for hot path tests: a statement is timed over a number of
+// iterations, after warmup iterations that are not recorded, and the test
+// fails when the latency at a percentile exceeds the budget:
+//
+//     using namespace testplan::latency;
+//
+//     EXPECT_LATENCY(book.insert(order), p99(micros(5)));            // gtest.h
+//     EXPECT_LATENCY(book.cancel(id),
+//                    p999(micros(20)).iterations(100000).warmup(10000));
+//     TESTPLAN_CPPUNIT_ASSERT_LATENCY(book.insert(order),             // cppunit.h
+//                                     p99(micros(5)));
+//
+// Every measurement, passing or not, is written to the Testplan channel with
+// its percentiles and an HDR histogram of the samples (see hdr.h), which the
+// GTest and Cppunit runners render in the report.
+//
+// Each sample includes the cost of reading the clock (a few tens of ns with
+// std::chrono::steady_clock), time statements that last well above that or
+// batch them. Results the compiler could discard must be passed to
+// doNotOptimize().
+#ifndef TESTPLAN_LATENCY_H
+#define TESTPLAN_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "channel.h"
+#include "hdr.h"
+
+namespace testplan {
+namespace latency {
+
+// Durations are expressed in nanoseconds.
+inline double nanos(double value) { return value; }
+inline double micros(double value) { return value * 1e3; }
+inline double millis(double value) { return value * 1e6; }
+
+class Budget {
+public:
+    Budget(double percentile, double limit)
+        : percentile_(percentile), limit_(limit), iterations_(10000),
+          warmup_(1000) {}
+
+    // Recorded iterations.
+    Budget& iterations(size_t count) {
+        iterations_ = count > 0 ? count : 1;
+        return *this;
+    }
+
+    // Iterations run before recording, to warm caches and branch predictors.
+    Budget& warmup(size_t count) {
+        warmup_ = count;
+        return *this;
+    }
+
+    double percentile() const { return percentile_; }
+    double limit() const { return limit_; }
+    size_t iterationCount() const { return iterations_; }
+    size_t warmupCount() const { return warmup_; }
+
+private:
+    double percentile_;
+    double limit_;
+    size_t iterations_;
+    size_t warmup_;
+};
+
+inline Budget percentile(double p, double limit) { return Budget(p, limit); }
+inline Budget p50(double limit) { return Budget(50.0, limit); }
+inline Budget p90(double limit) { return Budget(90.0, limit); }
+inline Budget p99(double limit) { return Budget(99.0, limit); }
+inline Budget p999(double limit) { return Budget(99.9, limit); }
+
+struct Result {
+    explicit Result(const Budget& b)
+        : budget(b), measured(0), min(0), mean(0), max(0) {}
+
+    Budget budget;
+    // Latency at the budget percentile.
+    double measured;
+    double min;
+    double mean;
+    double max;
+    // (percentile, latency) of the standard percentiles.
+    std::vector<std::pair<double, double> > percentiles;
+    hdr::Histogram histogram;
+
+    bool passed() const { return measured <= budget.limit(); }
+};
+
+// Keeps the compiler from optimizing away the computation of `value`.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* sink =
+        reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+namespace detail {
+
+// Nearest rank percentile of sorted samples.
+inline double rank(const std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(
+        std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    index = std::min(std::max<size_t>(index, 1), sorted.size());
+    return sorted[index - 1];
+}
+
+inline std::string duration(double ns) {
+    char buf[32];
+    if(ns < 1e3) {
+        snprintf(buf, sizeof(buf), "%.0fns", ns);
+    } else if(ns < 1e6) {
+        snprintf(buf, sizeof(buf), "%.2fus", ns / 1e3);
+    } else if(ns < 1e9) {
+        snprintf(buf, sizeof(buf), "%.2fms", ns / 1e6);
+    } else {
+        snprintf(buf, sizeof(buf), "%.2fs", ns / 1e9);
+    }
+    return buf;
+}
+
+inline std::string percentileName(double p) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "p%g", p);
+    return buf;
+}
+
+} // namespace detail
+
+// Statistics of already measured samples, in nanoseconds.
+inline Result analyze(std::vector<double> samples, const Budget& budget) {
+    Result result(budget);
+    if(samples.empty()) {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0;
+    for(size_t i = 0; i < samples.size(); ++i) {
+        total += samples[i];
+        result.histogram.record(
+            static_cast<uint64_t>(std::max(samples[i], 0.0) + 0.5));
+    }
+    result.min = samples.front();
+    result.max = samples.back();
+    result.mean = total / static_cast<double>(samples.size());
+    result.measured = detail::rank(samples, budget.percentile());
+
+    static const double standard[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+    for(size_t i = 0; i < sizeof(standard) / sizeof(standard[0]); ++i) {
+        result.percentiles.push_back(
+            std::make_pair(standard[i], detail::rank(samples, standard[i])));
+    }
+    return result;
+}
+
+// Runs `body` budget.warmupCount() times, then times each of
+// budget.iterationCount() runs.
+template <typename F>
+Result measure(F body, const Budget& budget) {
+    typedef std::chrono::steady_clock Clock;
+
+    for(size_t i = 0; i < budget.warmupCount(); ++i) {
+        body();
+    }
+
+    std::vector<double> samples(budget.iterationCount());
+    for(size_t i = 0; i < samples.size(); ++i) {
+        Clock::time_point start = Clock::now();
+        body();
+        Clock::time_point end = Clock::now();
+        samples[i] = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                .count());
+    }
+    return analyze(samples, budget);
+}
+
+// Short description of a result, e.g. "p99 3.20us <= 5.00us".
+inline std::string summary(const Result& result) {
+    return detail::percentileName(result.budget.percentile()) + " " +
+           detail::duration(result.measured) +
+           (result.passed() ? " <= " : " > ") +
+           detail::duration(result.budget.limit()) + " over " +
+           std::to_string(result.budget.iterationCount()) + " iterations";
+}
+
+// Writes the result to the channel, attached to the given test when it
+// passed, and returns the failure message referring to it otherwise.
+inline std::string report(const Result& result, const char* statement,
+                          const std::string& suite, const std::string& test) {
+    std::string message = std::string("Latency of ") + statement + ": " +
+                          summary(result);
+
+    if(channel::enabled()) {
+        std::string id = channel::nextId();
+        channel::Json json;
+        json.beginObject()
+            .field("id", id)
+            .field("type", "latency")
+            .field("statement", statement)
+            .field("suite", suite)
+            .field("test", test)
+            .field("attached", result.passed())
+            .field("passed", result.passed())
+            .field("iterations",
+                   static_cast<unsigned long long>(
+                       result.budget.iterationCount()))
+            .field("warmup",
+                   static_cast<unsigned long long>(
+                       result.budget.warmupCount()))
+            .field("percentile", result.budget.percentile())
+            .field("limit_ns", result.budget.limit())
+            .field("measured_ns", result.measured)
+            .field("min_ns", result.min)
+            .field("mean_ns", result.mean)
+            .field("max_ns", result.max)
+            .key("percentiles")
+            .beginArray();
+        for(size_t i = 0; i < result.percentiles.size(); ++i) {
+            json.beginObject()
+                .field("percentile", result.percentiles[i].first)
+                .field("ns", result.percentiles[i].second)
+                .endObject();
+        }
+        json.endArray().key("histogram");
+        result.histogram.encode(json);
+        json.endObject();
+        if(channel::write(json) && !result.passed()) {
+            return message + " " + channel::marker(id);
+        }
+    }
+
+    for(size_t i = 0; i < result.percentiles.size(); ++i) {
+        message += "\n  " +
+                   detail::percentileName(result.percentiles[i].first) +
+                   ": " + detail::duration(result.percentiles[i].second);
+    }
+    return message;
+}
+
+} // namespace latency
+} // namespace testplan
+
+#endif // TESTPLAN_LATENCY_H
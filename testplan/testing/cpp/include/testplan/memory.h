@@ -0,0 +1,110 @@
+// memory.h
+//
+// Memory usage of the test process, sampled by the Testplan listeners of
+// gtest_listener.h and cppunit_listener.h at the start and at the end of
+// every test. The runners record the growth of each test, so that a leak
+// shows up on the test that leaks rather than as the peak RSS of the whole
+// process.
+//
+// The resident set size is read from /proc/self/statm. Defining
+// TESTPLAN_HEAP_USAGE before including the listeners also samples the bytes
+// allocated by malloc (glibc 2.33 or later), which is more precise for leaks
+// as freed memory is not always returned to the system, but walks the free
+// lists of the allocator.
+#ifndef TESTPLAN_MEMORY_H
+#define TESTPLAN_MEMORY_H
+
+#include <stdio.h>
+
+#include "channel.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(TESTPLAN_HEAP_USAGE) && defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace testplan {
+namespace memory {
+
+// Memory usage in bytes, -1 when unknown.
+struct Usage {
+    Usage() : rss(-1), heap(-1) {}
+
+    long long rss;
+    long long heap;
+};
+
+// Resident set size, read without allocating so as not to disturb what is
+// measured.
+inline long long residentBytes() {
+#ifdef __linux__
+    int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+        return -1;
+    }
+    char buf[128];
+    ssize_t size = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if(size <= 0) {
+        return -1;
+    }
+    buf[size] = '\0';
+
+    // Total program size then resident pages
+    unsigned long long pages = 0, resident = 0;
+    if(sscanf(buf, "%llu %llu", &pages, &resident) != 2) {
+        return -1;
+    }
+    return static_cast<long long>(resident) * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+// Bytes allocated by malloc, in use by the program.
+inline long long heapBytes() {
+#if defined(TESTPLAN_HEAP_USAGE) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+inline Usage current() {
+    Usage usage;
+    usage.rss = residentBytes();
+    usage.heap = heapBytes();
+    return usage;
+}
+
+// Records the memory usage of the process before and after a test.
+inline void writeRecord(const std::string& suite, const std::string& test,
+                        const Usage& start, const Usage& end) {
+    if(start.rss < 0 || end.rss < 0) {
+        return;
+    }
+    channel::Json json;
+    json.beginObject()
+        .field("id", channel::nextId())
+        .field("type", "test_memory")
+        .field("suite", suite)
+        .field("test", test)
+        .field("rss_start", start.rss)
+        .field("rss_end", end.rss);
+    if(start.heap >= 0 && end.heap >= 0) {
+        json.field("heap_start", start.heap).field("heap_end", end.heap);
+    }
+    json.endObject();
+    channel::write(json);
+}
+
+} // namespace memory
+} // namespace testplan
+
+#endif // TESTPLAN_MEMORY_H
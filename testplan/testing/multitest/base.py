@@ -16,6 +16,7 @@ from testplan.common.utils import validation
 from testplan.common.utils import timing
 from testplan.common.utils import callable as callable_utils
 from testplan.common.utils import strings
+from testplan.runners.processing import ReportProcessor, ReportProcessingError
 
 from testplan.testing import tagging
 from testplan.testing import filtering
@@ -108,6 +109,7 @@ class MultiTestConfig(testing_base.TestConfig):
             "suites": Use(iterable_suites),
             config.ConfigOption("thread_pool_size", default=0): int,
             config.ConfigOption("max_thread_pool_size", default=10): int,
+            config.ConfigOption("process_pool_size", default=0): int,
             config.ConfigOption("stop_on_error", default=True): bool,
             config.ConfigOption("part", default=None): Or(
                 None,
@@ -152,6 +154,15 @@ class MultiTest(testing_base.Test):
     :type thread_pool_size: ``int``
     :param max_thread_pool_size: Maximum number of threads allowed in the pool.
     :type max_thread_pool_size: ``int``
+    :param process_pool_size: Number of forked processes which execute
+        testcases with execution_group specified in parallel instead of the
+        thread pool, e.g. for CPU bound assertions (default 0 means threads).
+        The processes share the started environment of the MultiTest and
+        send back the testcase reports. Drivers that serve from threads of
+        the test process (e.g. ``FixServer``, ``TCPServer``,
+        ``HTTPServer``) do not run in forked processes, the thread pool is
+        used if the environment has any.
+    :type process_pool_size: ``int``
     :param stop_on_error: When exception raised, stop executing remaining
         testcases in the current test suite. Default: True
     :type stop_on_error: ``bool``
@@ -188,6 +199,7 @@ class MultiTest(testing_base.Test):
         description=None,
         thread_pool_size=0,
         max_thread_pool_size=10,
+        process_pool_size=0,
         stop_on_error=True,
         part=None,
         multi_part_uid=None,
@@ -219,6 +231,8 @@ class MultiTest(testing_base.Test):
         # MultiTest may start a thread pool for running testcases concurrently,
         # if they are marked with an execution group.
         self._thread_pool = None
+        # Or processes forked from the current one, see process_pool_size
+        self._process_pool = None
 
         self.log_testcase_status = functools.partial(
             self._log_status, indent=testing_base.TESTCASE_INDENT
@@ -270,14 +284,18 @@ class MultiTest(testing_base.Test):
         :rtype: ``list`` of ``tuple``
         """
         ctx = []
-        sorted_suites = self.cfg.test_sorter.sorted_testsuites(self.cfg.suites)
+        sorted_suites = self.cfg.test_sorter.sorted_testsuites(
+            self.cfg.suites, test=self
+        )
 
         for suite in sorted_suites:
             testcases = suite.get_testcases()
             sorted_testcases = (
                 testcases
                 if getattr(suite, "strict_order", False)
-                else self.cfg.test_sorter.sorted_testcases(suite, testcases)
+                else self.cfg.test_sorter.sorted_testcases(
+                    suite, testcases, test=self
+                )
             )
 
             testcases_to_run = [
@@ -340,12 +358,18 @@ class MultiTest(testing_base.Test):
         testsuites = self.test_context
         report = self.report
         report.runtime_status = RuntimeStatus.RUNNING
+        self._journal_group(report, [])
 
         with report.timer.record("run"):
             if _need_threadpool(testsuites):
-                self._thread_pool = concurrent.futures.ThreadPoolExecutor(
-                    self._thread_pool_size
-                )
+                if self._can_fork_testcases():
+                    self._process_pool = ReportProcessor(
+                        workers=self.cfg.process_pool_size
+                    )
+                else:
+                    self._thread_pool = concurrent.futures.ThreadPoolExecutor(
+                        self._thread_pool_size
+                    )
 
             for testsuite, testcases in testsuites:
                 if not self.active:
@@ -369,6 +393,9 @@ class MultiTest(testing_base.Test):
             if self._thread_pool is not None:
                 self._thread_pool.shutdown()
                 self._thread_pool = None
+            if self._process_pool is not None:
+                self._process_pool.shutdown()
+                self._process_pool = None
 
         report.runtime_status = RuntimeStatus.FINISHED
 
@@ -669,11 +696,13 @@ class MultiTest(testing_base.Test):
         _check_testcases(testcases)
         testsuite_report = self._new_testsuite_report(testsuite)
         testsuite_report.runtime_status = RuntimeStatus.RUNNING
+        self._journal_group(testsuite_report, [self.uid()])
 
         with testsuite_report.timer.record("run"):
             setup_report = self._setup_testsuite(testsuite)
             if setup_report is not None:
                 testsuite_report.append(setup_report)
+                self._record_testcase(setup_report, [testsuite.name])
                 if setup_report.failed:
                     return testsuite_report
 
@@ -704,6 +733,7 @@ class MultiTest(testing_base.Test):
             teardown_report = self._teardown_testsuite(testsuite)
             if teardown_report is not None:
                 testsuite_report.append(teardown_report)
+                self._record_testcase(teardown_report, [testsuite.name])
 
         # if testsuite is marked xfail by user, override its status
         if hasattr(testsuite, "__xfail__"):
@@ -739,9 +769,16 @@ class MultiTest(testing_base.Test):
                     )
                     parametrization_reports[param_template] = param_report
                     testcase_reports.append(param_report)
+                    self._journal_group(
+                        param_report, [self.uid(), testsuite.name]
+                    )
                 parametrization_reports[param_template].append(testcase_report)
+                self._record_testcase(
+                    testcase_report, [testsuite.name, param_template]
+                )
             else:
                 testcase_reports.append(testcase_report)
+                self._record_testcase(testcase_report, [testsuite.name])
 
             if testcase_report.status == Status.ERROR:
                 if self.cfg.stop_on_error:
@@ -755,8 +792,8 @@ class MultiTest(testing_base.Test):
 
     def _run_parallel_testcases(self, testsuite, execution_groups):
         """
-        Schedule parallel testcases to a threadpool, wait for them to complete
-        and return a list of testcase reports.
+        Schedule parallel testcases to a threadpool or forked processes, wait
+        for them to complete and return a list of testcase reports.
         """
         testcase_reports = []
         all_testcases = itertools.chain.from_iterable(
@@ -765,24 +802,43 @@ class MultiTest(testing_base.Test):
         parametrization_reports = self._parametrization_reports(
             testsuite, all_testcases
         )
+        for param_report in parametrization_reports.values():
+            self._journal_group(param_report, [self.uid(), testsuite.name])
         pre_testcase = getattr(testsuite, "pre_testcase", None)
         post_testcase = getattr(testsuite, "post_testcase", None)
 
         for exec_group in execution_groups:
             self.logger.debug('Running execution group "%s"', exec_group)
-            results = [
-                self._thread_pool.submit(
-                    self._run_testcase, testcase, pre_testcase, post_testcase
+            if self._process_pool is not None:
+                results = self._run_forked_testcases(
+                    execution_groups[exec_group], pre_testcase, post_testcase
                 )
-                for testcase in execution_groups[exec_group]
-            ]
+            else:
+                results = [
+                    self._thread_pool.submit(
+                        self._run_testcase,
+                        testcase,
+                        pre_testcase,
+                        post_testcase,
+                    )
+                    for testcase in execution_groups[exec_group]
+                ]
 
             should_stop = False
 
             for i, future in enumerate(results):
-                testcase_report = future.result()
-
                 testcase = execution_groups[exec_group][i]
+                try:
+                    testcase_report = future.result()
+                except ReportProcessingError as exc:
+                    # The process running the testcase failed or died
+                    testcase_report = self._new_testcase_report(testcase)
+                    testcase_report.logger.error(
+                        "Testcase process failed: {}".format(exc)
+                    )
+                    testcase_report.status_override = Status.ERROR
+                    testcase_report.runtime_status = RuntimeStatus.FINISHED
+
                 param_template = getattr(
                     testcase, "_parametrization_template", None
                 )
@@ -790,8 +846,12 @@ class MultiTest(testing_base.Test):
                     parametrization_reports[param_template].append(
                         testcase_report
                     )
+                    self._record_testcase(
+                        testcase_report, [testsuite.name, param_template]
+                    )
                 else:
                     testcase_reports.append(testcase_report)
+                    self._record_testcase(testcase_report, [testsuite.name])
 
                 # If any testcase errors and we are configured to stop on
                 # errors, we still wait for the rest of the current execution
@@ -817,6 +877,75 @@ class MultiTest(testing_base.Test):
 
         return testcase_reports
 
+    def _can_fork_testcases(self):
+        """
+        Whether parallel testcases run in forked processes, which drivers
+        serving from threads of the test process cannot be used from: the
+        thread pool is used instead when the environment has any.
+        """
+        if self.cfg.process_pool_size <= 0:
+            return False
+        threaded = [
+            driver.uid()
+            for driver in self.resources
+            if not getattr(driver, "FORK_SAFE", True)
+        ]
+        if threaded:
+            self.logger.warning(
+                "%s: running parallel testcases in threads, not in forked"
+                " processes, as drivers %s serve from threads of the test"
+                " process",
+                self,
+                ", ".join(threaded),
+            )
+            return False
+        return True
+
+    def _run_forked_testcases(self, testcases, pre_testcase, post_testcase):
+        """
+        Run testcases in processes forked from the current one, which inherit
+        the started environment instead of having it pickled, and return the
+        futures of their reports, pickled back once they complete.
+
+        Changes made by the testcases to the suite or environment objects are
+        only seen by their own process.
+        """
+        futures = [
+            self._process_pool.submit(
+                self._run_testcase, testcase, pre_testcase, post_testcase
+            )
+            for testcase in testcases
+        ]
+        while self._process_pool.pending:
+            self._process_pool.poll(timeout=None)
+        return futures
+
+    def _journal_group(self, group_report, parent_uids):
+        """Record a started group in the report journal, if any."""
+        journal = self.report_journal
+        if journal is not None:
+            journal.group(group_report, parent_uids)
+
+    def _record_testcase(self, testcase_report, parent_uids):
+        """
+        Record a completed testcase in the report journal and publish it on
+        the event bus of the run, if any, given the uids of its parents below
+        this MultiTest.
+        """
+        journal = self.report_journal
+        if journal is not None:
+            journal.testcase(testcase_report, [self.uid()] + parent_uids)
+        bus = self.event_bus
+        if bus is not None:
+            bus.publish(
+                "testcase_finished",
+                test=self.uid(),
+                suite=parent_uids[0],
+                testcase=testcase_report.name,
+                status=testcase_report.status,
+                entries=len(testcase_report.entries),
+            )
+
     def _parametrization_reports(self, testsuite, testcases):
         """
         Generate parametrization reports for any parametrized testcases.
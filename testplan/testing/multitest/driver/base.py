@@ -126,6 +126,11 @@ class Driver(Resource):
 
     CONFIG = DriverConfig
 
+    # Whether the driver can be used by testcases run in forked processes
+    # (see MultiTest process_pool_size), i.e. it does not serve from threads
+    # of the test process, which do not exist in forked processes.
+    FORK_SAFE = True
+
     def __init__(
         self,
         name,
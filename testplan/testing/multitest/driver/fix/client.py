@@ -268,6 +268,29 @@ class FixClient(Driver):
         self.logger.debug("Received msg {}.".format(received))
         return received
 
+    def receive_iter(self, count=None, timeout=None):
+        """
+        Iterate over received messages, e.g. to match them in bulk with
+        ``result.fix.match_bulk``. Stops after ``count`` messages or when no
+        message is received within the timeout.
+
+        :param count: Maximum number of messages, unlimited if ``None``.
+        :type count: ``int`` or ``NoneType``
+        :param timeout: Timeout in seconds for each message.
+        :type timeout: ``int``
+
+        :return: received ``FixMessage`` objects
+        :rtype: ``generator`` of ``FixMessage``
+        """
+        received = 0
+        while count is None or received < count:
+            try:
+                msg = self.receive(timeout=timeout)
+            except TimeoutException:
+                return
+            received += 1
+            yield msg
+
     def flush(self, timeout=0):
         """
         Flush all inbound messages.
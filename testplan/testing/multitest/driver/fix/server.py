@@ -70,6 +70,9 @@ class FixServer(Driver):
 
     CONFIG = FixServerConfig
 
+    # Served from a thread of the test process
+    FORK_SAFE = False
+
     def __init__(
         self,
         name,
@@ -191,6 +194,35 @@ class FixServer(Driver):
         )
         return received
 
+    def receive_iter(self, conn_name=(None, None), count=None, timeout=60):
+        """
+        Iterate over the FIX messages received from the given connection,
+        e.g. to match them in bulk with ``result.fix.match_bulk``. Stops after
+        ``count`` messages or when no message is received within the timeout,
+        or immediately available if the timeout is ``None``.
+
+        :param conn_name:  Connection name (sender and target ids) to receive
+          messages from.
+        :type conn_name: ``tuple`` of ``str`` and ``str``
+        :param count: Maximum number of messages, unlimited if ``None``.
+        :type count: ``int`` or ``NoneType``
+        :param timeout: timeout in seconds for each message or ``None``
+        :type timeout: ``int`` or ``NoneType``
+
+        :return: received FixMessage objects
+        :rtype: ``generator`` of ``FixMessage``
+        """
+        received = 0
+        while count is None or received < count:
+            try:
+                msg = self.receive(conn_name, timeout=timeout)
+            except TimeoutException:
+                return
+            if msg is None:
+                return
+            received += 1
+            yield msg
+
     def flush(self):
         """
         Flush the receive queues
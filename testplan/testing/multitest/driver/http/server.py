@@ -195,6 +195,9 @@ class HTTPServer(Driver):
 
     CONFIG = HTTPServerConfig
 
+    # Served from a thread of the test process
+    FORK_SAFE = False
+
     def __init__(
         self,
         name,
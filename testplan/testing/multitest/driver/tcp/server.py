@@ -52,6 +52,9 @@ class TCPServer(Driver):
 
     CONFIG = TCPServerConfig
 
+    # Served from a thread of the test process
+    FORK_SAFE = False
+
     def __init__(self, name, host="localhost", port=0, **options):
         options.update(self.filter_locals(locals()))
         super(TCPServer, self).__init__(**options)
@@ -16,8 +16,15 @@ import cmath
 
 import lxml
 
+try:
+    import numpy
+except ImportError:
+    numpy = None  # Tables are compared row by row
+
+from testplan import defaults
 from testplan.common.utils.convert import make_tuple, flatten_dict_comparison
-from testplan.common.utils import comparison, difflib
+from testplan.common.utils import columnar, comparison, difflib
+from testplan.common.utils.table import TableEntry
 
 from .base import BaseEntry, get_table
 
@@ -56,9 +63,11 @@ __all__ = [
     "DictCheck",
     "DictMatch",
     "DictMatchAll",
+    "DictMatchBulk",
     "FixCheck",
     "FixMatch",
     "FixMatchAll",
+    "FixMatchBulk",
 ]
 
 
@@ -756,6 +765,18 @@ def get_comparison_columns(table_1, table_2, include_columns, exclude_columns):
     :param exclude_columns: Exclusion rules for columns.
     :type exclude_columns: ``list`` of ``str``
     """
+    return _get_comparison_columns(
+        columns_1=table_1[0].keys() if table_1 else [],
+        columns_2=table_2[0].keys() if table_2 else [],
+        include_columns=include_columns,
+        exclude_columns=exclude_columns,
+    )
+
+
+def _get_comparison_columns(
+    columns_1, columns_2, include_columns, exclude_columns
+):
+    """``get_comparison_columns`` from the column names of the tables."""
 
     def check_missing_columns(columns, lookup):
         """Check if ``columns`` have any missing elements from ``lookup``."""
@@ -771,9 +792,6 @@ def get_comparison_columns(table_1, table_2, include_columns, exclude_columns):
             )
         )
 
-    columns_1 = table_1[0].keys() if table_1 else []
-    columns_2 = table_2[0].keys() if table_2 else []
-
     comparison_columns = columns_1
 
     if include_columns:
@@ -811,6 +829,20 @@ def get_comparison_columns(table_1, table_2, include_columns, exclude_columns):
     return comparison_columns
 
 
+def _check_display_columns(comparison_columns, display_columns):
+    # We always want to display a superset of comparison columns
+    # otherwise we can have a failing comparison but the
+    # resulting data will not include the mismatch context.
+    if not set(comparison_columns).issubset(display_columns):
+        raise ValueError(
+            "comparison_columns ({}) must be "
+            "subset of display_columns ({})".format(
+                ", ".join(sorted(comparison_columns)),
+                ", ".join(sorted(display_columns)),
+            )
+        )
+
+
 def compare_rows(
     table,
     expected_table,
@@ -848,76 +880,320 @@ def compare_rows(
     :type report_fails_only: ``bool``
     :returns: overall passed status and RowComparison data.
     """
+    _check_display_columns(comparison_columns, display_columns)
 
-    # We always want to display a superset of comparison columns
-    # otherwise we can have a failing comparison but the
-    # resulting data will not include the mismatch context.
-    if not set(comparison_columns).issubset(display_columns):
-        raise ValueError(
-            "comparison_columns ({}) must be "
-            "subset of display_columns ({})".format(
-                ", ".join(sorted(comparison_columns)),
-                ", ".join(sorted(display_columns)),
-            )
-        )
-
-    data = []
-    num_failures = 0
+    num_rows = min(len(table), len(expected_table))
+    table, expected_table = table[:num_rows], expected_table[:num_rows]
+    display_only = [
+        col for col in display_columns if col not in comparison_columns
+    ]
+    columns = collections.OrderedDict(
+        (col, [row[col] for row in table]) for col in display_columns
+    )
+    expected_columns = collections.OrderedDict(
+        (col, [row[col] for row in expected_table])
+        for col in comparison_columns
+    )
+    expected_columns.update(
+        (col, [row.get(col, _MISSING) for row in expected_table])
+        for col in display_only
+    )
+
+    passed, data, _ = compare_columns(
+        columns=columns,
+        expected_columns=expected_columns,
+        num_rows=num_rows,
+        comparison_columns=comparison_columns,
+        display_columns=display_columns,
+        strict=strict,
+        fail_limit=fail_limit,
+        report_fails_only=report_fails_only,
+    )
+    return passed, data
+
+
+# Cell missing from a row of the expected table
+_MISSING = object()
+
+
+def compare_columns(
+    columns,
+    expected_columns,
+    num_rows,
+    comparison_columns,
+    display_columns,
+    strict=True,
+    fail_limit=0,
+    report_fails_only=False,
+    report_pass_limit=0,
+):
+    """
+    Compare two tables column by column, as ``compare_rows`` does row by
+    row, creating a ``RowComparison`` only for the reported rows.
+
+    The comparisons of a column are vectorized when possible, see
+    :py:mod:`testplan.common.utils.columnar`. Without numpy, the cells are
+    compared row by row.
+
+    :param columns: Cells of the display columns of the original table.
+    :type columns: ``dict`` of ``list``
+    :param expected_columns: Cells of the display columns of the
+                             comparison table, which may be missing from
+                             some of its rows for the columns not compared.
+    :type expected_columns: ``dict`` of ``list``
+    :param num_rows: Number of rows of the tables.
+    :type num_rows: ``int``
+    :param comparison_columns: Columns to be used for comparison.
+    :type comparison_columns: ``list`` of ``str``
+    :param display_columns: Columns to be used
+                            for populating ``RowComparison`` data.
+    :type display_columns: ``list`` of ``str``
+    :param strict: Custom comparator strictness flag.
+    :type strict: ``bool``
+    :param fail_limit: Max number of failures before aborting
+                       the comparison run.
+    :type fail_limit: ``int``
+    :param report_fails_only: If ``True``, only report the failures.
+    :type report_fails_only: ``bool``
+    :param report_pass_limit: Max number of passing rows to report, all of
+                              them if 0.
+    :type report_pass_limit: ``int``
+    :returns: overall passed status, RowComparison data and the number of
+              compared passing rows that are not reported.
+    """
+    _check_display_columns(comparison_columns, display_columns)
     display_only = [
         col for col in display_columns if col not in comparison_columns
     ]
 
-    for idx, (row_1, row_2) in enumerate(zip(table, expected_table)):
-        diff, errors, extra = {}, {}, {}
-
-        for column_name in comparison_columns:
-            first, second = row_1[column_name], row_2[column_name]
+    if numpy is None:
+        return _compare_row_by_row(
+            columns,
+            expected_columns,
+            num_rows,
+            comparison_columns,
+            display_columns,
+            display_only,
+            strict,
+            fail_limit,
+            report_fails_only,
+            report_pass_limit,
+        )
 
-            passed, error = comparison.basic_compare(
-                first=first, second=second, strict=strict
+    row_passed = numpy.ones(num_rows, dtype=bool)
+    cell_passed, cell_errors = {}, {}
+    by_cell = []
+    for column_name in comparison_columns:
+        passed = columnar.compare_whole_column(
+            columns[column_name], expected_columns[column_name], strict=strict
+        )
+        if passed is None:
+            by_cell.append(column_name)
+            continue
+        cell_passed[column_name], cell_errors[column_name] = passed, {}
+        row_passed &= passed
+
+    if by_cell and fail_limit > 0:
+        # Comparators are not called past the failure limit
+        _compare_cells_until(
+            columns,
+            expected_columns,
+            by_cell,
+            row_passed,
+            cell_passed,
+            cell_errors,
+            strict,
+            fail_limit,
+        )
+    else:
+        for column_name in by_cell:
+            cell_passed[column_name], cell_errors[column_name] = (
+                columnar.compare_cells(
+                    columns[column_name],
+                    expected_columns[column_name],
+                    strict=strict,
+                )
             )
+            row_passed &= cell_passed[column_name]
+
+    # Rows compared before reaching the failure limit
+    failing = numpy.flatnonzero(~row_passed)
+    num_compared = num_rows
+    if fail_limit > 0 and len(failing) >= fail_limit:
+        num_compared = int(failing[fail_limit - 1]) + 1
+
+    if report_fails_only:
+        reported = failing[failing < num_compared]
+        omitted = 0
+    else:
+        reported = numpy.arange(num_compared)
+        omitted = 0
+        if report_pass_limit > 0:
+            passing = numpy.flatnonzero(row_passed[:num_compared])
+            omitted = max(len(passing) - report_pass_limit, 0)
+            if omitted:
+                reported = numpy.union1d(
+                    failing[failing < num_compared],
+                    passing[:report_pass_limit],
+                )
 
-            if error:
-                errors[column_name] = error
-
-            elif not passed:
-                diff[column_name] = second
-
-            # Populate extra if values differ (we don't check for equality
-            # as that may have raised an error for incompatible types as well
-            if first is not second and (error or passed):
-                extra[column_name] = second
-
-        row_data = [row_1[col] for col in display_columns]
-
-        # Need to populate extra with values from the
-        # second table, if they are not being used
-        # for comparison but have different values.
-        extra.update(
-            {
-                col: row_2[col]
-                for col in display_only
-                if col in row_2 and row_2[col] != row_1[col]
-            }
+    data = [
+        _row_comparison(
+            idx,
+            columns,
+            expected_columns,
+            comparison_columns,
+            display_columns,
+            display_only,
+            lambda column_name, idx: (
+                cell_passed[column_name][idx],
+                cell_errors[column_name].get(idx),
+            ),
         )
+        for idx in reported.tolist()
+    ]
+    return len(failing) == 0, data, omitted
 
-        row_comparison = RowComparison(idx, row_data, diff, errors, extra)
 
-        if not (report_fails_only and row_comparison.passed):
-            data.append(row_comparison)
+def _compare_row_by_row(
+    columns,
+    expected_columns,
+    num_rows,
+    comparison_columns,
+    display_columns,
+    display_only,
+    strict,
+    fail_limit,
+    report_fails_only,
+    report_pass_limit,
+):
+    """
+    ``compare_columns`` without numpy, comparing the cells of each row in
+    turn until ``fail_limit`` rows failed.
+    """
+    data = []
+    num_failures = num_passing = omitted = 0
+
+    def compare_cell(column_name, idx):
+        return comparison.basic_compare(
+            first=columns[column_name][idx],
+            second=expected_columns[column_name][idx],
+            strict=strict,
+        )
+
+    for idx in range(num_rows):
+        row_comparison = _row_comparison(
+            idx,
+            columns,
+            expected_columns,
+            comparison_columns,
+            display_columns,
+            display_only,
+            compare_cell,
+        )
 
         if not row_comparison.passed:
             num_failures += 1
+            data.append(row_comparison)
+        elif not report_fails_only:
+            if 0 < report_pass_limit <= num_passing:
+                omitted += 1
+            else:
+                data.append(row_comparison)
+            num_passing += 1
 
         if fail_limit > 0 and num_failures >= fail_limit:
             break
 
-    return num_failures == 0, data
+    return num_failures == 0, data, omitted
+
+
+def _row_comparison(
+    idx,
+    columns,
+    expected_columns,
+    comparison_columns,
+    display_columns,
+    display_only,
+    compare_cell,
+):
+    """
+    ``RowComparison`` of a row of the tables, ``compare_cell`` returning
+    the result and traceback of the comparison of a cell by column and row.
+    """
+    diff, errors, extra = {}, {}, {}
+
+    for column_name in comparison_columns:
+        first = columns[column_name][idx]
+        second = expected_columns[column_name][idx]
+        passed, error = compare_cell(column_name, idx)
+
+        if error:
+            errors[column_name] = error
+
+        elif not passed:
+            diff[column_name] = second
+
+        # Populate extra if values differ (we don't check for equality
+        # as that may have raised an error for incompatible types as well
+        if first is not second and (error or passed):
+            extra[column_name] = second
+
+    row_data = [columns[col][idx] for col in display_columns]
+
+    # Need to populate extra with values from the
+    # second table, if they are not being used
+    # for comparison but have different values.
+    for col in display_only:
+        second = expected_columns[col][idx]
+        if second is not _MISSING and second != columns[col][idx]:
+            extra[col] = second
+
+    return RowComparison(idx, row_data, diff, errors, extra)
+
+
+def _compare_cells_until(
+    columns,
+    expected_columns,
+    by_cell,
+    row_passed,
+    cell_passed,
+    cell_errors,
+    strict,
+    fail_limit,
+):
+    """
+    Compare the cells of the ``by_cell`` columns row by row, until
+    ``fail_limit`` rows failed, counting the rows that already failed the
+    comparison of the other columns. The following rows are not reported.
+    """
+    for column_name in by_cell:
+        cell_passed[column_name] = numpy.zeros(len(row_passed), dtype=bool)
+        cell_errors[column_name] = {}
+
+    num_failed = 0
+    for idx in range(len(row_passed)):
+        for column_name in by_cell:
+            passed, error = comparison.basic_compare(
+                columns[column_name][idx],
+                expected_columns[column_name][idx],
+                strict=strict,
+            )
+            if error:
+                cell_errors[column_name][idx] = error
+            else:
+                cell_passed[column_name][idx] = bool(passed)
+            row_passed[idx] &= cell_passed[column_name][idx]
+
+        if not row_passed[idx]:
+            num_failed += 1
+            if num_failed >= fail_limit:
+                return
 
 
 class TableMatch(Assertion):
     """
-    Match two tables using ``compare_rows``, may generate
+    Match two tables using ``compare_columns``, may generate
     custom message if tables cannot be compared for certain reasons.
     """
 
@@ -931,11 +1207,12 @@ class TableMatch(Assertion):
         fail_limit=0,
         report_fail_only=False,
         strict=False,
+        report_pass_limit=0,
         description=None,
         category=None,
     ):
-        self.table = get_table(table)
-        self.expected_table = get_table(expected_table)
+        self._table = _table_entry(table)
+        self._expected_table = _table_entry(expected_table)
         self.include_columns = include_columns
         self.exclude_columns = exclude_columns
         self.strict = strict
@@ -943,8 +1220,11 @@ class TableMatch(Assertion):
 
         self.fail_limit = fail_limit
         self.report_fails_only = report_fail_only
+        self.report_pass_limit = report_pass_limit
 
         # these will populated by self.evaluate
+        self.table = []
+        self.expected_table = []
         self.display_columns = []
         self.message = None
         self.data = []
@@ -954,7 +1234,12 @@ class TableMatch(Assertion):
         )
 
     def evaluate(self):
-        len_table, len_expected = len(self.table), len(self.expected_table)
+        # Original and comparison tables as ``list`` of ``dict``
+        self.table = get_table(self._table)
+        self.expected_table = get_table(self._expected_table)
+
+        len_table = len(self._table)
+        len_expected = len(self._expected_table)
 
         if len_table != len_expected:
             self.message = (
@@ -963,14 +1248,14 @@ class TableMatch(Assertion):
             ).format(len_table, len_expected)
             return False
 
-        if not (self.table or self.expected_table):
+        if not len_table:
             self.message = "Both tables are empty."
             return True
 
         try:
-            comparison_columns = get_comparison_columns(
-                table_1=self.table,
-                table_2=self.expected_table,
+            comparison_columns = _get_comparison_columns(
+                columns_1=list(self._table.column_names),
+                columns_2=list(self._expected_table.column_names),
                 include_columns=self.include_columns,
                 exclude_columns=self.exclude_columns,
             )
@@ -978,22 +1263,43 @@ class TableMatch(Assertion):
             self.message = str(exc)
             return False  # Fail on invalid tables
 
+        columns = self._table.as_columns()
         self.display_columns = (
-            self.table[0].keys() if self.report_all else comparison_columns
+            list(columns) if self.report_all else comparison_columns
+        )
+        expected_columns = self._expected_table.as_columns(
+            comparison_columns
+        )
+        expected_columns.update(
+            self._expected_table.as_columns(
+                [c for c in self.display_columns if c not in expected_columns],
+                placeholder=_MISSING,
+            )
         )
 
-        passed, self.data = compare_rows(
-            table=self.table,
-            expected_table=self.expected_table,
+        passed, self.data, omitted = compare_columns(
+            columns=columns,
+            expected_columns=expected_columns,
+            num_rows=len_table,
             comparison_columns=comparison_columns,
             display_columns=self.display_columns,
             strict=self.strict,
             fail_limit=self.fail_limit,
             report_fails_only=self.report_fails_only,
+            report_pass_limit=self.report_pass_limit,
         )
+        if omitted:
+            self.message = "{} passing row{} not reported.".format(
+                omitted, "s" if omitted > 1 else ""
+            )
         return passed
 
 
+def _table_entry(source):
+    """Tabular data as a ``TableEntry``."""
+    return source if isinstance(source, TableEntry) else TableEntry(source)
+
+
 class TableDiff(TableMatch):
     """
     Match two tables using ``compare_rows`` but only keep
@@ -1367,3 +1673,270 @@ class FixMatchAll(DictMatchAll):
             category=category,
             value_cmp_func=value_cmp_func,
         )
+
+
+class DictMatchBulk(Assertion):
+    """
+    Match a stream of dicts, e.g. messages received from a driver, against
+    named templates in a single entry.
+
+    Values are compared as they are consumed and are not kept: for each
+    template the entry counts the values matched and passed and the
+    mismatches of each key, and keeps the comparisons of the first failing
+    values of each combination of failed keys, as dict match summaries do.
+    """
+
+    key_label = "key"
+
+    def __init__(
+        self,
+        values,
+        templates,
+        template_key=None,
+        include_keys=None,
+        exclude_keys=None,
+        num_failing=defaults.SUMMARY_NUM_FAILING,
+        key_combs_limit=defaults.SUMMARY_KEY_COMB_LIMIT,
+        description=None,
+        category=None,
+        value_cmp_func=comparison.COMPARE_FUNCTIONS["native_equality"],
+    ):
+        """
+        :param values: Dicts to match, consumed once.
+        :type values: ``iterable`` of ``dict``
+        :param templates: Expected dicts or comparison plans by name.
+        :type templates: ``dict``
+        :param template_key: Key of the values holding the name of their
+            template, or function returning it. Values are matched against
+            the first template they pass, or else the one with the fewest
+            failed keys if not given.
+        :type template_key: ``object`` or ``callable``
+        :param num_failing: Number of failing values kept for each
+            combination of failed keys.
+        :type num_failing: ``int``
+        :param key_combs_limit: Number of combinations of failed keys
+            kept for each template, failures of others are only counted.
+        :type key_combs_limit: ``int``
+        """
+        self._values = values
+        self._templates = templates
+        self._template_key = template_key
+        self.include_keys = include_keys
+        self.exclude_keys = exclude_keys
+        self.num_failing = num_failing
+        self.key_combs_limit = key_combs_limit
+        self._value_cmp_func = value_cmp_func
+
+        # will be set by evaluate
+        self.num_values = 0
+        self.num_passed = 0
+        self.templates = None
+        self.unmatched = None
+        self.columns = None
+        self.table = None
+        self.indices = None
+        self.display_index = False
+        super(DictMatchBulk, self).__init__(
+            description=description, category=category
+        )
+
+    def get_value_cmp_func(self, value, plan):
+        """Value comparison function of a value and a template."""
+        return self._value_cmp_func
+
+    def _compare(self, value, plan, report_mode):
+        return plan.compare(
+            value,
+            ignore=self.exclude_keys,
+            only=self.include_keys,
+            report_mode=report_mode,
+            value_cmp_func=self.get_value_cmp_func(value, plan),
+        )
+
+    def _failed_keys(self, value, plan):
+        """Pass status of a value and its failed top level keys."""
+        passed, cmp_result = self._compare(
+            value, plan, comparison.ReportOptions.FAILS_ONLY
+        )
+        if passed:
+            return True, ()
+        return False, tuple(
+            row[0] for row in cmp_result if row[1] == comparison.Match.FAIL
+        )
+
+    def _match_template(self, value, plans):
+        """
+        Name of the template of a value, its pass status and failed keys,
+        ``None`` for the status if the value has no template.
+        """
+        if self._template_key is None:
+            best = (None, None, ())
+            for name, plan in plans.items():
+                passed, failed = self._failed_keys(value, plan)
+                if passed:
+                    return name, True, ()
+                if best[1] is None or len(failed) < len(best[2]):
+                    best = (name, False, failed)
+            return best
+
+        if callable(self._template_key):
+            name = self._template_key(value)
+        elif self._template_key in value:
+            name = value[self._template_key]
+        else:
+            name = None
+        if name not in plans:
+            return name, None, ()
+        return (name,) + self._failed_keys(value, plans[name])
+
+    def evaluate(self):
+        plans = collections.OrderedDict()
+        stats = collections.OrderedDict()
+        for name, expected in self._templates.items():
+            if not isinstance(expected, comparison.ComparisonPlan):
+                expected = comparison.ComparisonPlan(expected)
+            plans[name] = expected
+            stats[name] = {
+                "total": 0,
+                "passed": 0,
+                "mismatches": collections.Counter(),
+                "failures": collections.OrderedDict(),
+                "other_failures": 0,
+            }
+        self.unmatched = {"total": 0, "samples": []}
+
+        for index, value in enumerate(self._values):
+            self.num_values += 1
+            name, passed, failed = self._match_template(value, plans)
+            if passed is None:
+                self.unmatched["total"] += 1
+                if len(self.unmatched["samples"]) < self.num_failing:
+                    self.unmatched["samples"].append(
+                        {"index": index, "name": name}
+                    )
+                continue
+
+            stat = stats[name]
+            stat["total"] += 1
+            if passed:
+                stat["passed"] += 1
+                self.num_passed += 1
+                continue
+
+            stat["mismatches"].update(failed)
+            group = stat["failures"].get(failed)
+            if group is None:
+                if len(stat["failures"]) >= self.key_combs_limit:
+                    stat["other_failures"] += 1
+                    continue
+                group = {"keys": list(failed), "total": 0, "samples": []}
+                stat["failures"][failed] = group
+            group["total"] += 1
+            if len(group["samples"]) < self.num_failing:
+                # Only sampled failures are compared again for the report
+                _, cmp_result = self._compare(
+                    value, plans[name], comparison.ReportOptions.ALL
+                )
+                group["samples"].append(
+                    {
+                        "index": index,
+                        "comparison": flatten_dict_comparison(cmp_result),
+                    }
+                )
+
+        self.templates = []
+        for name, stat in stats.items():
+            self.templates.append(
+                {
+                    "name": name,
+                    "total": stat["total"],
+                    "passed": stat["passed"],
+                    "mismatches": [
+                        [key, count]
+                        for key, count in stat["mismatches"].most_common()
+                    ],
+                    "failures": sorted(
+                        stat["failures"].values(),
+                        key=operator.itemgetter("total"),
+                        reverse=True,
+                    ),
+                    "other_failures": stat["other_failures"],
+                }
+            )
+        self._set_summary_table()
+
+        return (
+            self.num_values > 0
+            and self.unmatched["total"] == 0
+            and self.num_passed == self.num_values
+        )
+
+    def _set_summary_table(self):
+        """Table of the counts of each template, e.g. for the web UI."""
+        self.columns = [
+            "Template",
+            "Total",
+            "Passed",
+            "Failed",
+            "Mismatched {}s".format(self.key_label),
+        ]
+        rows = [
+            [
+                str(template["name"]),
+                template["total"],
+                template["passed"],
+                template["total"] - template["passed"],
+                ", ".join(
+                    "{} ({})".format(key, count)
+                    for key, count in template["mismatches"]
+                ),
+            ]
+            for template in self.templates
+        ]
+        if self.unmatched["total"]:
+            total = self.unmatched["total"]
+            rows.append(["No template", total, 0, total, ""])
+        self.table = [dict(zip(self.columns, row)) for row in rows]
+        self.indices = list(range(len(rows)))
+
+
+class FixMatchBulk(DictMatchBulk):
+    """
+    Similar to DictMatchBulk, for FIX messages.
+    """
+
+    key_label = "tag"
+
+    def __init__(
+        self,
+        values,
+        templates,
+        template_tag=None,
+        include_tags=None,
+        exclude_tags=None,
+        num_failing=defaults.SUMMARY_NUM_FAILING,
+        key_combs_limit=defaults.SUMMARY_KEY_COMB_LIMIT,
+        description=None,
+        category=None,
+    ):
+        super(FixMatchBulk, self).__init__(
+            values=values,
+            templates=templates,
+            template_key=template_tag,
+            include_keys=include_tags,
+            exclude_keys=exclude_tags,
+            num_failing=num_failing,
+            key_combs_limit=key_combs_limit,
+            description=description,
+            category=category,
+        )
+
+    def get_value_cmp_func(self, value, plan):
+        """
+        If both FIX messages are typed, we enable strict type checking.
+        Otherwise, if either side is untyped we will compare the values as
+        strings.
+        """
+        if getattr(value, "typed_values", False) and plan.typed_values:
+            return comparison.COMPARE_FUNCTIONS["check_types"]
+        return comparison.COMPARE_FUNCTIONS["untyped_fixtag"]
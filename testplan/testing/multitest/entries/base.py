@@ -342,6 +342,53 @@ class Graph(BaseEntry):
                     )
 
 
+class Histogram(BaseEntry):
+    """
+    Distribution of values (e.g. latencies) stored as a log-bucketed
+    :py:class:`~testplan.common.utils.hdr.HDRHistogram`, rendered as a
+    percentile distribution plot.
+    """
+
+    def __init__(self, histogram, description=None, unit=None):
+        """
+        :param histogram: Histogram, its encoded form or the values.
+        :type histogram: :py:class:`~testplan.common.utils.hdr.HDRHistogram`
+            or ``dict`` or iterable of numbers
+        :param description: Text description of the histogram.
+        :type description: ``str``
+        :param unit: Unit of the values, when given the values.
+        :type unit: ``str``
+        """
+        from testplan.common.utils import hdr
+
+        if isinstance(histogram, dict):
+            histogram = hdr.HDRHistogram.decode(histogram)
+        elif not isinstance(histogram, hdr.HDRHistogram):
+            histogram = hdr.HDRHistogram(
+                unit=unit or hdr.DEFAULT_UNIT
+            ).record_values(list(histogram))
+
+        self.histogram = histogram.encode()
+        self.unit = histogram.unit
+        self.count = histogram.total
+        self.min = histogram.min
+        self.max = histogram.max
+        self.mean = histogram.mean
+        self.percentiles = [
+            {"percentile": percentile, "value": value}
+            for percentile, value in histogram.percentiles()
+        ]
+        super(Histogram, self).__init__(description=description)
+
+    def value_at_percentile(self, percentile):
+        """Value at a percentile, see :py:class:`HDRHistogram`."""
+        from testplan.common.utils import hdr
+
+        return hdr.HDRHistogram.decode(self.histogram).value_at_percentile(
+            percentile
+        )
+
+
 class Attachment(BaseEntry):
     """Entry representing a file attached to the report."""
 
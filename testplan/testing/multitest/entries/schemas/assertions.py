@@ -165,6 +165,7 @@ class TableMatchSchema(AssertionSchema):
     message = fields.String(allow_none=True)
     fail_limit = fields.Integer()
     report_fails_only = fields.Bool()
+    report_pass_limit = fields.Integer()
 
 
 @registry.bind(asr.XMLCheck)
@@ -205,3 +206,23 @@ class DictMatchAllSchema(AssertionSchema):
 
     key_weightings = fields.Raw()
     matches = fields.Function(lambda obj: {"matches": obj.matches})
+
+
+@registry.bind(asr.DictMatchBulk, asr.FixMatchBulk)
+class DictMatchBulkSchema(AssertionSchema):
+
+    key_label = fields.String()
+    include_keys = fields.List(custom_fields.NativeOrPretty())
+    exclude_keys = fields.List(custom_fields.NativeOrPretty())
+    num_failing = fields.Integer()
+    key_combs_limit = fields.Integer()
+    num_values = fields.Integer()
+    num_passed = fields.Integer()
+    templates = fields.Raw()
+    unmatched = fields.Raw()
+
+    # Counts of each template, shown as a logged table on the web UI
+    table = fields.List(custom_fields.NativeOrPrettyDict())
+    indices = fields.List(fields.Integer())
+    display_index = fields.Boolean()
+    columns = fields.List(fields.String())
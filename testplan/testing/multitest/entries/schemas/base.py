@@ -13,6 +13,18 @@ class AssertionSchemaRegistry(SchemaRegistry):
     def get_category(self, obj):
         return obj.meta_type
 
+    def serialize_lazily(self, obj, **known):
+        """
+        Serialized entry, dumped when first accessed, apart from its type
+        and whether it passed which the testcase report status relies on.
+        """
+        known.setdefault("type", obj.__class__.__name__)
+        if obj.meta_type == "assertion" or isinstance(obj, base.Group):
+            known.setdefault("passed", bool(obj.passed))
+        return super(AssertionSchemaRegistry, self).serialize_lazily(
+            obj, **known
+        )
+
 
 registry = AssertionSchemaRegistry()
 
@@ -86,6 +98,17 @@ class GraphSchema(BaseSchema):
     discrete_chart = fields.Bool()
 
 
+@registry.bind(base.Histogram)
+class HistogramSchema(BaseSchema):
+    histogram = fields.Raw()
+    unit = fields.String()
+    count = fields.Integer()
+    min = fields.Integer(allow_none=True)
+    max = fields.Integer(allow_none=True)
+    mean = fields.Float(allow_none=True)
+    percentiles = fields.List(fields.Dict())
+
+
 @registry.bind(base.Attachment, base.MatPlot)
 class AttachmentSchema(BaseSchema):
     source_path = fields.String()
@@ -233,18 +233,20 @@ class TableMatchRenderer(AssertionRenderer):
         else:
             result = ""
 
+        # Rows are not contiguous when some of them are not reported
+        display_index = entry.report_fails_only or entry.report_pass_limit
         row_data = [
             self.get_row_data(
                 row_comparison,
                 entry.display_columns,
-                display_index=entry.report_fails_only,
+                display_index=display_index,
             )
             for row_comparison in entry.data
         ]
 
         columns = (
             ["row"] + list(entry.display_columns)
-            if entry.report_fails_only
+            if display_index
             else entry.display_columns
         )
         ascii_table = (
@@ -373,6 +375,71 @@ class DictMatchAllRenderer(AssertionRenderer):
         return str(os.linesep.join(result))
 
 
+@registry.bind(assertions.DictMatchBulk, assertions.FixMatchBulk)
+class DictMatchBulkRenderer(AssertionRenderer):
+    def get_assertion_details(self, entry):
+        """Return counts and failure samples of each template"""
+        result = []
+        label = entry.key_label
+        for template in entry.templates:
+            failed = template["total"] - template["passed"]
+            result.append(
+                "Template {}: {} of {} passed{}".format(
+                    template["name"],
+                    template["passed"],
+                    template["total"],
+                    ", {}".format(Color.red("{} failed".format(failed)))
+                    if failed
+                    else "",
+                )
+            )
+            if template["mismatches"]:
+                result.append(
+                    "Mismatched {}s: {}".format(
+                        label,
+                        ", ".join(
+                            "{} ({})".format(key, count)
+                            for key, count in template["mismatches"]
+                        ),
+                    )
+                )
+            for group in template["failures"]:
+                result.append(
+                    "{}s: {} - (Displaying {} of {} failures)".format(
+                        label.title(),
+                        ", ".join(map(str, group["keys"])),
+                        len(group["samples"]),
+                        group["total"],
+                    )
+                )
+                for sample in group["samples"]:
+                    result.append("Value #{}".format(sample["index"]))
+                    for row in sample["comparison"]:
+                        add_printable_dict_comparison(result, row)
+            if template["other_failures"]:
+                result.append(
+                    "Other {} combinations: {} failures".format(
+                        label, template["other_failures"]
+                    )
+                )
+            result.append("")
+
+        if entry.unmatched["total"]:
+            result.append(
+                Color.red(
+                    "No template: {} values, e.g. {}".format(
+                        entry.unmatched["total"],
+                        ", ".join(
+                            "#{} ({})".format(sample["index"], sample["name"])
+                            for sample in entry.unmatched["samples"]
+                        ),
+                    )
+                )
+            )
+            result.append("")
+        return str(os.linesep.join(result))
+
+
 @registry.bind(assertions.ExceptionRaised, assertions.ExceptionNotRaised)
 class ExceptionRaisedRenderer(AssertionRenderer):
     def get_assertion_details(self, entry):
@@ -111,6 +111,24 @@ class TableLogRenderer(BaseRenderer):
         return AsciiTable([entry.columns] + rows).table
 
 
+@registry.bind(base.Histogram)
+class HistogramRenderer(BaseRenderer):
+    def get_details(self, entry):
+        if not entry.count:
+            return "(empty)"
+        from testplan.common.utils import hdr
+
+        wanted = (50.0, 90.0, 99.0, 99.9, 100.0)
+        histogram = hdr.HDRHistogram.decode(entry.histogram)
+        return "count={}, {}".format(
+            entry.count,
+            ", ".join(
+                "p{:g}={}{}".format(percentile, value, entry.unit)
+                for percentile, value in histogram.percentiles(wanted)
+            ),
+        )
+
+
 @registry.bind(base.DictLog, base.FixLog)
 class DictLogRenderer(BaseRenderer):
     def get_details(self, entry):
@@ -502,6 +502,7 @@ class TableNamespace(AssertionNamespace):
         exclude_columns=None,
         report_all=True,
         fail_limit=0,
+        report_pass_limit=0,
     ):
         r"""
         Compares two tables, uses equality for each table cell for plain
@@ -560,6 +561,11 @@ class TableNamespace(AssertionNamespace):
                            tables, when we want to stop after we have N rows
                            that fail the comparison.
         :type fail_limit: ``int``
+        :param report_pass_limit: Max number of passing rows reported, all
+                                  of them if 0. Useful for large tables,
+                                  when only the failing rows are of
+                                  interest.
+        :type report_pass_limit: ``int``
         :param description: Text description for the assertion.
         :type description: ``str``
         :param category: Custom category that will be used for summarization.
@@ -574,6 +580,7 @@ class TableNamespace(AssertionNamespace):
             exclude_columns=exclude_columns,
             report_all=report_all,
             fail_limit=fail_limit,
+            report_pass_limit=report_pass_limit,
             description=description,
             category=category,
         )
@@ -872,8 +879,10 @@ class DictNamespace(AssertionNamespace):
         :param actual: Original dictionary.
         :type actual: ``dict``.
         :param expected: Comparison dictionary, can contain custom comparators
-                         (e.g. regex, lambda functions)
-        :type expected: ``dict``
+                         (e.g. regex, lambda functions), or a comparison plan
+                         compiled from it when it is matched many times.
+        :type expected: ``dict`` or
+                        ``testplan.common.utils.comparison.ComparisonPlan``
         :param include_keys: Keys to exclusively consider in the comparison.
         :type include_keys: ``list`` of ``object`` (items must be hashable)
         :param exclude_keys: Keys to ignore in the comparison.
@@ -978,6 +987,82 @@ class DictNamespace(AssertionNamespace):
         _bind_entry(entry, self.result)
         return entry
 
+    def match_bulk(
+        self,
+        values,
+        templates,
+        template_key=None,
+        description=None,
+        category=None,
+        include_keys=None,
+        exclude_keys=None,
+        num_failing=defaults.SUMMARY_NUM_FAILING,
+        key_combs_limit=defaults.SUMMARY_KEY_COMB_LIMIT,
+    ):
+        """
+        Match a stream of dictionaries against named templates, adding a
+        single entry to the report.
+
+        Values are consumed once and are not kept, the entry holds for each
+        template the number of values matched and passed, the number of
+        mismatches of each key and the comparisons of the first
+        ``num_failing`` values of each combination of failed keys. The
+        assertion passes if every value passes its template, and fails if
+        there are no values.
+
+        .. code-block:: python
+
+            result.dict.match_bulk(
+                values=(row for row in cursor),
+                templates={
+                    'buy': {'side': 'BUY', 'qty': Greater(0), ...},
+                    'sell': {'side': 'SELL', ...},
+                },
+                template_key=lambda row: row['side'].lower(),
+            )
+
+        :param values: Dictionaries to match, e.g. a generator.
+        :type values: ``iterable`` of ``dict``
+        :param templates: Expected dictionaries, or comparison plans of
+                          them, by template name.
+        :type templates: ``dict``
+        :param template_key: Key of the values holding the name of their
+                             template, or function of a value returning it.
+                             If not given values are matched against the
+                             first template they pass, or else the one with
+                             the fewest failed keys.
+        :type template_key: ``object`` or ``callable``
+        :param description: Text description for the assertion.
+        :type description: ``str``
+        :param category: Custom category that will be used for summarization.
+        :type category: ``str``
+        :param include_keys: Keys to exclusively consider in the comparison.
+        :type include_keys: ``list`` of ``object`` (items must be hashable)
+        :param exclude_keys: Keys to ignore in the comparison.
+        :type exclude_keys: ``list`` of ``object`` (items must be hashable)
+        :param num_failing: Number of failing values reported for each
+                            combination of failed keys.
+        :type num_failing: ``int``
+        :param key_combs_limit: Number of combinations of failed keys
+                                reported for each template.
+        :type key_combs_limit: ``int``
+        :return: Assertion pass status
+        :rtype: ``bool``
+        """
+        entry = assertions.DictMatchBulk(
+            values=values,
+            templates=templates,
+            template_key=template_key,
+            include_keys=include_keys,
+            exclude_keys=exclude_keys,
+            num_failing=num_failing,
+            key_combs_limit=key_combs_limit,
+            description=description,
+            category=category,
+        )
+        _bind_entry(entry, self.result)
+        return entry
+
     def log(self, dictionary, description=None):
         """
         Logs a dictionary to the report.
@@ -1096,8 +1181,10 @@ class FixNamespace(AssertionNamespace):
         :type actual: ``dict``
         :param expected: Expected FIX message, can include compiled
                          regex patterns or callables for
-                         advanced comparison.
-        :type expected: ``dict``
+                         advanced comparison, or a comparison plan
+                         compiled from it when it is matched many times.
+        :type expected: ``dict`` or
+                        ``testplan.common.utils.comparison.ComparisonPlan``
         :param include_tags: Tags to exclusively consider in the comparison.
         :type include_tags: ``list`` of ``object`` (items must be hashable)
         :param exclude_tags: Keys to ignore in the comparison.
@@ -1200,6 +1287,83 @@ class FixNamespace(AssertionNamespace):
         _bind_entry(entry, self.result)
         return entry
 
+    def match_bulk(
+        self,
+        values,
+        templates,
+        template_tag=None,
+        description=None,
+        category=None,
+        include_tags=None,
+        exclude_tags=None,
+        num_failing=defaults.SUMMARY_NUM_FAILING,
+        key_combs_limit=defaults.SUMMARY_KEY_COMB_LIMIT,
+    ):
+        """
+        Match a stream of FIX messages, e.g. received from a FIX server or
+        client driver, against named templates, adding a single entry to
+        the report.
+
+        Messages are consumed once and are not kept, the entry holds for
+        each template the number of messages matched and passed, the number
+        of mismatches of each tag and the comparisons of the first
+        ``num_failing`` messages of each combination of failed tags. The
+        assertion passes if every message passes its template, and fails if
+        no message is received.
+
+        .. code-block:: python
+
+            result.fix.match_bulk(
+                values=env.client.receive_iter(count=1000, timeout=5),
+                templates={
+                    'D': {35: 'D', 55: re.compile(r'[A-Z]+'), ...},
+                    'F': {35: 'F', 41: re.compile(r'[A-Z0-9]+'), ...},
+                },
+                template_tag=35,
+            )
+
+        :param values: FIX messages to match, e.g. a generator.
+        :type values: ``iterable`` of ``pyfixmsg.fixmessage.FixMessage``
+        :param templates: Expected FIX messages, or comparison plans of
+                          them, by template name.
+        :type templates: ``dict``
+        :param template_tag: Tag of the messages holding the name of their
+                             template, or function of a message returning
+                             it. If not given messages are matched against
+                             the first template they pass, or else the one
+                             with the fewest failed tags.
+        :type template_tag: ``int`` or ``callable``
+        :param description: Text description for the assertion.
+        :type description: ``str``
+        :param category: Custom category that will be used for summarization.
+        :type category: ``str``
+        :param include_tags: Tags to exclusively consider in the comparison.
+        :type include_tags: ``list`` of ``object`` (items must be hashable)
+        :param exclude_tags: Tags to ignore in the comparison.
+        :type exclude_tags: ``list`` of ``object`` (items must be hashable)
+        :param num_failing: Number of failing messages reported for each
+                            combination of failed tags.
+        :type num_failing: ``int``
+        :param key_combs_limit: Number of combinations of failed tags
+                                reported for each template.
+        :type key_combs_limit: ``int``
+        :return: Assertion pass status
+        :rtype: ``bool``
+        """
+        entry = assertions.FixMatchBulk(
+            values=values,
+            templates=templates,
+            template_tag=template_tag,
+            include_tags=include_tags,
+            exclude_tags=exclude_tags,
+            num_failing=num_failing,
+            key_combs_limit=key_combs_limit,
+            description=description,
+            category=category,
+        )
+        _bind_entry(entry, self.result)
+        return entry
+
     def log(self, msg, description=None):
         """
         Logs a fix message to the report.
@@ -2162,6 +2326,34 @@ class Result(object):
         _bind_entry(entry, self)
         return entry
 
+    def histogram(self, values, description=None, unit="ns"):
+        """
+        Displays the distribution of values (e.g. latencies) in the report
+        as a percentile distribution plot. Histograms of several shards or
+        repetitions can be combined with
+        :py:func:`testplan.common.utils.hdr.merge` before being logged.
+
+        .. code-block:: python
+
+            result.histogram(latencies, description='Order latency')
+
+            merged = hdr.merge([shard_1, shard_2])
+            result.histogram(merged, description='All shards')
+
+        :param values: Values, or a histogram of them.
+        :type values: iterable of numbers or
+            :py:class:`~testplan.common.utils.hdr.HDRHistogram`
+        :param description: Text description for the histogram.
+        :type description: ``str``
+        :param unit: Unit of the values, ignored for a histogram.
+        :type unit: ``str``
+        """
+        entry = base.Histogram(
+            histogram=values, description=description, unit=unit
+        )
+        _bind_entry(entry, self)
+        return entry
+
     def attach(self, filepath, description=None):
         """
         Attaches a file to the report.
@@ -9,6 +9,7 @@ import random
 from enum import Enum
 
 from testplan.common.utils.convert import make_tuple
+from testplan.report.testing.performance import PerformanceSummary
 
 
 class SortType(Enum):
@@ -75,12 +76,29 @@ class BaseSorter(object):
             return self.sort_instances(instances)
         return instances
 
-    def sorted_testsuites(self, testsuites):
+    def sort_testsuites_of(self, test, testsuites):
+        """
+        Sort the suites of a test instance. Sorters ordering suites by their
+        instance override this, others sort them as any suites.
+        """
+        return self.sort_testsuites(testsuites)
+
+    def sort_testcases_of(self, test, testsuite, testcases, param_groups):
+        """
+        Sort the testcases of a suite of a test instance. Sorters ordering
+        testcases by their instance and suite override this, others sort them
+        as any testcases.
+        """
+        return self.sort_testcases(testcases, param_groups)
+
+    def sorted_testsuites(self, testsuites, test=None):
         if self.should_sort_testsuites():
-            return self.sort_testsuites(testsuites)
+            if test is None:
+                return self.sort_testsuites(testsuites)
+            return self.sort_testsuites_of(test, testsuites)
         return testsuites
 
-    def sorted_testcases(self, testsuite, testcases):
+    def sorted_testcases(self, testsuite, testcases, test=None):
         if self.should_sort_testcases():
             test_methods, param_groups = [], {}
             for testcase in testcases:
@@ -96,7 +114,12 @@ class BaseSorter(object):
                 else:
                     test_methods.append(testcase)
 
-            result = self.sort_testcases(test_methods, param_groups)
+            if test is None:
+                result = self.sort_testcases(test_methods, param_groups)
+            else:
+                result = self.sort_testcases_of(
+                    test, testsuite, test_methods, param_groups
+                )
             if isinstance(result, (tuple, list)):
                 sorted_test_methods, soted_param_groups = result
             else:
@@ -197,3 +220,168 @@ class AlphanumericSorter(TypedSorter):
             param_template: sorted(testcases, key=operator.attrgetter("name"))
             for param_template, testcases in param_groups.items()
         }
+
+
+class FailureHistorySorter(TypedSorter):
+    """
+    Sorter that runs the tests most likely to fail first, then the fastest
+    ones, according to the reports of earlier runs. Together with fail-fast
+    runs, failures surface in the first seconds of a run.
+
+    The failure probability of a testcase is the share of the earlier runs
+    it failed in, each run weighted by ``decay`` to the power of its age.
+    Testcases of C++ binaries are ordered by their runners through the
+    native test selection (see :py:meth:`order_test_context`). Suites and
+    testcases of other tests are ordered by the history of the same suites
+    and testcases of the same instance, and keep their order when sorted
+    without their instance.
+
+    :param history: Reports or JSON report paths of earlier runs, the most
+        recent first.
+    :type history: ``list`` of
+        :py:class:`~testplan.report.testing.base.TestReport` or ``str``
+    :param decay: Weight of a run relative to the next more recent one.
+    :type decay: ``float``
+    :param sort_type: Levels to sort.
+    :type sort_type: ``str`` or ``tuple`` of ``str``
+    """
+
+    def __init__(self, history, decay=0.8, sort_type=SortType.ALL):
+        if not 0 < decay <= 1:
+            raise ValueError("Decay must be in (0, 1], got {}".format(decay))
+        super(FailureHistorySorter, self).__init__(sort_type=sort_type)
+        self.decay = decay
+        # {(instance, suite, testcase): [weighted failures, weighted runs]}
+        self._runs = {}
+        # {(instance, suite, testcase): duration in the latest run}
+        self._durations = {}
+        # Keys by instance and (instance, suite)
+        self._index = {}
+        self._load(make_tuple(history))
+
+    def _load(self, history):
+        for age, source in enumerate(history):
+            weight = self.decay ** age
+            summary = PerformanceSummary.load(source)
+            for key in set(summary.testcases) | summary.failed:
+                runs = self._runs.setdefault(key, [0.0, 0.0])
+                runs[0] += weight if key in summary.failed else 0
+                runs[1] += weight
+            for key, duration in summary.testcases.items():
+                self._durations.setdefault(key, duration)
+
+        for key in self._runs:
+            instance, suite, testcase = key
+            for index in (
+                ("instance", instance),
+                ("instance_suite", instance, suite),
+            ):
+                self._index.setdefault(index, []).append(key)
+
+    def failure_probability(self, instance, suite, testcase):
+        """
+        Weighted share of the earlier runs a testcase failed in.
+
+        :param instance: Test instance name.
+        :type instance: ``str``
+        :param suite: Suite name.
+        :type suite: ``str``
+        :param testcase: Testcase name.
+        :type testcase: ``str``
+        :return: Probability, 0 for testcases that never ran.
+        :rtype: ``float``
+        """
+        failures, runs = self._runs.get((instance, suite, testcase), (0, 0))
+        return failures / runs if runs else 0.0
+
+    def _key(self, keys):
+        """Sort key of testcases run together, e.g. a whole suite."""
+        probability = max(
+            [self.failure_probability(*key) for key in keys] or [0.0]
+        )
+        duration = sum(self._durations.get(key, 0) for key in keys)
+        return -probability, duration
+
+    def _matching(self, *index):
+        return self._index.get(index, [])
+
+    def order_test_context(self, instance, test_context):
+        """
+        Order the listed testcases of a C++ test binary, to be run in this
+        order by its native test selection.
+
+        :param instance: Test instance name.
+        :type instance: ``str``
+        :param test_context: Listed suites and testcases, as returned by
+            ``get_test_context``.
+        :type test_context: ``list`` of ``list``
+        :return: (suite, testcase) pairs in run order, the testcase is
+            ``None`` for suites listed without testcases, and the number of
+            them which failed in earlier runs, at the start of the list.
+        :rtype: ``tuple`` of ``list`` of ``tuple`` and ``int``
+        """
+        keyed = []
+        for suite, testcases in test_context:
+            for testcase in testcases or [None]:
+                if testcase is None:
+                    keys = self._matching("instance_suite", instance, suite)
+                else:
+                    # Parameterized GTest testcases are listed with a
+                    # `# GetParam() = ...` comment
+                    keys = [(instance, suite, testcase.split()[0])]
+                keyed.append((self._key(keys), (suite, testcase)))
+        # Stable, testcases without history keep their listing order
+        keyed.sort(key=operator.itemgetter(0))
+        failing = sum(1 for key, _ in keyed if key[0] < 0)
+        return [unit for _, unit in keyed], failing
+
+    def sort_instances(self, instances):
+        return sorted(
+            instances,
+            key=lambda instance: self._key(
+                self._matching("instance", instance.name)
+            ),
+        )
+
+    def sort_testsuites(self, testsuites):
+        # History is kept by instance, suites of an unknown one keep their
+        # order
+        return list(testsuites)
+
+    def sort_testcases(self, testcases, param_groups=None):
+        return list(testcases), dict(param_groups or {})
+
+    def sort_testsuites_of(self, test, testsuites):
+        return sorted(
+            testsuites,
+            key=lambda suite: self._key(
+                self._matching("instance_suite", test.name, suite.name)
+            ),
+        )
+
+    def sort_testcases_of(self, test, testsuite, testcases, param_groups):
+        param_groups = param_groups or {}
+
+        def group_path(param_template):
+            # Parametrized testcases are reported in a group of the suite
+            group = getattr(testsuite, param_template)
+            return "{}/{}".format(testsuite.name, group.name)
+
+        def key(testcase):
+            if getattr(testcase, "__parametrization_template__", False):
+                path = group_path(testcase.__name__)
+                cases = param_groups.get(testcase.__name__, [])
+            else:
+                path = testcase_paths.get(testcase, testsuite.name)
+                cases = [testcase]
+            return self._key([(test.name, path, case.name) for case in cases])
+
+        testcase_paths = {
+            testcase: group_path(param_template)
+            for param_template, group in param_groups.items()
+            for testcase in group
+        }
+        return sorted(testcases, key=key), {
+            param_template: sorted(group, key=key)
+            for param_template, group in param_groups.items()
+        }
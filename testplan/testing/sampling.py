@@ -0,0 +1,282 @@
+"""
+Deterministic stratified sampling of the testcases of test binaries, for
+smoke runs of huge C++ suites (e.g. pre-merge checks).
+
+The sample is drawn from the test listing of each binary
+(:py:meth:`~testplan.testing.base.ProcessRunnerTest.get_test_context`) and
+run through its native filter. Each suite is a stratum: a fraction of its
+testcases is selected by ranking them by a hash of the seed and their names,
+so that the same seed always selects the same testcases and adding a
+testcase does not reshuffle the rest of the sample. Suites whose testcases
+are not listed (e.g. HobbesTest) are sampled as a whole.
+
+A full run with a sample in verification mode runs all testcases and
+reports the failures the sample would have missed:
+
+.. code-block:: python
+
+    # Pre-merge: 5% of every suite plus the failures of the last nightly run
+    Sample(fraction=0.05, seed=42, always_run=recent_failures(last_nightly))
+
+    # Nightly: full run, coverage of the same sample in the report meta data
+    Sample(fraction=0.05, seed=42, verify=True)
+"""
+
+import fnmatch
+import hashlib
+import math
+
+from testplan.report.testing.performance import PerformanceSummary
+
+# Name of a sampled testcase, or of a suite sampled as a whole.
+NAME_FORMAT = "{}.{}"
+
+
+def _unit_name(suite, testcase):
+    if testcase is None:
+        return suite
+    return NAME_FORMAT.format(suite, testcase)
+
+
+def recent_failures(*sources):
+    """
+    Testcases failed or in error in earlier runs, to be always run by a
+    sample.
+
+    :param sources: Reports or JSON report paths.
+    :type sources: :py:class:`~testplan.report.testing.base.TestReport`
+        or ``str``
+    :return: ``Suite.testcase`` names by test instance name.
+    :rtype: ``dict`` of ``str`` to ``list`` of ``str``
+    """
+    failures = {}
+    for source in sources:
+        summary = PerformanceSummary.load(source)
+        for instance, suite, testcase in sorted(summary.failed):
+            names = failures.setdefault(instance, [])
+            name = _unit_name(suite, testcase)
+            if name not in names:
+                names.append(name)
+    return failures
+
+
+class Sample(object):
+    """
+    Seeded stratified sample of the testcases of test binaries.
+
+    :param fraction: Fraction of the testcases of each suite to run.
+    :type fraction: ``float``
+    :param seed: Seed of the selection, the same seed selects the same
+        testcases.
+    :type seed: ``int`` or ``str``
+    :param minimum: Minimum number of testcases run per suite.
+    :type minimum: ``int``
+    :param always_run: ``Suite.testcase`` patterns (``fnmatch`` style) of
+        testcases run whether they are sampled or not, e.g. the recently
+        failed ones returned by :py:func:`recent_failures`, or such patterns
+        by test instance name.
+    :type always_run: ``list`` of ``str`` or ``dict`` of ``str`` to
+        ``list`` of ``str``
+    :param verify: Run all testcases and report the failures the sample
+        would have missed, e.g. for nightly runs.
+    :type verify: ``bool``
+    """
+
+    def __init__(
+        self, fraction=0.05, seed=0, minimum=1, always_run=None, verify=False
+    ):
+        if not 0 < fraction <= 1:
+            raise ValueError(
+                "Sample fraction must be in (0, 1], got {}".format(fraction)
+            )
+        if minimum < 0:
+            raise ValueError(
+                "Sample minimum must not be negative, got {}".format(minimum)
+            )
+        self.fraction = fraction
+        self.seed = seed
+        self.minimum = minimum
+        self.always_run = always_run or []
+        self.verify = verify
+
+    def __repr__(self):
+        return "{}(fraction={}, seed={!r}, verify={})".format(
+            self.__class__.__name__, self.fraction, self.seed, self.verify
+        )
+
+    def _rank(self, instance, name):
+        digest = hashlib.sha1(
+            "{}\0{}\0{}".format(self.seed, instance, name).encode("utf-8")
+        ).hexdigest()
+        return digest, name
+
+    def _size(self, count):
+        size = max(self.minimum, int(math.ceil(self.fraction * count)))
+        return min(size, count)
+
+    def _patterns(self, instance):
+        if isinstance(self.always_run, dict):
+            return list(self.always_run.get(instance, []))
+        return list(self.always_run)
+
+    def select(self, instance, test_context):
+        """
+        Sample of the testcases of a test instance.
+
+        :param instance: Name of the test instance.
+        :type instance: ``str``
+        :param test_context: Listed suites and testcases, as returned by
+            ``get_test_context``.
+        :type test_context: ``list`` of ``list``
+        :rtype: :py:class:`Selection`
+        """
+        strata = []
+        whole_suites = []
+        for suite, testcases in test_context:
+            if testcases:
+                strata.append([(suite, testcase) for testcase in testcases])
+            else:
+                whole_suites.append((suite, None))
+        if whole_suites:
+            strata.append(whole_suites)
+
+        patterns = self._patterns(instance)
+        sampled, always_run = set(), set()
+        for units in strata:
+            ranked = sorted(
+                units, key=lambda unit: self._rank(instance, _unit_name(*unit))
+            )
+            sampled.update(ranked[: self._size(len(units))])
+            for unit in units:
+                name = _unit_name(*unit)
+                if unit not in sampled and any(
+                    fnmatch.fnmatchcase(name, pattern) for pattern in patterns
+                ):
+                    always_run.add(unit)
+
+        listed = [unit for units in strata for unit in units]
+        return Selection(
+            sample=self,
+            instance=instance,
+            units=[unit for unit in listed if unit in sampled | always_run],
+            listed=len(listed),
+            always_run=[unit for unit in listed if unit in always_run],
+        )
+
+
+class Selection(object):
+    """
+    Testcases selected by a :py:class:`Sample` for a test instance.
+
+    :param sample: Sample the selection was drawn by.
+    :type sample: :py:class:`Sample`
+    :param instance: Name of the test instance.
+    :type instance: ``str``
+    :param units: Selected (suite, testcase) pairs in listing order, the
+        testcase is ``None`` for suites selected as a whole.
+    :type units: ``list`` of ``tuple``
+    :param listed: Number of testcases (or whole suites) listed.
+    :type listed: ``int``
+    :param always_run: Units selected by the ``always_run`` patterns only.
+    :type always_run: ``list`` of ``tuple``
+    """
+
+    def __init__(self, sample, instance, units, listed, always_run):
+        self.sample = sample
+        self.instance = instance
+        self.units = units
+        self.listed = listed
+        self.always_run = always_run
+        self._names = set(_unit_name(*unit) for unit in units)
+
+    def __len__(self):
+        return len(self.units)
+
+    def __repr__(self):
+        return "{}(instance={!r}, selected={}, listed={})".format(
+            self.__class__.__name__, self.instance, len(self), self.listed
+        )
+
+    def suites(self):
+        """
+        Selected testcases grouped by suite, in listing order. Suites
+        selected as a whole have no testcases.
+
+        :rtype: ``list`` of (``str``, ``list`` of ``str``)
+        """
+        result = []
+        for suite, testcase in self.units:
+            if not result or result[-1][0] != suite:
+                result.append((suite, []))
+            if testcase is not None:
+                result[-1][1].append(testcase)
+        return result
+
+    def names(self):
+        """
+        ``Suite.testcase`` names of the selected testcases, suite names for
+        suites selected as a whole.
+
+        :rtype: ``list`` of ``str``
+        """
+        return [_unit_name(*unit) for unit in self.units]
+
+    def contains(self, suite, testcase):
+        """
+        Whether a testcase has been selected.
+
+        :param suite: Suite name.
+        :type suite: ``str``
+        :param testcase: Testcase name.
+        :type testcase: ``str``
+        :rtype: ``bool``
+        """
+        return (
+            suite in self._names or _unit_name(suite, testcase) in self._names
+        )
+
+    def coverage(self, report, ignored_suites=()):
+        """
+        Failures of a full run of the test instance caught and missed by
+        the selection.
+
+        :param report: Report of the test instance.
+        :type report: :py:class:`~testplan.report.testing.base.TestGroupReport`
+        :param ignored_suites: Suites that are not tests of the binary, e.g.
+            the process checks of the runner.
+        :type ignored_suites: ``tuple`` of ``str``
+        :return: Number of failed testcases, number caught by the sample and
+            names of the missed ones.
+        :rtype: ``dict``
+        """
+        failed, missed = 0, []
+        for suite in report:
+            if suite.name in ignored_suites:
+                continue
+            for testcase in suite:
+                if testcase.failed:
+                    failed += 1
+                    if not self.contains(suite.name, testcase.name):
+                        missed.append(_unit_name(suite.name, testcase.name))
+        return {
+            "failed": failed,
+            "caught": failed - len(missed),
+            "missed": missed,
+        }
+
+    def to_dict(self):
+        """
+        Description of the sample taken, for the report meta data.
+
+        :rtype: ``dict``
+        """
+        return {
+            "fraction": self.sample.fraction,
+            "seed": self.sample.seed,
+            "minimum": self.sample.minimum,
+            "verify": self.sample.verify,
+            "listed": self.listed,
+            "selected": len(self),
+            "always_run": [_unit_name(*unit) for unit in self.always_run],
+            "testcases": self.names(),
+        }
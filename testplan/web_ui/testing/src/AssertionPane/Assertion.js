@@ -26,6 +26,8 @@ import XYGraphAssertion
   from './AssertionTypes/GraphAssertions/XYGraphAssertion';
 import DiscreteChartAssertion
   from './AssertionTypes/GraphAssertions/DiscreteChartAssertion';
+import HistogramAssertion
+  from './AssertionTypes/GraphAssertions/HistogramAssertion';
 import SummaryBaseAssertion from './AssertionSummary';
 import AttachmentAssertion from './AssertionTypes/AttachmentAssertions.js';
 
@@ -118,7 +120,11 @@ class Assertion extends Component {
       DictMatch: DictMatchAssertion,
       FixLog: FixLogAssertion,
       FixMatch: FixMatchAssertion,
+      // Counts of each template, failure samples are in the exported reports
+      DictMatchBulk: TableLogAssertion,
+      FixMatchBulk: TableLogAssertion,
       Graph: graphAssertion,
+      Histogram: HistogramAssertion,
       Attachment: AttachmentAssertion,
       MatPlot: AttachmentAssertion,
       Markdown: MarkdownAssertion,
@@ -0,0 +1,91 @@
+import React, {Component} from 'react';
+import PropTypes from 'prop-types';
+import 'react-vis/dist/style.css';
+import * as GraphUtil from './graphUtils';
+import {css, StyleSheet} from 'aphrodite';
+import {
+  XAxis,
+  YAxis,
+  HorizontalGridLines,
+  VerticalGridLines,
+  XYPlot,
+  LineSeries,
+  ChartLabel
+} from 'react-vis';
+
+const TICKS = [0, 90, 99, 99.9, 99.99, 99.999, 99.9999];
+
+/**
+ * Component that renders a Histogram entry as a percentile distribution
+ * plot: the value at each percentile, with a logarithmic percentile axis.
+ */
+class HistogramAssertion extends Component {
+  render() {
+    const assertion = this.props.assertion;
+    const data = assertion.percentiles.map(item => ({
+      x: GraphUtil.percentilePosition(item.percentile),
+      y: item.value
+    }));
+
+    if (data.length === 0) {
+      return <div>(empty histogram)</div>;
+    }
+
+    const lastPosition = data[data.length - 1].x;
+    const tickValues = TICKS.map(GraphUtil.percentilePosition).filter(
+      position => position <= lastPosition
+    );
+
+    return (
+      <div className={css(styles.centreComponent)}>
+        <div className={css(styles.summary)}>
+          {`count=${assertion.count}, min=${assertion.min}, `
+            + `mean=${assertion.mean.toFixed(1)}, max=${assertion.max} `
+            + `(${assertion.unit})`}
+        </div>
+        <XYPlot width={750} height={400}>
+          <HorizontalGridLines />
+          <VerticalGridLines tickValues={tickValues} />
+          <XAxis
+            tickValues={tickValues}
+            tickFormat={GraphUtil.percentileLabel}
+          />
+          <ChartLabel
+            text='Percentile'
+            className='x-axis-label'
+            includeMargin={false}
+            xPercent={0.5}
+            yPercent={1.107}
+            style={{transform: 'rotate(0)', textAnchor: 'middle'}}
+          />
+          <YAxis />
+          <ChartLabel
+            text={assertion.unit}
+            className='y-axis-label'
+            includeMargin={false}
+            xPercent={-0.0455}
+            yPercent={0.5}
+            style={{transform: 'rotate(270)', textAnchor: 'middle'}}
+          />
+          <LineSeries data={data} curve='curveStepAfter' />
+        </XYPlot>
+      </div>
+    );
+  }
+}
+
+HistogramAssertion.propTypes = {
+  /** Assertion being rendered */
+  assertion: PropTypes.object,
+};
+
+const styles = StyleSheet.create({
+  centreComponent: {
+    alignItems: 'center'
+  },
+  summary: {
+    paddingBottom: '.5rem'
+  }
+});
+
+export default HistogramAssertion;
@@ -0,0 +1,76 @@
+import React from 'react';
+import {shallow} from 'enzyme';
+import {StyleSheetTestUtils} from "aphrodite";
+import {LineSeries, XAxis} from 'react-vis';
+
+import HistogramAssertion from '../HistogramAssertion.js';
+import {percentilePosition, percentileLabel} from '../graphUtils';
+
+function defaultProps() {
+  return {
+    assertion: {
+      "meta_type": "entry",
+      "utc_time": "2019-07-12T12:36:09.782759+00:00",
+      "machine_time": "2019-07-12T12:36:09.782759+00:00",
+      "type": "Histogram",
+      "line_no": 50,
+      "description": "Order latency",
+      "category": "DEFAULT",
+      "unit": "ns",
+      "count": 1000,
+      "min": 800,
+      "max": 25000,
+      "mean": 1200.5,
+      "histogram": {
+        "sub_bucket_bits": 8, "unit": "ns", "total": 1000, "sum": 1200500,
+        "min": 800, "max": 25000, "counts": [1328, 990, 1000, 10]
+      },
+      "percentiles": [
+        {"percentile": 0, "value": 800},
+        {"percentile": 50, "value": 1100},
+        {"percentile": 99, "value": 1500},
+        {"percentile": 99.9, "value": 25000},
+        {"percentile": 100, "value": 25000}
+      ]
+    }
+  };
+}
+
+describe('HistogramAssertion', () => {
+  let props;
+
+  beforeEach(() => {
+    // Stop Aphrodite from injecting styles, this crashes the tests.
+    StyleSheetTestUtils.suppressStyleInjection();
+    props = defaultProps();
+  });
+
+  it('can render basic markup without error', () => {
+    shallow(<HistogramAssertion {...props}/>).html();
+  });
+
+  it('plots the values against the percentile positions', () => {
+    const series = shallow(<HistogramAssertion {...props}/>).find(LineSeries);
+    const data = series.prop('data');
+    expect(data.map(point => point.y)).toEqual([800, 1100, 1500, 25000, 25000]);
+    expect(data[0].x).toEqual(0);
+    expect(data[2].x).toBeCloseTo(2);
+  });
+
+  it('only shows the percentile ticks up to the last sample', () => {
+    props.assertion.percentiles = props.assertion.percentiles.slice(0, 3);
+    const axis = shallow(<HistogramAssertion {...props}/>).find(XAxis);
+    expect(axis.prop('tickValues').length).toEqual(3);
+  });
+
+  it('renders empty histograms', () => {
+    props.assertion.percentiles = [];
+    const component = shallow(<HistogramAssertion {...props}/>);
+    expect(component.text()).toEqual('(empty histogram)');
+  });
+
+  it('labels the percentile axis', () => {
+    expect(percentileLabel(percentilePosition(99.9))).toEqual('99.9%');
+    expect(percentileLabel(percentilePosition(0))).toEqual('0%');
+  });
+});
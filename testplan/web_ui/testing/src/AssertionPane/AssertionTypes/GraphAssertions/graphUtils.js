@@ -122,3 +122,26 @@ export function returnYAxisTitle(graph_options){
     return graph_options.yAxisTitle;
   }
 }
+
+/**
+ * Return the x coordinate of a percentile on a percentile distribution plot,
+ * the number of nines of the percentile (0 for p0, 1 for p90, 2 for p99...)
+ * so that the tail of the distribution is readable.
+ *
+ * @param {number} percentile - Percentile in [0, 100]
+ * @return {number} Position of the percentile on the x axis
+ */
+export function percentilePosition(percentile){
+  return -Math.log10(Math.max(1 - percentile / 100, 1e-9));
+}
+
+/**
+ * Return the label of a percentile axis tick.
+ *
+ * @param {number} position - Position returned by percentilePosition
+ * @return {str} Percentile label, e.g. "99.9%"
+ */
+export function percentileLabel(position){
+  const percentile = 100 * (1 - Math.pow(10, -position));
+  return `${parseFloat(percentile.toPrecision(7))}%`;
+}
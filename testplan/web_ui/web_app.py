@@ -3,21 +3,39 @@
 Web application for Testplan & Monitor UIs,
 """
 import os
+import json
 import argparse
-from threading import Thread
+from threading import BoundedSemaphore, Thread
 
-from flask import Flask, send_from_directory, redirect
+from flask import (
+    Blueprint,
+    Flask,
+    Response,
+    send_from_directory,
+    redirect,
+    request,
+)
 from flask_restplus import Resource, Api
 from werkzeug import exceptions
 from cheroot.wsgi import Server as WSGIServer, PathInfoDispatcher
 
 from testplan import defaults
 from testplan.common.utils.path import pwd
+from testplan.report.testing.journal import load_journal
+from testplan.report.testing.schemas import TestReportSchema
 
 TESTPLAN_UI_STATIC_DIR = os.path.abspath(os.path.dirname(__file__))
 INDEX_HTML = "index.html"
+JOURNAL_EXT = ".journal"
 TESTPLAN_REPORT = os.path.basename(defaults.JSON_PATH)
 MONITOR_REPORT = "monitor_report.json"
+# Seconds between the comments keeping idle event streams open.
+MONITOR_KEEPALIVE = 15
+# Event streams served at a time by a monitor, each holding a thread of its
+# web server until the client disconnects.
+MONITOR_MAX_STREAMS = 8
+# Threads of a monitor web server left for the requests other than streams.
+MONITOR_REQUEST_THREADS = 2
 
 app = Flask(__name__)
 _api = Api(app)
@@ -58,7 +76,10 @@ class Testplan(Resource):
 @_api.route("/api/v1/reports/<string:report_uid>")
 class TestplanReport(Resource):
     def get(self, report_uid):
-        """Get a Testplan report (JSON) given it's uid."""
+        """
+        Get a Testplan report (JSON) given it's uid, created from the report
+        journal of a run if it is one.
+        """
         # report_uid will be used when looking up the report from a database.
         report_path = os.path.abspath(
             os.path.join(
@@ -66,7 +87,12 @@ class TestplanReport(Resource):
             )
         )
 
-        if os.path.exists(report_path):
+        if report_path.endswith(JOURNAL_EXT) and os.path.exists(report_path):
+            report = load_journal(report_path)
+            data = TestReportSchema(strict=True).dump(report).data
+            data["version"] = 1
+            return Response(json.dumps(data), mimetype="application/json")
+        elif os.path.exists(report_path):
             return send_from_directory(
                 directory=os.path.dirname(report_path),
                 filename=os.path.basename(report_path),
@@ -108,6 +134,148 @@ class TestplanAttachment(Resource):
             raise exceptions.NotFound()
 
 
+def generate_monitor_app(
+    event_bus,
+    monitor,
+    static_path=TESTPLAN_UI_STATIC_DIR,
+    max_streams=MONITOR_MAX_STREAMS,
+):
+    """
+    Web application of the live monitor of a run, separate from the one of
+    the Testplan UI so that both can be served by the same process.
+
+    :param event_bus: Event bus of the run.
+    :type event_bus: :py:class:`EventBus
+        <testplan.common.utils.events.EventBus>`
+    :param monitor: State of the run.
+    :type monitor: :py:class:`RunMonitor
+        <testplan.runnable.monitor.RunMonitor>`
+    :param static_path: Directory of the monitor page.
+    :type static_path: ``str``
+    :param max_streams: Event streams served at a time, clients past the
+        limit get a ``503`` response.
+    :type max_streams: ``int``
+    :return: Flask application.
+    :rtype: ``flask.Flask``
+    """
+    api = Blueprint("monitor_api", "testplan")
+    app = Flask("testplan")
+    stream_slots = BoundedSemaphore(max_streams)
+
+    @app.route("/monitor/")
+    def monitor_page():
+        """Get the live monitor of a run (HTML)."""
+        directory = os.path.abspath(os.path.join(static_path, "monitor"))
+        if os.path.exists(os.path.join(directory, INDEX_HTML)):
+            return send_from_directory(
+                directory=directory, filename=INDEX_HTML
+            )
+        else:
+            raise exceptions.NotFound()
+
+    @api.route("/state")
+    def monitor_state():
+        """Get the state of the monitored run (JSON)."""
+        return Response(
+            json.dumps(monitor.snapshot()), mimetype="application/json"
+        )
+
+    @api.route("/events")
+    def monitor_events():
+        """
+        Stream the events of the monitored run as server-sent events. The
+        state of the run is sent first, as a ``snapshot`` event, unless the
+        client resumes the stream from the last event it received.
+        """
+        since = request.headers.get("Last-Event-ID") or request.args.get(
+            "since"
+        )
+        try:
+            since = int(since)
+        except (TypeError, ValueError):
+            since = None
+        if not stream_slots.acquire(blocking=False):
+            raise exceptions.ServiceUnavailable(
+                "At most {} clients can follow the run".format(max_streams)
+            )
+        return Response(
+            _StreamSlot(event_stream(event_bus, monitor, since), stream_slots),
+            mimetype="text/event-stream",
+            headers={"Cache-Control": "no-cache", "X-Accel-Buffering": "no"},
+        )
+
+    app.register_blueprint(api, url_prefix="/api/v1/monitor")
+    return app
+
+
+class _StreamSlot(object):
+    """
+    Response body of an event stream, releasing its slot when the server
+    closes it, whether it was sent or not.
+    """
+
+    def __init__(self, stream, slots):
+        self._stream = stream
+        self._slots = slots
+
+    def __iter__(self):
+        return self._stream
+
+    def close(self):
+        self._stream.close()
+        if self._slots is not None:
+            self._slots.release()
+            self._slots = None
+
+
+def event_stream(event_bus, monitor, since=None, keepalive=MONITOR_KEEPALIVE):
+    """
+    Server-sent events of a run, until its event bus is closed.
+
+    :param event_bus: Event bus of the run.
+    :type event_bus: :py:class:`EventBus
+        <testplan.common.utils.events.EventBus>`
+    :param monitor: State of the run.
+    :type monitor: :py:class:`RunMonitor
+        <testplan.runnable.monitor.RunMonitor>`
+    :param since: Number of the last event received by the client, ``None``
+        to start with the state of the run.
+    :type since: ``int`` or ``NoneType``
+    :param keepalive: Seconds between comments sent to idle clients.
+    :type keepalive: ``float``
+    :return: Chunks of the stream.
+    :rtype: generator of ``str``
+    """
+    if since is not None and since <= event_bus.last_seq:
+        events = event_bus.events_since(since, timeout=0)
+    else:
+        events = None
+    while True:
+        if events is None:
+            # New client, one that missed events no longer kept or one of
+            # a previous run
+            snapshot = monitor.snapshot()
+            since = snapshot["seq"]
+            yield _sse_message(since, "snapshot", snapshot)
+        elif events:
+            since = events[-1].seq
+            yield "".join(
+                _sse_message(event.seq, event.kind, event.to_dict())
+                for event in events
+            )
+        elif event_bus.closed:
+            return
+        else:
+            yield ": keepalive\n\n"
+        events = event_bus.events_since(since, timeout=keepalive)
+
+
+def _sse_message(seq, kind, data):
+    return "id: {}\nevent: {}\ndata: {}\n\n".format(
+        seq, kind, json.dumps(data)
+    )
+
+
 class WebServer(Thread):
     def __init__(
         self,
@@ -149,6 +317,53 @@ class WebServer(Thread):
         self.server.stop()
 
 
+class MonitorServer(WebServer):
+    """
+    Web server of the live monitor of a run, streaming its events.
+
+    :param event_bus: Event bus of the run.
+    :type event_bus: :py:class:`EventBus
+        <testplan.common.utils.events.EventBus>`
+    :param monitor: State of the run.
+    :type monitor: :py:class:`RunMonitor
+        <testplan.runnable.monitor.RunMonitor>`
+    :param port: Port of the web server, 0 for any free port.
+    :type port: ``int``
+    :param max_streams: Event streams served at a time.
+    :type max_streams: ``int``
+    """
+
+    def __init__(
+        self,
+        event_bus,
+        monitor,
+        port=defaults.WEB_SERVER_PORT,
+        static_path=TESTPLAN_UI_STATIC_DIR,
+        max_streams=MONITOR_MAX_STREAMS,
+    ):
+        super(MonitorServer, self).__init__(port=port, static_path=static_path)
+        self.daemon = True
+        self.event_bus = event_bus
+        self.monitor = monitor
+        self.max_streams = max_streams
+
+    def run(self):
+        monitor_app = generate_monitor_app(
+            self.event_bus,
+            self.monitor,
+            static_path=self.static_path,
+            max_streams=self.max_streams,
+        )
+        dispatcher = PathInfoDispatcher({"/": monitor_app})
+        # Streams hold a thread each, the others serve the page and state
+        self.server = WSGIServer(
+            (self.host, self.port),
+            dispatcher,
+            numthreads=self.max_streams + MONITOR_REQUEST_THREADS,
+        )
+        self.server.start()
+
+
 if __name__ == "__main__":
     args = parse_cli_args()
 
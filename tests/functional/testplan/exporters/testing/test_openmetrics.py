@@ -0,0 +1,138 @@
+"""Test the OpenMetrics exporter."""
+
+import os
+import re
+
+import pytest
+
+from testplan import TestplanMock
+from testplan.testing import multitest
+from testplan.common.utils.testing import argv_overridden
+from testplan.exporters.testing import OpenMetricsExporter
+from testplan.runners.pools.base import Pool as ThreadPool
+from testplan.runners.pools.tasks import Task
+
+
+@multitest.testsuite
+class Alpha(object):
+    @multitest.testcase
+    def test_comparison(self, env, result):
+        result.equal(1, 1, "equality description")
+
+    @multitest.testcase
+    def test_latency(self, env, result):
+        result.histogram(
+            [1000 * i for i in range(1, 101)], description="Insert"
+        )
+
+
+@multitest.testsuite
+class Beta(object):
+    @multitest.testcase
+    def test_failure(self, env, result):
+        result.equal(1, 2, "failing assertion")
+
+
+def make_alpha():
+    return multitest.MultiTest(name="Alpha", suites=[Alpha()])
+
+
+def make_beta():
+    return multitest.MultiTest(name="Beta", suites=[Beta()])
+
+
+def samples(content, name):
+    """Label strings and values of the samples of a metric."""
+    return {
+        labels: float(value)
+        for labels, value in re.findall(
+            r"^{}(\{{.*\}}) (\S+)$".format(re.escape(name)),
+            content,
+            re.MULTILINE,
+        )
+    }
+
+
+def test_openmetrics_exporter(runpath):
+    """
+    OpenMetrics Exporter should write the run, test, pool and histogram
+    metrics at the given `openmetrics_path`.
+    """
+    openmetrics_path = os.path.join(runpath, "metrics", "testplan.prom")
+
+    plan = TestplanMock(
+        "plan",
+        exporters=OpenMetricsExporter(
+            openmetrics_path=openmetrics_path, top_testcases=2
+        ),
+        runpath=runpath,
+    )
+    pool = ThreadPool(name="MyPool", size=2)
+    plan.add_resource(pool)
+    plan.schedule(Task(target=make_alpha), resource="MyPool")
+    plan.schedule(Task(target=make_beta), resource="MyPool")
+    plan.run()
+
+    assert os.listdir(os.path.dirname(openmetrics_path)) == ["testplan.prom"]
+    with open(openmetrics_path) as metrics_file:
+        content = metrics_file.read()
+
+    assert content.endswith("# EOF\n")
+    assert "# TYPE testplan_run_duration_seconds gauge\n" in content
+    assert "# UNIT testplan_run_duration_seconds seconds\n" in content
+    assert samples(content, "testplan_run_passed") == {'{plan="plan"}': 0}
+    assert (
+        samples(content, "testplan_run_duration_seconds")['{plan="plan"}'] > 0
+    )
+    assert '{plan="plan"}' in samples(
+        content, "testplan_report_processing_seconds"
+    )
+
+    for test in ("Alpha", "Beta"):
+        labels = '{{plan="plan",test="{}"}}'.format(test)
+        assert labels in samples(content, "testplan_test_duration_seconds")
+        assert labels in samples(content, "testplan_test_queue_wait_seconds")
+
+    pool = '{plan="plan",pool="MyPool"}'
+    assert samples(content, "testplan_pool_workers") == {pool: 2}
+    assert samples(content, "testplan_pool_tasks") == {pool: 2}
+    assert 0 < samples(content, "testplan_pool_utilization_ratio")[pool] <= 1
+
+    assert len(samples(content, "testplan_testcase_duration_seconds")) == 2
+
+    benchmark = (
+        'plan="plan",test="Alpha",suite="Alpha",testcase="test_latency",'
+        'benchmark="Insert"'
+    )
+    summary = samples(content, "testplan_benchmark_seconds")
+    # Bucket values within 0.8% (see testplan.common.utils.hdr)
+    assert summary["{" + benchmark + ',quantile="0.5"}'] == pytest.approx(
+        50e-6, rel=0.01
+    )
+    assert summary["{" + benchmark + ',quantile="0.99"}'] == pytest.approx(
+        99e-6, rel=0.01
+    )
+    assert samples(content, "testplan_benchmark_seconds_count") == {
+        "{" + benchmark + "}": 100
+    }
+
+
+def test_implicit_exporter_initialization(runpath):
+    """
+    An implicit OpenMetrics exporter should be created if `openmetrics_path`
+    is available via cmdline args, replacing the file of the previous run.
+    """
+    openmetrics_path = os.path.join(runpath, "testplan.prom")
+    with open(openmetrics_path, "w") as metrics_file:
+        metrics_file.write("stale\n")
+
+    with argv_overridden("--openmetrics", openmetrics_path):
+        plan = TestplanMock(name="plan", parse_cmdline=True)
+        plan.add(make_alpha())
+        plan.run()
+
+    with open(openmetrics_path) as metrics_file:
+        content = metrics_file.read()
+    assert not content.startswith("stale")
+    assert samples(content, "testplan_run_passed") == {'{plan="plan"}': 1}
+    assert oct(os.stat(openmetrics_path).st_mode & 0o777) == oct(0o644)
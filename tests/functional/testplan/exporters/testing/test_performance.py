@@ -0,0 +1,93 @@
+"""Test the performance comparison exporter."""
+
+import json
+import os
+import time
+
+from testplan import TestplanMock
+from testplan.common.utils.testing import argv_overridden
+from testplan.exporters.testing import (
+    JSONExporter,
+    PerformanceComparisonExporter,
+)
+from testplan.testing import multitest
+
+
+def make_suite(delay):
+    @multitest.testsuite
+    class Suite(object):
+        @multitest.testcase
+        def test_sleep(self, env, result):
+            time.sleep(delay)
+            result.true(True)
+
+        @multitest.testcase
+        def test_latency(self, env, result):
+            result.histogram(
+                [int(delay * 1e6)] * 10 + [1000] * 90, description="Insert"
+            )
+
+    return Suite()
+
+
+def run_plan(runpath, delay, **options):
+    plan = TestplanMock("plan", runpath=runpath, **options)
+    plan.add(multitest.MultiTest(name="MTest", suites=[make_suite(delay)]))
+    plan.run()
+    return plan
+
+
+def test_performance_comparison_exporter(runpath):
+    """
+    The exporter should compare the run with a JSON report of a previous
+    run and save the comparison.
+    """
+    baseline_path = os.path.join(runpath, "baseline.json")
+    comparison_path = os.path.join(runpath, "comparison.json")
+    run_plan(
+        os.path.join(runpath, "baseline"),
+        0.01,
+        exporters=JSONExporter(json_path=baseline_path),
+    )
+    run_plan(
+        os.path.join(runpath, "current"),
+        0.3,
+        exporters=PerformanceComparisonExporter(
+            performance_baseline=baseline_path,
+            comparison_path=comparison_path,
+        ),
+    )
+
+    with open(comparison_path) as json_file:
+        comparison = json.load(json_file)
+
+    testcases = {
+        tuple(change["key"]): change for change in comparison["testcases"]
+    }
+    sleep = testcases[("MTest", "Suite", "test_sleep")]
+    assert sleep["current"] - sleep["baseline"] > 0.2
+
+    benchmarks = {
+        tuple(change["key"]): change for change in comparison["benchmarks"]
+    }
+    p99 = benchmarks[("MTest", "Suite", "test_latency", "Insert", "p99")]
+    assert p99["unit"] == "s"
+    assert p99["ratio"] > 10
+    assert comparison["regressions"] >= 2
+
+
+def test_implicit_exporter_initialization(runpath):
+    """
+    An implicit exporter should be created if `performance_baseline` is
+    available via cmdline args, and skip missing baselines.
+    """
+    baseline_path = os.path.join(runpath, "baseline.json")
+    with argv_overridden("--performance-baseline", baseline_path):
+        plan = TestplanMock(name="plan", parse_cmdline=True)
+        plan.add(multitest.MultiTest(name="MTest", suites=[make_suite(0)]))
+        plan.run()
+    assert plan.cfg.performance_baseline == baseline_path
+    assert any(
+        isinstance(exporter, PerformanceComparisonExporter)
+        for exporter in plan.runnable.exporters
+    )
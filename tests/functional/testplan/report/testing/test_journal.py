@@ -0,0 +1,100 @@
+"""Test the report journal written while a plan runs."""
+
+import json
+
+from testplan.base import TestplanMock
+from testplan.common.utils.testing import log_propagation_disabled
+from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.report import Status
+from testplan.report.testing import journal as report_journal
+from testplan.report.testing.journal import load_journal
+from testplan.testing.multitest import MultiTest, testsuite, testcase
+
+
+@testsuite
+class Suite(object):
+    def __init__(self, journal_path):
+        self.journal_path = journal_path
+
+    def setup(self, env):
+        pass
+
+    @testcase
+    def first(self, env, result):
+        result.equal(1, 1)
+
+    @testcase
+    def journaled(self, env, result):
+        """Previous testcases are journaled while the plan runs."""
+        report = load_journal(self.journal_path)
+        suite = report["Journaled"]["Suite"]
+        result.equal(suite.entry_uids, ["setup", "first"])
+        result.equal(suite["first"].status, Status.PASSED)
+        result.equal(report["Journaled"].status, Status.INCOMPLETE)
+
+    @testcase(parameters=(1, 2))
+    def param(self, env, result, value):
+        result.equal(value, 1)
+
+    @testcase(execution_group="group")
+    def grouped(self, env, result):
+        result.true(True)
+
+
+def make_plan(tmpdir, **options):
+    journal_path = str(tmpdir.join("report.journal"))
+    plan = TestplanMock(
+        "plan", runpath=str(tmpdir), report_journal=journal_path
+    )
+    plan.add(
+        MultiTest(name="Journaled", suites=[Suite(journal_path)], **options)
+    )
+    return plan, journal_path
+
+
+def test_report_journal(tmpdir):
+    mockplan, journal_path = make_plan(tmpdir, thread_pool_size=2)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        mockplan.run()
+
+    with open(journal_path) as journal:
+        records = [json.loads(line)["record"] for line in journal]
+    assert records[0] == records[-1] == "plan"
+    assert records[1:-2].count("testcase") == 6
+    assert records[-2] == "instance"
+
+    report = load_journal(journal_path)
+    assert report.status == mockplan.report.status == Status.FAILED
+    assert report.counter == mockplan.report.counter
+    instance = report["Journaled"]
+    assert instance["Suite"]["param"].status == Status.FAILED
+    assert instance["Suite"]["journaled"].status == Status.PASSED
+
+
+def test_crashed_run(tmpdir):
+    mockplan, journal_path = make_plan(tmpdir)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        mockplan.run()
+
+    # Keep the records of the plan, the groups and the testcases up to the
+    # second one, followed by a record cut short by the crash
+    with open(journal_path) as journal:
+        lines = journal.readlines()
+    with open(journal_path, "w") as journal:
+        journal.writelines(lines[:6])
+        journal.write(lines[6][:20])
+
+    report = load_journal(journal_path)
+    assert report.status == Status.INCOMPLETE
+    suite = report["Journaled"]["Suite"]
+    assert suite.entry_uids == ["setup", "first", "journaled"]
+    assert suite["journaled"].status == Status.PASSED
+
+    json_path = str(tmpdir.join("report.json"))
+    assert report_journal.main([journal_path, "--json", json_path]) == 0
+    with open(json_path) as json_file:
+        data = json.load(json_file)
+    assert data["status"] == Status.INCOMPLETE
+    assert len(data["entries"][0]["entries"][0]["entries"]) == 3
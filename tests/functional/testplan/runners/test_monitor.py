@@ -0,0 +1,119 @@
+"""Test the events of a run published for its live monitor."""
+
+import collections
+
+from testplan.base import TestplanMock
+from testplan.common.utils.events import EventBus
+from testplan.common.utils.testing import log_propagation_disabled
+from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.report import Status
+from testplan.runnable.monitor import RunMonitor
+from testplan.runners.pools import ThreadPool
+from testplan.testing.multitest import MultiTest, testsuite, testcase
+from testplan.web_ui import web_app
+
+
+@testsuite
+class Suite(object):
+    @testcase
+    def passing(self, env, result):
+        result.equal(1, 1)
+
+    @testcase
+    def failing(self, env, result):
+        result.fail("failure")
+
+
+@testsuite
+class MonitoredSuite(object):
+    def __init__(self, plan):
+        self.plan = plan
+
+    @testcase
+    def monitored(self, env, result):
+        """Events are published while the plan runs."""
+        events = self.plan.event_bus.events_since(0, timeout=0)
+        kinds = [
+            (event.kind, event.data.get("testcase"))
+            for event in events
+            if event.data.get("test") in (None, env.parent.uid())
+        ]
+        result.equal(
+            kinds,
+            [
+                ("plan_started", None),
+                ("test_started", None),
+                ("testcase_finished", "passing"),
+                ("testcase_finished", "failing"),
+            ],
+        )
+
+
+class MonitorServer(object):
+    """Monitor server not serving the events, they are read from the bus."""
+
+    def __init__(self, event_bus, monitor, port):
+        self.monitor = monitor
+        self.server = collections.namedtuple("Server", "bind_addr")(
+            ("localhost", port)
+        )
+
+    def start(self):
+        pass
+
+    def ready(self):
+        return True
+
+    def stop(self):
+        pass
+
+
+def test_monitor_events(tmpdir, monkeypatch):
+    monkeypatch.setattr(web_app, "MonitorServer", MonitorServer)
+    mockplan = TestplanMock("plan", runpath=str(tmpdir), monitor_port=0)
+    mockplan.add_resource(ThreadPool(name="Pool", size=2))
+    mockplan.add(
+        MultiTest(name="Local", suites=[Suite(), MonitoredSuite(mockplan)])
+    )
+    for idx in range(3):
+        mockplan.schedule(
+            target=MultiTest(name="Pooled{}".format(idx), suites=[Suite()]),
+            resource="Pool",
+        )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        mockplan.run()
+
+    bus = mockplan.event_bus
+    assert bus.closed
+    events = bus.events_since(0, timeout=0)
+    assert events[0].kind == "plan_started"
+    assert events[0].data["tests"] == {
+        "Local": "local_runner",
+        "Pooled0": "Pool",
+        "Pooled1": "Pool",
+        "Pooled2": "Pool",
+    }
+    assert events[-1].kind == "plan_finished"
+    assert events[-1].data["status"] == Status.FAILED
+
+    for event in events:
+        if event.kind == "test_started" and event.data["executor"] == "Pool":
+            assert event.data["worker"] in ("0", "1")
+        elif event.kind == "test_finished":
+            assert event.data["status"] == Status.FAILED
+            assert event.data["counter"]["failed"] == 1
+            if event.data["executor"] == "Pool":
+                assert event.data["utilization"] > 0
+
+    # State of the monitor at the end of the run
+    monitor = RunMonitor(EventBus())
+    for event in events:
+        monitor.update(event)
+    state = monitor.snapshot()
+    assert state["plan"]["done"] == state["plan"]["tests"] == 4
+    assert state["tests"]["Local"]["testcases"] == 3
+    assert state["tests"]["Local"]["counter"]["passed"] == 2
+    workers = state["executors"]["Pool"]["workers"]
+    assert sum(worker["done"] for worker in workers.values()) == 3
+    assert all(worker["test"] is None for worker in workers.values())
@@ -1,15 +1,27 @@
+import copy
 import os
 import platform
 
 import pytest
 
+from testplan import TestplanMock
+from testplan.common.utils import path
 from testplan.common.utils.testing import (
     log_propagation_disabled,
     check_report,
 )
 from testplan.common.utils.logger import TESTPLAN_LOGGER
 from testplan.testing.cpp import GTest
-from testplan.report import Status
+from testplan.testing.ordering import FailureHistorySorter
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.schemas.base import registry
+from testplan.testing.sampling import Sample
+from testplan.report import (
+    Status,
+    TestReport,
+    TestGroupReport,
+    TestCaseReport,
+)
 
 from tests.functional.testplan.testing.fixtures.cpp import gtest
 
@@ -25,6 +37,18 @@ You need to compile the files at "{binary_dir}" to be able to run this test.
 """
 
 
+def binary_or_skip(binary_dir):
+    """Path of the test binary of a fixture, skips the test if not built."""
+    binary_path = os.path.join(binary_dir, "runTests")
+    if not os.path.exists(binary_path):
+        pytest.skip(
+            BINARY_NOT_FOUND_MESSAGE.format(
+                binary_dir=binary_dir, binary_path=binary_path
+            )
+        )
+    return binary_path
+
+
 @skip_on_windows(reason="GTest is skipped on Windows.")
 @pytest.mark.parametrize(
     "binary_dir, expected_report, report_status",
@@ -44,17 +68,26 @@ You need to compile the files at "{binary_dir}" to be able to run this test.
             gtest.empty.report.expected_report,
             Status.PASSED,
         ),
+        (
+            os.path.join(fixture_root, "compare"),
+            gtest.compare.report.expected_report,
+            Status.FAILED,
+        ),
+        (
+            os.path.join(fixture_root, "typed"),
+            gtest.typed.report.expected_report,
+            Status.FAILED,
+        ),
+        (
+            os.path.join(fixture_root, "latency"),
+            gtest.latency.report.expected_report,
+            Status.FAILED,
+        ),
     ),
 )
 def test_gtest(mockplan, binary_dir, expected_report, report_status):
 
-    binary_path = os.path.join(binary_dir, "runTests")
-
-    if not os.path.exists(binary_path):
-        msg = BINARY_NOT_FOUND_MESSAGE.format(
-            binary_dir=binary_dir, binary_path=binary_path
-        )
-        pytest.skip(msg)
+    binary_path = binary_or_skip(binary_dir)
 
     mockplan.add(GTest(name="My GTest", binary=binary_path))
 
@@ -66,6 +99,199 @@ def test_gtest(mockplan, binary_dir, expected_report, report_status):
     assert mockplan.report.status == report_status
 
 
+@skip_on_windows(reason="GTest is skipped on Windows.")
+def test_gtest_forked_death_tests(mockplan):
+
+    binary_path = binary_or_skip(os.path.join(fixture_root, "death"))
+
+    mockplan.add(GTest(name="My GTest", binary=binary_path))
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    check_report(
+        expected=gtest.death.report.expected_report, actual=mockplan.report
+    )
+
+    death_tests = mockplan.report["My GTest"].meta["death_tests"]
+    assert death_tests["forked"] == 4
+    assert death_tests["time_saved"] > 0
+
+
+@skip_on_windows(reason="GTest is skipped on Windows.")
+@pytest.mark.parametrize("verify", (False, True))
+def test_gtest_sample(mockplan, verify):
+
+    binary_path = binary_or_skip(os.path.join(fixture_root, "failing"))
+
+    sample = Sample(fraction=0.5, seed=1, verify=verify)
+    mockplan.add(
+        GTest(name="My GTest", binary=binary_path, test_sample=sample)
+    )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    test_report = mockplan.report["My GTest"]
+    meta = test_report.meta["sample"]
+    assert meta["listed"] == 4
+    assert meta["selected"] == 2
+
+    run = {
+        "{}.{}".format(suite.name, testcase.name)
+        for suite in test_report
+        if suite.name != "ProcessChecks"
+        for testcase in suite
+    }
+    if verify:
+        # All testcases run, 2 of them fail
+        assert len(run) == 4
+        coverage = meta["coverage"]
+        assert coverage["failed"] == 2
+        assert coverage["caught"] + len(coverage["missed"]) == 2
+    else:
+        # One testcase of each suite
+        assert run == set(meta["testcases"])
+        assert len({name.split(".")[0] for name in run}) == 2
+
+
+def failed_history(instance, suite, testcase):
+    """Report of an earlier run in which a testcase failed."""
+    testcase_report = TestCaseReport(name=testcase, uid=testcase)
+    testcase_report.append(
+        registry.serialize(
+            RawAssertion(description="failure", content="", passed=False)
+        )
+    )
+    suite_report = TestGroupReport(
+        name=suite, uid=suite, category="testsuite", entries=[testcase_report]
+    )
+    return TestReport(
+        name="history",
+        entries=[
+            TestGroupReport(
+                name=instance,
+                uid=instance,
+                category="gtest",
+                entries=[suite_report],
+            )
+        ],
+    )
+
+
+@skip_on_windows(reason="GTest is skipped on Windows.")
+@pytest.mark.parametrize("fail_fast", (False, True))
+def test_gtest_failure_history_order(mockplan, fail_fast):
+
+    binary_path = binary_or_skip(os.path.join(fixture_root, "failing"))
+
+    sorter = FailureHistorySorter(
+        history=[
+            failed_history("My GTest", "SquareRootTestNonFatal", "PositiveNos")
+        ]
+    )
+    mockplan.add(
+        GTest(
+            name="My GTest",
+            binary=binary_path,
+            test_sorter=sorter,
+            gtest_fail_fast=fail_fast,
+        )
+    )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    test_report = mockplan.report["My GTest"]
+    assert test_report.meta["order"] == {
+        "testcases": 4,
+        "failed_recently": 1,
+        "passes": 2,
+    }
+    run = [
+        "{}.{}".format(suite.name, testcase.name)
+        for suite in test_report
+        if suite.name != "ProcessChecks"
+        for testcase in suite
+    ]
+    if fail_fast:
+        # The second pass is skipped after the failure of the first one
+        assert run == ["SquareRootTestNonFatal.PositiveNos"]
+    else:
+        # Reports of both passes are merged, the failed testcase first
+        assert run == [
+            "SquareRootTestNonFatal.PositiveNos",
+            "SquareRootTestNonFatal.NegativeNos",
+            "SquareRootTest.PositiveNos",
+            "SquareRootTest.NegativeNos",
+        ]
+    assert test_report.status == Status.FAILED
+
+
+@skip_on_windows(reason="GTest is skipped on Windows.")
+def test_gtest_memory_growth(mockplan):
+
+    binary_path = binary_or_skip(os.path.join(fixture_root, "memory"))
+
+    mockplan.add(
+        GTest(
+            name="My GTest",
+            binary=binary_path,
+            memory_growth_threshold=32 * 1024 * 1024,
+        )
+    )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    check_report(
+        expected=gtest.memory.report.expected_report, actual=mockplan.report
+    )
+
+    test_report = mockplan.report["My GTest"]
+    memory = test_report.meta["memory"]
+    assert memory["tests"] == 2
+    assert memory["flagged"] == ["MemoryTest.Leaks"]
+    assert memory["largest_growth"][0]["testcase"] == "MemoryTest.Leaks"
+    assert memory["largest_growth"][0]["rss_delta"] >= 64 * 1024 * 1024
+    assert memory["rss_end"] - memory["rss_start"] >= 64 * 1024 * 1024
+
+    suite = test_report["MemoryTest"]
+    assert suite["Leaks"].status == Status.FAILED
+    assert suite["Leaks"].entries[-1]["description"] == "Memory growth"
+    assert suite["Frees"].status == Status.PASSED
+
+
+@skip_on_windows(reason="GTest is skipped on Windows.")
+def test_gtest_report_workers():
+
+    binary_path = binary_or_skip(os.path.join(fixture_root, "failing"))
+
+    names = ["My GTest {}".format(index) for index in range(4)]
+    with path.TemporaryDirectory() as runpath:
+        plan = TestplanMock("plan", runpath=runpath, report_workers=2)
+        for name in names:
+            plan.add(GTest(name=name, binary=binary_path))
+
+        with log_propagation_disabled(TESTPLAN_LOGGER):
+            assert plan.run().run is True
+
+    # Reports are processed in other processes, in the order tests were added
+    assert [test.name for test in plan.report] == names
+    for name in names:
+        expected = copy.deepcopy(
+            gtest.failing.report.expected_report.entries[0]
+        )
+        expected.name = name
+        check_report(expected=expected, actual=plan.report[name])
+        assert plan.report[name].timer["process_results"].elapsed > 0
+
+    statistics = plan.report.meta["executors"]["local_runner"]
+    assert statistics["workers"] == 2
+    assert statistics["reports"] == len(names)
+    assert plan.report.status == Status.FAILED
+
+
 @skip_on_windows(reason="GTest is skipped on Windows.")
 def test_gtest_no_report(mockplan):
 
@@ -11,7 +11,13 @@ from testplan.common.utils.testing import (
     argv_overridden,
 )
 from testplan.common.utils.logger import TESTPLAN_LOGGER
+from testplan.testing.base import ProcessRunnerTest
 from testplan.testing.cpp import HobbesTest
+from testplan.testing.ordering import FailureHistorySorter
+from testplan.testing.sampling import Sample
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.schemas.base import registry
+from testplan.report import TestCaseReport, TestGroupReport, TestReport
 
 from tests.functional.testplan.testing.fixtures.cpp import hobbestest
 
@@ -64,6 +70,12 @@ def test_hobbestest(mockplan, binary_dir, expected_report):
 
     check_report(expected=expected_report, actual=mockplan.report)
 
+    # Testcases are timed from the durations reported by Hobbes
+    net = mockplan.report["My HobbesTest"]["Net"]
+    sync, async_ = net["syncClientAPI"], net["asyncClientAPI"]
+    assert sync.timer["run"].elapsed == pytest.approx(4.66587)
+    assert async_.timer["run"].start == sync.timer["run"].end
+
 
 @skip_on_windows(reason="HobbesTest is skipped on Windows.")
 @pytest.mark.parametrize(
@@ -96,3 +108,98 @@ def test_hobbestest_listing(binary_dir, expected_output):
                 print(log_capture.output)
                 assert log_capture.output == expected_output
                 assert len(result.test_report) == 0, "No tests should be run."
+
+
+class UnsampledHobbesTest(HobbesTest):
+    """HobbesTest of a binary that cannot run a sample."""
+
+    test_command_sample = ProcessRunnerTest.test_command_sample
+
+
+@skip_on_windows(reason="HobbesTest is skipped on Windows.")
+@pytest.mark.parametrize("test_class", (HobbesTest, UnsampledHobbesTest))
+def test_hobbestest_sample(mockplan, test_class):
+
+    binary_path = os.path.join(fixture_root, "passing", "hobbes-test")
+    tests = ["Hog", "Net", "Recursives"]
+
+    mockplan.add(
+        test_class(
+            name="My HobbesTest",
+            binary=binary_path,
+            tests=tests,
+            test_sample=Sample(fraction=0.5, seed=1),
+        )
+    )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    test_report = mockplan.report["My HobbesTest"]
+    run = {suite.name for suite in test_report if suite.name in tests}
+    if test_class is HobbesTest:
+        # Sampled among the specified tests only
+        meta = test_report.meta["sample"]
+        assert meta["listed"] == 3
+        assert meta["selected"] == 2
+        assert run == set(meta["testcases"])
+    else:
+        # All specified tests run
+        assert "sample" not in test_report.meta
+        assert run == set(tests)
+
+
+def failed_suite(name):
+    """Report of a Hobbes test in which a testcase failed."""
+    testcase_report = TestCaseReport(name="testcase", uid="testcase")
+    testcase_report.append(
+        registry.serialize(
+            RawAssertion(description="failure", content="", passed=False)
+        )
+    )
+    return TestGroupReport(
+        name=name, uid=name, category="testsuite", entries=[testcase_report]
+    )
+
+
+@skip_on_windows(reason="HobbesTest is skipped on Windows.")
+def test_hobbestest_failure_history_order(mockplan):
+
+    binary_path = os.path.join(fixture_root, "passing", "hobbes-test")
+    tests = ["Hog", "Net", "Recursives"]
+
+    # Net failed in an earlier run, as well as a test that is not run
+    history = TestReport(
+        name="history",
+        entries=[
+            TestGroupReport(
+                name="My HobbesTest",
+                uid="My HobbesTest",
+                category="hobbestest",
+                entries=[failed_suite("Arrays"), failed_suite("Net")],
+            )
+        ],
+    )
+    mockplan.add(
+        HobbesTest(
+            name="My HobbesTest",
+            binary=binary_path,
+            tests=tests,
+            test_sorter=FailureHistorySorter(history=[history]),
+        )
+    )
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    # Only the specified tests are ordered and run
+    test_report = mockplan.report["My HobbesTest"]
+    assert test_report.meta["order"] == {
+        "testcases": 3,
+        "failed_recently": 1,
+        "passes": 1,
+    }
+    run = {
+        suite.name for suite in test_report if suite.name != "ProcessChecks"
+    }
+    assert run == set(tests)
@@ -1,3 +1,4 @@
 from . import passing
 from . import sleeping
 from . import failing
+from . import golden
@@ -0,0 +1,47 @@
+from testplan.report import (
+    TestReport,
+    TestGroupReport,
+    TestCaseReport,
+    RuntimeStatus,
+)
+
+exit_code_report = TestCaseReport(
+    name="ExitCodeCheck",
+    entries=[
+        {
+            "type": "RawAssertion",
+            "description": "Process exit code check",
+            "passed": True,
+        },
+        {"type": "Attachment", "description": "Process stdout"},
+        {"type": "Attachment", "description": "Process stderr"},
+    ],
+)
+exit_code_report.runtime_status = RuntimeStatus.FINISHED
+
+golden_report = TestCaseReport(
+    name="GoldenFileCheck",
+    entries=[
+        {"type": "RawAssertion", "passed": False},
+        {"type": "TableLog", "description": "Differing regions"},
+        {"type": "RawAssertion", "passed": True},
+    ],
+)
+golden_report.runtime_status = RuntimeStatus.FINISHED
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="MyTest",
+            category="dummytest",
+            entries=[
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[exit_code_report, golden_report],
+                )
+            ],
+        )
+    ],
+)
@@ -0,0 +1,3 @@
+#!/bin/sh
+printf 'name,price\nfoo,1.5\nbar,2.25\n' > same.csv
+printf 'name,price\nfoo,1.5\nbar,2.75\n' > changed.csv
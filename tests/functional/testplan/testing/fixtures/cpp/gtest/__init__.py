@@ -1 +1 @@
-from . import failing, passing, empty
+from . import failing, passing, empty, compare, typed, latency, death, memory
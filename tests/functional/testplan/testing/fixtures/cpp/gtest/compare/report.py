@@ -0,0 +1,87 @@
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="My GTest",
+            category="gtest",
+            entries=[
+                TestGroupReport(
+                    name="ArrayCompareTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="Close",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                        TestCaseReport(
+                            name="Mismatches",
+                            entries=[
+                                {
+                                    "type": "RawAssertion",
+                                    "passed": False,
+                                    "description": "actual vs expected: "
+                                    "1001 of 1000000 elements differ",
+                                },
+                                {"type": "TableLog"},
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="SizeMismatch",
+                            entries=[
+                                {
+                                    "type": "RawAssertion",
+                                    "passed": False,
+                                    "description": "actual vs expected: "
+                                    "1 of 10 elements differ",
+                                },
+                                {"type": "TableLog"},
+                            ],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="GoldenFileTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="Identical",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                        TestCaseReport(
+                            name="Differs",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "TableLog",
+                                    "description": "Differing regions",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="ExitCodeCheck",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stdout",
+                                },
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stderr",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+            ],
+        )
+    ],
+)
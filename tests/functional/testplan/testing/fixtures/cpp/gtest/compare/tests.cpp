@@ -0,0 +1,74 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <testplan/gtest.h>
+
+using testplan::compare::absolute;
+using testplan::compare::relative;
+using testplan::compare::ulps;
+
+static std::vector<double> prices(size_t n) {
+  std::vector<double> result(n);
+  for(size_t i = 0; i < n; ++i) {
+    result[i] = 100.0 + std::sin(static_cast<double>(i));
+  }
+  return result;
+}
+
+TEST(ArrayCompareTest, Close) {
+  std::vector<double> expected = prices(100003);
+  std::vector<double> actual = expected;
+  for(size_t i = 0; i < actual.size(); i += 7) {
+    actual[i] = std::nextafter(actual[i], 200.0);
+  }
+  EXPECT_VECTOR_NEAR(actual, expected, ulps(1));
+  EXPECT_VECTOR_NEAR(actual, expected, relative(1e-12));
+  EXPECT_ARRAY_NEAR(actual.data(), expected.data(), actual.size(),
+                    absolute(1e-9));
+}
+
+TEST(ArrayCompareTest, Mismatches) {
+  std::vector<double> expected = prices(1000000);
+  std::vector<double> actual = expected;
+  for(size_t i = 500; i < actual.size(); i += 1000) {
+    actual[i] += 1e-3;
+  }
+  actual[777777] = NAN;
+  EXPECT_VECTOR_NEAR(actual, expected, absolute(1e-6));
+}
+
+TEST(ArrayCompareTest, SizeMismatch) {
+  std::vector<double> expected = prices(10);
+  std::vector<double> actual = prices(9);
+  ASSERT_VECTOR_NEAR(actual, expected, absolute(1e-6));
+}
+static std::string writeFile(const char* name, const std::string& content) {
+  std::string path = testing::TempDir() + name;
+  FILE* out = fopen(path.c_str(), "wb");
+  fwrite(content.data(), 1, content.size(), out);
+  fclose(out);
+  return path;
+}
+
+TEST(GoldenFileTest, Identical) {
+  std::string content(3 << 20, 'x');
+  EXPECT_GOLDEN_FILE(writeFile("same.out", content),
+                     writeFile("same.golden", content));
+}
+
+TEST(GoldenFileTest, Differs) {
+  std::string golden(20 << 20, 'x');
+  std::string actual = golden;
+  actual[100] = 'y';
+  actual[10 << 20] = 'z';
+  EXPECT_GOLDEN_FILE(writeFile("differs.out", actual),
+                     writeFile("differs.golden", golden));
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,59 @@
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="My GTest",
+            category="gtest",
+            entries=[
+                TestGroupReport(
+                    name="DeathTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="Dies",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                        TestCaseReport(
+                            name="Exits",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                        TestCaseReport(
+                            name="DoesNotDie",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False}
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="WrongMessage",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False}
+                            ],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="ExitCodeCheck",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stdout",
+                                },
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stderr",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+            ],
+        )
+    ],
+)
@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <testplan/gtest.h>
+
+void crash() {
+  fprintf(stderr, "crashing\n");
+  abort();
+}
+
+TEST(DeathTest, Dies) {
+  EXPECT_FORKED_DEATH(crash(), "crash");
+}
+
+TEST(DeathTest, Exits) {
+  ASSERT_FORKED_DEATH(exit(1), "");
+}
+
+TEST(DeathTest, DoesNotDie) {
+  EXPECT_FORKED_DEATH(puts("alive"), "");
+}
+
+TEST(DeathTest, WrongMessage) {
+  EXPECT_FORKED_DEATH(crash(), "segfault");
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testplan::death::ForkServer::instance().start(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="My GTest",
+            category="gtest",
+            entries=[
+                TestGroupReport(
+                    name="LatencyTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="WithinBudget",
+                            entries=[
+                                {"type": "RawAssertion", "passed": True},
+                                {"type": "RawAssertion", "passed": True},
+                                {
+                                    "type": "TableLog",
+                                    "description": "Latency percentiles",
+                                },
+                                {
+                                    "type": "Histogram",
+                                    "description": "Latency distribution",
+                                },
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="OverBudget",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "TableLog",
+                                    "description": "Latency percentiles",
+                                },
+                                {
+                                    "type": "Histogram",
+                                    "description": "Latency distribution",
+                                },
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="Distribution",
+                            entries=[
+                                {"type": "RawAssertion", "passed": True},
+                                {
+                                    "type": "Histogram",
+                                    "description": "Recorded latencies",
+                                    "count": 14286,
+                                    "min": 0,
+                                    "max": 99995,
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="ExitCodeCheck",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stdout",
+                                },
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stderr",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+            ],
+        )
+    ],
+)
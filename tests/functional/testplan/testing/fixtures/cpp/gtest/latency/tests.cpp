@@ -0,0 +1,31 @@
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include <testplan/gtest.h>
+
+using namespace testplan::latency;
+
+TEST(LatencyTest, WithinBudget) {
+  volatile double value = 2.0;
+  EXPECT_LATENCY(doNotOptimize(std::sqrt(value)),
+                 p99(millis(10)).iterations(1000).warmup(100));
+}
+
+TEST(LatencyTest, OverBudget) {
+  EXPECT_LATENCY(std::this_thread::sleep_for(std::chrono::microseconds(200)),
+                 p50(micros(1)).iterations(20).warmup(2));
+}
+
+TEST(LatencyTest, Distribution) {
+  testplan::hdr::Histogram latencies;
+  for(uint64_t value = 0; value < 100000; value += 7) {
+    latencies.record(value);
+  }
+  testplan::gtest::logHistogram(latencies, "Recorded latencies");
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
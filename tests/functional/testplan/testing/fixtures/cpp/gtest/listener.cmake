@@ -0,0 +1,14 @@
+# Shared by the fixtures of the Testplan GTest listener: builds runTests from
+# the tests.cpp of the including directory.
+
+# Locate GTest
+find_package(Threads REQUIRED)
+find_package(GTest REQUIRED)
+include_directories(${GTEST_INCLUDE_DIRS})
+
+# Testplan C++ headers shipped with the package
+include_directories(${CMAKE_CURRENT_SOURCE_DIR}/../../../../../../../../testplan/testing/cpp/include)
+
+# Link runTests with what we want to test and the GTest and pthread library
+add_executable(runTests tests.cpp)
+target_link_libraries(runTests ${GTEST_LIBRARIES} pthread)
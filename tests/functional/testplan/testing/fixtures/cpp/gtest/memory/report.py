@@ -0,0 +1,54 @@
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="My GTest",
+            category="gtest",
+            entries=[
+                TestGroupReport(
+                    name="MemoryTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="Leaks",
+                            entries=[
+                                {"type": "RawAssertion", "passed": True},
+                                {
+                                    "type": "RawAssertion",
+                                    "description": "Memory growth",
+                                    "passed": False,
+                                },
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="Frees",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="ExitCodeCheck",
+                            entries=[
+                                {"type": "RawAssertion", "passed": True},
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stdout",
+                                },
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stderr",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+            ],
+        )
+    ],
+)
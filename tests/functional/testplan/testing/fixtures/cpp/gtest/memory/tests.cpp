@@ -0,0 +1,30 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <testplan/gtest_listener.h>
+
+static std::vector<char*> leaked;
+
+TEST(MemoryTest, Leaks) {
+  // 64MB never freed, touched so that it is resident
+  for (int i = 0; i < 64; ++i) {
+    char* block = static_cast<char*>(malloc(1 << 20));
+    memset(block, 1, 1 << 20);
+    leaked.push_back(block);
+  }
+  EXPECT_EQ(64u, leaked.size());
+}
+
+TEST(MemoryTest, Frees) {
+  std::vector<char> buffer(1 << 20, 1);
+  EXPECT_EQ(1, buffer[0]);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testplan::gtest::installListener();
+  return RUN_ALL_TESTS();
+}
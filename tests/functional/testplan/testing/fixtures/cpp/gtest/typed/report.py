@@ -0,0 +1,89 @@
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+
+expected_report = TestReport(
+    name="plan",
+    entries=[
+        TestGroupReport(
+            name="My GTest",
+            category="gtest",
+            entries=[
+                TestGroupReport(
+                    name="TypedTest",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="Passing",
+                            entries=[{"type": "RawAssertion", "passed": True}],
+                        ),
+                        TestCaseReport(
+                            name="Equal",
+                            entries=[
+                                {
+                                    "type": "Equal",
+                                    "passed": False,
+                                    "description": "tests.cpp:13: "
+                                    "value == 4 - Custom message",
+                                    "first": "5",
+                                    "second": "4",
+                                }
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="Comparisons",
+                            entries=[
+                                {
+                                    "type": "Less",
+                                    "passed": False,
+                                    "first": "2",
+                                    "second": "1",
+                                },
+                                {"type": "NotEqual", "passed": False},
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="Booleans",
+                            entries=[
+                                {"type": "IsTrue", "passed": False},
+                                {"type": "IsFalse", "passed": False},
+                            ],
+                        ),
+                        TestCaseReport(
+                            name="Near",
+                            entries=[{"type": "IsClose", "passed": False}],
+                        ),
+                        TestCaseReport(
+                            name="Other",
+                            entries=[
+                                {
+                                    "type": "RawAssertion",
+                                    "passed": False,
+                                    "description": "tests.cpp:33",
+                                }
+                            ],
+                        ),
+                    ],
+                ),
+                TestGroupReport(
+                    name="ProcessChecks",
+                    category="testsuite",
+                    entries=[
+                        TestCaseReport(
+                            name="ExitCodeCheck",
+                            entries=[
+                                {"type": "RawAssertion", "passed": False},
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stdout",
+                                },
+                                {
+                                    "type": "Attachment",
+                                    "description": "Process stderr",
+                                },
+                            ],
+                        ),
+                    ],
+                ),
+            ],
+        )
+    ],
+)
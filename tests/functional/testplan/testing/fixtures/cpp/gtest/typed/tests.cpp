@@ -0,0 +1,40 @@
+#include <cmath>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <testplan/gtest_listener.h>
+
+TEST(TypedTest, Passing) {
+  EXPECT_EQ(4, 2 + 2);
+}
+
+TEST(TypedTest, Equal) {
+  int value = 5;
+  EXPECT_EQ(value, 4) << "Custom message";
+}
+
+TEST(TypedTest, Comparisons) {
+  int low = 1;
+  int high = 2;
+  EXPECT_LT(high, low);
+  EXPECT_NE(low, 1);
+}
+
+TEST(TypedTest, Booleans) {
+  EXPECT_TRUE(std::string("abc").empty());
+  EXPECT_FALSE(std::string().empty());
+}
+
+TEST(TypedTest, Near) {
+  EXPECT_NEAR(std::sqrt(2.0), 1.5, 0.01);
+}
+
+TEST(TypedTest, Other) {
+  ADD_FAILURE() << "Something went wrong";
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testplan::gtest::installListener();
+  return RUN_ALL_TESTS();
+}
@@ -1,10 +1,15 @@
+import os
 import time
 from collections import OrderedDict
 
+import pytest
+
+from testplan.common.utils.context import context
 from testplan.testing.multitest import MultiTest, testsuite, testcase
+from testplan.testing.multitest.driver.tcp import TCPServer, TCPClient
 
 from testplan.common.utils.testing import log_propagation_disabled
-from testplan.report import TestGroupReport
+from testplan.report import TestGroupReport, Status
 from testplan.common.utils.logger import TESTPLAN_LOGGER
 
 EXECUTION_PERIOD = 0.001
@@ -82,10 +87,13 @@ def get_testcase_execution_time(
         return testcase_execution_time
 
 
-def test_execution_order(mockplan):
+@pytest.mark.parametrize(
+    "pool_options", ({"thread_pool_size": 2}, {"process_pool_size": 2})
+)
+def test_execution_order(mockplan, pool_options):
 
     multitest = MultiTest(
-        name="MyMultitest", suites=[MySuite()], thread_pool_size=2
+        name="MyMultitest", suites=[MySuite()], **pool_options
     )
 
     mockplan.add(multitest)
@@ -125,3 +133,101 @@ def test_execution_order(mockplan):
     assert group_0_end <= group_1_start
     assert group_1_end <= group_2_start
     assert group_2_end <= group_3_start
+
+
+@testsuite
+class ForkedSuite(object):
+    def __init__(self):
+        self.pids = []
+
+    @testcase
+    def serial(self, env, result):
+        self.pids.append(os.getpid())
+        result.equal(env.parent.cfg.name, "MyMultitest")
+
+    @testcase(execution_group="forked", parameters=range(3))
+    def forked(self, env, result, value):
+        self.pids.append(os.getpid())
+        result.dict.match({"value": value}, {"value": value})
+        result.log(str(os.getpid()))
+
+    @testcase(execution_group="forked")
+    def died(self, env, result):
+        os._exit(1)
+
+
+@pytest.mark.skipif(not hasattr(os, "fork"), reason="Requires fork")
+def test_forked_execution_group(mockplan):
+    suite = ForkedSuite()
+    multitest = MultiTest(
+        name="MyMultitest",
+        suites=[suite],
+        process_pool_size=2,
+        stop_on_error=False,
+    )
+    mockplan.add(multitest)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        mockplan.run()
+
+    suite_report = mockplan.report["MyMultitest"]["ForkedSuite"]
+    serial, died, param_report = suite_report.entries
+    assert serial.status == Status.PASSED
+    assert died.status == Status.ERROR
+    assert "Testcase process failed" in died.logs[0]["message"]
+
+    # Testcases ran in other processes, from the state of the suite when
+    # they were forked
+    assert suite.pids == [os.getpid()]
+    assert len(param_report.entries) == 3
+    for testcase_report in param_report:
+        assert testcase_report.status == Status.PASSED
+        match, log = testcase_report.entries
+        assert match["type"] == "DictMatch"
+        assert int(log["message"]) != os.getpid()
+
+
+@testsuite
+class ThreadedDriverSuite(object):
+    def __init__(self):
+        self.pids = []
+
+    @testcase(execution_group="forked")
+    def connect(self, env, result):
+        # The server accepts connections from a thread of the test process
+        self.pids.append(os.getpid())
+        env.client.connect()
+        conn_idx = env.server.accept_connection(timeout=5)
+        result.not_equal(conn_idx, -1, description="Connection accepted")
+
+        bytes_sent = env.client.send_text("hello")
+        received = env.server.receive_text(size=bytes_sent, conn_idx=conn_idx)
+        result.equal(received, "hello", description="Server received")
+
+
+@pytest.mark.skipif(not hasattr(os, "fork"), reason="Requires fork")
+def test_forked_execution_group_threaded_driver(mockplan):
+    suite = ThreadedDriverSuite()
+    multitest = MultiTest(
+        name="MyMultitest",
+        suites=[suite],
+        environment=[
+            TCPServer(name="server"),
+            TCPClient(
+                name="client",
+                host=context("server", "{{host}}"),
+                port=context("server", "{{port}}"),
+                connect_at_start=False,
+            ),
+        ],
+        process_pool_size=2,
+    )
+    mockplan.add(multitest)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        mockplan.run()
+
+    # TCPServer serves from a thread, the testcase runs in the thread pool
+    suite_report = mockplan.report["MyMultitest"]["ThreadedDriverSuite"]
+    assert suite_report["connect"].status == Status.PASSED
+    assert suite.pids == [os.getpid()]
@@ -96,3 +96,52 @@ def test_process_runner(mockplan, binary_path, expected_report, test_kwargs):
         assert mockplan.run().run is True
 
     check_report(expected=expected_report, actual=mockplan.report)
+
+
+@skip_on_windows(reason="Bash files skipped on Windows.")
+def test_golden_files(mockplan, tmpdir):
+    golden_dir = os.path.join(fixture_root, "golden", "expected")
+    process_test = DummyTest(
+        name="MyTest",
+        binary=os.path.join(fixture_root, "golden", "test.sh"),
+        proc_cwd=str(tmpdir),
+        golden_files={
+            "same.csv": os.path.join(golden_dir, "same.csv"),
+            "changed.csv": os.path.join(golden_dir, "changed.csv"),
+        },
+    )
+    mockplan.add(process_test)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    check_report(
+        expected=base.golden.report.expected_report, actual=mockplan.report
+    )
+
+    testcase_report = mockplan.report["MyTest"]["ProcessChecks"][
+        "GoldenFileCheck"
+    ]
+    assert testcase_report.entries[1]["table"] == [
+        {"Offset": 25, "Length": 1, "Actual": "7", "Golden": "2"}
+    ]
+
+
+@skip_on_windows(reason="Bash files skipped on Windows.")
+def test_golden_files_update(mockplan, tmpdir):
+    golden_file = tmpdir.join("golden.csv")
+    golden_file.write("stale")
+    process_test = DummyTest(
+        name="MyTest",
+        binary=os.path.join(fixture_root, "golden", "test.sh"),
+        proc_cwd=str(tmpdir),
+        golden_files={"changed.csv": str(golden_file)},
+        update_golden=True,
+    )
+    mockplan.add(process_test)
+
+    with log_propagation_disabled(TESTPLAN_LOGGER):
+        assert mockplan.run().run is True
+
+    assert mockplan.report.passed
+    assert golden_file.read() == tmpdir.join("changed.csv").read()
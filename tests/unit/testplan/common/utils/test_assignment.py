@@ -0,0 +1,82 @@
+import itertools
+import random
+
+import numpy
+import pytest
+from scipy.optimize import linear_sum_assignment
+
+from testplan.common.utils import assignment
+
+SOLVERS = [
+    pytest.param(assignment.python_min_cost_assignment, id="python"),
+    pytest.param(
+        assignment.min_cost_assignment,
+        id="native",
+        marks=pytest.mark.skipif(
+            assignment._assignment is None,
+            reason="C++ extension not built",
+        ),
+    ),
+]
+
+
+def exhaustive(grid):
+    """
+    Least total cost, then cheapest column (lowest index on equal costs)
+    for each row in turn, as the exhaustive search used to return.
+    """
+    size = len(grid)
+    return list(
+        min(
+            itertools.permutations(range(size)),
+            key=lambda cols: (
+                sum(grid[row][col] for row, col in enumerate(cols)),
+                [(grid[row][col], col) for row, col in enumerate(cols)],
+            ),
+        )
+    )
+
+
+@pytest.mark.parametrize("solve", SOLVERS)
+def test_example(solve):
+    grid = [[1000, 2000, 2000], [1000, 2000, 2000], [0, 2000, 2000]]
+    assert solve(grid) == [1, 2, 0]
+    assert solve([]) == []
+    assert solve([[5]]) == [0]
+
+
+@pytest.mark.parametrize("solve", SOLVERS)
+def test_exhaustive(solve):
+    rng = random.Random(0)
+    for _ in range(500):
+        size = rng.randint(2, 6)
+        high = rng.choice([1, 2, 10, 10000])
+        grid = [
+            [rng.randint(0, high) for _ in range(size)] for _ in range(size)
+        ]
+        assert solve(grid) == exhaustive(grid), grid
+
+
+@pytest.mark.parametrize("solve", SOLVERS)
+@pytest.mark.parametrize("high", (3, 1000000))
+def test_optimal(solve, high):
+    rng = random.Random(high)
+    size = 200
+    grid = [[rng.randint(0, high) for _ in range(size)] for _ in range(size)]
+    cols = solve(grid)
+    assert sorted(cols) == list(range(size))
+
+    array = numpy.array(grid)
+    rows, optimal = linear_sum_assignment(array)
+    assert array[rows, cols].sum() == array[rows, optimal].sum()
+    assert cols == assignment.python_min_cost_assignment(grid)
+
+
+def test_not_integers():
+    grid = [[0.5, 1.0, 2.5], [0.1, 2.0, 0.3], [1.5, 0.2, 0.2]]
+    assert assignment.min_cost_assignment(grid) == exhaustive(grid)
+    grid = [[2**70, 0], [0, 1]]
+    assert assignment.min_cost_assignment(grid) == [1, 0]
+
+    with pytest.raises(ValueError):
+        assignment.min_cost_assignment([[1, 2], [3]])
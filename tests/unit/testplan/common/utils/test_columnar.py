@@ -0,0 +1,95 @@
+import random
+import re
+
+import pytest
+
+from testplan.common.utils import columnar, comparison
+
+
+def check_column(actual, expected, strict=False):
+    """Same result as the cell by cell comparison."""
+    passed, errors = columnar.compare_column(actual, expected, strict=strict)
+    assert len(passed) == len(actual)
+    for idx, (first, second) in enumerate(zip(actual, expected)):
+        result, error = comparison.basic_compare(first, second, strict)
+        if error:
+            assert idx in errors and not passed[idx]
+        else:
+            assert idx not in errors
+            assert bool(passed[idx]) == bool(result)
+    return passed.tolist(), errors
+
+
+def test_numeric_array():
+    assert columnar.numeric_array([1, True]).dtype.kind == "i"
+    assert columnar.numeric_array([1.5, 2.0]).dtype.kind == "f"
+    assert columnar.numeric_array([1, 2.0]) is None
+    assert columnar.numeric_array([2**70]) is None
+    assert columnar.numeric_array(["1"]) is None
+
+
+@pytest.mark.parametrize(
+    "actual,expected,result",
+    (
+        ([], [], []),
+        ([1, 2, 3], [1, 5, 3], [True, False, True]),
+        ([1.5, float("nan")], [1.5, float("nan")], [True, False]),
+        ([1, 2.0, "a", None], [1.0, 2, "b", None], [True, True, False, True]),
+        ([2**70, 1], [2**70, 2], [True, False]),
+        (["foo", 1, 10], [re.compile(r"\w")] * 3, [True, True, True]),
+        (
+            [1, 5, 2.5],
+            [comparison.Less(3), comparison.Less(4), comparison.Less(2)],
+            [True, False, False],
+        ),
+        (
+            [1.0, 1.2, float("inf"), 3],
+            [
+                comparison.IsClose(1.05, abs_tol=0.1),
+                comparison.IsClose(1.0, rel_tol=0.1),
+                comparison.IsClose(float("inf")),
+                comparison.IsClose(3),
+            ],
+            [True, False, True, True],
+        ),
+        (
+            [1, 5, 3],
+            [comparison.In([1, 2]), comparison.Less(2), lambda x: x > 2],
+            [True, False, True],
+        ),
+    ),
+)
+def test_compare_column(actual, expected, result):
+    assert check_column(actual, expected) == (result, {})
+
+
+def test_compare_column_errors():
+    _, errors = check_column([1, 2], [re.compile(r"1")] * 2, strict=True)
+    assert sorted(errors) == [0, 1]
+    _, errors = check_column([1, "foo"], [comparison.IsClose(1)] * 2)
+    assert list(errors) == [1]
+
+
+def test_compare_column_random():
+    rng = random.Random(0)
+    values = (
+        lambda: rng.randint(-3, 3),
+        lambda: rng.random() * 3,
+        lambda: float("nan"),
+        lambda: "ab"[rng.randint(0, 1)],
+        lambda: None,
+    )
+    comparators = (
+        lambda: rng.choice(values)(),
+        lambda: re.compile(rng.choice(["a", "1", ".*"])),
+        lambda: comparison.GreaterEqual(rng.randint(-3, 3)),
+        lambda: comparison.IsClose(rng.randint(-3, 3), abs_tol=0.5),
+    )
+    for _ in range(1000):
+        size = rng.randint(0, 8)
+        actual = [rng.choice(values[:2])() for _ in range(size)]
+        if rng.random() < 0.2:
+            actual = [rng.choice(values)() for _ in range(size)]
+        comparator = rng.choice(comparators)
+        expected = [comparator() for _ in range(size)]
+        check_column(actual, expected, strict=rng.random() < 0.5)
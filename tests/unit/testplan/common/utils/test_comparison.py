@@ -1,5 +1,8 @@
+import re
+
 import pytest
 from testplan.common.utils import comparison as cmp
+from testplan.common.utils.reporting import Absent
 
 
 @pytest.mark.parametrize(
@@ -46,6 +49,28 @@ def test_boolean_callable(callable_kls, value, expected, description):
     assert str(callable_obj) == description
 
 
+@pytest.mark.parametrize(
+    "kwargs,value,expected",
+    (
+        ({}, 1.0 + 1e-10, True),
+        ({}, 1.001, False),
+        ({"rel_tol": 0.01}, 1.001, True),
+        ({"abs_tol": 0.5}, 1.4, True),
+        ({"abs_tol": 0.5}, 1.6, False),
+        ({"abs_tol": 1}, float("inf"), False),
+    ),
+)
+def test_is_close(kwargs, value, expected):
+    callable_obj = cmp.IsClose(1, **kwargs)
+    assert str(callable_obj) == "VAL ~= 1"
+    assert callable_obj(value) == expected
+
+
+def test_is_close_negative_tolerance():
+    with pytest.raises(ValueError):
+        cmp.IsClose(1, abs_tol=-1)
+
+
 def test_custom_callable():
     custom_callable = cmp.Custom(
         lambda value: value % 2 == 0, description="Value is even."
@@ -82,3 +107,90 @@ def test_comparator_composition(
 ):
     assert composed_callable(value) == expected
     assert str(composed_callable) == description
+
+
+def test_unordered_compare_many():
+    expected = [
+        {"ClOrdID": str(index), "OrderQty": index, "Side": index % 2}
+        for index in range(50)
+    ]
+    values = [dict(value) for value in reversed(expected)]
+    values[10]["OrderQty"] = -1  # ClOrdID 39, a single tag mismatch
+    del values[0]  # ClOrdID 49 missing
+
+    results = cmp.unordered_compare(
+        match_name="fixmatch",
+        values=values,
+        comparisons=[cmp.Expected(value) for value in expected],
+    )
+    assert len(results) == 50
+    matched = {
+        result["comparison_index"]: index
+        for index, result in enumerate(results)
+    }
+    for cmp_index in range(49):
+        assert values[matched[cmp_index]]["ClOrdID"] == str(cmp_index)
+    assert [
+        expected[result["comparison_index"]]["ClOrdID"]
+        for result in results
+        if not result["passed"]
+    ] == ["39", "49"]
+    assert results[-1]["description"].endswith("expected[49] vs Absent")
+
+
+PLAN_EXPECTED = {
+    35: "D",
+    38: cmp.GreaterEqual(4),
+    55: re.compile(r"[A-Z]+"),
+    59: None,
+    453: [
+        {448: "DESK", 447: cmp.In(["C", "D"]), 452: 1},
+        {448: re.compile(r"\d+"), 447: "D"},
+    ],
+    555: [1, 2],
+}
+
+
+@pytest.mark.parametrize(
+    "value",
+    (
+        {35: "D", 38: 5, 55: "AAPL", 59: None, 453: [], 555: [1, 2]},
+        {
+            35: "F",
+            38: "x",
+            55: "12",
+            453: [{448: "DESK", 447: "D", 452: "1"}, {448: "x"}, {}],
+            555: [1, 2, 3],
+            60: "extra",
+        },
+        {35: re.compile(r"D"), 38: [4], 453: "group"},
+        {},
+    ),
+)
+@pytest.mark.parametrize("report_mode", list(cmp.ReportOptions))
+@pytest.mark.parametrize(
+    "value_cmp_func", list(cmp.COMPARE_FUNCTIONS.values())
+)
+def test_comparison_plan(value, report_mode, value_cmp_func):
+    plan = cmp.ComparisonPlan(PLAN_EXPECTED)
+    for ignore, only in ((None, None), ([453], None), (None, [35, 55, 9])):
+        kwargs = dict(
+            ignore=ignore,
+            only=only,
+            report_mode=report_mode,
+            value_cmp_func=value_cmp_func,
+        )
+        expected = cmp.compare(value, PLAN_EXPECTED, **kwargs)
+        assert plan.compare(value, **kwargs) == expected
+        assert cmp.compare(value, plan, **kwargs) == expected
+        assert cmp.compare(plan, value, **kwargs) == cmp.compare(
+            PLAN_EXPECTED, value, **kwargs
+        )
+
+
+def test_comparison_plan_absent():
+    plan = cmp.ComparisonPlan(PLAN_EXPECTED)
+    for value in (None, Absent):
+        assert cmp.compare(value, plan) == cmp.compare(value, PLAN_EXPECTED)
+    with pytest.raises(TypeError):
+        cmp.ComparisonPlan([1, 2])
@@ -0,0 +1,71 @@
+"""Unit tests for the event bus of a run."""
+
+import threading
+
+from testplan.common.utils.events import EventBus
+
+
+def test_publish():
+    """Events are numbered and given to the listeners in order."""
+    bus = EventBus()
+    received = []
+    bus.subscribe(received.append)
+
+    first = bus.publish("test_started", test="A")
+    second = bus.publish("test_finished", test="A", status="passed")
+
+    assert received == [first, second]
+    assert (first.seq, second.seq) == (1, 2)
+    assert bus.last_seq == 2
+    assert second.to_dict() == {
+        "seq": 2,
+        "kind": "test_finished",
+        "time": second.time,
+        "test": "A",
+        "status": "passed",
+    }
+
+
+def test_events_since():
+    """Readers get the events after the last one they read."""
+    bus = EventBus()
+    events = [bus.publish("event", idx=idx) for idx in range(5)]
+
+    assert bus.events_since(0) == events
+    assert bus.events_since(3) == events[3:]
+    assert bus.events_since(5, timeout=0) == []
+
+
+def test_events_since_history():
+    """Readers of events no longer kept are told so."""
+    bus = EventBus(history=3)
+    events = [bus.publish("event", idx=idx) for idx in range(5)]
+
+    assert bus.events_since(0) is None
+    assert bus.events_since(1) is None
+    assert bus.events_since(2) == events[2:]
+
+
+def test_events_since_wait():
+    """Readers wait for events until the bus is closed."""
+    bus = EventBus()
+    read = []
+
+    def reader():
+        seq = 0
+        while True:
+            events = bus.events_since(seq)
+            if not events:
+                return
+            read.extend(events)
+            seq = events[-1].seq
+
+    thread = threading.Thread(target=reader)
+    thread.start()
+    events = [bus.publish("event", idx=idx) for idx in range(3)]
+    bus.close()
+    thread.join(timeout=5)
+
+    assert not thread.is_alive()
+    assert read == events
+    assert bus.closed
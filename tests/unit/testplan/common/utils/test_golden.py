@@ -0,0 +1,115 @@
+import mmap
+import os
+
+import pytest
+
+from testplan.common.utils import golden
+from testplan.common.utils.golden import DiffRegion
+
+PAGE = mmap.PAGESIZE
+
+
+@pytest.fixture
+def files(tmpdir):
+    def _write(actual, expected):
+        actual_path = str(tmpdir.join("actual.bin"))
+        golden_path = str(tmpdir.join("golden.bin"))
+        for path, content in ((actual_path, actual), (golden_path, expected)):
+            with open(path, "wb") as fobj:
+                fobj.write(content)
+        return actual_path, golden_path
+
+    return _write
+
+
+def test_identical(files):
+    content = os.urandom(10 * PAGE + 123)
+    result = golden.compare_files(*files(content, content), chunk_size=PAGE)
+    assert result.passed
+    assert result.regions == []
+    assert not result.truncated
+    assert result.actual_size == result.golden_size == len(content)
+
+
+def test_empty(files):
+    result = golden.compare_files(*files(b"", b""))
+    assert result.passed
+
+    result = golden.compare_files(*files(b"", b"abc"))
+    assert result.regions == [DiffRegion(0, 3)]
+
+
+def test_regions(files):
+    expected = bytearray(8 * PAGE)
+    actual = bytearray(expected)
+    actual[10] = 1
+    actual[10 + golden.MERGE_GAP + 1] = 1  # merged with the previous one
+    actual[100] = 1
+    # Differences on both sides of a chunk boundary form a single region
+    actual[3 * PAGE - 2 : 3 * PAGE + 2] = b"\x01" * 4
+
+    result = golden.compare_files(
+        *files(bytes(actual), bytes(expected)), chunk_size=PAGE, workers=4
+    )
+    assert not result.passed
+    assert result.regions == [
+        DiffRegion(10, golden.MERGE_GAP + 2),
+        DiffRegion(100, 1),
+        DiffRegion(3 * PAGE - 2, 4),
+    ]
+    assert not result.truncated
+
+
+def test_size_difference(files):
+    result = golden.compare_files(*files(b"abcdef", b"abXd"))
+    assert result.regions == [DiffRegion(2, 1), DiffRegion(4, 2)]
+    assert (result.actual_size, result.golden_size) == (6, 4)
+
+
+def test_early_exit(files):
+    expected = bytes(16 * PAGE)
+    actual = bytearray(expected)
+    actual[::100] = b"\x01" * len(actual[::100])
+    actual = bytes(actual)
+
+    result = golden.compare_files(
+        *files(actual, expected), chunk_size=PAGE, max_regions=3, workers=2
+    )
+    assert result.regions == [
+        DiffRegion(0, 1),
+        DiffRegion(100, 1),
+        DiffRegion(200, 1),
+    ]
+    assert result.truncated
+
+
+def test_missing_file(tmpdir):
+    with pytest.raises(OSError):
+        golden.compare_files(str(tmpdir.join("a")), str(tmpdir.join("b")))
+
+
+def test_update(files, tmpdir):
+    actual, expected = files(b"new content", b"old")
+    os.chmod(expected, 0o640)
+
+    result = golden.check_golden(actual, expected, update=True)
+    assert result.passed and result.updated
+    with open(expected, "rb") as fobj:
+        assert fobj.read() == b"new content"
+    assert os.stat(expected).st_mode & 0o777 == 0o640
+    assert sorted(os.listdir(str(tmpdir))) == ["actual.bin", "golden.bin"]
+
+
+def test_regions_table(files):
+    padding = b" " * golden.MERGE_GAP
+    actual, expected = files(
+        b"price,1.25" + padding + b"\x00\x01",
+        b"price,1.50" + padding + b"\x00\x02",
+    )
+    result = golden.compare_files(actual, expected)
+    assert golden.regions_table(result, actual, expected) == [
+        ["Offset", "Length", "Actual", "Golden"],
+        [8, 2, "25", "50"],
+        [11 + golden.MERGE_GAP, 1, "01", "02"],
+    ]
+    assert golden.summary(result) == "2 differing regions, size 20 vs 20 bytes"
@@ -0,0 +1,119 @@
+"""Unit tests for the hdr module."""
+
+import math
+import random
+
+import pytest
+
+from testplan.common.utils import hdr
+
+
+@pytest.mark.parametrize("bits", (2, 5, 8, 12))
+def test_bucket_index_and_range(bits):
+    previous_high = -1
+    for index in range(0, 40 << bits):
+        low, high = hdr.bucket_range(index, bits)
+        # Buckets are contiguous and ordered
+        assert low == previous_high + 1
+        previous_high = high
+        assert hdr.bucket_index(low, bits) == index
+        assert hdr.bucket_index(high, bits) == index
+        # Relative width bounded by the precision
+        assert high - low <= max(0, low >> (bits - 1))
+
+
+@pytest.mark.parametrize("vectorized", (True, False))
+def test_vectorized_indices_match(vectorized, monkeypatch):
+    if not vectorized:
+        monkeypatch.setattr(hdr, "numpy", None)
+    values = [random.randint(0, 2**50) for _ in range(2000)]
+    values.extend([0, 1, 255, 256, 257.5, 2**52, 2**53 - 1])
+    recorded = hdr.HDRHistogram().record_values(values)
+    scalar = hdr.HDRHistogram()
+    for value in values:
+        scalar.record(value)
+    assert recorded == scalar
+
+    with pytest.raises(ValueError):
+        recorded.record_values([1, -1])
+    assert recorded == scalar
+
+
+def test_percentiles_within_precision():
+    values = [random.expovariate(1 / 5000.0) for _ in range(20000)]
+    histogram = hdr.HDRHistogram().record_values(values)
+    ordered = sorted(int(round(value)) for value in values)
+
+    assert histogram.total == len(values)
+    assert histogram.min == ordered[0]
+    assert histogram.max == ordered[-1]
+    for percentile in (1, 50, 90, 99, 99.9):
+        rank = int(math.ceil(percentile / 100.0 * len(ordered)))
+        exact = ordered[rank - 1]
+        approx = histogram.value_at_percentile(percentile)
+        assert abs(approx - exact) <= exact / 128.0 + 1
+    assert histogram.value_at_percentile(100) == ordered[-1]
+    assert histogram.value_at_percentile(0) == ordered[0]
+
+    wanted = [50, 99, 99.9]
+    assert histogram.percentiles(wanted) == [
+        (percentile, histogram.value_at_percentile(percentile))
+        for percentile in wanted
+    ]
+
+
+def test_merge():
+    first = hdr.HDRHistogram().record_values(range(0, 1000))
+    second = hdr.HDRHistogram().record_values(range(5000, 6000))
+    merged = hdr.merge([first, second.encode()])
+
+    assert merged.total == 2000
+    assert merged.min == 0
+    assert merged.max == 5999
+    assert merged.value_at_percentile(50) == 999
+    assert merged == first + second
+    assert first.total == 1000
+
+    with pytest.raises(ValueError):
+        first.merge(hdr.HDRHistogram(sub_bucket_bits=6))
+    with pytest.raises(ValueError):
+        first.merge(hdr.HDRHistogram(unit="us"))
+    assert hdr.merge([]) is None
+
+
+def test_encode_decode():
+    histogram = hdr.HDRHistogram(sub_bucket_bits=6, unit="us")
+    histogram.record(3, count=2).record(1000).record(70000)
+    encoded = histogram.encode()
+
+    assert encoded["counts"] == [
+        3,
+        2,
+        hdr.bucket_index(1000, 6) - 3,
+        1,
+        hdr.bucket_index(70000, 6) - hdr.bucket_index(1000, 6),
+        1,
+    ]
+    decoded = hdr.HDRHistogram.decode(encoded)
+    assert decoded == histogram
+    assert decoded.mean == pytest.approx((6 + 1000 + 70000) / 4.0)
+
+
+def test_empty_and_invalid():
+    histogram = hdr.HDRHistogram()
+    assert histogram.value_at_percentile(50) is None
+    assert histogram.percentiles() == []
+    assert histogram.mean is None
+    assert hdr.HDRHistogram.decode(histogram.encode()) == histogram
+
+    with pytest.raises(ValueError):
+        histogram.record(-1)
+    with pytest.raises(ValueError):
+        histogram.record_values([1, 2**53])
+    with pytest.raises(ValueError):
+        hdr.HDRHistogram(sub_bucket_bits=1)
+
+
+def test_percentile_ticks():
+    assert hdr.percentile_ticks(0) == [100.0]
+    assert hdr.percentile_ticks(8) == [0.0, 50.0, 75.0, 87.5, 100.0]
@@ -0,0 +1,76 @@
+"""Unit tests for the jsonstream module."""
+
+import io
+import json
+import random
+
+import pytest
+
+from testplan.common.utils.jsonstream import JSONStreamReader
+
+
+def random_value(depth=0):
+    choice = random.random()
+    if depth > 4 or choice < 0.3:
+        return random.choice(
+            [
+                0,
+                -12,
+                2**60,
+                -2.5e-3,
+                1.5e10,
+                True,
+                False,
+                None,
+                "",
+                'quote " backslash \\ unicode é中',
+                "x" * random.randint(0, 300),
+            ]
+        )
+    if choice < 0.65:
+        return {
+            "key{}".format(index): random_value(depth + 1)
+            for index in range(random.randint(0, 5))
+        }
+    return [random_value(depth + 1) for _ in range(random.randint(0, 5))]
+
+
+@pytest.mark.parametrize("chunk_size", (1, 2, 7, 1 << 16))
+def test_read_value(chunk_size):
+    random.seed(chunk_size)
+    for index in range(100):
+        value = random_value()
+        text = json.dumps(
+            value, indent=2 if index % 2 else None, ensure_ascii=index % 3
+        )
+        reader = JSONStreamReader(io.StringIO(text), chunk_size=chunk_size)
+        assert reader.read_value() == value
+        assert reader.peek() == ""
+
+        reader = JSONStreamReader(io.StringIO(text), chunk_size=chunk_size)
+        reader.skip_value()
+        assert reader.peek() == ""
+
+
+def test_iterate():
+    text = json.dumps(
+        {"name": "plan", "big": list(range(1000)), "entries": [{"a": 1}, 2]}
+    )
+    reader = JSONStreamReader(io.StringIO(text), chunk_size=16)
+    result = {}
+    for key in reader.iter_object():
+        if key == "entries":
+            result[key] = [reader.read_value() for _ in reader.iter_array()]
+        elif key == "name":
+            result[key] = reader.read_value()
+        else:
+            reader.skip_value()
+    assert result == {"name": "plan", "entries": [{"a": 1}, 2]}
+
+
+@pytest.mark.parametrize(
+    "text", ("{", "[1,", "[1 2]", '{"a" 1}', '{"a": 1,}', "tru", "nope", '"ab')
+)
+def test_invalid(text):
+    with pytest.raises(ValueError):
+        JSONStreamReader(io.StringIO(text), chunk_size=2).read_value()
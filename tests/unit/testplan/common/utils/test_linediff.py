@@ -0,0 +1,136 @@
+import os
+import random
+
+import pytest
+
+from testplan.common.utils import difflib, linediff
+
+MATCHERS = [
+    pytest.param(linediff.python_matching_blocks, id="python"),
+    pytest.param(
+        linediff.matching_blocks,
+        id="native",
+        marks=pytest.mark.skipif(
+            linediff._linediff is None, reason="C++ extension not built"
+        ),
+    ),
+]
+
+
+def check_blocks(a, b, blocks):
+    """Blocks are increasing, maximal and made of equal lines."""
+    assert blocks[-1] == (len(a), len(b), 0)
+    end_i = end_j = -1
+    for i, j, size in blocks[:-1]:
+        assert size > 0
+        assert (i, j) != (end_i, end_j)
+        assert i >= end_i and j >= end_j
+        assert a[i : i + size] == b[j : j + size]
+        end_i, end_j = i + size, j + size
+
+
+def lcs_length(a, b):
+    lengths = [[0] * (len(b) + 1) for _ in range(len(a) + 1)]
+    for i, line in enumerate(a):
+        for j, other in enumerate(b):
+            lengths[i + 1][j + 1] = (
+                lengths[i][j] + 1
+                if line == other
+                else max(lengths[i][j + 1], lengths[i + 1][j])
+            )
+    return lengths[-1][-1]
+
+
+@pytest.mark.parametrize("match", MATCHERS)
+def test_matching_blocks(match):
+    assert match([], []) == [(0, 0, 0)]
+    assert match([0, 1], []) == [(2, 0, 0)]
+    assert match([0, 1, 2], [0, 1, 2]) == [(0, 0, 3), (3, 3, 0)]
+    # Common head, then the line occurring once splits the texts
+    assert match([1, 1, 2, 1, 1], [1, 2, 1, 3]) == [
+        (0, 0, 1),
+        (2, 1, 2),
+        (5, 4, 0),
+    ]
+    # Junk lines never start a match
+    assert match([0, -1, 1], [2, -1, 3]) == [(3, 3, 0)]
+    assert match([0, -1, 1], [0, -1, 3]) == [(0, 0, 2), (3, 3, 0)]
+
+
+@pytest.mark.parametrize("match", MATCHERS)
+def test_random(match):
+    rng = random.Random(0)
+    for _ in range(500):
+        ids = rng.randint(1, 10)
+        a = [rng.randint(0, ids) for _ in range(rng.randint(0, 30))]
+        b = [rng.randint(0, ids) for _ in range(rng.randint(0, 30))]
+        blocks = match(a, b)
+        check_blocks(a, b, blocks)
+        assert blocks == linediff.python_matching_blocks(a, b)
+
+
+@pytest.mark.parametrize("match", MATCHERS)
+def test_myers(match):
+    """Lines repeated too often to split the texts, matched by Myers."""
+    rng = random.Random(1)
+    for _ in range(20):
+        a = [rng.randint(0, 2) for _ in range(300)]
+        b = [rng.randint(0, 2) for _ in range(300)]
+        blocks = match(a, b)
+        check_blocks(a, b, blocks)
+        assert sum(size for _, _, size in blocks) == lcs_length(a, b)
+
+
+def test_line_ids():
+    a = ["abc\n", " a  b\tc \r\n", "\n"]
+    b = ["a b c\n", "abc\n", "  \n"]
+    assert linediff.line_ids(a, b) == ([0, 1, 2], [3, 0, 4])
+    assert linediff.line_ids(a, b, ignore_space_change=True) == (
+        [0, 1, 2],
+        [3, 0, 2],
+    )
+    assert linediff.line_ids(a, b, ignore_whitespaces=True) == (
+        [0, 0, 1],
+        [0, 0, 1],
+    )
+    ids_a, ids_b = linediff.line_ids(a, b, linejunk=difflib.IS_LINE_JUNK)
+    assert ids_a[2] < 0 and ids_b[2] < 0 and ids_a[:2] == [0, 1]
+
+
+def test_diff():
+    first = ["1\n", "2\n", "\n", "3\n", "4\n", "5\n"]
+    second = ["1\n", "two\n", "\n", "3\n", "5\n", "6\n"]
+    assert list(difflib.diff(first, second)) == [
+        "2c2" + os.linesep,
+        "< 2\n",
+        "---" + os.linesep,
+        "> two\n",
+        "5d4" + os.linesep,
+        "< 4\n",
+        "6a6" + os.linesep,
+        "> 6\n",
+    ]
+    unified = list(difflib.diff(first, second, unified=1))
+    assert unified[2:] == [
+        "@@ -1,6 +1,6 @@" + os.linesep,
+        " 1\n",
+        "-2\n",
+        "+two\n",
+        " \n",
+        " 3\n",
+        "-4\n",
+        " 5\n",
+        "+6\n",
+    ]
+
+
+def test_diff_large():
+    rng = random.Random(2)
+    first = ["line {}\n".format(rng.randint(0, 10**9)) for _ in range(20000)]
+    second = list(first)
+    for index in sorted(rng.sample(range(len(second)), 50), reverse=True):
+        second[index] = "changed\n"
+    delta = list(difflib.diff(first, second))
+    assert sum(line.startswith("> ") for line in delta) == 50
+    spaced = [line.replace(" ", "  ") for line in first]
+    assert not list(difflib.diff(first, spaced, ignore_space_change=True))
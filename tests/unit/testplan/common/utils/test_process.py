@@ -0,0 +1,40 @@
+"""Unit tests for the process utilities."""
+
+import os
+import subprocess
+import sys
+
+import pytest
+
+from testplan.common.utils.process import wait_with_usage
+
+pytestmark = pytest.mark.skipif(
+    not hasattr(os, "wait4"), reason="Resource usage requires wait4"
+)
+
+
+def test_wait_with_usage():
+    """Exit code and peak memory of a process allocating 64MB."""
+    proc = subprocess.Popen(
+        [
+            sys.executable,
+            "-c",
+            "import sys, time; data = bytearray(64 * 2**20); time.sleep(0.2);"
+            " sys.exit(3)",
+        ]
+    )
+    retcode, usage = wait_with_usage(proc)
+
+    assert retcode == proc.returncode == proc.wait() == 3
+    assert usage["max_rss"] >= 64 * 2**20
+    assert usage["user_time"] + usage["system_time"] > 0
+
+
+def test_wait_with_usage_killed():
+    """Killed processes return the negative signal number."""
+    proc = subprocess.Popen(["sleep", "10"])
+    proc.kill()
+    retcode, usage = wait_with_usage(proc)
+
+    assert retcode == proc.returncode == -9
+    assert usage is not None
@@ -30,3 +30,21 @@ class TestTableEntry(object):
     )
     def test_validation_success(self, value):
         TableEntry(value)
+
+    @pytest.mark.parametrize(
+        "value",
+        (
+            [["foo", "bar"], [1, 2], [3, 4]],
+            [{"foo": 1, "bar": 2}, {"foo": 3, "bar": 4}],
+        ),
+    )
+    def test_as_columns(self, value):
+        table = TableEntry(value)
+        assert table.as_columns() == {"foo": [1, 3], "bar": [2, 4]}
+        assert list(table.as_columns()) == ["foo", "bar"]
+        assert table.as_columns(["bar"]) == {"bar": [2, 4]}
+        with pytest.raises(KeyError):
+            table.as_columns(["baz"])
+        assert table.as_columns(["baz"], placeholder=None) == {
+            "baz": [None, None]
+        }
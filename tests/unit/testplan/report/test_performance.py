@@ -0,0 +1,178 @@
+"""Unit tests for the run over run performance comparison."""
+
+import datetime
+import json
+import os
+
+import pytest
+
+from testplan.common.utils.timing import Interval
+from testplan.exporters.testing import JSONExporter
+from testplan.report import (
+    ReportCategories,
+    TestCaseReport,
+    TestGroupReport,
+    TestReport,
+)
+from testplan.report.testing import performance
+from testplan.report.testing.schemas import TestReportSchema
+from testplan.testing.multitest.entries import base
+from testplan.testing.multitest.entries.schemas.base import registry
+
+START = datetime.datetime(2026, 10, 18, 9, 0, 0)
+
+
+def interval(seconds, offset=0):
+    start = START + datetime.timedelta(seconds=offset)
+    return Interval(start, start + datetime.timedelta(seconds=seconds))
+
+
+def make_report(durations, latency, max_rss):
+    """Report of a GTest binary and a MultiTest with the given timings."""
+    report = TestReport(name="plan", uid="plan")
+    report.timer["run"] = interval(sum(durations.values()) + 1)
+
+    binary = TestGroupReport(
+        name="Binary", uid="Binary", category=ReportCategories.GTEST
+    )
+    binary.timer["run"] = interval(sum(durations.values()))
+    binary.meta["resource_usage"] = {
+        "max_rss": max_rss,
+        "user_time": 1.0,
+        "system_time": 0.5,
+    }
+    suite = TestGroupReport(
+        name="Suite", uid="Suite", category=ReportCategories.GTEST_SUITE
+    )
+    for name, duration in sorted(durations.items()):
+        testcase = TestCaseReport(name=name, uid=name)
+        testcase.timer["run"] = interval(duration)
+        suite.append(testcase)
+    binary.append(suite)
+
+    multitest = TestGroupReport(
+        name="MTest", uid="MTest", category=ReportCategories.MULTITEST
+    )
+    multitest.timer["run"] = interval(1)
+    mt_suite = TestGroupReport(
+        name="MSuite", uid="MSuite", category=ReportCategories.TESTSUITE
+    )
+    testcase = TestCaseReport(name="test_latency", uid="test_latency")
+    testcase.timer["run"] = interval(0.5)
+    group = base.Group(
+        [base.Histogram(latency, description="Insert"), base.Log("text")],
+        description="group",
+    )
+    testcase.extend(
+        [registry.serialize(base.Log("before")), registry.serialize(group)]
+    )
+    mt_suite.append(testcase)
+    multitest.append(mt_suite)
+
+    report.append(binary)
+    report.append(multitest)
+    return report
+
+
+def write_json(report, path):
+    with open(path, "w") as json_file:
+        json.dump(TestReportSchema(strict=True).dump(report).data, json_file)
+    return path
+
+
+@pytest.fixture
+def reports():
+    baseline = make_report(
+        {"fast": 0.01, "slow": 1.0, "stable": 0.2},
+        [1000] * 99 + [3000],
+        100 << 20,
+    )
+    current = make_report(
+        {"fast": 2.0, "slow": 1.0, "stable": 0.2, "added": 0.3},
+        [1000] * 50 + [3000] * 50,
+        200 << 20,
+    )
+    return baseline, current
+
+
+def test_summary_from_json(tmpdir, reports):
+    """Summaries of streamed JSON reports match those of report objects."""
+    report = reports[1]
+    path = write_json(report, str(tmpdir.join("report.json")))
+    from_json = performance.PerformanceSummary.from_json(path)
+    from_report = performance.PerformanceSummary.from_report(report)
+
+    for summary in (from_json, from_report):
+        assert summary.name == "plan"
+        assert summary.testcases[("Binary", "Suite", "fast")] == 2.0
+        assert summary.testcases[("MTest", "MSuite", "test_latency")] == 0.5
+        assert summary.instances["Binary"]["max_rss"] == 200 << 20
+        assert summary.instances["Binary"]["duration"] == pytest.approx(3.5)
+        benchmark = summary.benchmarks[
+            ("MTest", "MSuite", "test_latency", "Insert")
+        ]
+        assert benchmark["unit"] == "s"
+        assert benchmark["count"] == 100
+        assert benchmark["p99"] == pytest.approx(3e-6, rel=0.01)
+
+    assert from_json.testcases == from_report.testcases
+    assert from_json.instances == from_report.instances
+    assert from_json.benchmarks == from_report.benchmarks
+    assert from_json.run == from_report.run
+
+
+def test_summary_from_split_json(tmpdir, reports):
+    """Split JSON reports are read from their structure and assertions."""
+    path = str(tmpdir.join("split", "report.json"))
+    JSONExporter(json_path=path, split_json_report=True).export(reports[1])
+
+    summary = performance.PerformanceSummary.from_json(path)
+    expected = performance.PerformanceSummary.from_report(reports[1])
+    assert summary.testcases == expected.testcases
+    assert summary.benchmarks == expected.benchmarks
+
+
+def test_compare(tmpdir, reports):
+    baseline = write_json(reports[0], str(tmpdir.join("baseline.json")))
+    current = write_json(reports[1], str(tmpdir.join("current.json")))
+    comparison = performance.compare(baseline, current, threshold=0.1, top=2)
+
+    # Ranked by absolute change, unchanged testcases are not listed
+    assert [change.key for change in comparison.testcases] == [
+        ("Binary", "Suite", "fast")
+    ]
+    assert comparison.testcases[0].ratio == pytest.approx(199)
+    assert comparison.instances[0].key == ("Binary", "duration")
+    assert comparison.added == [("Binary", "Suite", "added")]
+    assert comparison.new_slowest == [(("Binary", "Suite", "fast"), 2.0, 0.01)]
+
+    resources = {change.key: change for change in comparison.resources}
+    assert resources[("Binary", "max_rss")].ratio == pytest.approx(1)
+    assert ("Binary", "user_time") not in resources
+
+    benchmarks = {change.key[-1]: change for change in comparison.benchmarks}
+    assert "p50" not in benchmarks
+    assert benchmarks["p99"].ratio == pytest.approx(2, rel=0.02)
+
+    regressions = {change.key for change in comparison.regressions}
+    assert ("Binary", "Suite", "fast") in regressions
+    assert ("Binary", "max_rss") in regressions
+
+    text = comparison.format()
+    assert "Binary / Suite / fast: 0.01s -> 2s (+19900.0%)" in text
+    assert "New among the 2 slowest testcases:" in text
+
+    data = comparison.to_dict()
+    assert json.loads(json.dumps(data)) == data
+    assert data["regressions"] == len(comparison.regressions)
+
+
+def test_main(tmpdir, reports, capsys):
+    baseline = write_json(reports[0], str(tmpdir.join("baseline.json")))
+    current = write_json(reports[1], str(tmpdir.join("current.json")))
+    json_path = str(tmpdir.join("comparison.json"))
+
+    assert performance.main([baseline, current, "--json", json_path]) == 1
+    assert "Testcase durations (1 changed):" in capsys.readouterr().out
+    assert os.path.exists(json_path)
+    assert performance.main([baseline, baseline]) == 0
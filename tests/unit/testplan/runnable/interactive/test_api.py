@@ -6,6 +6,7 @@ import pytest
 
 from testplan.runnable.interactive import http
 from testplan.runnable.interactive import base
+from testplan.runnable.interactive.versions import ReportVersions
 from testplan import report
 from testplan.common import entity
 
@@ -613,6 +614,106 @@ class TestSingleAttachment(object):
         assert rsp.status_code == 405
 
 
+class TestReportChanges(object):
+    """Test the nodes of the report returned by the ReportChanges resource."""
+
+    def test_changes(self, api_env):
+        """Test that the changed nodes are returned, oldest change first."""
+        _, ihandler = api_env
+        versions = ihandler.report_versions
+        testcase_uids = ["MTest1", "MT1Suite1", "MT1S1TC1"]
+        assert http.report_changes(ihandler, versions.tag(0)) == {
+            "version": versions.tag(0),
+            "changes": [],
+        }
+
+        with ihandler.report_mutex:
+            ihandler.report_changed(testcase_uids)
+        changes = http.report_changes(ihandler, versions.tag(0))
+        assert changes["version"] == versions.tag(1)
+        assert [change["uids"] for change in changes["changes"]] == [
+            testcase_uids[:depth] for depth in range(4)
+        ]
+        compare_json(
+            changes["changes"][0]["data"], ihandler.report.shallow_serialize()
+        )
+        testcase = ihandler.report["MTest1"]["MT1Suite1"]["MT1S1TC1"]
+        compare_json(
+            changes["changes"][-1]["data"], serialize_testcase(testcase)
+        )
+        assert http.report_changes(ihandler, versions.tag(1)) == {
+            "version": versions.tag(1),
+            "changes": [],
+        }
+
+    def test_reset(self, api_env):
+        """Test that clients are told to read the report again."""
+        _, ihandler = api_env
+        versions = ihandler.report_versions
+        with ihandler.report_mutex:
+            ihandler.report_changed(["MTest1"], recursive=True)
+            ihandler.report_changed(["Removed"])
+
+        changes = http.report_changes(ihandler, versions.tag(1))
+        assert changes["changes"][-1] == {
+            "uids": ["Removed"],
+            "version": versions.tag(2),
+            "data": None,
+        }
+        assert http.report_changes(ihandler, versions.tag(0), limit=5) == {
+            "version": versions.tag(2),
+            "reset": True,
+        }
+
+        versions.reset()
+        assert http.report_changes(ihandler, versions.tag(2)) == {
+            "version": versions.tag(3),
+            "reset": True,
+        }
+
+        # Version of the report of another handler, e.g. before a restart
+        assert http.report_changes(ihandler, ReportVersions().tag(3)) == {
+            "version": versions.tag(3),
+            "reset": True,
+        }
+
+
+class TestConditionalGet(object):
+    """Test the entity tags of the nodes of the report."""
+
+    def test_not_modified(self, api_env):
+        """Test that nodes are not serialized again until they change."""
+        client, ihandler = api_env
+        app = client.application
+        uids = ["MTest1", "MT1Suite1"]
+        serialize = mock.MagicMock(return_value={"uid": "MT1Suite1"})
+
+        with app.test_request_context():
+            data, code, headers = http._conditional_get(
+                ihandler, uids, serialize
+            )
+        assert (data, code) == ({"uid": "MT1Suite1"}, 200)
+        etag = headers["ETag"]
+
+        with app.test_request_context(headers={"If-None-Match": etag}):
+            assert http._conditional_get(ihandler, uids, serialize) == (
+                None,
+                304,
+                {"ETag": etag},
+            )
+        assert serialize.call_count == 1
+
+        # A change of a testcase changes its suite
+        with ihandler.report_mutex:
+            ihandler.report_changed(uids + ["MT1S1TC1"])
+        with app.test_request_context(headers={"If-None-Match": etag}):
+            _, code, headers = http._conditional_get(
+                ihandler, uids, serialize
+            )
+        assert code == 200
+        assert headers["ETag"] != etag
+
+
 def compare_json(actual, expected):
     """
     Compare the actual and expected JSON returned from the API. Since the
@@ -0,0 +1,115 @@
+"""Unit tests for the change counters of the interactive report."""
+
+from testplan import report
+from testplan.runnable.interactive.versions import ReportVersions
+
+
+def make_report():
+    """Report with a test of a suite of two testcases."""
+    return report.TestReport(
+        name="plan",
+        uid="plan",
+        entries=[
+            report.TestGroupReport(
+                name="MTest",
+                uid="MTest",
+                category=report.ReportCategories.MULTITEST,
+                entries=[
+                    report.TestGroupReport(
+                        name="Suite",
+                        uid="Suite",
+                        category=report.ReportCategories.TESTSUITE,
+                        entries=[
+                            report.TestCaseReport(name="case1", uid="case1"),
+                            report.TestCaseReport(name="case2", uid="case2"),
+                        ],
+                    )
+                ],
+            )
+        ],
+    )
+
+
+def test_changed():
+    """A change marks the node and its parents."""
+    versions = ReportVersions()
+    rep = make_report()
+    etag = versions.etag(["MTest", "Suite", "case2"])
+
+    assert versions.changed(rep, ["MTest", "Suite", "case1"]) == 1
+    assert versions.version == 1
+    assert versions.node_version() == 1
+    assert versions.node_version(["MTest"]) == 1
+    assert versions.node_version(["MTest", "Suite", "case1"]) == 1
+    assert versions.node_version(["MTest", "Suite", "case2"]) == 0
+    assert versions.etag(["MTest", "Suite", "case2"]) == etag
+    assert versions.etag(["MTest", "Suite"]) != etag
+
+    # Entity tags of another report never match
+    assert ReportVersions().etag(["MTest", "Suite", "case2"]) != etag
+
+
+def test_changed_recursive():
+    """A recursive change marks the children of the node too."""
+    versions = ReportVersions()
+    rep = make_report()
+    versions.changed(rep, ["MTest", "Suite", "case1"])
+    versions.changed(rep, ["MTest"], recursive=True)
+
+    assert versions.changes_since(versions.tag(0)) == [
+        ((), 2),
+        (("MTest",), 2),
+        (("MTest", "Suite"), 2),
+        (("MTest", "Suite", "case1"), 2),
+        (("MTest", "Suite", "case2"), 2),
+    ]
+    # Node removed from the report
+    assert versions.changed(rep, ["Removed"], recursive=True) == 3
+    assert versions.changes_since(versions.tag(2)) == [
+        ((), 3),
+        (("Removed",), 3),
+    ]
+
+
+def test_changes_since():
+    """Nodes changed since a version are returned in the order of changes."""
+    versions = ReportVersions()
+    rep = make_report()
+    versions.changed(rep, ["MTest", "Suite", "case1"])
+    versions.changed(rep, ["MTest", "Suite", "case2"])
+
+    assert versions.changes_since(versions.tag(1)) == [
+        ((), 2),
+        (("MTest",), 2),
+        (("MTest", "Suite"), 2),
+        (("MTest", "Suite", "case2"), 2),
+    ]
+    assert versions.changes_since(versions.tag(2)) == []
+    assert versions.changes_since(versions.tag(1), limit=3) is None
+    assert len(versions.changes_since(versions.tag(0))) == 5
+    # Versions not of this report
+    assert versions.changes_since(versions.tag(3)) is None
+    assert versions.changes_since(ReportVersions().tag(1)) is None
+    assert versions.changes_since("1") is None
+    assert versions.changes_since(versions.tag() + "x") is None
+
+
+def test_reset():
+    """Clients have to read the report again after a reset."""
+    versions = ReportVersions()
+    rep = make_report()
+    versions.changed(rep, ["MTest"])
+    etag = versions.etag()
+
+    assert versions.reset() == 2
+    assert versions.changes_since(versions.tag(1)) is None
+    assert versions.changes_since(versions.tag(2)) == []
+    assert versions.node_version(["MTest", "Suite"]) == 2
+    assert versions.etag() != etag
+
+    versions.changed(rep, ["MTest", "Suite"])
+    assert versions.changes_since(versions.tag(2)) == [
+        ((), 3),
+        (("MTest",), 3),
+        (("MTest", "Suite"), 3),
+    ]
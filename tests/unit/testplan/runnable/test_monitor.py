@@ -0,0 +1,87 @@
+"""Unit tests for the state of a run kept for its live monitor."""
+
+from testplan.common.utils.events import EventBus
+from testplan.runnable.monitor import RunMonitor, RUNNING, WAITING
+
+
+def test_run_monitor():
+    """State of a run follows the events of a pool and a local runner."""
+    bus = EventBus()
+    monitor = RunMonitor(bus, name="plan")
+    bus.publish(
+        "plan_started",
+        tests={"A": "pool", "B": "pool", "C": "local_runner"},
+    )
+    bus.publish("test_started", test="A", executor="pool", worker="0")
+    bus.publish("test_started", test="B", executor="pool", worker="1")
+    bus.publish("test_started", test="C", executor="local_runner")
+    bus.publish(
+        "testcase_finished",
+        test="C",
+        suite="Suite",
+        testcase="case",
+        status="passed",
+        entries=2,
+    )
+
+    state = monitor.snapshot()
+    assert state["seq"] == 5
+    assert state["plan"]["status"] == RUNNING
+    assert (state["plan"]["tests"], state["plan"]["done"]) == (3, 0)
+    assert state["tests"]["A"]["status"] == RUNNING
+    assert state["tests"]["C"]["testcases"] == 1
+    assert state["executors"]["pool"]["workers"]["1"]["test"] == "B"
+    # Local runners run their tests as a single worker
+    assert state["executors"]["local_runner"]["workers"] == {
+        "local_runner": {
+            "test": "C",
+            "since": state["tests"]["C"]["started"],
+            "done": 0,
+        }
+    }
+
+    counter = {"passed": 1, "failed": 0, "total": 1}
+    bus.publish(
+        "test_finished",
+        test="A",
+        executor="pool",
+        status="passed",
+        counter=counter,
+        utilization=0.5,
+    )
+    # Result of a test already finished, e.g. when the pool is aborted
+    bus.publish(
+        "test_finished",
+        test="A",
+        executor="pool",
+        status="error",
+        counter={},
+        utilization=None,
+    )
+
+    state = monitor.snapshot()
+    assert state["plan"]["done"] == 1
+    assert state["tests"]["A"]["status"] == "passed"
+    assert state["tests"]["A"]["counter"] == counter
+    assert state["executors"]["pool"]["utilization"] == 0.5
+    assert state["executors"]["pool"]["workers"]["0"]["test"] is None
+    assert state["executors"]["pool"]["workers"]["0"]["done"] == 1
+    assert state["executors"]["pool"]["workers"]["1"]["test"] == "B"
+
+
+def test_run_monitor_snapshot():
+    """Snapshots are copies of the state at the time they are taken."""
+    bus = EventBus()
+    monitor = RunMonitor(bus)
+    bus.publish("plan_started", tests={"A": "local_runner"})
+    state = monitor.snapshot()
+
+    bus.publish("test_started", test="A", executor="local_runner")
+    bus.publish(
+        "plan_finished", status="passed", counter={"passed": 1, "total": 1}
+    )
+
+    assert state["tests"]["A"]["status"] == WAITING
+    assert monitor.snapshot()["tests"]["A"]["status"] == RUNNING
+    assert monitor.snapshot()["plan"]["status"] == "passed"
+    assert monitor.snapshot()["seq"] == 3
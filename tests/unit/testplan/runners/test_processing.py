@@ -0,0 +1,132 @@
+import logging
+import os
+import threading
+import time
+
+import pytest
+
+from testplan.runners.processing import ReportProcessor, ReportProcessingError
+
+from pytest_test_filters import skip_on_windows
+
+
+def convert(value):
+    return {"value": value, "pid": os.getpid()}
+
+
+def fail():
+    raise ValueError("Cannot convert")
+
+
+def die():
+    os._exit(1)
+
+
+def wait(processor, futures):
+    deadline = time.time() + 30
+    while not all(future.done() for future in futures):
+        assert time.time() < deadline
+        processor.poll(timeout=0.1)
+
+
+@skip_on_windows(reason="Reports are processed inline on Windows.")
+def test_results():
+    processor = ReportProcessor(workers=2)
+    futures = [processor.submit(convert, index) for index in range(5)]
+    # Nothing runs until polled
+    assert processor.pending == 5
+    assert not any(future.done() for future in futures)
+
+    processor.poll()
+    assert processor.pending == 5
+    wait(processor, futures)
+    assert processor.pending == 0
+
+    results = [future.result() for future in futures]
+    assert [result["value"] for result in results] == list(range(5))
+    assert all(result["pid"] != os.getpid() for result in results)
+
+
+@skip_on_windows(reason="Reports are processed inline on Windows.")
+def test_bounded():
+    processor = ReportProcessor(workers=2)
+    futures = [processor.submit(time.sleep, 0.2) for _ in range(3)]
+    processor.poll()
+    assert len([future for future in futures if future.running()]) == 2
+    processor.shutdown()
+    assert all(future.done() for future in futures)
+
+
+@skip_on_windows(reason="Reports are processed inline on Windows.")
+def test_errors():
+    processor = ReportProcessor(workers=1)
+    failed = processor.submit(fail)
+    died = processor.submit(die)
+    abandoned = processor.submit(convert, 0)
+    wait(processor, [failed, died])
+
+    with pytest.raises(ReportProcessingError, match="Cannot convert"):
+        failed.result()
+    with pytest.raises(ReportProcessingError, match="died"):
+        died.result()
+
+    processor.shutdown(wait=False)
+    assert abandoned.done()
+    assert processor.pending == 0
+
+
+def log_done(logger):
+    logger.info("logged")
+    return True
+
+
+def write(stream, data):
+    stream.write(data)
+    stream.flush()
+
+
+@skip_on_windows(reason="Reports are processed inline on Windows.")
+def test_stream_locked_by_thread():
+    """
+    A thread of the parent writing to a full pipe holds the lock of the
+    stream when the processing process is forked, the process logs to the
+    same stream nonetheless.
+    """
+    read_fd, write_fd = os.pipe()
+    stream = os.fdopen(write_fd, "w")
+    handler = logging.StreamHandler(stream)
+    logger = logging.getLogger("test_processing")
+    logger.propagate = False
+    logger.setLevel(logging.INFO)
+    logger.addHandler(handler)
+    try:
+        blocked = threading.Thread(
+            target=write, args=(stream, "x" * (1 << 20)), daemon=True
+        )
+        blocked.start()
+        time.sleep(0.2)
+
+        processor = ReportProcessor(workers=1)
+        future = processor.submit(log_done, logger)
+        processor.poll()
+        # Drain the pipe once the process has been forked
+        output = bytearray()
+        drain = threading.Thread(
+            target=lambda: [
+                output.extend(chunk)
+                for chunk in iter(lambda: os.read(read_fd, 1 << 16), b"")
+            ],
+            daemon=True,
+        )
+        drain.start()
+        wait(processor, [future])
+        assert future.result() is True
+        blocked.join(timeout=10)
+        stream.flush()
+        deadline = time.time() + 10
+        while b"logged\n" not in output:
+            assert time.time() < deadline
+            time.sleep(0.1)
+    finally:
+        logger.removeHandler(handler)
+        logger.setLevel(logging.NOTSET)
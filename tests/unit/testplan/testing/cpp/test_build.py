@@ -0,0 +1,141 @@
+import os
+import shutil
+
+import pytest
+
+from testplan.testing.cpp import build
+from testplan.testing.cpp.build import CMakeProject, BUILT_TARGET_PATTERN
+
+CMAKE_LISTS = """
+cmake_minimum_required(VERSION 3.1)
+project(BuildTest CXX)
+add_executable(first first.cpp)
+add_executable(second second.cpp)
+add_executable(broken broken.cpp)
+"""
+
+pytestmark = pytest.mark.skipif(
+    shutil.which("cmake") is None or shutil.which("c++") is None,
+    reason="CMake and a C++ compiler are required.",
+)
+
+
+@pytest.fixture
+def source_dir(tmpdir):
+    root = str(tmpdir.mkdir("src"))
+    sources = {
+        "CMakeLists.txt": CMAKE_LISTS,
+        "first.cpp": "int main() { return 0; }\n",
+        "second.cpp": "int main() { return 0; }\n",
+        "broken.cpp": "int main() { return undefined; }\n",
+    }
+    for name, content in sources.items():
+        with open(os.path.join(root, name), "w") as source:
+            source.write(content)
+    return root
+
+
+def test_built_target_pattern():
+    match = BUILT_TARGET_PATTERN.search("[100%] Built target runTests\n")
+    assert match.group(1) == "runTests"
+    assert BUILT_TARGET_PATTERN.search("Linking CXX executable x") is None
+
+
+@pytest.mark.parametrize(
+    "generator,line,target",
+    (
+        ("Unix Makefiles", "[100%] Built target runTests\n", "runTests"),
+        ("Unix Makefiles", "Linking CXX executable runTests\n", None),
+        ("Ninja", "[4/4] Linking CXX executable runTests\n", "runTests"),
+        ("Ninja", "[3/9] Linking CXX executable bin/runTests\n", "runTests"),
+        ("Ninja", "[1/2] Linking CXX static library libapp.a\n", None),
+        ("Ninja", "[1/2] Building CXX object runTests.o\n", None),
+        ("Ninja Multi-Config", "[2/2] Linking CXX executable a.exe", "a"),
+        ("Xcode", "** BUILD SUCCEEDED **\n", None),
+    ),
+)
+def test_built_target(generator, line, target):
+    assert build.built_target(generator, line) == target
+
+
+def test_reports_built_targets():
+    for generator in ("Unix Makefiles", "MinGW Makefiles", "Ninja"):
+        assert build.reports_built_targets(generator)
+    for generator in ("Xcode", "Visual Studio 16 2019", ""):
+        assert not build.reports_built_targets(generator)
+
+
+def test_cached_generator(tmpdir):
+    """The generator of an existing build tree is the one of its cache."""
+    project = CMakeProject(
+        source_dir=str(tmpdir), build_dir=str(tmpdir), generator="Xcode"
+    )
+    assert project._cached_generator() == "Xcode"
+    tmpdir.join("CMakeCache.txt").write(
+        "CMAKE_GENERATOR:INTERNAL=Ninja\nCMAKE_BUILD_TYPE:STRING=\n"
+    )
+    assert project._cached_generator() == "Ninja"
+
+
+def test_batched_build(source_dir):
+    project = CMakeProject(source_dir=source_dir, batch_window=0.2)
+    first, second = project.target("first"), project.target("second")
+
+    first.request()
+    second.build(timeout=300)
+    first.build(timeout=300)
+
+    assert os.path.isfile(first.binary)
+    assert os.path.isfile(second.binary)
+
+    # Both requests fall into the same batch, i.e. a single build invocation
+    with open(project.log_path) as log:
+        content = log.read()
+    assert content.count("Built target first") == 1
+    assert content.count("Built target second") == 1
+    assert content.count("Build files have been written") == 1
+    assert project._build_generator == "Unix Makefiles"
+
+    # Already built targets are not rebuilt within the same run
+    first.build(timeout=1)
+
+
+def test_failed_build(source_dir):
+    project = CMakeProject(source_dir=source_dir, batch_window=0)
+    broken = project.target("broken")
+
+    with pytest.raises(RuntimeError, match="failed with exit code"):
+        broken.build(timeout=300)
+
+    # Other targets of the same project are not affected
+    project.target("first").build(timeout=300)
+
+    # Failed targets are built again when requested again
+    with open(os.path.join(source_dir, "broken.cpp"), "w") as source:
+        source.write("int main() { return 0; }\n")
+    broken.build(timeout=300)
+    assert os.path.isfile(broken.binary)
+
+
+def test_build_error(source_dir, monkeypatch):
+    """Targets are failed rather than left pending if the build raises."""
+
+    def popen(*args, **kwargs):
+        raise OSError("cannot execute cmake")
+
+    monkeypatch.setattr(build, "subprocess_popen", popen)
+    project = CMakeProject(source_dir=source_dir, batch_window=0)
+
+    with pytest.raises(RuntimeError, match="cannot execute cmake"):
+        project.target("first").build(timeout=300)
+
+
+def test_configure_error(source_dir):
+    project = CMakeProject(
+        source_dir=source_dir, batch_window=0, cmake="/no/such/cmake"
+    )
+    target = project.target("first")
+
+    for _ in range(2):
+        with pytest.raises(RuntimeError, match="Configuring .* failed"):
+            target.build(timeout=300)
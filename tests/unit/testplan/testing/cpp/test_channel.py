@@ -0,0 +1,416 @@
+import collections
+import json
+
+import pytest
+
+from testplan.common.utils import hdr
+
+from testplan.testing.cpp import channel
+from testplan.testing.multitest.entries import assertions
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.base import Histogram, TableLog
+
+
+def _mismatch(index, actual, expected):
+    return {
+        "index": index,
+        "actual": actual,
+        "expected": expected,
+        "abs_err": abs(actual - expected),
+        "rel_err": abs(actual - expected) / max(abs(actual), abs(expected)),
+        "ulps": 12,
+    }
+
+
+ARRAY_COMPARE = {
+    "id": "100_1",
+    "type": "array_compare",
+    "actual_expr": "prices",
+    "expected_expr": "golden",
+    "size": 1000,
+    "mismatches": 3,
+    "abs_tol": 1e-9,
+    "rel_tol": 0,
+    "ulps": 0,
+    "worst": 42,
+    "first": [_mismatch(3, 1.5, 1.25), _mismatch(7, 2.0, 2.5)],
+    "worst_entry": _mismatch(42, 10.0, 1.0),
+}
+
+
+def test_read_records(tmpdir):
+    path = str(tmpdir.join("entries.jsonl"))
+    assert channel.read_records(path) == {}
+
+    with open(path, "w") as channel_file:
+        channel_file.write(json.dumps(ARRAY_COMPARE) + "\n")
+        channel_file.write('{"id": "100_2", "type": "array_comp')
+
+    records = channel.read_records(path)
+    assert list(records) == ["100_1"]
+    assert records["100_1"]["worst"] == 42
+
+
+def test_render_raw():
+    records = {"100_1": ARRAY_COMPARE}
+    for content in ("tests.cpp:12\nValue of: x", None):
+        (entry,) = channel.render(
+            records, description="failure", content=content, passed=False
+        )
+        assert isinstance(entry, RawAssertion)
+        assert entry.content == (content or "")
+        assert entry.passed is False
+
+    # Unknown ids are rendered as raw text, marker included
+    (entry,) = channel.render(
+        records, "failure", "tests.cpp:12\n[testplan:entry:1_1]", False
+    )
+    assert entry.content.endswith("[testplan:entry:1_1]")
+
+
+def test_render_array_compare():
+    content = (
+        "tests.cpp:12\nArrays prices and golden are not close: 3 of 1000"
+        " elements differ [testplan:entry:100_1]"
+    )
+    summary, table = channel.render(
+        {"100_1": ARRAY_COMPARE}, "failure", content, False
+    )
+
+    assert isinstance(summary, RawAssertion)
+    assert summary.passed is False
+    assert summary.description == "prices vs golden: 3 of 1000 elements differ"
+    assert "[testplan:entry" not in summary.content
+    assert summary.content.endswith("3 of 1000 elements differ")
+
+    assert isinstance(table, TableLog)
+    assert list(table.columns) == [
+        "Index",
+        "Actual",
+        "Expected",
+        "Abs Error",
+        "Rel Error",
+        "ULPs",
+    ]
+    # First mismatches followed by the worst one
+    assert [row["Index"] for row in table.table] == ["3", "7", "42 (worst)"]
+    assert table.table[0]["Actual"] == "1.5"
+    assert table.table[2]["Abs Error"] == "9"
+
+
+def _test_part(summary, result="nonfatal", message=None):
+    return {
+        "id": "200_1",
+        "type": "test_part",
+        "suite": "SquareRootTest",
+        "test": "PositiveNos",
+        "result": result,
+        "file": "/src/tests.cpp",
+        "line": 12,
+        "summary": summary,
+        "message": summary if message is None else message,
+    }
+
+
+@pytest.mark.parametrize(
+    "summary, entry_cls, description, first, second",
+    (
+        (
+            "Expected equality of these values:\n  squareRoot(36.0)\n"
+            "    Which is: 6\n  4\nSquare root of 36",
+            assertions.Equal,
+            "tests.cpp:12: squareRoot(36.0) == 4 - Square root of 36",
+            "6",
+            "4",
+        ),
+        (
+            'Expected equality of these values:\n  name\n    Which is: "a"\n'
+            '  "b"\n    With diff:\n    @@ -1 +1 @@\n    -a\n    +b\n',
+            assertions.Equal,
+            'tests.cpp:12: name == "b"',
+            '"a"',
+            '"b"',
+        ),
+        (
+            "Expected: (high) < (low), actual: 2 vs 1",
+            assertions.Less,
+            "tests.cpp:12: high < low",
+            "2",
+            "1",
+        ),
+        (
+            "Expected: (size) >= (10), actual: 3 vs 10\nToo small",
+            assertions.GreaterEqual,
+            "tests.cpp:12: size >= 10 - Too small",
+            "3",
+            "10",
+        ),
+        (
+            "The difference between std::sqrt(2.0) and 1.5 is 0.0857, which"
+            " exceeds 0.01, where\nstd::sqrt(2.0) evaluates to 1.4142,\n"
+            "1.5 evaluates to 1.5, and\n0.01 evaluates to 0.01.",
+            assertions.IsClose,
+            "tests.cpp:12: std::sqrt(2.0) ~= 1.5 +- 0.01",
+            1.4142,
+            1.5,
+        ),
+    ),
+)
+def test_gtest_part_typed(summary, entry_cls, description, first, second):
+    (entry,) = channel.gtest_part_entries(_test_part(summary), {})
+
+    assert type(entry) is entry_cls
+    assert entry.description == description
+    assert entry.first == first
+    assert entry.second == second
+    # The verdict is the one of GTest, not the one of the entry
+    assert entry.passed is False
+    assert entry.file_path == "/src/tests.cpp"
+    assert entry.line_no == 12
+
+
+def test_gtest_part_boolean():
+    (entry,) = channel.gtest_part_entries(
+        _test_part("Value of: queue.empty()\n  Actual: true\nExpected: false"),
+        {},
+    )
+    assert isinstance(entry, assertions.IsFalse)
+    assert entry.description == "tests.cpp:12: queue.empty()"
+    assert entry.passed is False
+
+
+def test_gtest_part_raw():
+    (entry,) = channel.gtest_part_entries(
+        _test_part("Failed\nSomething went wrong"), {}
+    )
+    assert isinstance(entry, RawAssertion)
+    assert entry.description == "tests.cpp:12"
+    assert entry.content == "/src/tests.cpp:12\nFailed\nSomething went wrong"
+    assert entry.passed is False
+
+    (entry,) = channel.gtest_part_entries(
+        _test_part("Not ready", result="skip"), {}
+    )
+    assert isinstance(entry, RawAssertion)
+    assert entry.description == "tests.cpp:12: skipped"
+    assert entry.passed is True
+
+
+def test_gtest_part_marker():
+    message = "Arrays are not close [testplan:entry:100_1]"
+    entries = channel.gtest_part_entries(
+        _test_part(message), {"100_1": ARRAY_COMPARE}
+    )
+    assert [type(entry) for entry in entries] == [RawAssertion, TableLog]
+    assert entries[0].passed is False
+
+
+def test_gtest_parts():
+    records = {
+        "1_1": _test_part("a"),
+        "1_2": ARRAY_COMPARE,
+        "1_3": dict(_test_part("b"), test="NegativeNos"),
+        "1_4": _test_part("c"),
+    }
+    parts = channel.gtest_parts(records)
+    assert [
+        part["summary"] for part in parts["SquareRootTest", "PositiveNos"]
+    ] == [
+        "a",
+        "c",
+    ]
+    assert len(parts["SquareRootTest", "NegativeNos"]) == 1
+
+
+LATENCY = {
+    "id": "300_1",
+    "type": "latency",
+    "statement": "book.insert(order)",
+    "suite": "",
+    "test": "OrderBook::testInsert",
+    "attached": True,
+    "passed": True,
+    "iterations": 1000,
+    "warmup": 100,
+    "percentile": 99.0,
+    "limit_ns": 5000.0,
+    "measured_ns": 3200.0,
+    "min_ns": 900.0,
+    "mean_ns": 1500.0,
+    "max_ns": 2500000.0,
+    "percentiles": [
+        {"percentile": 50.0, "ns": 1400.0},
+        {"percentile": 99.9, "ns": 4100.0},
+    ],
+    "histogram": {
+        "sub_bucket_bits": 8,
+        "unit": "ns",
+        "total": 1000,
+        "sum": 1500000,
+        "min": 900,
+        "max": 2500000,
+        "counts": [1024, 990, 1000, 9, 1500, 1],
+    },
+}
+
+
+def test_format_duration():
+    assert channel.format_duration(850) == "850ns"
+    assert channel.format_duration(3200) == "3.20us"
+    assert channel.format_duration(2.5e6) == "2.50ms"
+    assert channel.format_duration(3e9) == "3.00s"
+
+
+def test_attached_latency():
+    records = {
+        "300_1": LATENCY,
+        "300_2": dict(LATENCY, test="OrderBook::testCancel"),
+        "300_3": dict(LATENCY, attached=False),
+    }
+    verdict, percentiles, histogram = channel.attached_entries(
+        records, "OrderBook::testInsert"
+    )
+
+    assert verdict.passed is True
+    assert verdict.description == (
+        "Latency of book.insert(order): p99 3.20us <= 5.00us"
+    )
+    assert verdict.content == "1000 iterations after 100 warmup iterations"
+    assert [row["Percentile"] for row in percentiles.table] == [
+        "min",
+        "mean",
+        "p50",
+        "p99.9",
+        "max",
+    ]
+    assert isinstance(histogram, Histogram)
+    assert histogram.description == "Latency distribution"
+    assert histogram.count == 1000
+    assert (
+        channel.attached_entries(records, "OrderBook::testInsert", "S") == []
+    )
+
+
+def test_render_latency_failure():
+    record = dict(LATENCY, attached=False, passed=False, measured_ns=7100.0)
+    content = (
+        "tests.cpp:20\nLatency of book.insert(order) [testplan:entry:3_1]"
+    )
+    verdict, _, _ = channel.render({"3_1": record}, "failure", content, False)
+    assert verdict.passed is False
+    assert verdict.description.endswith("p99 7.10us > 5.00us")
+    assert verdict.content == "tests.cpp:20\nLatency of book.insert(order)"
+
+
+def test_attached_histogram():
+    histogram = hdr.HDRHistogram().record_values(range(100))
+    record = {
+        "id": "400_1",
+        "type": "histogram",
+        "description": "Order latency",
+        "suite": "OrderBook",
+        "test": "Insert",
+        "attached": True,
+        "histogram": histogram.encode(),
+    }
+    (entry,) = channel.attached_entries(
+        {"400_1": record}, "Insert", "OrderBook"
+    )
+    assert isinstance(entry, Histogram)
+    assert entry.description == "Order latency"
+    assert entry.histogram == histogram.encode()
+
+
+def test_test_intervals():
+    records = {
+        "1_1": {
+            "id": "1_1",
+            "type": "test_time",
+            "suite": "",
+            "test": "Suite::testOne",
+            "start_us": 1760000000123456,
+            "elapsed": 0.25,
+        },
+        "1_2": {"id": "1_2", "type": "raw", "passed": True},
+    }
+    intervals = channel.test_intervals(records)
+    assert list(intervals) == [("", "Suite::testOne")]
+    interval = intervals[("", "Suite::testOne")]
+    assert interval.elapsed == 0.25
+    assert interval.start.microsecond == 123456
+    assert interval.start.tzinfo is not None
+
+
+def test_forked_death_tests():
+    assert channel.forked_death_tests({}) is None
+
+    records = {
+        "1_{}".format(index): {
+            "id": "1_{}".format(index),
+            "type": "forked_death_test",
+            "suite": "Suite",
+            "test": "Dies",
+            "statement": "abort()",
+            "elapsed": 0.01,
+            "saved": 0.5,
+        }
+        for index in range(3)
+    }
+    records["1_3"] = {"id": "1_3", "type": "raw", "passed": True}
+    summary = channel.forked_death_tests(records)
+    assert summary["forked"] == 3
+    assert summary["elapsed"] == pytest.approx(0.03)
+    assert summary["time_saved"] == pytest.approx(1.5)
+
+
+MB = 1024 * 1024
+
+
+def test_memory_growth():
+    records = collections.OrderedDict()
+    for index, (test, start, end) in enumerate(
+        (("Small", 10, 11), ("Leaks", 11, 75), ("Shrinks", 75, 70))
+    ):
+        records["1_{}".format(index)] = {
+            "id": "1_{}".format(index),
+            "type": "test_memory",
+            "suite": "Suite",
+            "test": test,
+            "rss_start": start * MB,
+            "rss_end": end * MB,
+        }
+    records["1_3"] = {"id": "1_3", "type": "raw", "passed": True}
+    records["1_1"].update(heap_start=0, heap_end=64 * MB)
+
+    memory = channel.test_memory(records)
+    assert list(memory) == [
+        ("Suite", "Small"),
+        ("Suite", "Leaks"),
+        ("Suite", "Shrinks"),
+    ]
+    leaks = memory[("Suite", "Leaks")]
+    assert leaks["rss_delta"] == 64 * MB
+    assert leaks["heap_delta"] == 64 * MB
+    assert memory[("Suite", "Small")]["heap_delta"] is None
+
+    assert channel.memory_growth_entries(leaks, None) == []
+    assert channel.memory_growth_entries(leaks, 64 * MB) == []
+    (entry,) = channel.memory_growth_entries(leaks, 16 * MB)
+    assert isinstance(entry, RawAssertion)
+    assert not entry.passed
+    assert entry.content == (
+        "RSS grew by 64.0MB (11.0MB to 75.0MB), above 16.0MB,"
+        " heap grew by 64.0MB"
+    )
+
+    summary = channel.memory_summary(memory, 16 * MB)
+    assert summary["tests"] == 3
+    assert summary["rss_start"] == 10 * MB
+    assert summary["rss_end"] == 70 * MB
+    assert [test["testcase"] for test in summary["largest_growth"]] == [
+        "Suite.Leaks",
+        "Suite.Small",
+    ]
+    assert summary["flagged"] == ["Suite.Leaks"]
+    assert channel.memory_summary(memory, None)["flagged"] == []
+    assert channel.memory_summary({}, None) is None
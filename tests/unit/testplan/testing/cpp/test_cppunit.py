@@ -0,0 +1,42 @@
+import pytest
+
+from testplan.testing.cpp import Cppunit
+
+UNITS = [("Comparison", "testLess"), ("LogicalOp", None)]
+
+
+@pytest.mark.parametrize(
+    "options",
+    (
+        {"listing_flag": "-l"},
+        {"filtering_flag": "-t"},
+        {"filtering_flag": "-t", "listing_flag": "-l", "cppunit_filter": "x"},
+    ),
+)
+def test_units_command_unsupported(options):
+    """Testcases are not selected without filtering or listing flags."""
+    cppunit = Cppunit(name="My Cppunit", binary="runTests", **options)
+    selection = type("Selection", (), {"suites": lambda self: []})()
+    assert cppunit.test_command_sample(selection) is None
+    assert cppunit.test_command_order(["runTests"], UNITS, 1) is None
+
+
+def test_units_command():
+    cppunit = Cppunit(
+        name="My Cppunit",
+        binary="runTests",
+        filtering_flag="-t",
+        listing_flag="-l",
+        output_path="report.xml",
+    )
+    assert cppunit._units_command("Ordering", UNITS) == [
+        "runTests",
+        "-t",
+        "Comparison::testLess",
+        "-t",
+        "LogicalOp",
+        "-y",
+        "report.xml",
+    ]
+    too_many = [("Suite", "test{}".format(i)) for i in range(10000)]
+    assert cppunit._units_command("Ordering", too_many) is None
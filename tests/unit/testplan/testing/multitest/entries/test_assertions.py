@@ -7,6 +7,8 @@ import traceback
 
 import pytest
 
+from testplan.common.utils import comparison
+from testplan.common.utils.testing import FixMessage
 from testplan.testing.multitest.entries import assertions
 
 
@@ -1373,6 +1375,15 @@ TABLEMATCH_FAIL_PARAMS = [
 ]
 
 
+@pytest.fixture(params=["numpy", "python"])
+def table_compare(request, monkeypatch):
+    """Compare tables column by column with numpy, or row by row without."""
+    if request.param == "python":
+        monkeypatch.setattr(assertions, "numpy", None)
+    return request.param
+
+
+@pytest.mark.usefixtures("table_compare")
 class TestTableMatch(object):
     @pytest.mark.parametrize(
         GET_COMPARISON_COLUMNS_PARAM_NAMES, GET_COMPARISON_COLUMNS_PARAMS
@@ -1543,6 +1554,62 @@ class TestTableMatch(object):
             expected_result=False,
         )
 
+    def test_report_pass_limit(self):
+        table = [["name", "age"]] + [
+            ["name{}".format(idx), idx] for idx in range(1000)
+        ]
+        expected_table = [list(row) for row in table]
+        expected_table[500][1] = comparison.Greater(500)
+        expected_table[800][1] = -1
+
+        assertion = assertions.TableMatch(
+            table=table, expected_table=expected_table, report_pass_limit=3
+        )
+        assert not assertion
+        assert [row.idx for row in assertion.data] == [0, 1, 2, 499, 799]
+        assert assertion.data[3].diff == {"age": expected_table[500][1]}
+        assert assertion.data[4].diff == {"age": -1}
+        assert assertion.message == "995 passing rows not reported."
+
+        assertion = assertions.TableMatch(
+            table=table,
+            expected_table=expected_table,
+            report_pass_limit=3,
+            fail_limit=1,
+        )
+        assert [row.idx for row in assertion.data] == [0, 1, 2, 499]
+        assert assertion.message == "496 passing rows not reported."
+
+    def test_fail_limit_comparators(self):
+        """Comparators are not called past the failure limit."""
+        called = []
+
+        def even(value):
+            called.append(value)
+            return value % 2 == 0
+
+        table = [["idx", "value"]] + [[idx, idx] for idx in range(100)]
+        expected_table = [["idx", "value"]] + [
+            [idx if idx != 1 else -1, even] for idx in range(100)
+        ]
+
+        assertion = assertions.TableMatch(
+            table=table, expected_table=expected_table, fail_limit=2
+        )
+        assert not assertion
+        # Row 1 fails on both columns, row 3 on the comparator
+        assert [row.idx for row in assertion.data] == [0, 1, 2, 3]
+        assert called == [0, 1, 2, 3]
+        assert assertion.table[3] == {"idx": 3, "value": 3}
+        assert assertion.table is assertion.table
+
+        del called[:]
+        assertion = assertions.TableMatch(
+            table=table, expected_table=expected_table
+        )
+        assert len(assertion.data) == 100
+        assert called == list(range(100))
+
 
 TABLEDIFF_COLUMN_NAMES = TABLEMATCH_COLUMN_NAMES
 
@@ -1551,6 +1618,7 @@ TABLEDIFF_PASS_PARAMS = TABLEMATCH_PASS_PARAMS
 TABLEDIFF_FAIL_PARAMS = TABLEMATCH_FAIL_PARAMS
 
 
+@pytest.mark.usefixtures("table_compare")
 class TestTableDiff(object):
     """
     Class `TableDiff` inherits class `TableMatch` and they work in
@@ -1754,3 +1822,125 @@ def test_dict_check(dictionary, has_keys, absent_keys, expected):
     )
 
     assert bool(assertion) is expected
+
+
+class TestDictMatchBulk(object):
+    @staticmethod
+    def orders():
+        for idx in range(20):
+            yield {
+                "id": idx,
+                "side": "BUY" if idx % 2 else "SELL",
+                "qty": idx % 5,
+                "price": 10 if idx % 7 else -1,
+            }
+
+    templates = {
+        "BUY": {
+            "id": comparison.Greater(-1),
+            "side": "BUY",
+            "qty": comparison.Greater(0),
+            "price": comparison.Greater(0),
+        },
+        "SELL": {
+            "id": comparison.Greater(-1),
+            "side": "SELL",
+            "qty": comparison.Greater(0),
+            "price": comparison.Greater(0),
+        },
+    }
+
+    def test_counts(self):
+        assertion = assertions.DictMatchBulk(
+            self.orders(), self.templates, template_key="side", num_failing=1
+        )
+        assert not assertion
+        assert assertion.num_values == 20
+        buy, sell = assertion.templates
+        for template, side in ((buy, "BUY"), (sell, "SELL")):
+            values = [
+                value for value in self.orders() if value["side"] == side
+            ]
+            failing = [
+                value
+                for value in values
+                if value["qty"] == 0 or value["price"] < 0
+            ]
+            assert template["name"] == side
+            assert template["total"] == len(values)
+            assert template["passed"] == len(values) - len(failing)
+            assert dict(template["mismatches"]) == {
+                "qty": sum(value["qty"] == 0 for value in failing),
+                "price": sum(value["price"] < 0 for value in failing),
+            }
+            assert sum(group["total"] for group in template["failures"]) == (
+                len(failing)
+            )
+            for group in template["failures"]:
+                (sample,) = group["samples"]
+                failed = [
+                    row[1]
+                    for row in sample["comparison"]
+                    if row[2] == "Failed"
+                ]
+                assert failed == group["keys"]
+        assert assertion.num_passed == buy["passed"] + sell["passed"]
+        assert assertion.unmatched == {"total": 0, "samples": []}
+        assert [row["Template"] for row in assertion.table] == ["BUY", "SELL"]
+
+    def test_template_selection(self):
+        values = [{"side": "BUY"}, {"side": "SELL"}, {"side": "HOLD"}]
+        templates = {"BUY": {"side": "BUY"}, "SELL": {"side": "SELL"}}
+        assertion = assertions.DictMatchBulk(values[:2], templates)
+        assert assertion
+        assert [t["passed"] for t in assertion.templates] == [1, 1]
+
+        assertion = assertions.DictMatchBulk(
+            values, templates, template_key=lambda value: value["side"]
+        )
+        assert not assertion
+        assert assertion.unmatched == {
+            "total": 1,
+            "samples": [{"index": 2, "name": "HOLD"}],
+        }
+
+        # Without template key, matched against the closest template
+        assertion = assertions.DictMatchBulk(values, templates)
+        assert assertion.unmatched["total"] == 0
+        assert assertion.templates[0]["total"] == 2
+
+    def test_limits(self):
+        values = ({"a": idx % 4, "b": idx % 3} for idx in range(100))
+        assertion = assertions.DictMatchBulk(
+            values,
+            {"zero": {"a": 0, "b": 0}},
+            num_failing=2,
+            key_combs_limit=2,
+        )
+        (template,) = assertion.templates
+        assert len(template["failures"]) == 2
+        for group in template["failures"]:
+            assert len(group["samples"]) == 2
+        assert template["other_failures"] + sum(
+            group["total"] for group in template["failures"]
+        ) == (template["total"] - template["passed"])
+
+    def test_empty(self):
+        assert not assertions.DictMatchBulk([], self.templates)
+
+    def test_fix_match_bulk(self):
+        typed = FixMessage({35: "D", 38: 5}, typed_values=True)
+        untyped = FixMessage({35: "D", 38: "5"}, typed_values=False)
+        template = FixMessage({35: "D", 38: 5}, typed_values=True)
+
+        assertion = assertions.FixMatchBulk(
+            [typed, untyped], {"D": template}, template_tag=35
+        )
+        assert assertion
+        assertion = assertions.FixMatchBulk(
+            [FixMessage({35: "D", 38: "5"}, typed_values=True)],
+            {"D": comparison.ComparisonPlan(template)},
+            template_tag=35,
+        )
+        assert not assertion
+        assert assertion.templates[0]["mismatches"] == [[38, 1]]
@@ -0,0 +1,86 @@
+"""
+Unit tests for the serialization of entries.
+"""
+
+import copy
+import pickle
+
+from testplan.common.serialization.schemas import LazySerialized
+from testplan.report import Status, TestCaseReport
+from testplan.report.testing.schemas import TestCaseReportSchema
+from testplan.testing.multitest.entries import assertions, base
+from testplan.testing.multitest.entries.schemas.base import registry
+
+
+def make_entries():
+    return [
+        assertions.Equal(1, 1),
+        assertions.RawAssertion(
+            description="failure", content="1 != 2", passed=False
+        ),
+        base.Group(
+            entries=[assertions.Less(1, 2), base.Group([assertions.IsTrue(1)])]
+        ),
+        base.Log("message", description="log"),
+    ]
+
+
+def test_serialize_reuses_schemas():
+    """Entries, nested ones too, serialize as with a new schema."""
+    for entry in make_entries():
+        expected = registry[entry](strict=True).dump(entry).data
+        assert registry.serialize(entry) == expected
+        assert registry.serialize(entry) == expected
+
+    group = registry.serialize(make_entries()[2])
+    assert group["passed"] is True
+    assert group["entries"][1]["type"] == "Group"
+    assert group["entries"][1]["entries"][0]["type"] == "IsTrue"
+
+
+def test_serialize_lazily():
+    """Lazily serialized entries equal their eager serialization."""
+    for entry in make_entries():
+        lazy = registry.serialize_lazily(entry)
+        assert lazy["type"] == entry.__class__.__name__
+        assert lazy._data is None
+        if isinstance(entry, base.Group) or entry.meta_type == "assertion":
+            assert lazy["passed"] is bool(entry.passed)
+            assert lazy._data is None
+        else:
+            assert "passed" not in lazy
+
+        assert lazy == registry.serialize(entry)
+        assert lazy._obj is None
+
+        for other in (
+            copy.copy(lazy),
+            copy.deepcopy(lazy),
+            pickle.loads(pickle.dumps(lazy)),
+        ):
+            assert type(other) is dict
+            assert other == lazy
+
+
+def test_lazy_testcase_report():
+    """Status of a testcase does not serialize its entries."""
+    report = TestCaseReport(name="testcase")
+    entries = [registry.serialize_lazily(e) for e in make_entries()]
+    for entry in entries:
+        report.append(entry)
+
+    assert report.status == Status.FAILED
+    assert all(entry._data is None for entry in entries)
+
+    data = TestCaseReportSchema(strict=True).dump(report).data
+    assert [entry["type"] for entry in data["entries"]] == [
+        "Equal",
+        "RawAssertion",
+        "Group",
+        "Log",
+    ]
+    assert all(isinstance(entry, LazySerialized) for entry in report.entries)
+
+    loaded = pickle.loads(pickle.dumps(report))
+    assert loaded.status == Status.FAILED
+    assert loaded.entries == data["entries"]
@@ -14,6 +14,7 @@ from testplan.testing.multitest import result as result_mod
 from testplan.testing.multitest.suite import testcase, testsuite
 from testplan.testing.multitest import MultiTest
 from testplan.common.utils import comparison
+from testplan.common.utils import hdr
 from testplan.common.utils import testing
 from testplan.common.utils import path as path_utils
 
@@ -367,6 +368,33 @@ class TestResultBaseNamespace(object):
         assert type(result.entries[0].series_options) is dict
         assert result.entries[0].graph_options is None
 
+    def test_histogram(self):
+        """Unit testcase for the result.histogram method."""
+        result = result_mod.Result()
+        entry = result.histogram(range(1, 1001), description="Latency")
+
+        assert len(result.entries) == 1
+        assert entry.count == 1000
+        assert entry.unit == "ns"
+        assert (entry.min, entry.max) == (1, 1000)
+        assert entry.percentiles[0] == {"percentile": 0.0, "value": 1}
+        assert entry.percentiles[-1] == {"percentile": 100.0, "value": 1000}
+        # Highest value of the bucket of 500, within the precision
+        assert entry.value_at_percentile(50) == 501
+
+        shards = [
+            hdr.HDRHistogram(unit="us").record_values(range(0, 100)),
+            hdr.HDRHistogram(unit="us").record_values(range(100, 200)),
+        ]
+        entry = result.histogram(hdr.merge(shards), description="Merged")
+        assert entry.count == 200
+        assert entry.unit == "us"
+
+        serialized = entry.serialize()
+        assert serialized["type"] == "Histogram"
+        assert serialized["histogram"] == hdr.merge(shards).encode()
+        assert serialized["mean"] == pytest.approx(99.5)
+
     def test_attach(self, tmpdir):
         """UT for result.attach method."""
         tmpfile = str(tmpdir.join("attach_me.txt"))
@@ -1,6 +1,12 @@
+import datetime
+
 import pytest
 
+from testplan.common.utils.timing import Interval
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
 from testplan.testing import ordering
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.schemas.base import registry
 
 
 def test_noop_sorter():
@@ -107,3 +113,120 @@ class TestShuffleSorter(object):
         sorter = ordering.ShuffleSorter(seed=5, shuffle_type=shuffle_types)
         arr = [1, 2, 3, 4, 5]
         assert expected == sorter.sorted_testcases(None, arr)
+
+
+START = datetime.datetime(2026, 10, 18, 9, 0, 0)
+
+
+def make_run(durations, failed=()):
+    """Report of a run of a binary, testcases named ``Suite.testcase``."""
+    suites = {}
+    for name, duration in durations.items():
+        suite_name, testcase_name = name.split(".")
+        if suite_name not in suites:
+            suites[suite_name] = TestGroupReport(
+                name=suite_name, uid=suite_name, category="testsuite"
+            )
+        testcase = TestCaseReport(name=testcase_name, uid=testcase_name)
+        testcase.timer["run"] = Interval(
+            START, START + datetime.timedelta(seconds=duration)
+        )
+        testcase.append(
+            registry.serialize(
+                RawAssertion(
+                    description="check", content="", passed=name not in failed
+                )
+            )
+        )
+        suites[suite_name].append(testcase)
+    binary = TestGroupReport(
+        name="bin", uid="bin", category="gtest", entries=list(suites.values())
+    )
+    return TestReport(name="plan", entries=[binary])
+
+
+DURATIONS = {"A.slow": 3, "A.fast": 1, "B.one": 2, "B.two": 0.5}
+
+
+def test_failure_history_probability():
+    sorter = ordering.FailureHistorySorter(
+        history=[
+            make_run(DURATIONS, failed={"B.two"}),
+            make_run(DURATIONS, failed={"A.slow"}),
+        ],
+        decay=0.5,
+    )
+    # Failed in the latest run (weight 1) out of two (weight 1.5)
+    assert sorter.failure_probability("bin", "B", "two") == pytest.approx(
+        1 / 1.5
+    )
+    assert sorter.failure_probability("bin", "A", "slow") == pytest.approx(
+        0.5 / 1.5
+    )
+    assert sorter.failure_probability("bin", "A", "fast") == 0
+    assert sorter.failure_probability("other", "A", "slow") == 0
+
+    with pytest.raises(ValueError):
+        ordering.FailureHistorySorter(history=[], decay=0)
+
+
+def test_failure_history_order_test_context():
+    sorter = ordering.FailureHistorySorter(
+        history=[make_run(DURATIONS, failed={"A.slow"})]
+    )
+    context = [
+        ["A", ["slow", "fast", "new"]],
+        ["B", ["one", "two/0  # GetParam() = 1"]],
+    ]
+    units, failing = sorter.order_test_context("bin", context)
+    # Failed first, then by duration, testcases without history keep their
+    # listing order
+    assert failing == 1
+    assert units == [
+        ("A", "slow"),
+        ("A", "new"),
+        ("B", "two/0  # GetParam() = 1"),
+        ("A", "fast"),
+        ("B", "one"),
+    ]
+
+    # Suites run as a whole
+    units, failing = sorter.order_test_context("bin", [["B", []], ["A", []]])
+    assert units == [("A", None), ("B", None)] and failing == 1
+
+
+class Named(object):
+    def __init__(self, name):
+        self.name = name
+
+
+def test_failure_history_sort_by_names():
+    sorter = ordering.FailureHistorySorter(
+        history=[make_run(DURATIONS, failed={"B.one"})],
+        sort_type=ordering.SortType.SUITES,
+    )
+    suites = [Named("A"), Named("B")]
+    assert [
+        suite.name for suite in sorter.sorted_testsuites(suites, Named("bin"))
+    ] == ["B", "A"]
+    # Only suites are sorted
+    testcases = [Named("one"), Named("fast")]
+    assert sorter.sorted_testcases(None, testcases, Named("bin")) == testcases
+
+
+def test_failure_history_sort_by_instance():
+    """Suites and testcases are sorted by the history of their instance."""
+    sorter = ordering.FailureHistorySorter(
+        history=[make_run(DURATIONS, failed={"B.one"})]
+    )
+    suites = [Named("A"), Named("B")]
+    testcases = [Named("two"), Named("one")]
+
+    assert sorter.sorted_testsuites(suites, Named("bin")) == suites[::-1]
+    assert sorter.sorted_testcases(suites[1], testcases, Named("bin")) == (
+        testcases[::-1]
+    )
+    # Same suite and testcase names in other instances or without instance
+    for test in (Named("other"), None):
+        assert sorter.sorted_testsuites(suites, test) == suites
+        assert sorter.sorted_testcases(suites[1], testcases, test) == testcases
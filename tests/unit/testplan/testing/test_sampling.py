@@ -0,0 +1,141 @@
+import pytest
+
+from testplan.report import TestReport, TestGroupReport, TestCaseReport
+from testplan.testing import sampling
+from testplan.testing.multitest.entries.assertions import RawAssertion
+from testplan.testing.multitest.entries.schemas.base import registry
+
+CONTEXT = [
+    ["Big", ["test{}".format(index) for index in range(100)]],
+    ["Small", ["one", "two"]],
+]
+
+
+def test_stratified():
+    selection = sampling.Sample(fraction=0.05, seed=1).select("bin", CONTEXT)
+    suites = dict(selection.suites())
+    # 5% of each suite, at least one testcase
+    assert len(suites["Big"]) == 5
+    assert len(suites["Small"]) == 1
+    assert selection.listed == 102
+    assert len(selection) == 6
+    # Listing order
+    assert suites["Big"] == sorted(
+        suites["Big"], key=lambda name: int(name[4:])
+    )
+
+
+def test_deterministic():
+    sample = sampling.Sample(fraction=0.1, seed="abc")
+    first = sample.select("bin", CONTEXT).names()
+    assert first == sample.select("bin", CONTEXT).names()
+    other = sampling.Sample(fraction=0.1, seed="abd").select("bin", CONTEXT)
+    assert first != other.names()
+
+    # New testcases do not reshuffle the rest of the sample
+    grown = [
+        ["Big", CONTEXT[0][1] + ["test{}".format(100 + i) for i in range(5)]],
+        CONTEXT[1],
+    ]
+    sampled = set(sample.select("bin", grown).names())
+    kept = [name for name in first if name in sampled]
+    assert len(kept) >= len(first) - 1
+
+
+def test_minimum_and_fraction():
+    selection = sampling.Sample(fraction=0.01, minimum=3).select(
+        "bin", CONTEXT
+    )
+    assert [len(cases) for _, cases in selection.suites()] == [3, 2]
+    selection = sampling.Sample(fraction=1).select("bin", CONTEXT)
+    assert len(selection) == selection.listed
+
+    with pytest.raises(ValueError):
+        sampling.Sample(fraction=0)
+    with pytest.raises(ValueError):
+        sampling.Sample(minimum=-1)
+
+
+@pytest.mark.parametrize(
+    "always_run",
+    (["Big.test7*", "Small.*"], {"bin": ["Big.test7*", "Small.*"]}),
+)
+def test_always_run(always_run):
+    sample = sampling.Sample(fraction=0.01, seed=3, always_run=always_run)
+    selection = sample.select("bin", CONTEXT)
+    names = selection.names()
+    for name in ["Big.test7"] + ["Big.test7{}".format(i) for i in range(10)]:
+        assert name in names
+    assert "Small.one" in names and "Small.two" in names
+    assert len(selection.always_run) == len(selection) - 2
+    assert sample.select("other", CONTEXT).always_run == (
+        [] if isinstance(always_run, dict) else selection.always_run
+    )
+
+
+def test_whole_suites():
+    context = [["Suite{}".format(index), []] for index in range(20)]
+    selection = sampling.Sample(fraction=0.1, seed=5).select("bin", context)
+    assert len(selection) == 2
+    assert all(not cases for _, cases in selection.suites())
+    suite = selection.names()[0]
+    assert selection.contains(suite, "anything")
+
+
+def make_report(failed):
+    def testcase(name):
+        report = TestCaseReport(name=name, uid=name)
+        report.append(
+            registry.serialize(
+                RawAssertion(
+                    description=name, content="", passed=name not in failed
+                )
+            )
+        )
+        return report
+
+    suites = [
+        TestGroupReport(
+            name=suite,
+            uid=suite,
+            category="testsuite",
+            entries=[testcase(name) for name in testcases],
+        )
+        for suite, testcases in CONTEXT
+    ]
+    suites.append(
+        TestGroupReport(
+            name="ProcessChecks",
+            uid="ProcessChecks",
+            category="testsuite",
+            entries=[testcase("ExitCodeCheck")],
+        )
+    )
+    return TestGroupReport(
+        name="bin", uid="bin", category="gtest", entries=suites
+    )
+
+
+def test_coverage():
+    selection = sampling.Sample(fraction=0.05, seed=1).select("bin", CONTEXT)
+    big = dict(selection.suites())["Big"]
+    missed = next(name for name in CONTEXT[0][1] if name not in big)
+    report = make_report({big[0], missed, "ExitCodeCheck"})
+    coverage = selection.coverage(report, ignored_suites=("ProcessChecks",))
+    assert coverage == {
+        "failed": 2,
+        "caught": 1,
+        "missed": ["Big.{}".format(missed)],
+    }
+
+    description = selection.to_dict()
+    assert description["selected"] == 6
+    assert description["listed"] == 102
+    assert description["testcases"] == selection.names()
+
+
+def test_recent_failures():
+    plan = TestReport(name="plan", entries=[make_report({"test3", "one"})])
+    assert sampling.recent_failures(plan) == {
+        "bin": ["Big.test3", "Small.one"]
+    }
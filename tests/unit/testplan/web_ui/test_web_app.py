@@ -1,4 +1,5 @@
 import os
+import json
 import uuid
 import shutil
 import tempfile
@@ -6,7 +7,16 @@ import tempfile
 import pytest
 
 from testplan import defaults
-from testplan.web_ui.web_app import app as tp_web_app
+from testplan.common.utils.events import EventBus
+from testplan.report import Status, TestReport
+from testplan.report.testing.journal import ReportJournal
+from testplan.runnable.monitor import RunMonitor
+from testplan.web_ui.web_app import (
+    app as tp_web_app,
+    event_stream,
+    generate_monitor_app,
+    TestplanReport,
+)
 
 STATIC_REPORTS = {
     "testing": {"uid": str(uuid.uuid4()), "contents": str(uuid.uuid4())}
@@ -182,3 +192,119 @@ class TestDataEndpoints(object):
         expected_contents = str(DATA_REPORTS["testplan"]["contents"])
         assert response.status_code == 200
         assert expected_contents in str(response.data)
+
+    def test_testplan_report_journal(self):
+        """Is the report of a journal returned as JSON."""
+        journal_path = os.path.join(self.data_dir, "report.journal")
+        ReportJournal(journal_path).open(TestReport(name="plan"))
+        tp_web_app.config["TESTPLAN_REPORT_NAME"] = "report.journal"
+        try:
+            with tp_web_app.test_request_context():
+                response = TestplanReport().get("123")
+        finally:
+            tp_web_app.config["TESTPLAN_REPORT_NAME"] = "report.json"
+        assert response.status_code == 200
+        data = json.loads(response.get_data())
+        assert data["name"] == "plan"
+        assert data["status"] == Status.INCOMPLETE
+
+
+def _parse_sse(chunks):
+    """Kind and data of the server-sent events in chunks of a stream."""
+    messages = []
+    for message in "".join(chunks).split("\n\n"):
+        fields = dict(
+            line.split(": ", 1)
+            for line in message.split("\n")
+            if line and not line.startswith(":")
+        )
+        if fields:
+            messages.append(
+                (
+                    int(fields["id"]),
+                    fields["event"],
+                    json.loads(fields["data"]),
+                )
+            )
+    return messages
+
+
+class TestMonitorEndpoints(object):
+    """
+    Test the endpoints of the live monitor of a run.
+    """
+
+    def setup_method(self, _):
+        """Create the event bus and state of a run."""
+        self.bus = EventBus()
+        self.monitor = RunMonitor(self.bus, name="plan")
+        self.bus.publish("plan_started", tests={"A": "local_runner"})
+        self.client = generate_monitor_app(
+            self.bus, self.monitor, max_streams=1
+        ).test_client()
+
+    def test_monitor_state(self):
+        """Is the state of the run returned as JSON."""
+        response = self.client.get("/api/v1/monitor/state")
+        assert response.status_code == 200
+        data = json.loads(response.get_data())
+        assert data["seq"] == 1
+        assert data["plan"]["name"] == "plan"
+        assert data["tests"]["A"]["executor"] == "local_runner"
+
+    def test_monitor_events(self):
+        """Are clients sent the state of the run then its events."""
+        self.bus.publish("test_started", test="A", executor="local_runner")
+        self.bus.close()
+
+        messages = _parse_sse(event_stream(self.bus, self.monitor))
+        assert [message[:2] for message in messages] == [(2, "snapshot")]
+        assert messages[0][2]["tests"]["A"]["status"] == "running"
+
+        # Clients resuming the stream are sent the events they missed
+        messages = _parse_sse(event_stream(self.bus, self.monitor, since=1))
+        assert [message[:2] for message in messages] == [(2, "test_started")]
+        assert messages[0][2]["test"] == "A"
+
+    def test_monitor_events_limit(self):
+        """Are clients past the limit of streams refused."""
+        response = self.client.get("/api/v1/monitor/events")
+        assert response.status_code == 200
+        assert response.mimetype == "text/event-stream"
+        assert self.client.get("/api/v1/monitor/events").status_code == 503
+
+        # The stream is closed without having been sent
+        response.close()
+        response = self.client.get("/api/v1/monitor/events")
+        assert response.status_code == 200
+        self.bus.close()
+        assert _parse_sse(chunk.decode() for chunk in response.response) == [
+            (1, "snapshot", self.monitor.snapshot())
+        ]
+        response.close()
+
+    def test_monitor_app(self):
+        """Is the monitor served apart from the UI of the reports."""
+        client = tp_web_app.test_client()
+        for url in ("/monitor/", "/api/v1/monitor/state"):
+            assert client.get(url).status_code == 404
+        assert self.client.get("/api/v1/monitor/state").status_code == 200
+
+    def test_monitor_events_reset(self):
+        """Are clients missing events no longer kept sent the state."""
+        bus = EventBus(history=2)
+        monitor = RunMonitor(bus)
+        for _ in range(4):
+            bus.publish("event")
+        bus.close()
+
+        for since in (1, 10):
+            messages = _parse_sse(event_stream(bus, monitor, since=since))
+            assert [message[:2] for message in messages] == [(4, "snapshot")]
+
+    def test_monitor_events_keepalive(self):
+        """Are idle clients sent comments until there are events."""
+        stream = event_stream(self.bus, self.monitor, since=1, keepalive=0)
+        assert next(stream) == ": keepalive\n\n"
+        self.bus.publish("test_started", test="A", executor="local_runner")
+        assert _parse_sse([next(stream)])[0][:2] == (2, "test_started")